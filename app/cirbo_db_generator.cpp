@@ -0,0 +1,128 @@
+#include <CLI/CLI.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "circuits_db/database_generator.hpp"
+#include "core/npn.hpp"
+#include "synthesis/exact_synthesis.hpp"
+#include "utils/cast.hpp"
+
+namespace
+{
+
+using namespace cirbo;  // NOLINT
+
+/**
+ * Reads additional functions of `inputs` inputs, one hexadecimal truth table
+ * per line, and returns their NPN-canonical representatives.
+ */
+std::vector<circuits_db::GenerationTask> readClasses(std::string const& file_path, size_t inputs)
+{
+    std::ifstream file(file_path);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Can't open classes file '" + file_path + "'.");
+    }
+    std::vector<circuits_db::GenerationTask> tasks;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line.front() == '#')
+        {
+            continue;
+        }
+        uint64_t const truth = std::stoull(line, nullptr, 16);
+        tasks.push_back({npn::canonize(truth, inputs).truth, inputs});
+    }
+    return tasks;
+}
+
+}  // namespace
+
+int main(int const argc, char** argv)
+{
+    try
+    {
+        CLI::App app{"Cirbo-Search generator of database of optimal small circuits"};
+
+        std::string output_file;
+        std::string basis_name = "BENCH";
+        size_t max_inputs      = npn::MaxExhaustiveVariables;
+        std::string classes_file;
+        size_t classes_inputs       = 5;
+        size_t threads              = 0;
+        size_t max_gates            = synthesis::ExactSynthesizer::DefaultMaxGates;
+        int64_t conflict_limit      = -1;
+        int64_t checkpoint_interval = circuits_db::DatabaseGenerator::DefaultCheckpointInterval.count();
+        size_t shard_index          = 0;
+        size_t shard_count          = 1;
+        std::vector<std::string> merge_files;
+        app.add_option("-o,--output", output_file, "path to database, existing one is continued")->required();
+        app.add_option("--basis", basis_name, "basis of circuits")
+            ->check(CLI::IsMember({"BENCH", "AIG", "XAG"}))
+            ->capture_default_str();
+        app.add_option("--max-inputs", max_inputs, "all NPN classes of up to this number of inputs are synthesized")
+            ->check(CLI::Range(size_t{0}, npn::MaxExhaustiveVariables))
+            ->capture_default_str();
+        app.add_option("--classes", classes_file, "file with additional hexadecimal truth tables, one per line");
+        app.add_option("--classes-inputs", classes_inputs, "number of inputs of functions from classes file")
+            ->check(CLI::Range(size_t{0}, npn::MaxVariables))
+            ->capture_default_str();
+        app.add_option("--threads", threads, "number of threads, 0 means all hardware threads")->capture_default_str();
+        app.add_option("--max-gates", max_gates, "maximum size of synthesized circuit")->capture_default_str();
+        app.add_option("--conflict-limit", conflict_limit, "conflict limit of each SAT query, negative means no limit")
+            ->capture_default_str();
+        app.add_option("--checkpoint-interval", checkpoint_interval, "seconds between database checkpoints")
+            ->check(CLI::NonNegativeNumber)
+            ->capture_default_str();
+        app.add_option("--shard-index", shard_index, "index of this shard of work")->capture_default_str();
+        app.add_option("--shard-count", shard_count, "number of shards, work is split among")->capture_default_str();
+        app.add_option(
+            "--merge",
+            merge_files,
+            "instead of synthesis, merge given databases (e.g. files of shards, written to <output>.shard-I-of-N) "
+            "into the output");
+
+        CLI11_PARSE(app, argc, argv);
+
+        if (!merge_files.empty())
+        {
+            size_t const circuits = circuits_db::DatabaseGenerator::merge(merge_files, output_file);
+            std::cout << "merged: " << merge_files.size() << " files, circuits: " << circuits << std::endl;
+            return 0;
+        }
+
+        std::vector<circuits_db::GenerationTask> tasks =
+            circuits_db::DatabaseGenerator::enumerateNpnClasses(max_inputs);
+        if (!classes_file.empty())
+        {
+            auto const extra = readClasses(classes_file, classes_inputs);
+            tasks.insert(tasks.end(), extra.begin(), extra.end());
+        }
+
+        circuits_db::DatabaseGenerator const generator(
+            synthesis::ExactSynthesizer(utils::stringToBasis(basis_name), max_gates, conflict_limit),
+            threads,
+            std::chrono::seconds(checkpoint_interval));
+        circuits_db::GenerationStatistics const statistics =
+            generator.run(tasks, output_file, shard_index, shard_count);
+
+        std::cout << "solved: " << statistics.solved << ", failed: " << statistics.failed
+                  << ", skipped: " << statistics.skipped << ", checkpoints: " << statistics.checkpoints << std::endl;
+    }
+    catch (std::exception const& exc)
+    {
+        std::cerr << "An exception occurred:\n";
+        std::cerr << exc.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,19 +1,32 @@
 #include <CLI/CLI.hpp>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
 #include <cstdlib>
 #include <exception>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <tuple>
+#include <utility>
+#include <vector>
 
+#include "core/cost_model.hpp"
 #include "core/structures/dag.hpp"
 #include "io/parsers/bench_to_circuit.hpp"
 #include "io/writers/write_utils.hpp"
 #include "logger.hpp"
-#include "minimization/composition.hpp"
-#include "minimization/strategy.hpp"
+#include "minimization/adaptive_scheduler.hpp"
+#include "minimization/pass_report.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/registry.hpp"
+#include "utils/buffer_pool.hpp"
 #include "utils/encoder.hpp"
+#include "verification/equivalence_checker.hpp"
 
 namespace
 {
@@ -45,23 +58,105 @@ void writeResult(DAG const& simplified_circuit, utils::NameEncoder const& encode
 }
 
 /**
- * Helper to run specific minimization strategies on the circuit.
+ * Helper to run minimization pipeline on the circuit.
  */
 std::tuple<std::unique_ptr<DAG>, std::unique_ptr<utils::NameEncoder>> applySimplification(
-    std::unique_ptr<DAG>& csat_instance,
-    utils::NameEncoder& encoder)
+    minimization::ITransformer<DAG>& pipeline,
+    std::unique_ptr<DAG> csat_instance,
+    std::unique_ptr<utils::NameEncoder> encoder)
 {
-    return minimization::
-        Composition<DAG, minimization::DuplicateGatesCleaner<DAG>, minimization::DuplicateOperandsCleaner<DAG>>()
-            .apply(*csat_instance, encoder);
+    return pipeline.apply(std::move(csat_instance), std::move(encoder));
 }
 
 /**
- * Performs minimization of the given circuit located at the `input_path`.
+ * Prints registered transformers and pipeline presets.
+ */
+void listTransformers(std::ostream& out)
+{
+    auto const& registry = minimization::getDefaultTransformerRegistry();
+    out << "Transformers:\n";
+    for (auto const& [name, entry] : registry.getEntries())
+    {
+        out << "  " << name;
+        if (!entry.parameters.empty())
+        {
+            out << "(";
+            for (size_t i = 0; i < entry.parameters.size(); ++i)
+            {
+                out << (i == 0 ? "" : ", ") << entry.parameters.at(i);
+            }
+            out << ")";
+        }
+        out << " -- " << entry.description << "\n";
+    }
+    out << "Presets:\n";
+    for (auto const& [name, pipeline] : registry.getPresets())
+    {
+        out << "  " << name << " = " << pipeline << "\n";
+    }
+}
+
+/**
+ * Reads whole pipeline description file.
+ */
+std::string readPipelineFile(std::string const& file_path)
+{
+    auto file = openFileStream(file_path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+/**
+ * Writes per-pass report, collected during minimization, to the `report_path`.
+ */
+void writeReport(std::string const& report_path)
+{
+    std::ofstream file_out(report_path);
+    if (!file_out.is_open())
+    {
+        log::error("Can't open report file, path is incorrect.");
+        std::abort();
+    }
+    minimization::PassReport::getInstance().writeJson(file_out);
+}
+
+/**
+ * Checks, that minimized circuit is equivalent to the original one, and prints per-output report.
+ *
+ * @return true iff all outputs are proven to be equivalent.
+ */
+bool verifyResult(
+    std::string const& input_file,
+    DAG const& original,
+    utils::NameEncoder const& original_encoder,
+    DAG const& simplified,
+    utils::NameEncoder const& simplified_encoder)
+{
+    log::debug(input_file, ": verification start.");
+    verification::EquivalenceReport const report =
+        verification::EquivalenceChecker().check(original, original_encoder, simplified, simplified_encoder);
+    log::debug(input_file, ": verification end.");
+
+    std::cout << input_file << ": " << (report.isEquivalent() ? "verified" : "NOT verified") << "\n";
+    report.write(std::cout);
+    return report.isEquivalent();
+}
+
+/**
+ * Performs minimization of the given circuit located at the `input_file`.
  *
  * @param input_file path to the input circuit.
+ * @param output_file path to the resulting circuit.
+ * @param pipeline transformer to apply.
+ * @param verify whether to check equivalence of resulting circuit to the input one.
+ * @return false iff verification is requested and failed.
  */
-void minimize(std::string const& input_file, std::string const& output_file)
+bool minimizeFile(
+    std::string const& input_file,
+    std::string const& output_file,
+    minimization::ITransformer<DAG>& pipeline,
+    bool verify)
 {
     log::debug("Opening circuit file at ", input_file, ".");
     auto fstream = openFileStream(input_file);
@@ -70,15 +165,73 @@ void minimize(std::string const& input_file, std::string const& output_file)
     io::parsers::BenchToCircuit<DAG> parser{};
     parser.parseStream(fstream);
 
-    auto encoder       = parser.getEncoder();
+    auto encoder       = std::make_unique<utils::NameEncoder>(std::move(parser.encoder));
     auto csat_instance = parser.instantiate();
+    // Minimization takes ownership of the circuit, so original is kept for verification.
+    std::unique_ptr<DAG> original;
+    std::unique_ptr<utils::NameEncoder> original_encoder;
+    if (verify)
+    {
+        original         = std::make_unique<DAG>(*csat_instance);
+        original_encoder = std::make_unique<utils::NameEncoder>(*encoder);
+    }
 
     // Start minimization step.
     log::debug(input_file, ": minimization start.");
-    auto [simplified_instance, simplified_encoder] = applySimplification(csat_instance, encoder);
+    auto [simplified_instance, simplified_encoder] = applySimplification(
+        pipeline, std::move(csat_instance), std::move(encoder));
     log::debug(input_file, ": minimization end.");
 
     writeResult(*simplified_instance, *simplified_encoder, output_file);
+    bool const verified =
+        !verify || verifyResult(input_file, *original, *original_encoder, *simplified_instance, *simplified_encoder);
+
+    // Buffers, kept for the next pass, are not needed after the last one.
+    simplified_instance.reset();
+    original.reset();
+    utils::clearBufferPools();
+    return verified;
+}
+
+/**
+ * Performs minimization of a single circuit, or of all .BENCH files of the
+ * directory `input_path`, writing results to the directory `output_path`.
+ * The same transformer is used for all circuits, so adaptive scheduler keeps
+ * learning over the whole batch.
+ *
+ * @return false iff verification is requested and failed for some circuit.
+ */
+bool minimize(
+    std::string const& input_path,
+    std::string const& output_path,
+    minimization::ITransformer<DAG>& pipeline,
+    bool verify)
+{
+    namespace fs = std::filesystem;
+    if (!fs::is_directory(input_path))
+    {
+        return minimizeFile(input_path, output_path, pipeline, verify);
+    }
+
+    fs::create_directories(output_path);
+    std::vector<fs::path> files;
+    for (auto const& entry : fs::directory_iterator(input_path))
+    {
+        std::string extension = entry.path().extension().string();
+        std::ranges::transform(extension, extension.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (entry.is_regular_file() && extension == ".bench")
+        {
+            files.push_back(entry.path());
+        }
+    }
+    // Directory order is unspecified, sorting makes runs reproducible.
+    std::ranges::sort(files);
+    bool verified = true;
+    for (auto const& file : files)
+    {
+        verified &= minimizeFile(file.string(), (fs::path(output_path) / file.filename()).string(), pipeline, verify);
+    }
+    return verified;
 }
 
 }  // namespace
@@ -91,12 +244,95 @@ int main(int const argc, char** argv)
 
         std::string input_file;
         std::string output_file;
+        std::string pipeline_text = "default";
+        std::string pipeline_file;
+        std::string report_file;
+        std::string cost       = "gates";
+        std::string schedule   = "static";
+        int64_t time_budget    = minimization::AdaptiveScheduler<DAG>::DefaultTimeBudget.count();
+        bool list_transformers = false;
+        bool verify            = false;
         app.add_option("-i,--input-path", input_file, "directory with input .BENCH files (or a single .BENCH file)");
         app.add_option("-o,--output", output_file, "path to resulting directory or to a resulting single .BENCH file");
+        auto* pipeline_option = app.add_option(
+            "-p,--pipeline",
+            pipeline_text,
+            "minimization pipeline, e.g. \"DuplicateGatesCleaner; fixpoint { ConstantGateReducer; DeMorgan }\"");
+        pipeline_option->capture_default_str();
+        app.add_option("--pipeline-file", pipeline_file, "file with minimization pipeline description")
+            ->excludes(pipeline_option);
+        app.add_option(
+            "--report",
+            report_file,
+            "path to JSON report with time, memory and effect of each applied transformer");
+        app.add_option(
+               "--cost",
+               cost,
+               "cost model of report and adaptive schedule, e.g. \"gates/XOR:0/MUX:3\" (see also cost parameter of "
+               "local search transformers)")
+            ->capture_default_str();
+        app.add_option(
+               "--schedule",
+               schedule,
+               "\"static\" applies the pipeline, \"adaptive\" chooses passes at runtime by gain per second among "
+               "top-level items of the pipeline, if it is given, or among default passes")
+            ->check(CLI::IsMember({"static", "adaptive"}))
+            ->capture_default_str();
+        app.add_option("--time-budget", time_budget, "time budget of adaptive schedule per circuit, in milliseconds")
+            ->check(CLI::NonNegativeNumber)
+            ->capture_default_str();
+        app.add_flag("--list-transformers", list_transformers, "print available transformers and presets, then exit");
+        app.add_flag("--verify", verify, "check that minimized circuits are equivalent to the input ones");
 
         CLI11_PARSE(app, argc, argv);
 
-        minimize(input_file, output_file);
+        if (list_transformers)
+        {
+            listTransformers(std::cout);
+            return 0;
+        }
+        if (!pipeline_file.empty())
+        {
+            pipeline_text = readPipelineFile(pipeline_file);
+        }
+
+        // Pipeline is built first, so malformed description is reported before reading circuits.
+        CostModel const cost_model = CostModel::parse(cost);
+        std::unique_ptr<minimization::ITransformer<DAG>> pipeline;
+        if (schedule == "adaptive" && (pipeline_option->count() > 0 || !pipeline_file.empty()))
+        {
+            // Top-level items of explicitly given pipeline are arms of the schedule.
+            pipeline = minimization::makeAdaptiveScheduler(
+                std::chrono::milliseconds(time_budget),
+                std::make_shared<minimization::SchedulerStatistics>(),
+                minimization::parsePipeline(pipeline_text)->releaseTransformers(),
+                cost_model);
+        }
+        else if (schedule == "adaptive")
+        {
+            pipeline = minimization::makeAdaptiveScheduler(
+                std::chrono::milliseconds(time_budget),
+                std::make_shared<minimization::SchedulerStatistics>(),
+                minimization::getDefaultScheduledPasses(),
+                cost_model);
+        }
+        else
+        {
+            pipeline = minimization::parsePipeline(pipeline_text);
+        }
+
+        minimization::PassReport::getInstance().setEnabled(!report_file.empty());
+        minimization::PassReport::getInstance().setCostModel(cost_model);
+        bool const verified = minimize(input_file, output_file, *pipeline, verify);
+        if (!report_file.empty())
+        {
+            writeReport(report_file);
+        }
+        if (!verified)
+        {
+            std::cerr << "Verification failed: minimized circuit is not equivalent to the input one." << std::endl;
+            return 1;
+        }
     }
     catch (std::exception const& exc)
     {
@@ -0,0 +1,569 @@
+#ifndef CIRBO_SEARCH_CIRCUITS_DB_CIRCUIT_DATABASE_HPP
+#define CIRBO_SEARCH_CIRCUITS_DB_CIRCUIT_DATABASE_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/npn.hpp"
+#include "core/types.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CIRBO_SEARCH_CIRCUITS_DB_MMAP
+#endif
+
+/**
+ * Database of optimal small single-output circuits, indexed by truth table of
+ * their function (usually NPN-canonical one, see `core/npn.hpp`).
+ *
+ * On-disk format (native byte order, all offsets are from the file start):
+ *
+ *   FileHeader     | magic "CIRBODB1", version, number of sections
+ *   SectionHeader  | one per basis: basis, number of index slots and
+ *   ...            | circuits, offsets of index and records, size of records
+ *   Index          | open addressing hash table of (truth, inputs) -> record
+ *   Records        | inputs, gates, output, then 5 bytes per gate:
+ *   ...            | type, arity, three operands
+ *
+ * File is mapped read-only and shared, so all processes using a database get
+ * one page-cached copy and pay nothing on startup except for pages, which
+ * their lookups touch.
+ */
+namespace cirbo::circuits_db
+{
+
+/* Gate of a database circuit. Operand `i < inputs` is input, others are gates `operand - inputs`. */
+struct GateRecord
+{
+    GateType type = GateType::UNDEFINED;
+    uint8_t arity = 0;
+    std::array<uint8_t, 3> operands{};
+
+    bool operator==(GateRecord const&) const = default;
+};
+
+/**
+ * Computes truth tables of all nodes of a small circuit: `inputs` inputs are
+ * followed by gates, each gate refers to inputs and previous gates.
+ *
+ * @return truth table of each node, in the format of `core/npn.hpp`.
+ */
+[[nodiscard]]
+inline std::vector<uint64_t> simulateGates(size_t inputs, std::vector<GateRecord> const& gates)
+{
+    std::vector<uint64_t> values(inputs + gates.size(), 0);
+    for (size_t i = 0; i < inputs; ++i)
+    {
+        values[i] = npn::VariableMasks.at(i) & npn::getTruthMask(inputs);
+    }
+    for (size_t i = 0; i < gates.size(); ++i)
+    {
+        GateRecord const& gate = gates[i];
+        auto const operand     = [&values, &gate](size_t j) { return values.at(gate.operands.at(j)); };
+        uint64_t value         = 0;
+        switch (gate.type)
+        {
+            case GateType::CONST_FALSE:
+                value = 0;
+                break;
+            case GateType::CONST_TRUE:
+                value = ~uint64_t{0};
+                break;
+            case GateType::NOT:
+                value = ~operand(0);
+                break;
+            case GateType::IFF:
+            case GateType::BUFF:
+                value = operand(0);
+                break;
+            case GateType::MUX:
+                value = (~operand(0) & operand(1)) | (operand(0) & operand(2));
+                break;
+            case GateType::AND:
+            case GateType::NAND:
+                value = ~uint64_t{0};
+                for (size_t j = 0; j < gate.arity; ++j)
+                {
+                    value &= operand(j);
+                }
+                value = gate.type == GateType::NAND ? ~value : value;
+                break;
+            case GateType::OR:
+            case GateType::NOR:
+                for (size_t j = 0; j < gate.arity; ++j)
+                {
+                    value |= operand(j);
+                }
+                value = gate.type == GateType::NOR ? ~value : value;
+                break;
+            case GateType::XOR:
+            case GateType::NXOR:
+                for (size_t j = 0; j < gate.arity; ++j)
+                {
+                    value ^= operand(j);
+                }
+                value = gate.type == GateType::NXOR ? ~value : value;
+                break;
+            default:
+                throw std::invalid_argument("simulateGates: unsupported gate type.");
+        }
+        values[inputs + i] = value & npn::getTruthMask(inputs);
+    }
+    return values;
+}
+
+/**
+ * Single-output circuit with at most `npn::MaxVariables` inputs. Inputs have
+ * ids `0..inputs - 1`, i-th gate has id `inputs + i`, output is any of them.
+ */
+struct DatabaseCircuit
+{
+    uint8_t inputs = 0;
+    uint8_t output = 0;
+    std::vector<GateRecord> gates;
+
+    bool operator==(DatabaseCircuit const&) const = default;
+
+    /* Returns truth table of output, in the format of `core/npn.hpp`. */
+    [[nodiscard]]
+    uint64_t computeTruthTable() const
+    {
+        return simulateGates(inputs, gates).at(output);
+    }
+};
+
+/**
+ * Returns circuit of original function, given circuit of its NPN-canonical
+ * form (see `npn::Transform`). Negations of used inputs and of output are
+ * implemented by NOT gates.
+ */
+[[nodiscard]]
+inline DatabaseCircuit restoreCircuit(DatabaseCircuit const& canonical, npn::Transform const& transform)
+{
+    DatabaseCircuit result{.inputs = canonical.inputs, .output = 0, .gates = {}};
+    // Node of result for each node of canonical circuit.
+    std::vector<uint8_t> nodes;
+    for (uint8_t i = 0; i < canonical.inputs; ++i)
+    {
+        nodes.push_back(transform.permutation[i]);
+        bool const used = canonical.output == i ||
+                          std::ranges::any_of(
+                              canonical.gates,
+                              [i](GateRecord const& gate)
+                              {
+                                  auto const end = gate.operands.begin() + gate.arity;
+                                  return std::find(gate.operands.begin(), end, i) != end;
+                              });
+        if (((transform.phase >> i) & 1U) != 0 && used)
+        {
+            result.gates.push_back({GateType::NOT, 1, {nodes[i], 0, 0}});
+            nodes[i] = static_cast<uint8_t>(result.inputs + result.gates.size() - 1);
+        }
+    }
+    for (GateRecord gate : canonical.gates)
+    {
+        for (size_t i = 0; i < gate.arity; ++i)
+        {
+            gate.operands[i] = nodes[gate.operands[i]];
+        }
+        nodes.push_back(static_cast<uint8_t>(result.inputs + result.gates.size()));
+        result.gates.push_back(gate);
+    }
+    result.output = nodes[canonical.output];
+    if (transform.output_negated)
+    {
+        result.gates.push_back({GateType::NOT, 1, {result.output, 0, 0}});
+        result.output = static_cast<uint8_t>(result.inputs + result.gates.size() - 1);
+    }
+    return result;
+}
+
+namespace impl
+{
+
+constexpr std::array<char, 8> Magic{'C', 'I', 'R', 'B', 'O', 'D', 'B', '1'};
+constexpr uint32_t Version = 1;
+
+/* Magic at 0, version at 8, number of sections at 12. */
+constexpr size_t FileHeaderSize = 16;
+/* Basis at 0, slots at 4, circuits at 8, index offset at 16, records offset at 24, records size at 32. */
+constexpr size_t SectionHeaderSize = 40;
+/* Truth table at 0, record offset (from records start) at 8, number of inputs at 12. */
+constexpr size_t IndexEntrySize = 16;
+constexpr size_t RecordHeaderSize  = 3;
+constexpr size_t GateRecordSize    = 5;
+/* Marks empty index slot, since circuits never have that many inputs. */
+constexpr uint8_t EmptySlot = 0xFF;
+
+/* Returns index slot, where lookup of function starts. `slots` is a power of two. */
+[[nodiscard]]
+inline size_t getHomeSlot(uint64_t truth, uint8_t inputs, size_t slots) noexcept
+{
+    uint64_t hash = truth ^ (static_cast<uint64_t>(inputs) * 0x9E3779B97F4A7C15ULL);
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDULL;
+    hash ^= hash >> 33;
+    return static_cast<size_t>(hash & (slots - 1));
+}
+
+template<typename T>
+[[nodiscard]]
+T readValue(std::byte const* data) noexcept
+{
+    T value;
+    std::memcpy(&value, data, sizeof(T));
+    return value;
+}
+
+}  // namespace impl
+
+/**
+ * Zero-copy view of a circuit record inside of database.
+ */
+class CircuitView
+{
+private:
+    std::byte const* record_;
+
+public:
+    explicit CircuitView(std::byte const* record)
+        : record_(record)
+    {
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfInputs() const noexcept
+    {
+        return impl::readValue<uint8_t>(record_);
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfGates() const noexcept
+    {
+        return impl::readValue<uint8_t>(record_ + 1);
+    }
+
+    [[nodiscard]]
+    size_t getOutput() const noexcept
+    {
+        return impl::readValue<uint8_t>(record_ + 2);
+    }
+
+    [[nodiscard]]
+    GateRecord getGate(size_t index) const noexcept
+    {
+        std::byte const* gate = record_ + impl::RecordHeaderSize + (index * impl::GateRecordSize);
+        GateRecord result;
+        result.type  = static_cast<GateType>(impl::readValue<uint8_t>(gate));
+        result.arity = impl::readValue<uint8_t>(gate + 1);
+        for (size_t i = 0; i < result.operands.size(); ++i)
+        {
+            result.operands[i] = impl::readValue<uint8_t>(gate + 2 + i);
+        }
+        return result;
+    }
+
+    [[nodiscard]]
+    DatabaseCircuit toCircuit() const
+    {
+        DatabaseCircuit circuit;
+        circuit.inputs = static_cast<uint8_t>(getNumberOfInputs());
+        circuit.output = static_cast<uint8_t>(getOutput());
+        for (size_t i = 0; i < getNumberOfGates(); ++i)
+        {
+            circuit.gates.push_back(getGate(i));
+        }
+        return circuit;
+    }
+};
+
+/**
+ * Read-only database of optimal circuits, mapped to memory. Lookups take
+ * constant time and do not allocate, so database may be shared by threads.
+ */
+class CircuitDatabase
+{
+private:
+    struct Section_
+    {
+        Basis basis;
+        size_t slots;
+        size_t circuits;
+        size_t index_offset;
+        size_t records_offset;
+        size_t records_size;
+    };
+
+    std::byte const* data_ = nullptr;
+    size_t size_           = 0;
+#ifdef CIRBO_SEARCH_CIRCUITS_DB_MMAP
+    void* mapping_ = nullptr;
+#else
+    std::vector<std::byte> buffer_;
+#endif
+    std::vector<Section_> sections_;
+
+public:
+    /**
+     * Opens database file.
+     *
+     * @throws std::runtime_error if file can't be read, or is not a valid database.
+     */
+    explicit CircuitDatabase(std::string const& path)
+    {
+        map_(path);
+        try
+        {
+            parseHeaders_();
+        }
+        catch (...)
+        {
+            unmap_();
+            throw;
+        }
+    }
+
+    CircuitDatabase(CircuitDatabase const&)            = delete;
+    CircuitDatabase& operator=(CircuitDatabase const&) = delete;
+    CircuitDatabase(CircuitDatabase&&)                 = delete;
+    CircuitDatabase& operator=(CircuitDatabase&&)      = delete;
+
+    ~CircuitDatabase()
+    {
+        unmap_();
+    }
+
+    [[nodiscard]]
+    bool hasBasis(Basis basis) const noexcept
+    {
+        return findSection_(basis) != nullptr;
+    }
+
+    /* Returns number of circuits in basis, 0 if there is no such basis. */
+    [[nodiscard]]
+    size_t getNumberOfCircuits(Basis basis) const noexcept
+    {
+        Section_ const* section = findSection_(basis);
+        return section == nullptr ? 0 : section->circuits;
+    }
+
+    [[nodiscard]]
+    std::vector<Basis> getBases() const
+    {
+        std::vector<Basis> bases;
+        for (Section_ const& section : sections_)
+        {
+            bases.push_back(section.basis);
+        }
+        return bases;
+    }
+
+    /**
+     * Calls `visitor` with view of each circuit of basis, in unspecified order.
+     *
+     * @throws std::runtime_error if some record of basis is malformed.
+     */
+    template<class VisitorT>
+    void forEachCircuit(Basis basis, VisitorT&& visitor) const
+    {
+        Section_ const* section = findSection_(basis);
+        for (size_t slot = 0; section != nullptr && slot < section->slots; ++slot)
+        {
+            std::byte const* entry = data_ + section->index_offset + (slot * impl::IndexEntrySize);
+            if (impl::readValue<uint8_t>(entry + 12) != impl::EmptySlot)
+            {
+                visitor(makeView_(*section, impl::readValue<uint32_t>(entry + 8)));
+            }
+        }
+    }
+
+    /**
+     * @param basis -- basis of circuit.
+     * @param truth -- truth table of function, bits beyond `2^inputs` are ignored.
+     * @param inputs -- number of inputs of function.
+     * @return circuit, computing the function, if it is stored in database.
+     * @throws std::runtime_error if record of circuit is malformed.
+     */
+    [[nodiscard]]
+    std::optional<CircuitView> find(Basis basis, uint64_t truth, size_t inputs) const
+    {
+        Section_ const* section = findSection_(basis);
+        if (section == nullptr || section->slots == 0 || inputs > npn::MaxVariables)
+        {
+            return std::nullopt;
+        }
+        truth &= npn::getTruthMask(inputs);
+        auto const key_inputs = static_cast<uint8_t>(inputs);
+        for (size_t slot = impl::getHomeSlot(truth, key_inputs, section->slots);;
+             slot        = (slot + 1) & (section->slots - 1))
+        {
+            std::byte const* entry = data_ + section->index_offset + (slot * impl::IndexEntrySize);
+            auto const entry_inputs = impl::readValue<uint8_t>(entry + 12);
+            if (entry_inputs == impl::EmptySlot)
+            {
+                return std::nullopt;
+            }
+            if (entry_inputs == key_inputs && impl::readValue<uint64_t>(entry) == truth)
+            {
+                return makeView_(*section, impl::readValue<uint32_t>(entry + 8));
+            }
+        }
+    }
+
+private:
+    [[nodiscard]]
+    Section_ const* findSection_(Basis basis) const noexcept
+    {
+        for (Section_ const& section : sections_)
+        {
+            if (section.basis == basis)
+            {
+                return &section;
+            }
+        }
+        return nullptr;
+    }
+
+    /*
+     * Returns view of record at offset `record` of records of section. Records are checked
+     * on access rather than on opening, so opening does not touch all pages of the file.
+     */
+    [[nodiscard]]
+    CircuitView makeView_(Section_ const& section, size_t record) const
+    {
+        if (record + impl::RecordHeaderSize > section.records_size)
+        {
+            throw std::runtime_error("CircuitDatabase: malformed circuit record.");
+        }
+        CircuitView const view(data_ + section.records_offset + record);
+        size_t const inputs = view.getNumberOfInputs();
+        size_t const gates  = view.getNumberOfGates();
+        if (inputs > npn::MaxVariables || view.getOutput() >= inputs + gates
+            || record + impl::RecordHeaderSize + (gates * impl::GateRecordSize) > section.records_size)
+        {
+            throw std::runtime_error("CircuitDatabase: malformed circuit record.");
+        }
+        for (size_t i = 0; i < gates; ++i)
+        {
+            GateRecord const gate = view.getGate(i);
+            if (gate.arity > gate.operands.size()
+                || std::any_of(
+                    gate.operands.begin(),
+                    gate.operands.begin() + gate.arity,
+                    [inputs, i](uint8_t operand) { return operand >= inputs + i; }))
+            {
+                throw std::runtime_error("CircuitDatabase: malformed circuit record.");
+            }
+        }
+        return view;
+    }
+
+    void map_(std::string const& path)
+    {
+#ifdef CIRBO_SEARCH_CIRCUITS_DB_MMAP
+        int const fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+        {
+            throw std::runtime_error("CircuitDatabase: can't open '" + path + "'.");
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("CircuitDatabase: can't stat '" + path + "'.");
+        }
+        size_ = static_cast<size_t>(info.st_size);
+        if (size_ > 0)
+        {
+            void* mapping = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                ::close(fd);
+                throw std::runtime_error("CircuitDatabase: can't map '" + path + "'.");
+            }
+            mapping_ = mapping;
+            data_    = static_cast<std::byte const*>(mapping);
+        }
+        // Mapping stays valid after descriptor is closed.
+        ::close(fd);
+#else
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("CircuitDatabase: can't open '" + path + "'.");
+        }
+        std::vector<char> const content{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+        buffer_.resize(content.size());
+        std::memcpy(buffer_.data(), content.data(), content.size());
+        data_ = buffer_.data();
+        size_ = buffer_.size();
+#endif
+    }
+
+    void unmap_() noexcept
+    {
+#ifdef CIRBO_SEARCH_CIRCUITS_DB_MMAP
+        if (mapping_ != nullptr)
+        {
+            ::munmap(mapping_, size_);
+            mapping_ = nullptr;
+        }
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    void parseHeaders_()
+    {
+        if (size_ < impl::FileHeaderSize || std::memcmp(data_, impl::Magic.data(), impl::Magic.size()) != 0)
+        {
+            throw std::runtime_error("CircuitDatabase: file is not a circuit database.");
+        }
+        if (impl::readValue<uint32_t>(data_ + 8) != impl::Version)
+        {
+            throw std::runtime_error("CircuitDatabase: unsupported database version.");
+        }
+        auto const sections = impl::readValue<uint32_t>(data_ + 12);
+        if (size_ < impl::FileHeaderSize + (sections * impl::SectionHeaderSize))
+        {
+            throw std::runtime_error("CircuitDatabase: truncated section headers.");
+        }
+        for (size_t i = 0; i < sections; ++i)
+        {
+            std::byte const* header = data_ + impl::FileHeaderSize + (i * impl::SectionHeaderSize);
+            Section_ const section{
+                .basis          = static_cast<Basis>(impl::readValue<uint8_t>(header)),
+                .slots          = impl::readValue<uint32_t>(header + 4),
+                .circuits       = impl::readValue<uint32_t>(header + 8),
+                .index_offset   = impl::readValue<uint64_t>(header + 16),
+                .records_offset = impl::readValue<uint64_t>(header + 24),
+                .records_size   = impl::readValue<uint64_t>(header + 32)};
+            // Lookup relies on power of two number of slots and at least one empty slot.
+            bool const valid_index = section.slots == 0 ? section.circuits == 0
+                                                        : (section.slots & (section.slots - 1)) == 0
+                                                              && section.circuits < section.slots;
+            if (!valid_index || section.index_offset + (section.slots * impl::IndexEntrySize) > size_
+                || section.records_offset + section.records_size > size_)
+            {
+                throw std::runtime_error("CircuitDatabase: malformed section header.");
+            }
+            sections_.push_back(section);
+        }
+    }
+};
+
+}  // namespace cirbo::circuits_db
+
+#endif  // CIRBO_SEARCH_CIRCUITS_DB_CIRCUIT_DATABASE_HPP
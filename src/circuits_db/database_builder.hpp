@@ -0,0 +1,226 @@
+#ifndef CIRBO_SEARCH_CIRCUITS_DB_DATABASE_BUILDER_HPP
+#define CIRBO_SEARCH_CIRCUITS_DB_DATABASE_BUILDER_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "core/npn.hpp"
+#include "core/types.hpp"
+
+namespace cirbo::circuits_db
+{
+
+/**
+ * Collects circuits in memory and serializes them to the format, read by
+ * `CircuitDatabase`. For each basis and function only the smallest circuit
+ * is kept.
+ */
+class DatabaseBuilder
+{
+private:
+    /* Key of a function: number of inputs and truth table. */
+    using Key_ = std::pair<uint8_t, uint64_t>;
+
+    std::map<Basis, std::map<Key_, DatabaseCircuit>> circuits_;
+
+public:
+    /**
+     * Adds circuit, keyed by function it computes.
+     *
+     * @return true iff circuit is stored, i.e. there was no circuit of this function of at most the same size.
+     * @throws std::invalid_argument if circuit is malformed or too large for the format.
+     */
+    bool add(Basis basis, DatabaseCircuit circuit)
+    {
+        validate_(circuit);
+        Key_ const key{circuit.inputs, circuit.computeTruthTable()};
+        auto& section = circuits_[basis];
+        auto it       = section.find(key);
+        if (it != section.end() && it->second.gates.size() <= circuit.gates.size())
+        {
+            return false;
+        }
+        section.insert_or_assign(key, std::move(circuit));
+        return true;
+    }
+
+    /* Returns stored circuit of function, or nullptr. */
+    [[nodiscard]]
+    DatabaseCircuit const* find(Basis basis, uint64_t truth, size_t inputs) const
+    {
+        auto const section = circuits_.find(basis);
+        if (section == circuits_.end() || inputs > npn::MaxVariables)
+        {
+            return nullptr;
+        }
+        auto const it = section->second.find({static_cast<uint8_t>(inputs), truth & npn::getTruthMask(inputs)});
+        return it == section->second.end() ? nullptr : &it->second;
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfCircuits() const noexcept
+    {
+        size_t total = 0;
+        for (auto const& [basis, section] : circuits_)
+        {
+            total += section.size();
+        }
+        return total;
+    }
+
+    /**
+     * Adds all circuits of existing database, for example to continue its generation.
+     */
+    void merge(CircuitDatabase const& database)
+    {
+        for (Basis const basis : database.getBases())
+        {
+            database.forEachCircuit(basis, [this, basis](CircuitView const& view) { add(basis, view.toCircuit()); });
+        }
+    }
+
+    void write(std::ostream& out) const
+    {
+        std::vector<std::byte> bytes(impl::FileHeaderSize + (circuits_.size() * impl::SectionHeaderSize));
+        std::memcpy(bytes.data(), impl::Magic.data(), impl::Magic.size());
+        put_(bytes, 8, impl::Version);
+        put_(bytes, 12, static_cast<uint32_t>(circuits_.size()));
+
+        size_t header = impl::FileHeaderSize;
+        for (auto const& [basis, section] : circuits_)
+        {
+            // Load factor is at most one half, so probe sequences stay short.
+            size_t const slots        = std::bit_ceil(std::max<size_t>(2 * section.size(), 2));
+            size_t const index_offset = align_(bytes.size());
+            bytes.resize(index_offset + (slots * impl::IndexEntrySize));
+            for (size_t slot = 0; slot < slots; ++slot)
+            {
+                put_(bytes, index_offset + (slot * impl::IndexEntrySize) + 12, impl::EmptySlot);
+            }
+
+            size_t const records_offset = align_(bytes.size());
+            bytes.resize(records_offset);
+            for (auto const& [key, circuit] : section)
+            {
+                size_t slot = impl::getHomeSlot(key.second, key.first, slots);
+                while (get_<uint8_t>(bytes, index_offset + (slot * impl::IndexEntrySize) + 12) != impl::EmptySlot)
+                {
+                    slot = (slot + 1) & (slots - 1);
+                }
+                size_t const entry = index_offset + (slot * impl::IndexEntrySize);
+                put_(bytes, entry, key.second);
+                put_(bytes, entry + 8, static_cast<uint32_t>(bytes.size() - records_offset));
+                put_(bytes, entry + 12, key.first);
+                appendRecord_(bytes, circuit);
+            }
+
+            put_(bytes, header, static_cast<uint8_t>(basis));
+            put_(bytes, header + 4, static_cast<uint32_t>(slots));
+            put_(bytes, header + 8, static_cast<uint32_t>(section.size()));
+            put_(bytes, header + 16, static_cast<uint64_t>(index_offset));
+            put_(bytes, header + 24, static_cast<uint64_t>(records_offset));
+            put_(bytes, header + 32, static_cast<uint64_t>(bytes.size() - records_offset));
+            header += impl::SectionHeaderSize;
+        }
+        out.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    /**
+     * Writes database to file atomically: readers, which map the old file,
+     * never observe partially written one.
+     *
+     * @throws std::runtime_error if file can't be written.
+     */
+    void writeFile(std::string const& path) const
+    {
+        std::string const temporary = path + ".tmp";
+        {
+            std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+            if (!out.is_open())
+            {
+                throw std::runtime_error("DatabaseBuilder: can't open '" + temporary + "'.");
+            }
+            write(out);
+            if (!out.good())
+            {
+                throw std::runtime_error("DatabaseBuilder: can't write '" + temporary + "'.");
+            }
+        }
+        std::filesystem::rename(temporary, path);
+    }
+
+private:
+    static void validate_(DatabaseCircuit const& circuit)
+    {
+        size_t const ids = circuit.inputs + circuit.gates.size();
+        if (circuit.inputs > npn::MaxVariables || ids > UINT8_MAX || circuit.output >= ids)
+        {
+            throw std::invalid_argument("DatabaseBuilder: circuit is too large or has invalid output.");
+        }
+        for (size_t i = 0; i < circuit.gates.size(); ++i)
+        {
+            GateRecord const& gate = circuit.gates[i];
+            if (gate.arity > gate.operands.size())
+            {
+                throw std::invalid_argument("DatabaseBuilder: gate arity is larger than 3.");
+            }
+            for (size_t j = 0; j < gate.arity; ++j)
+            {
+                if (gate.operands[j] >= circuit.inputs + i)
+                {
+                    throw std::invalid_argument("DatabaseBuilder: gate operand must precede the gate.");
+                }
+            }
+        }
+    }
+
+    static void appendRecord_(std::vector<std::byte>& bytes, DatabaseCircuit const& circuit)
+    {
+        bytes.push_back(static_cast<std::byte>(circuit.inputs));
+        bytes.push_back(static_cast<std::byte>(circuit.gates.size()));
+        bytes.push_back(static_cast<std::byte>(circuit.output));
+        for (GateRecord const& gate : circuit.gates)
+        {
+            bytes.push_back(static_cast<std::byte>(gate.type));
+            bytes.push_back(static_cast<std::byte>(gate.arity));
+            for (uint8_t const operand : gate.operands)
+            {
+                bytes.push_back(static_cast<std::byte>(operand));
+            }
+        }
+    }
+
+    /* Sections start at 8-byte boundary. */
+    static size_t align_(size_t offset) noexcept
+    {
+        return (offset + 7) & ~size_t{7};
+    }
+
+    template<typename T>
+    static void put_(std::vector<std::byte>& bytes, size_t offset, T value) noexcept
+    {
+        std::memcpy(bytes.data() + offset, &value, sizeof(T));
+    }
+
+    template<typename T>
+    static T get_(std::vector<std::byte> const& bytes, size_t offset) noexcept
+    {
+        return impl::readValue<T>(bytes.data() + offset);
+    }
+};
+
+}  // namespace cirbo::circuits_db
+
+#endif  // CIRBO_SEARCH_CIRCUITS_DB_DATABASE_BUILDER_HPP
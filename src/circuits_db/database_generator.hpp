@@ -0,0 +1,223 @@
+#ifndef CIRBO_SEARCH_CIRCUITS_DB_DATABASE_GENERATOR_HPP
+#define CIRBO_SEARCH_CIRCUITS_DB_DATABASE_GENERATOR_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "circuits_db/database_builder.hpp"
+#include "core/npn.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "synthesis/exact_synthesis.hpp"
+#include "utils/parallel.hpp"
+
+namespace cirbo::circuits_db
+{
+
+/* Function to synthesize: NPN-canonical truth table and number of inputs. */
+struct GenerationTask
+{
+    uint64_t truth = 0;
+    size_t inputs  = 0;
+
+    auto operator<=>(GenerationTask const&) const = default;
+};
+
+struct GenerationStatistics
+{
+    /* Tasks, which were already solved in the existing database, or belong to other shards. */
+    size_t skipped = 0;
+    size_t solved  = 0;
+    /* Tasks, whose minimum circuit was not found within limits. */
+    size_t failed      = 0;
+    size_t checkpoints = 0;
+};
+
+/**
+ * Offline generator of database of optimal circuits. Tasks are independent,
+ * so they are shared among threads (and, by sharding, among processes or
+ * machines), each running own exact synthesis. Database file serves as
+ * checkpoint: it is rewritten atomically from time to time, and on restart
+ * tasks, which are already in database, are skipped.
+ *
+ * Each shard writes its own file (see `getShardPath`), so shards may share
+ * the output path, and shard files are joined by `merge` afterwards.
+ */
+class DatabaseGenerator
+{
+public:
+    static constexpr std::chrono::seconds DefaultCheckpointInterval{600};
+
+private:
+    synthesis::ExactSynthesizer synthesizer_;
+    size_t threads_;
+    std::chrono::milliseconds checkpoint_interval_;
+
+public:
+    /**
+     * @param synthesizer -- exact synthesis engine, defines basis of database.
+     * @param threads -- number of threads, 0 means number of hardware threads.
+     * @param checkpoint_interval -- minimum time between writes of database.
+     */
+    explicit DatabaseGenerator(
+        synthesis::ExactSynthesizer synthesizer,
+        size_t threads                                = 0,
+        std::chrono::milliseconds checkpoint_interval = DefaultCheckpointInterval)
+        : synthesizer_(std::move(synthesizer))
+        , threads_(threads == 0 ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : threads)
+        , checkpoint_interval_(checkpoint_interval)
+    {
+    }
+
+    /**
+     * @return representatives of all NPN classes of functions of at most `max_inputs` inputs.
+     */
+    [[nodiscard]]
+    static std::vector<GenerationTask> enumerateNpnClasses(size_t max_inputs)
+    {
+        if (max_inputs > npn::MaxExhaustiveVariables)
+        {
+            throw std::invalid_argument(
+                "DatabaseGenerator: NPN classes are enumerated for at most "
+                + std::to_string(npn::MaxExhaustiveVariables) + " inputs.");
+        }
+        std::set<GenerationTask> tasks;
+        for (size_t inputs = 0; inputs <= max_inputs; ++inputs)
+        {
+            for (uint64_t truth = 0; truth <= npn::getTruthMask(inputs); ++truth)
+            {
+                tasks.insert({npn::canonize(truth, inputs).truth, inputs});
+            }
+        }
+        return {tasks.begin(), tasks.end()};
+    }
+
+    /**
+     * @return path to file of shard `shard_index` of database at `path`, which is `path` itself
+     *         if there is only one shard.
+     */
+    [[nodiscard]]
+    static std::string getShardPath(std::string const& path, size_t shard_index, size_t shard_count)
+    {
+        if (shard_count == 1)
+        {
+            return path;
+        }
+        return path + ".shard-" + std::to_string(shard_index) + "-of-" + std::to_string(shard_count);
+    }
+
+    /**
+     * Writes to database at `path` circuits of all databases `inputs` and of
+     * database at `path` itself, if it exists. The smallest circuit of each
+     * function is kept.
+     *
+     * @return number of circuits in resulting database.
+     */
+    static size_t merge(std::vector<std::string> const& inputs, std::string const& path)
+    {
+        DatabaseBuilder builder;
+        if (std::filesystem::exists(path))
+        {
+            builder.merge(CircuitDatabase(path));
+        }
+        for (std::string const& input : inputs)
+        {
+            builder.merge(CircuitDatabase(input));
+        }
+        builder.writeFile(path);
+        return builder.getNumberOfCircuits();
+    }
+
+    /**
+     * Synthesizes circuits for tasks and writes them to the shard file of database
+     * at `path` (see `getShardPath`), keeping circuits, which are already there
+     * (of all bases). Tasks, solved in database at `path` or in shard file, are skipped.
+     *
+     * @param tasks -- functions to synthesize.
+     * @param path -- path to database, shard file is created if doesn't exist.
+     * @param shard_index -- index of this shard, only tasks `i` with `i % shard_count == shard_index` are processed.
+     * @param shard_count -- number of shards.
+     */
+    GenerationStatistics run(
+        std::vector<GenerationTask> const& tasks,
+        std::string const& path,
+        size_t shard_index = 0,
+        size_t shard_count = 1) const
+    {
+        if (shard_count == 0 || shard_index >= shard_count)
+        {
+            throw std::invalid_argument("DatabaseGenerator: shard index must be less than shard count.");
+        }
+
+        // Shard file is continued, and circuits of the shared database are not synthesized again.
+        std::string const shard_path = getShardPath(path, shard_index, shard_count);
+        DatabaseBuilder builder;
+        if (std::filesystem::exists(path))
+        {
+            builder.merge(CircuitDatabase(path));
+        }
+        if (shard_path != path && std::filesystem::exists(shard_path))
+        {
+            builder.merge(CircuitDatabase(shard_path));
+        }
+
+        GenerationStatistics statistics;
+        std::vector<GenerationTask> pending;
+        for (size_t i = 0; i < tasks.size(); ++i)
+        {
+            GenerationTask const& task = tasks[i];
+            if (i % shard_count != shard_index || builder.find(synthesizer_.getBasis(), task.truth, task.inputs))
+            {
+                ++statistics.skipped;
+                continue;
+            }
+            pending.push_back(task);
+        }
+        log::debug("DatabaseGenerator: ", pending.size(), " tasks pending, ", statistics.skipped, " skipped.");
+
+        std::mutex mutex;
+        auto last_checkpoint = std::chrono::steady_clock::now();
+        utils::parallelFor(
+            pending.size(),
+            threads_,
+            [&](size_t i)
+            {
+                auto circuit = synthesizer_.synthesize(pending[i].truth, pending[i].inputs);
+
+                std::lock_guard const lock(mutex);
+                if (circuit.has_value())
+                {
+                    builder.add(synthesizer_.getBasis(), std::move(*circuit));
+                    ++statistics.solved;
+                }
+                else
+                {
+                    ++statistics.failed;
+                }
+                auto const now = std::chrono::steady_clock::now();
+                if (now - last_checkpoint >= checkpoint_interval_)
+                {
+                    builder.writeFile(shard_path);
+                    ++statistics.checkpoints;
+                    last_checkpoint = now;
+                }
+            });
+        builder.writeFile(shard_path);
+        return statistics;
+    }
+};
+
+}  // namespace cirbo::circuits_db
+
+#endif  // CIRBO_SEARCH_CIRCUITS_DB_DATABASE_GENERATOR_HPP
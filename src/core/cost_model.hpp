@@ -0,0 +1,232 @@
+#ifndef CIRBO_SEARCH_CORE_COST_MODEL_HPP
+#define CIRBO_SEARCH_CORE_COST_MODEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "utils/cast.hpp"
+
+namespace cirbo
+{
+
+/**
+ * Cost of circuit as sum of costs of its gates. Gate of type `t` with `n`
+ * operands costs `getWeight(t) + getOperandWeight(t) * (n - 2)`, when it has
+ * more than two operands, and `getWeight(t)` otherwise, so wide gates may cost
+ * as chains of binary gates, they are split into.
+ *
+ * Default model counts gates, inputs included, so its cost of circuit is equal
+ * to `ICircuit::getNumberOfGates`.
+ */
+class CostModel
+{
+public:
+    using Weight = uint32_t;
+
+private:
+    static constexpr size_t TypesNumber = 256;
+
+    std::array<Weight, TypesNumber> weights_{};
+    std::array<Weight, TypesNumber> operand_weights_{};
+
+public:
+    CostModel() { weights_.fill(1); }
+
+    /**
+     * @return model, which counts gates.
+     */
+    [[nodiscard]]
+    static CostModel gateCount()
+    {
+        return {};
+    }
+
+    /**
+     * @return model, which counts two-input gates, which circuit splits into,
+     * so gate with `n > 2` operands costs `n - 1`.
+     */
+    [[nodiscard]]
+    static CostModel binaryGateCount()
+    {
+        CostModel model;
+        model.operand_weights_.fill(1);
+        return model;
+    }
+
+    /**
+     * @return model, which counts binary AND gates, which circuit splits into, while
+     * XOR and NOT gates are free (multiplicative complexity of XAG circuits).
+     */
+    [[nodiscard]]
+    static CostModel multiplicativeComplexity()
+    {
+        CostModel model;
+        model.weights_.fill(0);
+        for (GateType const type : {GateType::AND, GateType::NAND, GateType::OR, GateType::NOR})
+        {
+            model.setWeight(type, 1, 1);
+        }
+        model.setWeight(GateType::MUX, 1);
+        return model;
+    }
+
+    /**
+     * Parses cost model from its description: '/'-separated items, each of them
+     * is either a named model (`gates`, `binary` or `mc`), which replaces all
+     * weights, or `TYPE:weight[:operand_weight]`, which overrides weights of one
+     * type. E.g. `gates/XOR:0/MUX:3` counts gates, where XOR gates are free and
+     * MUX gates cost three.
+     * @param description -- description of model.
+     * @return parsed model.
+     * @throw std::invalid_argument if description is malformed.
+     */
+    [[nodiscard]]
+    static CostModel parse(std::string_view description)
+    {
+        auto const fail = [description](std::string const& reason)
+        { throw std::invalid_argument("Malformed cost model '" + std::string(description) + "': " + reason + "."); };
+        auto const parse_weight = [&fail](std::string_view text)
+        {
+            if (text.empty() || text.size() > 9 || text.find_first_not_of("0123456789") != std::string_view::npos)
+            {
+                fail("expected non-negative weight, got '" + std::string(text) + "'");
+            }
+            return static_cast<Weight>(std::stoul(std::string(text)));
+        };
+
+        CostModel model;
+        size_t begin = 0;
+        while (begin <= description.size())
+        {
+            size_t end = description.find('/', begin);
+            if (end == std::string_view::npos)
+            {
+                end = description.size();
+            }
+            std::string_view const item = description.substr(begin, end - begin);
+            begin                       = end + 1;
+
+            size_t const colon = item.find(':');
+            if (colon == std::string_view::npos)
+            {
+                if (item == "gates")
+                {
+                    model = gateCount();
+                }
+                else if (item == "binary")
+                {
+                    model = binaryGateCount();
+                }
+                else if (item == "mc")
+                {
+                    model = multiplicativeComplexity();
+                }
+                else
+                {
+                    fail("unknown model '" + std::string(item) + "'");
+                }
+                continue;
+            }
+
+            std::string const type_name(item.substr(0, colon));
+            GateType type = GateType::INPUT;
+            if (type_name != "INPUT")
+            {
+                try
+                {
+                    type = utils::stringToGateType(type_name);
+                }
+                catch (std::exception const&)
+                {
+                    fail("unknown gate type '" + type_name + "'");
+                }
+            }
+            std::string_view const weights = item.substr(colon + 1);
+            size_t const second            = weights.find(':');
+            if (second == std::string_view::npos)
+            {
+                model.setWeight(type, parse_weight(weights));
+            }
+            else
+            {
+                model.setWeight(
+                    type, parse_weight(weights.substr(0, second)), parse_weight(weights.substr(second + 1)));
+            }
+        }
+        return model;
+    }
+
+    /**
+     * Sets cost of gates of `type`.
+     * @param type -- type of gates.
+     * @param weight -- cost of gate with at most two operands.
+     * @param operand_weight -- cost of each operand beyond the second one.
+     * @return this model.
+     */
+    CostModel& setWeight(GateType type, Weight weight, Weight operand_weight = 0) noexcept
+    {
+        weights_[static_cast<size_t>(type)]         = weight;
+        operand_weights_[static_cast<size_t>(type)] = operand_weight;
+        return *this;
+    }
+
+    [[nodiscard]]
+    Weight getWeight(GateType type) const noexcept
+    {
+        return weights_[static_cast<size_t>(type)];
+    }
+
+    [[nodiscard]]
+    Weight getOperandWeight(GateType type) const noexcept
+    {
+        return operand_weights_[static_cast<size_t>(type)];
+    }
+
+    /**
+     * @return cost of gate of `type` with `arity` operands.
+     */
+    [[nodiscard]]
+    size_t getGateCost(GateType type, size_t arity) const noexcept
+    {
+        size_t cost = weights_[static_cast<size_t>(type)];
+        if (arity > 2)
+        {
+            cost += static_cast<size_t>(operand_weights_[static_cast<size_t>(type)]) * (arity - 2);
+        }
+        return cost;
+    }
+
+    /**
+     * @return cost of gate `gateId` of `circuit`.
+     */
+    [[nodiscard]]
+    size_t getGateCost(ICircuit const& circuit, GateId gateId) const
+    {
+        return getGateCost(circuit.getGateType(gateId), circuit.getGateOperands(gateId).size());
+    }
+
+    /**
+     * @return sum of costs of all gates of `circuit`.
+     */
+    [[nodiscard]]
+    size_t getCircuitCost(ICircuit const& circuit) const
+    {
+        size_t cost = 0;
+        for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+        {
+            cost += getGateCost(circuit, gateId);
+        }
+        return cost;
+    }
+};
+
+}  // namespace cirbo
+
+#endif  // CIRBO_SEARCH_CORE_COST_MODEL_HPP
@@ -0,0 +1,496 @@
+#ifndef CIRBO_SEARCH_CORE_CUT_ENUMERATION_HPP
+#define CIRBO_SEARCH_CORE_CUT_ENUMERATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+
+namespace cirbo
+{
+
+/**
+ * Truth table of a cut function over at most `Cut::MaxSize` leaves. Bit `m`
+ * is the value of function on assignment `m`, where i-th bit of `m` is the
+ * value of i-th leaf. Bits beyond `2^size` are always zero, so functions of
+ * up to 6 leaves are fully described by the first word.
+ */
+using CutTruthTable = std::array<uint64_t, 4>;
+
+/**
+ * Cut of a gate: set of gates (leaves), such that every path from inputs to
+ * the gate passes through one of them. Cut carries function of the gate in
+ * terms of its leaves and costs, used to order cuts by priority.
+ */
+struct Cut
+{
+    static constexpr size_t MaxSize = 8;
+
+    /* Leaves in ascending order, first `size` entries are valid. */
+    std::array<GateId, MaxSize> leaves{};
+    uint8_t size = 0;
+    /* Bloom filter of leaves, used to reject merges and dominance checks fast. */
+    uint64_t signature = 0;
+    CutTruthTable truth{};
+    /* Area of cone between leaves and gate, shared among users of the gate. */
+    float area_flow = 0;
+    /* Number of cut levels from inputs to the gate when each gate is implemented by its best cut. */
+    uint32_t depth = 0;
+
+    [[nodiscard]]
+    std::span<GateId const> getLeaves() const noexcept
+    {
+        return {leaves.data(), size};
+    }
+
+    /* Returns value of cut function on assignment `assignment` of leaves. */
+    [[nodiscard]]
+    bool getValue(size_t assignment) const noexcept
+    {
+        return ((truth[assignment / 64] >> (assignment % 64)) & 1U) != 0;
+    }
+
+    /* Returns true iff leaves of this cut are subset of leaves of `other`, so `other` is redundant. */
+    [[nodiscard]]
+    bool dominates(Cut const& other) const noexcept
+    {
+        if (size > other.size || (signature & ~other.signature) != 0)
+        {
+            return false;
+        }
+        return std::ranges::includes(other.getLeaves(), getLeaves());
+    }
+};
+
+/**
+ * Enumeration of k-feasible priority cuts of all gates of a circuit. Each
+ * gate keeps its trivial cut and at most `getCutLimit()` best non-dominated
+ * cuts of at most `getCutSize()` leaves, ordered by area flow, then by size
+ * and depth. Cuts of gate are merged from cuts of its operands, so keeping
+ * only best ones bounds both time and memory.
+ *
+ * Cuts are stored in an arena, where each gate owns fixed number of slots.
+ * Gates of the same level depend only on cuts of lower levels, so each level
+ * is processed by several threads, each writing only to slots of own gates.
+ */
+class CutEnumeration
+{
+public:
+    static constexpr size_t DefaultCutSize  = 4;
+    static constexpr size_t DefaultCutLimit = 8;
+    /* Levels with less gates per thread are processed by single thread. */
+    static constexpr size_t MinGatesPerThread = 64;
+
+private:
+    size_t cut_size_;
+    size_t cut_limit_;
+    /* Slots of gate `g` are [g * (cut_limit_ + 1), (g + 1) * (cut_limit_ + 1)), first is trivial cut. */
+    std::vector<Cut> arena_;
+    std::vector<uint32_t> counts_;
+    /* Number of users of each gate (outputs count as users), at least one. */
+    std::vector<float> fanouts_;
+
+    /* Buffers of candidate cuts, owned by one thread. */
+    struct Scratch_
+    {
+        std::vector<Cut> current;
+        std::vector<Cut> next;
+    };
+
+public:
+    /**
+     * Enumerates cuts of all gates of the circuit.
+     *
+     * @param circuit -- circuit to enumerate cuts of.
+     * @param cut_size -- maximal number of leaves of a cut, at most `Cut::MaxSize`.
+     * @param cut_limit -- maximal number of priority cuts per gate, trivial cut excluded.
+     * @param threads -- number of threads, 0 means number of hardware threads.
+     */
+    explicit CutEnumeration(
+        ICircuit const& circuit,
+        size_t cut_size  = DefaultCutSize,
+        size_t cut_limit = DefaultCutLimit,
+        size_t threads   = 1)
+        : cut_size_(cut_size)
+        , cut_limit_(cut_limit)
+        , arena_(circuit.getNumberOfGates() * (cut_limit + 1))
+        , counts_(circuit.getNumberOfGates(), 0)
+        , fanouts_(circuit.getNumberOfGates(), 1)
+    {
+        if (cut_size_ == 0 || cut_size_ > Cut::MaxSize || cut_limit_ == 0)
+        {
+            log::error("CutEnumeration: cut size must be in [1, ", Cut::MaxSize, "], cut limit must be positive.");
+            std::abort();
+        }
+        threads = threads == 0 ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : threads;
+        enumerate_(circuit, threads);
+    }
+
+    [[nodiscard]]
+    size_t getCutSize() const noexcept
+    {
+        return cut_size_;
+    }
+
+    [[nodiscard]]
+    size_t getCutLimit() const noexcept
+    {
+        return cut_limit_;
+    }
+
+    /**
+     * @return cuts of gate: trivial cut `{gateId}` first, then priority cuts from best to worst.
+     */
+    [[nodiscard]]
+    std::span<Cut const> getCuts(GateId gateId) const noexcept
+    {
+        return {arena_.data() + (gateId * (cut_limit_ + 1)), counts_[gateId]};
+    }
+
+    /* Returns total number of cuts of all gates, trivial ones included. */
+    [[nodiscard]]
+    size_t getNumberOfCuts() const noexcept
+    {
+        size_t total = 0;
+        for (uint32_t const count : counts_)
+        {
+            total += count;
+        }
+        return total;
+    }
+
+private:
+    void enumerate_(ICircuit const& circuit, size_t threads)
+    {
+        GateIdContainer order = algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(circuit);
+        // Sorting starts from sinks, enumeration needs to start from sources.
+        std::ranges::reverse(order);
+
+        std::vector<size_t> levels(circuit.getNumberOfGates(), 0);
+        std::vector<GateIdContainer> by_level;
+        for (GateId const gateId : order)
+        {
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                levels[gateId] = std::max(levels[gateId], levels[operand] + 1);
+            }
+            if (by_level.size() <= levels[gateId])
+            {
+                by_level.resize(levels[gateId] + 1);
+            }
+            by_level[levels[gateId]].push_back(gateId);
+
+            size_t const users = circuit.getGateUsers(gateId).size() + (circuit.isOutputGate(gateId) ? 1 : 0);
+            fanouts_[gateId]   = static_cast<float>(std::max<size_t>(users, 1));
+        }
+
+        std::vector<Scratch_> scratches(threads);
+        for (GateIdContainer const& level : by_level)
+        {
+            size_t const workers = std::min(threads, std::max<size_t>(level.size() / MinGatesPerThread, 1));
+            auto const process   = [this, &circuit, &level, &scratches, workers](size_t worker)
+            {
+                for (size_t i = worker; i < level.size(); i += workers)
+                {
+                    enumerateGate_(circuit, level[i], scratches[worker]);
+                }
+            };
+            std::vector<std::thread> pool;
+            for (size_t worker = 1; worker < workers; ++worker)
+            {
+                pool.emplace_back(process, worker);
+            }
+            process(0);
+            for (auto& thread : pool)
+            {
+                thread.join();
+            }
+        }
+    }
+
+    void enumerateGate_(ICircuit const& circuit, GateId gateId, Scratch_& scratch)
+    {
+        Cut* const slots   = arena_.data() + (gateId * (cut_limit_ + 1));
+        slots[0]           = Cut{};
+        slots[0].leaves[0] = gateId;
+        slots[0].size      = 1;
+        slots[0].signature = leafSignature_(gateId);
+        slots[0].truth[0]  = 0b10;
+        counts_[gateId]    = 1;
+
+        GateIdContainer const& operands = circuit.getGateOperands(gateId);
+        GateType const type             = circuit.getGateType(gateId);
+        std::vector<Cut>& candidates    = scratch.current;
+        candidates.clear();
+
+        switch (type)
+        {
+            case GateType::INPUT:
+                return;
+            case GateType::CONST_FALSE:
+            case GateType::CONST_TRUE:
+                candidates.emplace_back();
+                candidates.back().truth[0] = type == GateType::CONST_TRUE ? 1 : 0;
+                break;
+            case GateType::NOT:
+            case GateType::IFF:
+            case GateType::BUFF:
+                for (Cut const& cut : getCuts(operands.at(0)))
+                {
+                    candidates.push_back(cut);
+                    if (type == GateType::NOT)
+                    {
+                        negate_(candidates.back());
+                    }
+                }
+                break;
+            case GateType::MUX:
+                enumerateMux_(operands, scratch);
+                break;
+            case GateType::AND:
+            case GateType::NAND:
+            case GateType::OR:
+            case GateType::NOR:
+            case GateType::XOR:
+            case GateType::NXOR:
+                enumerateAssociative_(type, operands, scratch);
+                break;
+            default:
+                log::error("CutEnumeration: unsupported gate type.");
+                std::abort();
+        }
+
+        for (Cut& cut : candidates)
+        {
+            float area_flow = 1;
+            uint32_t depth  = 0;
+            for (GateId const leaf : cut.getLeaves())
+            {
+                // Best cut of leaf defines its costs, inputs and constants are free.
+                if (counts_[leaf] > 1)
+                {
+                    Cut const& best = getCuts(leaf)[1];
+                    area_flow += best.area_flow;
+                    depth = std::max(depth, best.depth);
+                }
+            }
+            cut.area_flow = area_flow / fanouts_[gateId];
+            cut.depth     = depth + 1;
+        }
+        std::ranges::sort(
+            candidates,
+            [](Cut const& lhs, Cut const& rhs)
+            { return std::tie(lhs.area_flow, lhs.size, lhs.depth) < std::tie(rhs.area_flow, rhs.size, rhs.depth); });
+        size_t const count = std::min(candidates.size(), cut_limit_);
+        std::copy(candidates.begin(), candidates.begin() + static_cast<std::ptrdiff_t>(count), slots + 1);
+        counts_[gateId] = static_cast<uint32_t>(count + 1);
+    }
+
+    /* Merges cuts of operands one by one, combining functions with the (associative) operator of gate. */
+    void enumerateAssociative_(GateType type, GateIdContainer const& operands, Scratch_& scratch)
+    {
+        bool const negate = type == GateType::NAND || type == GateType::NOR || type == GateType::NXOR;
+        auto const apply  = [type](uint64_t lhs, uint64_t rhs)
+        {
+            switch (type)
+            {
+                case GateType::AND:
+                case GateType::NAND:
+                    return lhs & rhs;
+                case GateType::OR:
+                case GateType::NOR:
+                    return lhs | rhs;
+                default:
+                    return lhs ^ rhs;
+            }
+        };
+
+        std::span<Cut const> const first = getCuts(operands.at(0));
+        scratch.current.assign(first.begin(), first.end());
+        for (size_t i = 1; i < operands.size(); ++i)
+        {
+            scratch.next.clear();
+            for (Cut const& lhs : scratch.current)
+            {
+                for (Cut const& rhs : getCuts(operands[i]))
+                {
+                    Cut merged;
+                    if (!mergeLeaves_(lhs, rhs, merged))
+                    {
+                        continue;
+                    }
+                    CutTruthTable const lhs_truth = expand_(lhs, merged);
+                    CutTruthTable const rhs_truth = expand_(rhs, merged);
+                    for (size_t word = 0; word < merged.truth.size(); ++word)
+                    {
+                        merged.truth[word] = apply(lhs_truth[word], rhs_truth[word]);
+                    }
+                    insertFiltered_(scratch.next, merged);
+                }
+            }
+            std::swap(scratch.current, scratch.next);
+            truncateIntermediate_(scratch.current);
+        }
+        if (negate)
+        {
+            for (Cut& cut : scratch.current)
+            {
+                negate_(cut);
+            }
+        }
+    }
+
+    void enumerateMux_(GateIdContainer const& operands, Scratch_& scratch)
+    {
+        scratch.next.clear();
+        for (Cut const& selector : getCuts(operands.at(0)))
+        {
+            for (Cut const& lhs : getCuts(operands.at(1)))
+            {
+                Cut partial;
+                if (!mergeLeaves_(selector, lhs, partial))
+                {
+                    continue;
+                }
+                for (Cut const& rhs : getCuts(operands.at(2)))
+                {
+                    Cut merged;
+                    if (!mergeLeaves_(partial, rhs, merged))
+                    {
+                        continue;
+                    }
+                    CutTruthTable const s = expand_(selector, merged);
+                    CutTruthTable const x = expand_(lhs, merged);
+                    CutTruthTable const y = expand_(rhs, merged);
+                    for (size_t word = 0; word < merged.truth.size(); ++word)
+                    {
+                        merged.truth[word] = (~s[word] & x[word]) | (s[word] & y[word]);
+                    }
+                    insertFiltered_(scratch.next, merged);
+                }
+            }
+        }
+        std::swap(scratch.current, scratch.next);
+    }
+
+    /* Keeps intermediate set of cuts of wide gates bounded, preferring smaller cuts. */
+    void truncateIntermediate_(std::vector<Cut>& cuts) const
+    {
+        size_t const bound = cut_limit_ * cut_limit_;
+        if (cuts.size() > bound)
+        {
+            std::ranges::stable_sort(cuts, {}, &Cut::size);
+            cuts.resize(bound);
+        }
+    }
+
+    /* Adds cut to the set, unless it is dominated, and removes cuts dominated by it. */
+    static void insertFiltered_(std::vector<Cut>& cuts, Cut const& cut)
+    {
+        if (std::ranges::any_of(cuts, [&cut](Cut const& other) { return other.dominates(cut); }))
+        {
+            return;
+        }
+        std::erase_if(cuts, [&cut](Cut const& other) { return cut.dominates(other); });
+        cuts.push_back(cut);
+    }
+
+    /* Writes union of leaves to `result`, returns false if it has more than `cut_size_` leaves. */
+    bool mergeLeaves_(Cut const& lhs, Cut const& rhs, Cut& result) const
+    {
+        result.signature = lhs.signature | rhs.signature;
+        if (static_cast<size_t>(std::popcount(result.signature)) > cut_size_)
+        {
+            return false;
+        }
+        size_t i = 0;
+        size_t j = 0;
+        size_t k = 0;
+        while (i < lhs.size || j < rhs.size)
+        {
+            if (k == cut_size_)
+            {
+                return false;
+            }
+            if (j == rhs.size || (i < lhs.size && lhs.leaves[i] < rhs.leaves[j]))
+            {
+                result.leaves[k++] = lhs.leaves[i++];
+            }
+            else if (i == lhs.size || rhs.leaves[j] < lhs.leaves[i])
+            {
+                result.leaves[k++] = rhs.leaves[j++];
+            }
+            else
+            {
+                result.leaves[k++] = lhs.leaves[i++];
+                ++j;
+            }
+        }
+        result.size = static_cast<uint8_t>(k);
+        return true;
+    }
+
+    /* Returns truth table of `cut` function over leaves of `target`, which must include leaves of `cut`. */
+    static CutTruthTable expand_(Cut const& cut, Cut const& target)
+    {
+        if (cut.size == target.size)
+        {
+            return cut.truth;
+        }
+        std::array<size_t, Cut::MaxSize> positions{};
+        for (size_t i = 0, j = 0; i < cut.size; ++i)
+        {
+            while (target.leaves[j] != cut.leaves[i])
+            {
+                ++j;
+            }
+            positions[i] = j;
+        }
+        CutTruthTable result{};
+        for (size_t assignment = 0; assignment < (size_t{1} << target.size); ++assignment)
+        {
+            size_t sub_assignment = 0;
+            for (size_t i = 0; i < cut.size; ++i)
+            {
+                sub_assignment |= ((assignment >> positions[i]) & 1U) << i;
+            }
+            if (cut.getValue(sub_assignment))
+            {
+                result[assignment / 64] |= uint64_t{1} << (assignment % 64);
+            }
+        }
+        return result;
+    }
+
+    static void negate_(Cut& cut)
+    {
+        size_t const bits = size_t{1} << cut.size;
+        for (size_t word = 0; word < cut.truth.size(); ++word)
+        {
+            size_t const first = word * 64;
+            uint64_t const mask =
+                first >= bits ? 0 : (bits - first >= 64 ? ~uint64_t{0} : (uint64_t{1} << (bits - first)) - 1);
+            cut.truth[word] = ~cut.truth[word] & mask;
+        }
+    }
+
+    static uint64_t leafSignature_(GateId gateId) noexcept
+    {
+        return uint64_t{1} << (gateId % 64);
+    }
+};
+
+}  // namespace cirbo
+
+#endif  // CIRBO_SEARCH_CORE_CUT_ENUMERATION_HPP
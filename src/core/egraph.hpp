@@ -0,0 +1,322 @@
+#ifndef CIRBO_SEARCH_CORE_EGRAPH_HPP
+#define CIRBO_SEARCH_CORE_EGRAPH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/types.hpp"
+
+namespace cirbo
+{
+
+/** Identifier of class of equivalent nodes in `EGraph`. **/
+using EClassId = uint32_t;
+
+/**
+ * Node of `EGraph`: operator applied to classes of operands. Operands of
+ * symmetric operators are kept sorted, so that equal nodes are equal as
+ * values. Payload distinguishes nodes without operands, which are not equal,
+ * for example, it is id of input gate for INPUT nodes.
+ */
+struct ENode
+{
+    GateType type;
+    std::vector<EClassId> children;
+    GateId payload = 0;
+
+    bool operator==(ENode const& other) const = default;
+};
+
+/** Hash of `ENode`, used for hash-consing. **/
+struct ENodeHash
+{
+    size_t operator()(ENode const& node) const noexcept
+    {
+        size_t hash = static_cast<size_t>(node.type) * 0x9E3779B97F4A7C15ULL ^ node.payload;
+        for (EClassId const child : node.children)
+        {
+            hash ^= child + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+};
+
+/**
+ * E-graph: compact representation of many equivalent circuits at once. Nodes
+ * are grouped into classes of nodes, which compute equal functions, and
+ * operands of nodes are classes, so every combination of rewrites, applied
+ * to different parts of circuit, is represented without enumeration.
+ *
+ * Nodes are hash-consed: adding a node, which is already present, returns its
+ * class. Classes are merged with union-find, and invariants (nodes are unique
+ * and equal nodes are in one class, i.e. congruence) are restored lazily by
+ * `rebuild`, which processes only classes, merged since previous rebuild.
+ * So many merges may be done in a row, and e-graph must be rebuilt before it
+ * is searched for the next time.
+ */
+class EGraph
+{
+private:
+    struct EClass_
+    {
+        std::vector<ENode> nodes;
+        /* Nodes, which have this class as operand, and their classes. */
+        std::vector<std::pair<ENode, EClassId> > parents;
+    };
+
+    /* Union-find forest of classes, root of tree is canonical id of class. */
+    mutable std::vector<EClassId> union_find_;
+    /* Classes by their ids, only entries of canonical ids are valid. */
+    std::vector<EClass_> classes_;
+    /* Hash-consing: maps node to its class. */
+    std::unordered_map<ENode, EClassId, ENodeHash> memo_;
+    /* Classes, merged since previous rebuild. */
+    std::vector<EClassId> pending_;
+
+    size_t number_of_classes_ = 0;
+    size_t number_of_nodes_   = 0;
+
+public:
+    /** Returns canonical id of class `id`. **/
+    [[nodiscard]]
+    EClassId find(EClassId id) const
+    {
+        EClassId root = id;
+        while (union_find_[root] != root)
+        {
+            root = union_find_[root];
+        }
+        while (union_find_[id] != root)
+        {
+            id = std::exchange(union_find_[id], root);
+        }
+        return root;
+    }
+
+    /** Returns node with canonical ids of operands, sorted if its operator is symmetric. **/
+    [[nodiscard]]
+    ENode canonicalize(ENode node) const
+    {
+        for (EClassId& child : node.children)
+        {
+            child = find(child);
+        }
+        if (isSymmetric(node.type))
+        {
+            std::sort(node.children.begin(), node.children.end());
+        }
+        return node;
+    }
+
+    /**
+     * Adds node to e-graph.
+     *
+     * @param node -- node, whose operands are existing classes.
+     * @return canonical id of class of the node: new class, if the node is new, or class of equal node otherwise.
+     */
+    EClassId add(ENode node)
+    {
+        node = canonicalize(std::move(node));
+        if (auto const it = memo_.find(node); it != memo_.end())
+        {
+            return find(it->second);
+        }
+
+        auto const id = static_cast<EClassId>(classes_.size());
+        union_find_.push_back(id);
+        classes_.emplace_back();
+        for (size_t i = 0; i < node.children.size(); ++i)
+        {
+            // Repeated operands of a node are recorded once.
+            EClassId const child = node.children[i];
+            if (std::find(node.children.begin(), node.children.begin() + i, child) == node.children.begin() + i)
+            {
+                classes_[child].parents.emplace_back(node, id);
+            }
+        }
+        memo_.emplace(node, id);
+        classes_[id].nodes.push_back(std::move(node));
+        ++number_of_classes_;
+        ++number_of_nodes_;
+        return id;
+    }
+
+    /**
+     * Merges two classes. Invariants of e-graph are restored by the next `rebuild`.
+     *
+     * @return true iff classes were different.
+     */
+    bool merge(EClassId first, EClassId second)
+    {
+        first  = find(first);
+        second = find(second);
+        if (first == second)
+        {
+            return false;
+        }
+        // Smaller class is attached to larger one, so that less nodes are moved.
+        if (classes_[first].nodes.size() + classes_[first].parents.size() <
+            classes_[second].nodes.size() + classes_[second].parents.size())
+        {
+            std::swap(first, second);
+        }
+        union_find_[second] = first;
+        EClass_ merged      = std::move(classes_[second]);
+        classes_[second]    = {};
+        EClass_& leader     = classes_[first];
+        std::move(merged.nodes.begin(), merged.nodes.end(), std::back_inserter(leader.nodes));
+        std::move(merged.parents.begin(), merged.parents.end(), std::back_inserter(leader.parents));
+        pending_.push_back(first);
+        --number_of_classes_;
+        return true;
+    }
+
+    /**
+     * Restores invariants of e-graph after merges: repairs parents of merged
+     * classes, merging classes of parents, which became equal (congruence
+     * closure), and removes duplicate nodes of touched classes.
+     */
+    void rebuild()
+    {
+        std::vector<EClassId> touched;
+        while (!pending_.empty())
+        {
+            std::vector<EClassId> todo = std::exchange(pending_, {});
+            for (EClassId& id : todo)
+            {
+                id = find(id);
+            }
+            std::sort(todo.begin(), todo.end());
+            todo.erase(std::unique(todo.begin(), todo.end()), todo.end());
+            for (EClassId const id : todo)
+            {
+                repair_(find(id), touched);
+            }
+        }
+
+        for (EClassId& id : touched)
+        {
+            id = find(id);
+        }
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (EClassId const id : touched)
+        {
+            std::vector<ENode>& nodes = classes_[id].nodes;
+            number_of_nodes_ -= nodes.size();
+            for (ENode& node : nodes)
+            {
+                node = canonicalize(std::move(node));
+            }
+            std::sort(nodes.begin(), nodes.end(), lessNode_);
+            nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+            number_of_nodes_ += nodes.size();
+        }
+    }
+
+    /** Returns true iff there are no merges since previous rebuild. **/
+    [[nodiscard]]
+    bool isClean() const noexcept
+    {
+        return pending_.empty();
+    }
+
+    /** Returns nodes of class `id`. **/
+    [[nodiscard]]
+    std::vector<ENode> const& getNodes(EClassId id) const
+    {
+        return classes_[find(id)].nodes;
+    }
+
+    /** Returns canonical ids of all classes in ascending order. **/
+    [[nodiscard]]
+    std::vector<EClassId> getClasses() const
+    {
+        std::vector<EClassId> ids;
+        ids.reserve(number_of_classes_);
+        for (EClassId id = 0; id < union_find_.size(); ++id)
+        {
+            if (union_find_[id] == id)
+            {
+                ids.push_back(id);
+            }
+        }
+        return ids;
+    }
+
+    /** Returns upper bound of class ids, ids of all classes are less than it. **/
+    [[nodiscard]]
+    size_t getClassIdBound() const noexcept
+    {
+        return classes_.size();
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfClasses() const noexcept
+    {
+        return number_of_classes_;
+    }
+
+    /** Returns number of nodes, it is exact only if e-graph is clean. **/
+    [[nodiscard]]
+    size_t getNumberOfNodes() const noexcept
+    {
+        return number_of_nodes_;
+    }
+
+    /** Returns true iff operator is commutative, so order of its operands does not matter. **/
+    [[nodiscard]]
+    static bool isSymmetric(GateType type) noexcept
+    {
+        return type == GateType::AND || type == GateType::NAND || type == GateType::OR || type == GateType::NOR ||
+               type == GateType::XOR || type == GateType::NXOR;
+    }
+
+private:
+    static bool lessNode_(ENode const& lhs, ENode const& rhs)
+    {
+        return std::tie(lhs.type, lhs.payload, lhs.children) < std::tie(rhs.type, rhs.payload, rhs.children);
+    }
+
+    /* Re-canonicalizes parents of class `id` and merges congruent ones. */
+    void repair_(EClassId id, std::vector<EClassId>& touched)
+    {
+        std::vector<std::pair<ENode, EClassId> > parents = std::move(classes_[id].parents);
+        classes_[id].parents.clear();
+        for (auto& [node, parent] : parents)
+        {
+            memo_.erase(node);
+            node = canonicalize(std::move(node));
+            memo_[node] = find(parent);
+            touched.push_back(parent);
+        }
+
+        std::unordered_map<ENode, EClassId, ENodeHash> unique_parents;
+        for (auto& [node, parent] : parents)
+        {
+            auto const [it, inserted] = unique_parents.emplace(node, find(parent));
+            if (!inserted)
+            {
+                merge(it->second, parent);
+                it->second = find(parent);
+            }
+        }
+
+        EClassId const leader = find(id);
+        for (auto& [node, parent] : unique_parents)
+        {
+            classes_[leader].parents.emplace_back(node, find(parent));
+        }
+        touched.push_back(leader);
+    }
+};
+
+}  // namespace cirbo
+
+#endif  // CIRBO_SEARCH_CORE_EGRAPH_HPP
@@ -0,0 +1,337 @@
+#ifndef CIRBO_SEARCH_CORE_NPN_HPP
+#define CIRBO_SEARCH_CORE_NPN_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <utility>
+
+/**
+ * NPN canonization of boolean functions of at most 6 variables, given by
+ * 64-bit truth tables (bit `m` is value of function on assignment `m`, where
+ * i-th bit of `m` is value of i-th variable). Two functions are NPN-equivalent
+ * iff one is obtained from another by negation of inputs, permutation of
+ * inputs and negation of output, so equivalent functions may be implemented
+ * by one circuit up to inverters and wiring.
+ */
+namespace cirbo::npn
+{
+
+constexpr size_t MaxVariables = 6;
+/* Functions of up to this number of variables are canonized exhaustively. */
+constexpr size_t MaxExhaustiveVariables = 4;
+
+/* Truth tables of variables, i.e. assignments, where i-th variable is true. */
+constexpr std::array<uint64_t, MaxVariables> VariableMasks{
+    0xAAAAAAAAAAAAAAAAULL,
+    0xCCCCCCCCCCCCCCCCULL,
+    0xF0F0F0F0F0F0F0F0ULL,
+    0xFF00FF00FF00FF00ULL,
+    0xFFFF0000FFFF0000ULL,
+    0xFFFFFFFF00000000ULL};
+
+/**
+ * Transform from original function `f` to canonical one `g`:
+ *
+ *   g(y) = f(x) ^ output_negated, where x[permutation[i]] = y[i] ^ phase[i].
+ *
+ * So `f` is implemented by canonical circuit, whose i-th input is fed with
+ * variable `permutation[i]`, negated iff i-th bit of `phase` is set, and whose
+ * output is negated iff `output_negated`.
+ */
+struct Transform
+{
+    std::array<uint8_t, MaxVariables> permutation{0, 1, 2, 3, 4, 5};
+    uint8_t phase       = 0;
+    bool output_negated = false;
+
+    bool operator==(Transform const&) const = default;
+};
+
+struct CanonicalForm
+{
+    uint64_t truth = 0;
+    Transform transform;
+};
+
+/* Returns mask of meaningful bits of truth table of function of `variables` variables. */
+[[nodiscard]]
+constexpr uint64_t getTruthMask(size_t variables) noexcept
+{
+    return variables >= MaxVariables ? ~uint64_t{0} : (uint64_t{1} << (size_t{1} << variables)) - 1;
+}
+
+/* Returns truth table of `g(y) = f(y with i-th variable negated)`. */
+[[nodiscard]]
+constexpr uint64_t flipVariable(uint64_t truth, size_t variable) noexcept
+{
+    size_t const shift = size_t{1} << variable;
+    return ((truth & VariableMasks[variable]) >> shift) | ((truth & ~VariableMasks[variable]) << shift);
+}
+
+/* Returns truth table of function with swapped variables `variable` and `variable + 1`. */
+[[nodiscard]]
+constexpr uint64_t swapAdjacentVariables(uint64_t truth, size_t variable) noexcept
+{
+    constexpr std::array<std::array<uint64_t, 3>, MaxVariables - 1> masks{
+        {{0x9999999999999999ULL, 0x2222222222222222ULL, 0x4444444444444444ULL},
+         {0xC3C3C3C3C3C3C3C3ULL, 0x0C0C0C0C0C0C0C0CULL, 0x3030303030303030ULL},
+         {0xF00FF00FF00FF00FULL, 0x00F000F000F000F0ULL, 0x0F000F000F000F00ULL},
+         {0xFF0000FFFF0000FFULL, 0x0000FF000000FF00ULL, 0x00FF000000FF0000ULL},
+         {0xFFFF00000000FFFFULL, 0x00000000FFFF0000ULL, 0x0000FFFF00000000ULL}}
+    };
+    size_t const shift = size_t{1} << variable;
+    auto const& mask   = masks[variable];
+    return (truth & mask[0]) | ((truth & mask[1]) << shift) | ((truth & mask[2]) >> shift);
+}
+
+/**
+ * Returns canonical function `g` obtained from `f` by `transform`.
+ */
+[[nodiscard]]
+inline uint64_t applyTransform(uint64_t truth, size_t variables, Transform const& transform) noexcept
+{
+    uint64_t result = 0;
+    for (size_t y = 0; y < (size_t{1} << variables); ++y)
+    {
+        size_t x = 0;
+        for (size_t i = 0; i < variables; ++i)
+        {
+            x |= (((y >> i) ^ (transform.phase >> i)) & 1U) << transform.permutation[i];
+        }
+        if ((((truth >> x) & 1U) != 0) != transform.output_negated)
+        {
+            result |= uint64_t{1} << y;
+        }
+    }
+    return result;
+}
+
+/**
+ * Returns original function `f`, which is transformed to `canonical` by `transform`.
+ */
+[[nodiscard]]
+inline uint64_t restoreFunction(uint64_t canonical, size_t variables, Transform const& transform) noexcept
+{
+    uint64_t result = 0;
+    for (size_t x = 0; x < (size_t{1} << variables); ++x)
+    {
+        size_t y = 0;
+        for (size_t i = 0; i < variables; ++i)
+        {
+            y |= (((x >> transform.permutation[i]) ^ (transform.phase >> i)) & 1U) << i;
+        }
+        if ((((canonical >> y) & 1U) != 0) != transform.output_negated)
+        {
+            result |= uint64_t{1} << x;
+        }
+    }
+    return result;
+}
+
+namespace impl
+{
+
+/**
+ * Function together with transform, which produced it from the original one.
+ * Truth table is replicated to all 64 bits, so that operations on variables
+ * and comparisons do not depend on number of variables.
+ */
+struct State_
+{
+    uint64_t truth = 0;
+    Transform transform;
+
+    void flip(size_t variable) noexcept
+    {
+        truth = flipVariable(truth, variable);
+        transform.phase ^= static_cast<uint8_t>(1U << variable);
+    }
+
+    void swap(size_t variable) noexcept
+    {
+        truth = swapAdjacentVariables(truth, variable);
+        std::swap(transform.permutation[variable], transform.permutation[variable + 1]);
+        uint8_t const pair = (transform.phase >> variable) & 3U;
+        if (pair == 1U || pair == 2U)
+        {
+            transform.phase ^= static_cast<uint8_t>(3U << variable);
+        }
+    }
+
+    void negate() noexcept
+    {
+        truth                    = ~truth;
+        transform.output_negated = !transform.output_negated;
+    }
+};
+
+[[nodiscard]]
+inline uint64_t replicate_(uint64_t truth, size_t variables) noexcept
+{
+    truth &= getTruthMask(variables);
+    for (size_t i = variables; i < MaxVariables; ++i)
+    {
+        truth |= truth << (size_t{1} << i);
+    }
+    return truth;
+}
+
+/* Tries all permutations, phases and output negations. */
+[[nodiscard]]
+inline State_ canonizeExhaustive_(uint64_t truth, size_t variables) noexcept
+{
+    State_ best{.truth = ~uint64_t{0}, .transform = {}};
+    std::array<uint8_t, MaxVariables> order{};
+    std::iota(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(variables), 0);
+    do
+    {
+        // Bubble variables to positions, prescribed by `order`, tracking transform.
+        State_ state{.truth = truth, .transform = {}};
+        for (size_t i = 0; i < variables; ++i)
+        {
+            size_t j = i;
+            while (state.transform.permutation[j] != order[i])
+            {
+                ++j;
+            }
+            for (; j > i; --j)
+            {
+                state.swap(j - 1);
+            }
+        }
+        // Phases are enumerated in Gray code order, one flip per step.
+        for (size_t step = 0; step < (size_t{1} << variables); ++step)
+        {
+            if (step != 0)
+            {
+                state.flip(static_cast<size_t>(std::countr_zero(step)));
+            }
+            best = state.truth < best.truth ? state : best;
+            state.negate();
+            best = state.truth < best.truth ? state : best;
+            state.negate();
+        }
+    } while (std::next_permutation(order.begin(), order.begin() + static_cast<std::ptrdiff_t>(variables)));
+    return best;
+}
+
+/**
+ * Normalizes phases and order of variables by their cofactor weights, which
+ * are NPN invariants, then resolves remaining ties greedily.
+ */
+[[nodiscard]]
+inline State_ canonizeHeuristic_(uint64_t truth, size_t variables) noexcept
+{
+    // Weights are counted over all 64 bits, which scales them equally for all variables.
+    auto const weight = [](uint64_t value) { return std::popcount(value); };
+
+    State_ best{.truth = ~uint64_t{0}, .transform = {}};
+    for (bool const negate_output : {false, true})
+    {
+        State_ state{.truth = truth, .transform = {}};
+        if (negate_output)
+        {
+            state.negate();
+        }
+        // Output is negated to have at most half of ones, both phases are tried on tie.
+        if (weight(state.truth) > 32)
+        {
+            continue;
+        }
+
+        // Each variable is negated to have no more ones in positive cofactor than in negative one.
+        std::array<int, MaxVariables> positive{};
+        std::array<bool, MaxVariables> tied{};
+        for (size_t i = 0; i < variables; ++i)
+        {
+            positive[i]  = weight(state.truth & VariableMasks[i]);
+            int negative = weight(state.truth & ~VariableMasks[i]);
+            if (positive[i] > negative)
+            {
+                state.flip(i);
+                std::swap(positive[i], negative);
+            }
+            tied[i] = positive[i] == negative;
+        }
+        // Variables are sorted by weight of positive cofactor.
+        for (size_t pass = 0; pass < variables; ++pass)
+        {
+            for (size_t i = 0; i + 1 < variables; ++i)
+            {
+                if (positive[i] > positive[i + 1])
+                {
+                    state.swap(i);
+                    std::swap(positive[i], positive[i + 1]);
+                    std::swap(tied[i], tied[i + 1]);
+                }
+            }
+        }
+        // Weights do not distinguish tied phases and variables of equal weight, smaller table is preferred.
+        bool improved = true;
+        while (improved)
+        {
+            improved = false;
+            for (size_t i = 0; i < variables; ++i)
+            {
+                State_ candidate = state;
+                if (tied[i])
+                {
+                    candidate.flip(i);
+                    if (candidate.truth < state.truth)
+                    {
+                        state    = candidate;
+                        improved = true;
+                    }
+                }
+                candidate = state;
+                if (i + 1 < variables && positive[i] == positive[i + 1])
+                {
+                    candidate.swap(i);
+                    if (candidate.truth < state.truth)
+                    {
+                        state = candidate;
+                        std::swap(tied[i], tied[i + 1]);
+                        improved = true;
+                    }
+                }
+            }
+        }
+        best = state.truth < best.truth ? state : best;
+    }
+    return best;
+}
+
+}  // namespace impl
+
+/**
+ * Computes NPN canonical form of function of `variables` variables. Functions
+ * of at most `MaxExhaustiveVariables` variables get exact representative (the
+ * smallest truth table of the class), so all functions of class share it.
+ * Larger functions are canonized heuristically by phase and permutation
+ * signatures: representative is shared by most functions of class, but a
+ * class may have several.
+ *
+ * @param truth -- truth table of function, bits beyond `2^variables` are ignored.
+ * @param variables -- number of variables, at most `MaxVariables`.
+ * @return canonical truth table (with bits beyond `2^variables` cleared) and
+ *         transform, such that `applyTransform(truth, variables, transform)` is it.
+ */
+[[nodiscard]]
+inline CanonicalForm canonize(uint64_t truth, size_t variables) noexcept
+{
+    assert(variables <= MaxVariables);
+    uint64_t const replicated = impl::replicate_(truth, variables);
+    impl::State_ const state  = variables <= MaxExhaustiveVariables
+                                    ? impl::canonizeExhaustive_(replicated, variables)
+                                    : impl::canonizeHeuristic_(replicated, variables);
+    return {state.truth & getTruthMask(variables), state.transform};
+}
+
+}  // namespace cirbo::npn
+
+#endif  // CIRBO_SEARCH_CORE_NPN_HPP
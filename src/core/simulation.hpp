@@ -0,0 +1,202 @@
+#ifndef CIRBO_SEARCH_CORE_SIMULATION_HPP
+#define CIRBO_SEARCH_CORE_SIMULATION_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+
+namespace cirbo
+{
+
+/**
+ * Bit-parallel simulation of a circuit. Every gate carries signature of
+ * `getNumberOfWords()` 64-bit words, i-th bit of which is the value of the
+ * gate on i-th input pattern, so 64 patterns are evaluated per word operation.
+ */
+class Simulation
+{
+private:
+    size_t words_;
+    /* Gate-major signatures: words of gate `g` are [g * words_, (g + 1) * words_). */
+    std::vector<uint64_t> values_;
+    /* Gates in topological order (operands go before users). */
+    GateIdContainer order_;
+
+public:
+    /**
+     * @param circuit -- circuit to simulate.
+     * @param words -- number of 64-bit words in signatures, hence `64 * words` patterns are simulated.
+     */
+    Simulation(ICircuit const& circuit, size_t words)
+        : words_(words)
+        , values_(circuit.getNumberOfGates() * words, 0)
+        , order_(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(circuit))
+    {
+        // Sorting starts from sinks, simulation needs to start from sources.
+        std::ranges::reverse(order_);
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfWords() const noexcept
+    {
+        return words_;
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfPatterns() const noexcept
+    {
+        return words_ * 64;
+    }
+
+    /* Returns pointer to `getNumberOfWords()` words of gate signature. */
+    [[nodiscard]]
+    uint64_t const* getSignature(GateId gateId) const noexcept
+    {
+        return values_.data() + (gateId * words_);
+    }
+
+    /* Returns value of gate on pattern `pattern`. */
+    [[nodiscard]]
+    bool getValue(GateId gateId, size_t pattern) const noexcept
+    {
+        return ((getSignature(gateId)[pattern / 64] >> (pattern % 64)) & 1U) != 0;
+    }
+
+    /**
+     * Assigns uniformly random values to all inputs on all patterns.
+     */
+    template<class EngineT>
+    void randomizeInputs(ICircuit const& circuit, EngineT& engine)
+    {
+        std::uniform_int_distribution<uint64_t> dist;
+        for (GateId const input : circuit.getInputGates())
+        {
+            for (size_t word = 0; word < words_; ++word)
+            {
+                values_.at((input * words_) + word) = dist(engine);
+            }
+        }
+    }
+
+    /**
+     * Sets value of input gate `input` on pattern `pattern`.
+     */
+    void setInputValue(GateId input, size_t pattern, bool value) noexcept
+    {
+        assert(pattern < getNumberOfPatterns());
+        uint64_t& word     = values_[(input * words_) + (pattern / 64)];
+        uint64_t const bit = uint64_t{1} << (pattern % 64);
+        word               = value ? (word | bit) : (word & ~bit);
+    }
+
+    /**
+     * Sets values of input gate `input` on all patterns from `getNumberOfWords()` words.
+     */
+    void setInputWords(GateId input, uint64_t const* words) noexcept
+    {
+        std::copy(words, words + words_, values_.data() + (input * words_));
+    }
+
+    /**
+     * Evaluates all non-input gates on current input patterns.
+     */
+    void run(ICircuit const& circuit)
+    {
+        for (GateId const gateId : order_)
+        {
+            if (circuit.getGateType(gateId) != GateType::INPUT)
+            {
+                evaluateGate_(circuit, gateId);
+            }
+        }
+    }
+
+private:
+    void evaluateGate_(ICircuit const& circuit, GateId gateId)
+    {
+        GateIdContainer const& operands = circuit.getGateOperands(gateId);
+        GateType const type             = circuit.getGateType(gateId);
+        uint64_t* result                = values_.data() + (gateId * words_);
+        auto const operand              = [this, &operands](size_t i)
+        { return values_.data() + (operands[i] * words_); };
+
+        switch (type)
+        {
+            case GateType::CONST_FALSE:
+                std::fill(result, result + words_, uint64_t{0});
+                return;
+            case GateType::CONST_TRUE:
+                std::fill(result, result + words_, ~uint64_t{0});
+                return;
+            case GateType::NOT:
+                std::transform(operand(0), operand(0) + words_, result, [](uint64_t x) { return ~x; });
+                return;
+            case GateType::IFF:
+            case GateType::BUFF:
+                std::copy(operand(0), operand(0) + words_, result);
+                return;
+            case GateType::MUX:
+            {
+                // MUX(x, y, z) is y when x is false and z otherwise.
+                uint64_t const* x = operand(0);
+                uint64_t const* y = operand(1);
+                uint64_t const* z = operand(2);
+                for (size_t word = 0; word < words_; ++word)
+                {
+                    result[word] = (~x[word] & y[word]) | (x[word] & z[word]);
+                }
+                return;
+            }
+            case GateType::AND:
+            case GateType::NAND:
+            case GateType::OR:
+            case GateType::NOR:
+            case GateType::XOR:
+            case GateType::NXOR:
+                break;
+            default:
+                log::error("Simulation: unsupported gate type.");
+                std::abort();
+        }
+
+        // Symmetric operators are folded operand by operand.
+        assert(!operands.empty());
+        std::copy(operand(0), operand(0) + words_, result);
+        for (size_t i = 1; i < operands.size(); ++i)
+        {
+            uint64_t const* other = operand(i);
+            for (size_t word = 0; word < words_; ++word)
+            {
+                if (type == GateType::AND || type == GateType::NAND)
+                {
+                    result[word] &= other[word];
+                }
+                else if (type == GateType::OR || type == GateType::NOR)
+                {
+                    result[word] |= other[word];
+                }
+                else
+                {
+                    result[word] ^= other[word];
+                }
+            }
+        }
+        if (type == GateType::NAND || type == GateType::NOR || type == GateType::NXOR)
+        {
+            std::transform(result, result + words_, result, [](uint64_t x) { return ~x; });
+        }
+    }
+};
+
+}  // namespace cirbo
+
+#endif  // CIRBO_SEARCH_CORE_SIMULATION_HPP
@@ -0,0 +1,579 @@
+#ifndef CIRBO_SEARCH_CORE_SOP_HPP
+#define CIRBO_SEARCH_CORE_SOP_HPP
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "core/npn.hpp"
+#include "core/types.hpp"
+
+/**
+ * Sums of products of boolean functions of at most 16 variables, given by
+ * multi-word truth tables (bit `m % 64` of word `m / 64` is value of function
+ * on assignment `m`, where i-th bit of `m` is value of i-th variable), and
+ * their algebraic factoring. Tables of less than 6 variables take one word,
+ * whose bits beyond `2^variables` are zero.
+ */
+namespace cirbo::sop
+{
+
+constexpr size_t MaxVariables = 16;
+
+using TruthTable = std::vector<uint64_t>;
+
+/**
+ * Product of literals: variable `i` is in cube iff i-th bit of `mask` is set,
+ * and is positive iff i-th bit of `values` is set too.
+ */
+struct Cube
+{
+    uint32_t mask   = 0;
+    uint32_t values = 0;
+
+    auto operator<=>(Cube const&) const = default;
+
+    /* Returns true iff every literal of `other` is literal of this cube. */
+    [[nodiscard]]
+    bool contains(Cube const& other) const noexcept
+    {
+        return (other.mask & ~mask) == 0 && ((other.values ^ values) & other.mask) == 0;
+    }
+};
+
+using Cover = std::vector<Cube>;
+
+/* Returns number of words of truth table of function of `variables` variables. */
+[[nodiscard]]
+constexpr size_t getWords(size_t variables) noexcept
+{
+    return variables <= npn::MaxVariables ? 1 : size_t{1} << (variables - npn::MaxVariables);
+}
+
+[[nodiscard]]
+inline TruthTable makeConstant(bool value, size_t variables)
+{
+    return TruthTable(getWords(variables), value ? npn::getTruthMask(variables) : 0);
+}
+
+/* Returns truth table of i-th variable. */
+[[nodiscard]]
+inline TruthTable makeVariable(size_t variable, size_t variables)
+{
+    assert(variable < variables && variables <= MaxVariables);
+    TruthTable truth(getWords(variables));
+    for (size_t word = 0; word < truth.size(); ++word)
+    {
+        if (variable < npn::MaxVariables)
+        {
+            truth[word] = npn::VariableMasks[variable] & npn::getTruthMask(variables);
+        }
+        else if (((word >> (variable - npn::MaxVariables)) & 1U) != 0)
+        {
+            truth[word] = ~uint64_t{0};
+        }
+    }
+    return truth;
+}
+
+/* Returns truth table of negation of function. */
+[[nodiscard]]
+inline TruthTable negate(TruthTable truth, size_t variables)
+{
+    for (uint64_t& word : truth)
+    {
+        word = ~word & npn::getTruthMask(variables);
+    }
+    return truth;
+}
+
+/* Returns truth table of cofactor of function by variable, which does not depend on the variable. */
+[[nodiscard]]
+inline TruthTable cofactor(TruthTable truth, size_t variable, bool value)
+{
+    if (variable < npn::MaxVariables)
+    {
+        size_t const shift  = size_t{1} << variable;
+        uint64_t const mask = npn::VariableMasks[variable];
+        for (uint64_t& word : truth)
+        {
+            word = value ? (word & mask) | ((word & mask) >> shift) : (word & ~mask) | ((word & ~mask) << shift);
+        }
+        return truth;
+    }
+    size_t const stride = size_t{1} << (variable - npn::MaxVariables);
+    for (size_t block = 0; block < truth.size(); block += 2 * stride)
+    {
+        for (size_t word = block; word < block + stride; ++word)
+        {
+            if (value)
+            {
+                truth[word] = truth[word + stride];
+            }
+            else
+            {
+                truth[word + stride] = truth[word];
+            }
+        }
+    }
+    return truth;
+}
+
+[[nodiscard]]
+inline bool dependsOn(TruthTable const& truth, size_t variable)
+{
+    return cofactor(truth, variable, false) != cofactor(truth, variable, true);
+}
+
+/* Returns truth table of function of cover. */
+[[nodiscard]]
+inline TruthTable evaluate(Cover const& cover, size_t variables)
+{
+    TruthTable result = makeConstant(false, variables);
+    for (Cube const& cube : cover)
+    {
+        TruthTable product = makeConstant(true, variables);
+        for (size_t variable = 0; variable < variables; ++variable)
+        {
+            if (((cube.mask >> variable) & 1U) == 0)
+            {
+                continue;
+            }
+            TruthTable literal = makeVariable(variable, variables);
+            if (((cube.values >> variable) & 1U) == 0)
+            {
+                literal = negate(std::move(literal), variables);
+            }
+            for (size_t word = 0; word < product.size(); ++word)
+            {
+                product[word] &= literal[word];
+            }
+        }
+        for (size_t word = 0; word < result.size(); ++word)
+        {
+            result[word] |= product[word];
+        }
+    }
+    return result;
+}
+
+namespace impl
+{
+
+/* Minato-Morreale recursion over variables below `variable`, returns function of added cubes. */
+inline TruthTable computeIsop_(
+    TruthTable const& lower,
+    TruthTable const& upper,
+    size_t variable,
+    size_t variables,
+    Cover& cover)
+{
+    if (std::ranges::all_of(lower, [](uint64_t word) { return word == 0; }))
+    {
+        return lower;
+    }
+    if (upper == makeConstant(true, variables))
+    {
+        cover.emplace_back();
+        return upper;
+    }
+    // Function is not constant, so it depends on one of remaining variables.
+    do
+    {
+        --variable;
+    } while (!dependsOn(lower, variable) && !dependsOn(upper, variable));
+
+    TruthTable const lower0 = cofactor(lower, variable, false);
+    TruthTable const lower1 = cofactor(lower, variable, true);
+    TruthTable const upper0 = cofactor(upper, variable, false);
+    TruthTable const upper1 = cofactor(upper, variable, true);
+    size_t const words      = lower.size();
+    auto const cut          = [words](TruthTable lhs, TruthTable const& rhs)
+    {
+        for (size_t word = 0; word < words; ++word)
+        {
+            lhs[word] &= ~rhs[word];
+        }
+        return lhs;
+    };
+    auto const add_literal = [&cover, variable](size_t begin, bool value)
+    {
+        for (size_t i = begin; i < cover.size(); ++i)
+        {
+            cover[i].mask |= uint32_t{1} << variable;
+            cover[i].values |= static_cast<uint32_t>(value) << variable;
+        }
+    };
+
+    size_t begin              = cover.size();
+    TruthTable const negative = computeIsop_(cut(lower0, upper1), upper0, variable, variables, cover);
+    add_literal(begin, false);
+    begin                     = cover.size();
+    TruthTable const positive = computeIsop_(cut(lower1, upper0), upper1, variable, variables, cover);
+    add_literal(begin, true);
+
+    // Minterms, which are not covered by cubes with literal of variable, are covered by cubes without it.
+    TruthTable rest_lower        = cut(lower0, negative);
+    TruthTable const rest_lower1 = cut(lower1, positive);
+    TruthTable rest_upper        = upper0;
+    for (size_t word = 0; word < words; ++word)
+    {
+        rest_lower[word] |= rest_lower1[word];
+        rest_upper[word] &= upper1[word];
+    }
+    TruthTable result               = computeIsop_(rest_lower, rest_upper, variable, variables, cover);
+    TruthTable const variable_truth = makeVariable(variable, variables);
+    for (size_t word = 0; word < words; ++word)
+    {
+        result[word] |= (negative[word] & ~variable_truth[word]) | (positive[word] & variable_truth[word]);
+    }
+    return result;
+}
+
+}  // namespace impl
+
+/**
+ * Computes irredundant sum of products of a function, which is at least
+ * `lower` and at most `upper` (so `upper & ~lower` are don't cares), by the
+ * Minato-Morreale algorithm: no cube or literal can be removed from the cover
+ * without breaking these bounds.
+ *
+ * @param lower -- truth table of on-set.
+ * @param upper -- truth table of on-set and don't care set, contains `lower`.
+ * @param variables -- number of variables, at most `MaxVariables`.
+ */
+[[nodiscard]]
+inline Cover computeIsop(TruthTable const& lower, TruthTable const& upper, size_t variables)
+{
+    assert(variables <= MaxVariables && lower.size() == getWords(variables) && upper.size() == lower.size());
+    Cover cover;
+    impl::computeIsop_(lower, upper, variables, variables, cover);
+    return cover;
+}
+
+/* Computes irredundant sum of products of completely specified function. */
+[[nodiscard]]
+inline Cover computeIsop(TruthTable const& truth, size_t variables)
+{
+    return computeIsop(truth, truth, variables);
+}
+
+/**
+ * Factored form: tree of binary AND and OR nodes over literals and constants.
+ * Literal is node of type `GateType::INPUT`, literals and constants are shared.
+ */
+struct FactoredForm
+{
+    struct Node
+    {
+        GateType type = GateType::CONST_FALSE;
+        /* Variable of literal. */
+        uint8_t variable = 0;
+        bool negated     = false;
+        /* Operands of AND and OR nodes. */
+        uint32_t lhs = 0;
+        uint32_t rhs = 0;
+    };
+
+    std::vector<Node> nodes;
+    uint32_t root = 0;
+
+    /* Returns number of AND and OR nodes. */
+    [[nodiscard]]
+    size_t countOperators() const noexcept
+    {
+        return static_cast<size_t>(std::ranges::count_if(
+            nodes, [](Node const& node) { return node.type == GateType::AND || node.type == GateType::OR; }));
+    }
+
+    /* Returns truth table of function of root. */
+    [[nodiscard]]
+    TruthTable evaluate(size_t variables) const
+    {
+        std::vector<TruthTable> values;
+        for (Node const& node : nodes)
+        {
+            switch (node.type)
+            {
+                case GateType::INPUT:
+                    values.push_back(makeVariable(node.variable, variables));
+                    if (node.negated)
+                    {
+                        values.back() = negate(std::move(values.back()), variables);
+                    }
+                    break;
+                case GateType::AND:
+                case GateType::OR:
+                    values.push_back(values.at(node.lhs));
+                    for (size_t word = 0; word < values.back().size(); ++word)
+                    {
+                        values.back()[word] = node.type == GateType::AND ? values.back()[word] & values[node.rhs][word]
+                                                                         : values.back()[word] | values[node.rhs][word];
+                    }
+                    break;
+                default:
+                    values.push_back(makeConstant(node.type == GateType::CONST_TRUE, variables));
+                    break;
+            }
+        }
+        return values.at(root);
+    }
+};
+
+namespace impl
+{
+
+class Factoring_
+{
+private:
+    static constexpr uint32_t None_ = UINT32_MAX;
+
+    FactoredForm form_;
+    /* Node of literal `2 * variable + negated`, if it is created. */
+    std::array<uint32_t, 2 * MaxVariables> literals_{};
+    std::array<uint32_t, 2> constants_{None_, None_};
+
+public:
+    Factoring_()
+    {
+        literals_.fill(None_);
+    }
+
+    FactoredForm run(Cover cover, size_t variables) &&
+    {
+        form_.root = factor_(std::move(cover), variables);
+        return std::move(form_);
+    }
+
+private:
+    uint32_t factor_(Cover cover, size_t variables)
+    {
+        if (cover.empty())
+        {
+            return makeConstant_(false);
+        }
+        if (std::ranges::any_of(cover, [](Cube const& cube) { return cube.mask == 0; }))
+        {
+            return makeConstant_(true);
+        }
+        if (cover.size() == 1)
+        {
+            return makeProduct_(cover.front(), variables);
+        }
+
+        Cube const common = findCommonCube_(cover);
+        if (common.mask != 0)
+        {
+            for (Cube& cube : cover)
+            {
+                cube = divide_(cube, common);
+            }
+            return makeOperator_(GateType::AND, makeProduct_(common, variables), factor_(std::move(cover), variables));
+        }
+
+        // Level-0 kernel: cube-free quotient of cover by cube, which has no literal in two cubes.
+        Cover kernel                = cover;
+        std::optional<Cube> literal = findFrequentLiteral_(kernel, variables);
+        while (literal.has_value())
+        {
+            Cover quotient;
+            for (Cube const& cube : kernel)
+            {
+                if (cube.contains(*literal))
+                {
+                    quotient.push_back(divide_(cube, *literal));
+                }
+            }
+            Cube const quotient_common = findCommonCube_(quotient);
+            for (Cube& cube : quotient)
+            {
+                cube = divide_(cube, quotient_common);
+            }
+            kernel  = std::move(quotient);
+            literal = findFrequentLiteral_(kernel, variables);
+        }
+        if (kernel.size() == cover.size())
+        {
+            // No literal is shared by cubes.
+            std::vector<uint32_t> products;
+            for (Cube const& cube : cover)
+            {
+                products.push_back(makeProduct_(cube, variables));
+            }
+            return makeBalanced_(GateType::OR, products);
+        }
+
+        // Weak division of cover by kernel.
+        Cover quotient;
+        for (size_t i = 0; i < kernel.size(); ++i)
+        {
+            Cover partial;
+            for (Cube const& cube : cover)
+            {
+                if (cube.contains(kernel[i]))
+                {
+                    partial.push_back(divide_(cube, kernel[i]));
+                }
+            }
+            std::ranges::sort(partial);
+            if (i == 0)
+            {
+                quotient = std::move(partial);
+                continue;
+            }
+            Cover intersection;
+            std::ranges::set_intersection(quotient, partial, std::back_inserter(intersection));
+            quotient = std::move(intersection);
+        }
+        Cover products;
+        for (Cube const& lhs : quotient)
+        {
+            for (Cube const& rhs : kernel)
+            {
+                products.push_back({lhs.mask | rhs.mask, lhs.values | rhs.values});
+            }
+        }
+        Cover remainder;
+        for (Cube const& cube : cover)
+        {
+            if (std::ranges::find(products, cube) == products.end())
+            {
+                remainder.push_back(cube);
+            }
+        }
+        uint32_t const product =
+            makeOperator_(GateType::AND, factor_(std::move(quotient), variables), factor_(kernel, variables));
+        return remainder.empty() ? product
+                                 : makeOperator_(GateType::OR, product, factor_(std::move(remainder), variables));
+    }
+
+    static Cube divide_(Cube const& cube, Cube const& divisor) noexcept
+    {
+        return {cube.mask & ~divisor.mask, cube.values & ~divisor.mask};
+    }
+
+    static Cube findCommonCube_(Cover const& cover) noexcept
+    {
+        if (cover.empty())
+        {
+            return {};
+        }
+        Cube common = cover.front();
+        for (Cube const& cube : cover)
+        {
+            common.mask &= cube.mask & ~(cube.values ^ common.values);
+        }
+        common.values &= common.mask;
+        return common;
+    }
+
+    /* Returns literal, which is in the most cubes, if it is in at least two of them. */
+    static std::optional<Cube> findFrequentLiteral_(Cover const& cover, size_t variables)
+    {
+        std::optional<Cube> best;
+        size_t best_count = 1;
+        for (size_t variable = 0; variable < variables; ++variable)
+        {
+            for (uint32_t const value : {0U, 1U})
+            {
+                Cube const literal{uint32_t{1} << variable, value << variable};
+                auto const count = static_cast<size_t>(
+                    std::ranges::count_if(cover, [&literal](Cube const& cube) { return cube.contains(literal); }));
+                if (count > best_count)
+                {
+                    best       = literal;
+                    best_count = count;
+                }
+            }
+        }
+        return best;
+    }
+
+    uint32_t makeConstant_(bool value)
+    {
+        uint32_t& node = constants_[static_cast<size_t>(value)];
+        if (node == None_)
+        {
+            node = static_cast<uint32_t>(form_.nodes.size());
+            form_.nodes.push_back({.type = value ? GateType::CONST_TRUE : GateType::CONST_FALSE});
+        }
+        return node;
+    }
+
+    uint32_t makeLiteral_(size_t variable, bool negated)
+    {
+        uint32_t& node = literals_[2 * variable + static_cast<size_t>(negated)];
+        if (node == None_)
+        {
+            node = static_cast<uint32_t>(form_.nodes.size());
+            form_.nodes.push_back(
+                {.type = GateType::INPUT, .variable = static_cast<uint8_t>(variable), .negated = negated});
+        }
+        return node;
+    }
+
+    uint32_t makeOperator_(GateType type, uint32_t lhs, uint32_t rhs)
+    {
+        form_.nodes.push_back({.type = type, .lhs = lhs, .rhs = rhs});
+        return static_cast<uint32_t>(form_.nodes.size() - 1);
+    }
+
+    uint32_t makeProduct_(Cube const& cube, size_t variables)
+    {
+        std::vector<uint32_t> literals;
+        for (size_t variable = 0; variable < variables; ++variable)
+        {
+            if (((cube.mask >> variable) & 1U) != 0)
+            {
+                literals.push_back(makeLiteral_(variable, ((cube.values >> variable) & 1U) == 0));
+            }
+        }
+        return makeBalanced_(GateType::AND, literals);
+    }
+
+    /* Combines operands by balanced tree of binary nodes. */
+    uint32_t makeBalanced_(GateType type, std::vector<uint32_t> operands)
+    {
+        assert(!operands.empty());
+        while (operands.size() > 1)
+        {
+            std::vector<uint32_t> next;
+            for (size_t i = 0; i + 1 < operands.size(); i += 2)
+            {
+                next.push_back(makeOperator_(type, operands[i], operands[i + 1]));
+            }
+            if (operands.size() % 2 == 1)
+            {
+                next.push_back(operands.back());
+            }
+            operands = std::move(next);
+        }
+        return operands.front();
+    }
+};
+
+}  // namespace impl
+
+/**
+ * Factors sum of products algebraically: common cubes are taken out of
+ * cover, and cover is divided by its level-0 kernels recursively, as quick
+ * factoring of SIS does. So `ab + ac + d` becomes `a(b + c) + d`.
+ *
+ * @param cover -- sum of products.
+ * @param variables -- number of variables, at most `MaxVariables`.
+ */
+[[nodiscard]]
+inline FactoredForm factor(Cover cover, size_t variables)
+{
+    return impl::Factoring_{}.run(std::move(cover), variables);
+}
+
+}  // namespace cirbo::sop
+
+#endif  // CIRBO_SEARCH_CORE_SOP_HPP
@@ -9,6 +9,7 @@
 #include "core/structures/gate_info.hpp"
 #include "core/structures/icircuit.hpp"
 #include "core/types.hpp"
+#include "utils/buffer_pool.hpp"
 
 namespace cirbo
 {
@@ -102,6 +103,20 @@ public:
     {
         users_.push_back(gateId);
     }
+
+    /* Moves out operands container. Leaves node in invalid state. */
+    [[nodiscard]]
+    GateIdContainer&& moveOperands() noexcept
+    {
+        return std::move(operands_);
+    }
+
+    /* Moves out users container. Leaves node in invalid state. */
+    [[nodiscard]]
+    GateIdContainer&& moveUsers() noexcept
+    {
+        return std::move(users_);
+    }
 };
 
 /** Represents boolean circuit as Directed Acyclic Graph. **/
@@ -117,25 +132,45 @@ protected:
 
 public:
     DAG(DAG const& dag)
-        : gates_(dag.gates_)
+        : ICircuit(dag)
+        , gates_(dag.gates_)
         , input_gates_(dag.input_gates_)
         , output_gates_(dag.output_gates_)
     {
     }
 
+    DAG(DAG&& dag) noexcept
+        : ICircuit(std::move(dag))
+        , gates_(std::move(dag.gates_))
+        , input_gates_(std::move(dag.input_gates_))
+        , output_gates_(std::move(dag.output_gates_))
+    {
+    }
+
     DAG(GateInfoContainer const& gate_info, GateIdContainer const& output_gates)
         : output_gates_(output_gates)
     {
         comprehendGateInfo_(gate_info);
     }
 
+    /**
+     * Takes ownership of `gate_info` operand containers, so no operands are copied.
+     * Emptied `gate_info` is returned to the thread local buffer pool.
+     */
+    DAG(GateInfoContainer&& gate_info, GateIdContainer const& output_gates)
+        : output_gates_(output_gates)
+    {
+        comprehendGateInfo_(std::move(gate_info));
+    }
+
     DAG(GateInfoContainer&& gate_info, GateIdContainer&& output_gates)
         : output_gates_(std::move(output_gates))
     {
         comprehendGateInfo_(std::move(gate_info));
     }
 
-    ~DAG() override = default;
+    /* Returns all node buffers to the thread local buffer pools, so the next circuit may reuse them. */
+    ~DAG() override { recycleStorage_(); }
 
 private:
     template<class T>
@@ -147,10 +182,15 @@ private:
 
     void buildGates_(GateInfoContainer const& gate_info)
     {
+        gates_ = utils::getBufferPool<Node_>().acquire();
         gates_.reserve(gate_info.size());
         for (size_t gateId = 0; gateId < gate_info.size(); ++gateId)
         {
-            gates_.emplace_back(gateId, gate_info[gateId].getType(), gate_info[gateId].getOperands());
+            gates_.emplace_back(
+                gateId,
+                gate_info[gateId].getType(),
+                acquireGateIdContainer(gate_info[gateId].getOperands()),
+                acquireGateIdContainer());
 
             if (gate_info[gateId].getType() == GateType::INPUT)
             {
@@ -161,16 +201,30 @@ private:
 
     void buildGates_(GateInfoContainer&& gate_info)
     {
+        gates_ = utils::getBufferPool<Node_>().acquire();
         gates_.reserve(gate_info.size());
         for (size_t gateId = 0; gateId < gate_info.size(); ++gateId)
         {
-            gates_.emplace_back(gateId, gate_info[gateId].getType(), gate_info[gateId].moveOperands());
+            gates_.emplace_back(
+                gateId, gate_info[gateId].getType(), gate_info[gateId].moveOperands(), acquireGateIdContainer());
 
             if (gate_info[gateId].getType() == GateType::INPUT)
             {
                 input_gates_.push_back(gateId);
             }
         }
+        recycleGateInfoContainer(std::move(gate_info));
+    }
+
+    void recycleStorage_() noexcept
+    {
+        auto& operands_pool = utils::getBufferPool<GateId>();
+        for (auto& gate : gates_)
+        {
+            operands_pool.release(gate.moveOperands());
+            operands_pool.release(gate.moveUsers());
+        }
+        utils::getBufferPool<Node_>().release(std::move(gates_));
     }
 
     void calculateGateUsers_()
@@ -6,6 +6,7 @@
 #include <vector>
 
 #include "core/types.hpp"
+#include "utils/buffer_pool.hpp"
 #include "utils/cast.hpp"
 
 namespace cirbo
@@ -72,6 +73,37 @@ public:
 /** At i'th position carries info about gate with GateId = i. **/
 using GateInfoContainer = std::vector<GateInfo>;
 
+/**
+ * @return empty operands container, taken from thread local buffer pool.
+ */
+inline GateIdContainer acquireGateIdContainer() noexcept { return utils::getBufferPool<GateId>().acquire(); }
+
+/**
+ * @return copy of `source`, stored in a container taken from thread local buffer pool.
+ */
+inline GateIdContainer acquireGateIdContainer(GateIdContainer const& source)
+{
+    return utils::getBufferPool<GateId>().acquireCopy(source);
+}
+
+/**
+ * @return container of `size` empty gate infos, taken from thread local buffer pool.
+ */
+inline GateInfoContainer acquireGateInfoContainer(size_t const size)
+{
+    return utils::getBufferPool<GateInfo>().acquire(size);
+}
+
+/**
+ * Returns `gate_info` and all operand containers it still owns to thread local buffer pools.
+ */
+inline void recycleGateInfoContainer(GateInfoContainer&& gate_info)
+{
+    auto& operands_pool = utils::getBufferPool<GateId>();
+    for (auto& info : gate_info) { operands_pool.release(info.moveOperands()); }
+    utils::getBufferPool<GateInfo>().release(std::move(gate_info));
+}
+
 }  // namespace cirbo
 
 #endif  // CIRBO_SEARCH_GATE_INFO_HPP
@@ -28,6 +28,10 @@ namespace cirbo
  */
 class ICircuit
 {
+private:
+    /* Invariants, known to hold for the circuit. */
+    InvariantSet invariants_ = invariant::NONE;
+
 public:
     ICircuit()          = default;
     virtual ~ICircuit() = default;
@@ -60,6 +64,22 @@ public:
     [[nodiscard]]
     virtual bool isOutputGate(GateId gateId) const = 0;
 
+    // ========== Circuit Invariants ========== //
+    /* Returns set of invariants, known to hold for the circuit. */
+    [[nodiscard]]
+    InvariantSet getInvariants() const noexcept
+    {
+        return invariants_;
+    }
+    /* Returns true iff all invariants from `invariants` are known to hold. */
+    [[nodiscard]]
+    bool hasInvariants(InvariantSet invariants) const noexcept
+    {
+        return (invariants_ & invariants) == invariants;
+    }
+    /* Sets invariants, known to hold for the circuit. Must be maintained by code, which changes circuit. */
+    void setInvariants(InvariantSet invariants) noexcept { invariants_ = invariants; }
+
     // ========== Circuit Evaluation Methods ========== //
     /**
      * @param input_asmt -- some (partial) assignment.
@@ -0,0 +1,117 @@
+#ifndef CIRBO_SEARCH_XAG_HPP
+#define CIRBO_SEARCH_XAG_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/structures/dag.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/types.hpp"
+#include "utils/cast.hpp"
+
+namespace cirbo
+{
+
+/**
+ * Represents boolean circuit as XOR-AND graph: DAG of AND, XOR and NOT gates,
+ * inputs and constants. Any DAG is converted to this form by `ConvertToXAG`
+ * (see `minimization/strategy.hpp`). Note that transformers of DAG may emit
+ * other gate types (e.g. OR and NAND, or OR gadgets of ConstantGateReducer),
+ * so their results must be converted again before they are wrapped into XAG.
+ *
+ * Number of AND gates (multiplicative complexity) is the cost, that matters
+ * for cryptographic and MPC applications, while XOR and NOT gates are free.
+ */
+class XAG : public DAG
+{
+public:
+    XAG(XAG const& xag)     = default;
+    XAG(XAG&& xag) noexcept = default;
+
+    /**
+     * @throw std::invalid_argument if `dag` has gates of other types.
+     */
+    explicit XAG(DAG const& dag)
+        : DAG(dag)
+    {
+        validate_();
+    }
+
+    XAG(GateInfoContainer const& gate_info, GateIdContainer const& output_gates)
+        : DAG(gate_info, output_gates)
+    {
+        validate_();
+    }
+
+    XAG(GateInfoContainer&& gate_info, GateIdContainer const& output_gates)
+        : DAG(std::move(gate_info), output_gates)
+    {
+        validate_();
+    }
+
+    XAG(GateInfoContainer&& gate_info, GateIdContainer&& output_gates)
+        : DAG(std::move(gate_info), std::move(output_gates))
+    {
+        validate_();
+    }
+
+    ~XAG() override = default;
+
+    /**
+     * @return true iff gates of `type` may be in XAG.
+     */
+    [[nodiscard]]
+    static bool isXAGType(GateType type) noexcept
+    {
+        switch (type)
+        {
+            case GateType::INPUT:
+            case GateType::CONST_FALSE:
+            case GateType::CONST_TRUE:
+            case GateType::NOT:
+            case GateType::AND:
+            case GateType::XOR:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @return number of binary AND gates, which AND gates of circuit split into.
+     */
+    [[nodiscard]]
+    size_t getMultiplicativeComplexity() const
+    {
+        size_t ands = 0;
+        for (GateId gateId = 0; gateId < getNumberOfGates(); ++gateId)
+        {
+            size_t const arity = getGateOperands(gateId).size();
+            if (getGateType(gateId) == GateType::AND && arity > 1)
+            {
+                ands += arity - 1;
+            }
+        }
+        return ands;
+    }
+
+private:
+    void validate_() const
+    {
+        for (GateId gateId = 0; gateId < getNumberOfGates(); ++gateId)
+        {
+            if (!isXAGType(getGateType(gateId)))
+            {
+                throw std::invalid_argument(
+                    "XAG can not contain gate " + std::to_string(gateId) + " of type " +
+                    utils::gateTypeToString(getGateType(gateId)) + ".");
+            }
+        }
+    }
+};
+
+}  // namespace cirbo
+
+#endif  // CIRBO_SEARCH_XAG_HPP
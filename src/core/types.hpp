@@ -80,9 +80,32 @@ using GateIdContainer = std::vector<GateId>;
 enum class Basis : uint8_t
 {
     BENCH,
-    AIG
+    AIG,
+    /* AND, XOR and NOT gates. */
+    XAG
 };
 
+/** Set of structural invariants, which are known to hold for a circuit (bitwise OR of `invariant` values). **/
+using InvariantSet = uint8_t;
+
+/**
+ * Structural invariants of circuits. They are maintained by minimization
+ * passes, so passes, whose result already holds, can be skipped.
+ */
+namespace invariant
+{
+constexpr InvariantSet NONE = 0;
+/* Every gate is reachable from outputs. */
+constexpr InvariantSet NO_DANGLING = 1U << 0U;
+/* There are no two gates with the same type and operands. */
+constexpr InvariantSet DEDUPLICATED = 1U << 1U;
+/* No gate has an operand, which is NOT of another NOT. */
+constexpr InvariantSet NO_NOT_CHAINS = 1U << 2U;
+/* Every non-constant gate, reachable from outputs, evaluates to UNDEFINED when inputs are undefined. */
+constexpr InvariantSet CONSTANTS_FOLDED = 1U << 3U;
+constexpr InvariantSet ALL              = NO_DANGLING | DEDUPLICATED | NO_NOT_CHAINS | CONSTANTS_FOLDED;
+}  // namespace invariant
+
 }  // namespace cirbo
 
 #endif  // CIRBO_SEARCH_CORE_TYPES_HPP
\ No newline at end of file
@@ -0,0 +1,313 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_ADAPTIVE_SCHEDULER_HPP
+#define CIRBO_SEARCH_MINIMIZATION_ADAPTIVE_SCHEDULER_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/cost_model.hpp"
+#include "core/structures/icircuit.hpp"
+#include "logger.hpp"
+#include "minimization/pipeline.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/transformer_base.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Statistics of one pass (arm) of `AdaptiveScheduler`, accumulated over all
+ * circuits it was applied to.
+ */
+struct ArmStatistics
+{
+    std::string name;
+    size_t pulls = 0;
+    /* Total decrease of cost of circuits. */
+    size_t gain = 0;
+    double seconds = 0;
+
+    /* Mean reward: decrease of cost per second. */
+    [[nodiscard]]
+    double getRewardRate() const noexcept
+    {
+        return seconds > 0 ? static_cast<double>(gain) / seconds : 0;
+    }
+};
+
+/**
+ * Statistics of `AdaptiveScheduler` arms. May be shared between schedulers
+ * (e.g. while processing a batch of circuits), so knowledge about profitable
+ * passes gathered on previous circuits is used for the next ones.
+ */
+class SchedulerStatistics
+{
+private:
+    std::vector<ArmStatistics> arms_;
+
+public:
+    /**
+     * @return statistics of arm `name`, created if absent.
+     */
+    ArmStatistics& getArm(std::string const& name)
+    {
+        auto it = std::ranges::find(arms_, name, &ArmStatistics::name);
+        if (it == arms_.end())
+        {
+            arms_.push_back(ArmStatistics{name});
+            return arms_.back();
+        }
+        return *it;
+    }
+
+    [[nodiscard]]
+    std::vector<ArmStatistics> const& getArms() const noexcept
+    {
+        return arms_;
+    }
+
+    [[nodiscard]]
+    size_t getTotalPulls() const noexcept
+    {
+        size_t total = 0;
+        for (auto const& arm : arms_)
+        {
+            total += arm.pulls;
+        }
+        return total;
+    }
+};
+
+/**
+ * Transformer, which chooses next pass to apply at runtime, treating passes as
+ * arms of a multi-armed bandit with reward equal to decrease of cost of circuit
+ * per second (UCB1 policy). Scheduler stops when time budget is exhausted or all
+ * passes became stale -- did not decrease cost `patience` times in a row since
+ * the circuit was last changed. Pass, which increased cost of circuit, is rolled back.
+ * Costs are given by `CostModel`, which counts gates by default.
+ *
+ * @tparam CircuitT -- class that carries circuit.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+class AdaptiveScheduler : public ITransformer<CircuitT>
+{
+public:
+    /** Default time budget for one circuit. **/
+    static constexpr std::chrono::milliseconds DefaultTimeBudget{1000};
+    /** Default number of consecutive fruitless applications, after which pass is considered stale. **/
+    static constexpr size_t DefaultPatience = 2;
+    /** Default exploration coefficient of UCB1. **/
+    static constexpr double DefaultExploration = 1.4;
+
+private:
+    struct Arm_
+    {
+        TransformerPtr<CircuitT> transformer;
+        /* Number of fruitless applications since the circuit was last changed. */
+        size_t misses = 0;
+    };
+
+    std::vector<Arm_> arms_;
+    std::shared_ptr<SchedulerStatistics> statistics_;
+    std::chrono::milliseconds time_budget_;
+    size_t patience_;
+    double exploration_;
+    CostModel cost_model_;
+
+public:
+    explicit AdaptiveScheduler(
+        std::vector<TransformerPtr<CircuitT>>&& passes,
+        std::chrono::milliseconds time_budget          = DefaultTimeBudget,
+        std::shared_ptr<SchedulerStatistics> statistics = std::make_shared<SchedulerStatistics>(),
+        size_t patience                                 = DefaultPatience,
+        double exploration                              = DefaultExploration,
+        CostModel cost_model                            = CostModel::gateCount())
+        : statistics_(std::move(statistics))
+        , time_budget_(time_budget)
+        , patience_(std::max<size_t>(patience, 1))
+        , exploration_(exploration)
+        , cost_model_(cost_model)
+    {
+        for (auto& pass : passes)
+        {
+            arms_.push_back(Arm_{std::move(pass)});
+        }
+    }
+
+    [[nodiscard]]
+    SchedulerStatistics const& getStatistics() const noexcept
+    {
+        return *statistics_;
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("START AdaptiveScheduler");
+        using Clock         = std::chrono::steady_clock;
+        auto const deadline = Clock::now() + time_budget_;
+
+        for (auto& arm : arms_)
+        {
+            arm.misses = 0;
+        }
+
+        while (Clock::now() < deadline)
+        {
+            size_t const chosen = chooseArm_();
+            if (chosen == arms_.size())
+            {
+                log::debug("All passes are stale, stopping.");
+                break;
+            }
+            Arm_& arm            = arms_.at(chosen);
+            ArmStatistics& stats = statistics_->getArm(arm.transformer->getName());
+            size_t const before  = cost_model_.getCircuitCost(*circuit);
+            // Copy is kept to roll back pass, which made circuit more expensive.
+            auto saved_circuit = std::make_unique<CircuitT>(*circuit);
+            auto saved_encoder = std::make_unique<NameEncoder>(*encoder);
+
+            auto const start           = Clock::now();
+            std::tie(circuit, encoder) = arm.transformer->run(std::move(circuit), std::move(encoder));
+            std::chrono::duration<double> const elapsed = Clock::now() - start;
+
+            size_t const after = cost_model_.getCircuitCost(*circuit);
+            log::debug("AdaptiveScheduler applied ", stats.name, ": cost ", before, " -> ", after, ".");
+            if (after > before)
+            {
+                circuit = std::move(saved_circuit);
+                encoder = std::move(saved_encoder);
+            }
+
+            ++stats.pulls;
+            stats.seconds += elapsed.count();
+            if (after < before)
+            {
+                stats.gain += before - after;
+                // Circuit changed, so stale passes may become profitable again.
+                for (auto& other : arms_)
+                {
+                    other.misses = 0;
+                }
+            }
+            else
+            {
+                ++arm.misses;
+            }
+        }
+
+        log::debug("END AdaptiveScheduler");
+        return {std::move(circuit), std::move(encoder)};
+    }
+
+private:
+    /* Returns index of arm to apply next, or number of arms if all arms are stale. */
+    size_t chooseArm_()
+    {
+        double const total_pulls = static_cast<double>(std::max<size_t>(statistics_->getTotalPulls(), 1));
+        double best_rate         = 0;
+        for (auto const& arm : arms_)
+        {
+            best_rate = std::max(best_rate, statistics_->getArm(arm.transformer->getName()).getRewardRate());
+        }
+
+        size_t chosen     = arms_.size();
+        double best_score = -std::numeric_limits<double>::infinity();
+        for (size_t i = 0; i < arms_.size(); ++i)
+        {
+            if (arms_.at(i).misses >= patience_)
+            {
+                continue;
+            }
+            ArmStatistics const& stats = statistics_->getArm(arms_.at(i).transformer->getName());
+            if (stats.pulls == 0)
+            {
+                return i;
+            }
+            // Rewards are normalized to [0, 1] to keep exploration term meaningful.
+            double const mean  = best_rate > 0 ? stats.getRewardRate() / best_rate : 0;
+            double const bonus = std::sqrt(std::log(total_pulls) / static_cast<double>(stats.pulls));
+            double const score = mean + (exploration_ * bonus);
+            if (score > best_score)
+            {
+                best_score = score;
+                chosen     = i;
+            }
+        }
+        return chosen;
+    }
+};
+
+/** Passes, which are scheduled by `makeAdaptiveScheduler` by default. **/
+inline std::vector<std::string> const& getDefaultScheduledPasses()
+{
+    static std::vector<std::string> const passes = {
+        "DuplicateGatesCleaner",
+        "DuplicateOperandsCleaner",
+        "ConstantGateReducer",
+        "ReduceNotComposition",
+        "MergeNotWithOthers",
+        "DeMorgan",
+        "ConnectSymmetricalGates(and, or, xor)"};
+    return passes;
+}
+
+/**
+ * @param time_budget -- time budget for one circuit.
+ * @param statistics -- statistics, shared between schedulers.
+ * @param arms -- transformers, which are scheduled, e.g. top-level items of parsed pipeline.
+ * @param cost_model -- costs of gates, rewards and roll backs are measured by.
+ * @return scheduler over given transformers.
+ */
+inline std::unique_ptr<AdaptiveScheduler<DAG>> makeAdaptiveScheduler(
+    std::chrono::milliseconds time_budget,
+    std::shared_ptr<SchedulerStatistics> statistics,
+    std::vector<TransformerPtr<DAG>>&& arms,
+    CostModel const& cost_model = CostModel::gateCount())
+{
+    auto scheduler = std::make_unique<AdaptiveScheduler<DAG>>(
+        std::move(arms),
+        time_budget,
+        std::move(statistics),
+        AdaptiveScheduler<DAG>::DefaultPatience,
+        AdaptiveScheduler<DAG>::DefaultExploration,
+        cost_model);
+    scheduler->setName("adaptive");
+    return scheduler;
+}
+
+/**
+ * @param time_budget -- time budget for one circuit.
+ * @param statistics -- statistics, shared between schedulers.
+ * @param passes -- pipeline descriptions (see `minimization/pipeline_parser.hpp`) of arms.
+ * @param cost_model -- costs of gates, rewards and roll backs are measured by.
+ * @return scheduler over given passes.
+ */
+inline std::unique_ptr<AdaptiveScheduler<DAG>> makeAdaptiveScheduler(
+    std::chrono::milliseconds time_budget,
+    std::shared_ptr<SchedulerStatistics> statistics,
+    std::vector<std::string> const& passes = getDefaultScheduledPasses(),
+    CostModel const& cost_model            = CostModel::gateCount())
+{
+    std::vector<TransformerPtr<DAG>> arms;
+    for (std::string const& pass : passes)
+    {
+        TransformerPtr<DAG> arm = parsePipeline(pass);
+        arm->setName(pass);
+        arms.push_back(std::move(arm));
+    }
+    return makeAdaptiveScheduler(time_budget, std::move(statistics), std::move(arms), cost_model);
+}
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_ADAPTIVE_SCHEDULER_HPP
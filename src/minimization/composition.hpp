@@ -43,7 +43,7 @@ public:
         std::unique_ptr<NameEncoder> encoder) override
     {
         auto _transformer         = TransformerT();
-        auto [_circuit, _encoder] = _transformer.transform(std::move(circuit), std::move(encoder));
+        auto [_circuit, _encoder] = _transformer.run(std::move(circuit), std::move(encoder));
 
         Composition<CircuitT, OtherTransformersT...> obj_composition;
         return obj_composition.transform(std::move(_circuit), std::move(_encoder));
@@ -65,7 +65,7 @@ public:
         std::unique_ptr<NameEncoder> encoder) override
     {
         auto _transformer = TransformerT();
-        return _transformer.transform(std::move(circuit), std::move(encoder));
+        return _transformer.run(std::move(circuit), std::move(encoder));
     }
 };
 
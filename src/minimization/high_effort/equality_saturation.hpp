@@ -0,0 +1,680 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_HIGH_EFFORT_EQUALITY_SATURATION_HPP
+#define CIRBO_SEARCH_MINIMIZATION_HIGH_EFFORT_EQUALITY_SATURATION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/cost_model.hpp"
+#include "core/egraph.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Transformer, that applies rewrites of DeMorgan, MergeNotWithOthers, ReduceNotComposition
+ * and ConstantGateReducer all at once, without loss of result due to order of passes.
+ *
+ * Circuit is added to e-graph (see `EGraph`), where structurally equal gates get one class.
+ * Then rules are applied to all nodes for a few iterations, each of which adds equivalent
+ * nodes to classes and merges classes, until no rule changes e-graph, or limit of iterations
+ * or size of e-graph is reached. Rules are equalities:
+ *
+ *   constant folding:  AND(x, 0) = 0, AND(x, 1, y) = AND(x, y), XOR(x, 1) = NOT(x),
+ *                      NOT(0) = 1, MUX(0, x, y) = x, IFF(x) = x, and so on;
+ *   not composition:   NOT(NOT(x)) = x;
+ *   merging of NOT:    NOT(AND(xs)) = NAND(xs) and back, same for OR and XOR;
+ *   de Morgan:         NAND(xs) = OR(NOT(xs)), NOR(xs) = AND(NOT(xs)), both directions.
+ *
+ * Finally, each class gets its cheapest node by `CostModel`, so the best combination of
+ * rewrites is extracted. Cost of node is its own cost plus area flow of its operands
+ * (cost of operand, divided by number of its users), so shared gates are cheap. Classes
+ * are extracted in order of cost, and class is extracted only by node, whose operands
+ * are extracted already, so extracted circuit is acyclic. The second round estimates
+ * numbers of users by circuit, extracted in the first round. Extracted circuit replaces
+ * the original one only if it is cheaper.
+ *
+ * Note that replaced gates are left in circuit, so this algorithm must be followed by
+ * RedundantGatesCleaner and DuplicateGatesCleaner, and preceded by RedundantGatesCleaner,
+ * since dangling gates are counted as users.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class EqualitySaturation_ : public ITransformer<CircuitT>
+{
+public:
+    /** Default limit of iterations of rules application. **/
+    static constexpr size_t DefaultIterations = 8;
+    /** Default limit of e-graph size, relative to size of initial e-graph. **/
+    static constexpr size_t DefaultGrowth = 4;
+    /** Number of extraction rounds, each next round counts users by circuit, extracted by previous one. **/
+    static constexpr size_t ExtractionRounds = 2;
+
+private:
+    /* How result of rewrite is built from its operands. */
+    enum class Action_ : uint8_t
+    {
+        /* Class is equal to the first operand. */
+        MERGE,
+        /* TYPE(operands). */
+        NODE,
+        /* TYPE(NOT(operand) for each operand). */
+        NEGATED_OPERANDS,
+        /* NOT(TYPE(operands)). */
+        NEGATED_NODE
+    };
+
+    /* Rewrite, found by rule: class `target` is equal to term, built by `action`. */
+    struct Rewrite_
+    {
+        EClassId target;
+        Action_ action;
+        GateType type;
+        std::vector<EClassId> children;
+        std::string_view rule;
+    };
+
+    size_t iterations_;
+    size_t growth_;
+    CostModel cost_model_;
+
+    EClassId false_class_ = 0;
+    EClassId true_class_  = 0;
+
+public:
+    /**
+     * @param iterations -- limit of iterations of rules application.
+     * @param growth -- e-graph is not extended beyond `growth` times its initial number of nodes.
+     * @param cost_model -- costs of gates, minimized by extraction.
+     */
+    explicit EqualitySaturation_(
+        size_t iterations    = DefaultIterations,
+        size_t growth        = DefaultGrowth,
+        CostModel cost_model = CostModel::gateCount())
+        : iterations_(iterations)
+        , growth_(std::max<size_t>(growth, 1))
+        , cost_model_(cost_model)
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START EqualitySaturation");
+
+        // Topsort, from inputs to outputs.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+        size_t const size = circuit->getNumberOfGates();
+
+        log::debug("Building e-graph");
+        EGraph egraph;
+        false_class_ = egraph.add({GateType::CONST_FALSE, {}});
+        true_class_  = egraph.add({GateType::CONST_TRUE, {}});
+        std::vector<EClassId> classes(size);
+        for (GateId const gateId : gate_sorting)
+        {
+            GateType const type = circuit->getGateType(gateId);
+            if (type == GateType::INPUT)
+            {
+                classes.at(gateId) = egraph.add({GateType::INPUT, {}, gateId});
+                continue;
+            }
+            std::vector<EClassId> children;
+            for (GateId const operand : circuit->getGateOperands(gateId))
+            {
+                children.push_back(classes.at(operand));
+            }
+            classes.at(gateId) = egraph.add({type, std::move(children)});
+        }
+
+        std::unordered_map<std::string_view, size_t> fired = saturate_(egraph);
+        log::debug(
+            "E-graph has ", egraph.getNumberOfClasses(), " classes and ", egraph.getNumberOfNodes(), " nodes");
+
+        log::debug("Extracting cheapest circuit");
+        std::vector<EClassId> output_classes;
+        for (GateId const output_gate : circuit->getOutputGates())
+        {
+            output_classes.push_back(egraph.find(classes.at(output_gate)));
+        }
+        std::vector<double> fanouts(egraph.getClassIdBound(), 0);
+        for (GateId const gateId : gate_sorting)
+        {
+            for (GateId const operand : circuit->getGateOperands(gateId))
+            {
+                fanouts.at(egraph.find(classes.at(operand))) += 1;
+            }
+        }
+        for (EClassId const output_class : output_classes)
+        {
+            fanouts.at(output_class) += 1;
+        }
+
+        std::vector<ENode const*> choice;
+        std::vector<EClassId> extracted;
+        size_t extracted_cost = std::numeric_limits<size_t>::max();
+        for (size_t round = 0; round < ExtractionRounds; ++round)
+        {
+            std::vector<ENode const*> round_choice = extract_(egraph, fanouts);
+            std::vector<EClassId> round_extracted  = collect_(egraph, round_choice, output_classes);
+            size_t round_cost                      = 0;
+            std::fill(fanouts.begin(), fanouts.end(), 0);
+            for (EClassId const id : round_extracted)
+            {
+                ENode const& node = *round_choice.at(id);
+                if (node.type != GateType::INPUT)
+                {
+                    round_cost += cost_model_.getGateCost(node.type, node.children.size());
+                }
+                for (EClassId const child : node.children)
+                {
+                    fanouts.at(egraph.find(child)) += 1;
+                }
+            }
+            for (EClassId const output_class : output_classes)
+            {
+                fanouts.at(output_class) += 1;
+            }
+            if (round_cost < extracted_cost)
+            {
+                choice         = std::move(round_choice);
+                extracted      = std::move(round_extracted);
+                extracted_cost = round_cost;
+            }
+        }
+
+        size_t const original_cost = getReachableCost_(*circuit);
+        if (extracted_cost >= original_cost)
+        {
+            log::debug("Extracted circuit costs ", extracted_cost, ", original circuit is kept");
+            log::debug("END EqualitySaturation");
+            log::debug("=========================================================================================");
+            return {std::move(circuit), std::move(encoder)};
+        }
+        log::debug("Cost is reduced from ", original_cost, " to ", extracted_cost);
+        for (auto const& [rule, times] : fired)
+        {
+            countRule(rule, times);
+        }
+
+        log::debug("Building extracted circuit");
+        GateInfoContainer gate_info = acquireGateInfoContainer(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            gate_info.at(gateId) = {
+                circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
+        }
+        // Class is implemented by gate of its first node, input gates are never replaced.
+        std::vector<GateId> owners(egraph.getClassIdBound(), std::numeric_limits<GateId>::max());
+        for (GateId const gateId : gate_sorting)
+        {
+            GateId& owner = owners.at(egraph.find(classes.at(gateId)));
+            if (owner == std::numeric_limits<GateId>::max() || circuit->getGateType(gateId) == GateType::INPUT)
+            {
+                owner = gateId;
+            }
+        }
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_EqualitySaturation@");
+        for (EClassId const id : extracted)
+        {
+            ENode const& node = *choice.at(id);
+            if (node.type == GateType::INPUT)
+            {
+                continue;
+            }
+            GateId& owner = owners.at(id);
+            if (owner == std::numeric_limits<GateId>::max())
+            {
+                owner = encoder->encodeGate(getNewGateName_(new_gate_name_prefix, gate_info.size()));
+                gate_info.emplace_back();
+            }
+            GateIdContainer operands = acquireGateIdContainer();
+            for (EClassId const child : node.children)
+            {
+                operands.push_back(owners.at(egraph.find(child)));
+            }
+            gate_info.at(owner) = {node.type, std::move(operands)};
+        }
+
+        GateIdContainer new_output_gates{};
+        new_output_gates.reserve(output_classes.size());
+        for (EClassId const output_class : output_classes)
+        {
+            new_output_gates.push_back(owners.at(output_class));
+        }
+
+        log::debug("END EqualitySaturation");
+        log::debug("=========================================================================================");
+        return {std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)), std::move(encoder)};
+    }
+
+private:
+    /* Applies rules until e-graph is saturated or limits are reached, returns numbers of applications of rules. */
+    std::unordered_map<std::string_view, size_t> saturate_(EGraph& egraph) const
+    {
+        std::unordered_map<std::string_view, size_t> fired;
+        size_t const node_limit = growth_ * egraph.getNumberOfNodes();
+        for (size_t iteration = 0; iteration < iterations_ && egraph.getNumberOfNodes() < node_limit; ++iteration)
+        {
+            // Rewrites are searched on rebuilt e-graph, and applied after search.
+            std::vector<Rewrite_> rewrites;
+            for (EClassId const id : egraph.getClasses())
+            {
+                for (ENode const& node : egraph.getNodes(id))
+                {
+                    searchRewrites_(egraph, id, node, rewrites);
+                }
+            }
+
+            size_t const number_of_nodes   = egraph.getNumberOfNodes();
+            size_t const number_of_classes = egraph.getNumberOfClasses();
+            for (Rewrite_ const& rewrite : rewrites)
+            {
+                if (rewrite.action != Action_::MERGE && egraph.getNumberOfNodes() >= node_limit)
+                {
+                    continue;
+                }
+                if (applyRewrite_(egraph, rewrite))
+                {
+                    ++fired[rewrite.rule];
+                }
+            }
+            egraph.rebuild();
+            log::debug(
+                "Iteration ", iteration, ": ", egraph.getNumberOfClasses(), " classes, ", egraph.getNumberOfNodes(),
+                " nodes");
+
+            if (number_of_nodes == egraph.getNumberOfNodes() && number_of_classes == egraph.getNumberOfClasses())
+            {
+                log::debug("E-graph is saturated");
+                break;
+            }
+        }
+        return fired;
+    }
+
+    /* Returns true iff class of rewrite is merged with another class. */
+    static bool applyRewrite_(EGraph& egraph, Rewrite_ const& rewrite)
+    {
+        EClassId result = 0;
+        switch (rewrite.action)
+        {
+            case Action_::MERGE:
+                result = rewrite.children.front();
+                break;
+            case Action_::NODE:
+                result = egraph.add({rewrite.type, rewrite.children});
+                break;
+            case Action_::NEGATED_OPERANDS:
+            {
+                std::vector<EClassId> negations;
+                negations.reserve(rewrite.children.size());
+                for (EClassId const child : rewrite.children)
+                {
+                    negations.push_back(egraph.add({GateType::NOT, {child}}));
+                }
+                result = egraph.add({rewrite.type, std::move(negations)});
+                break;
+            }
+            case Action_::NEGATED_NODE:
+                result = egraph.add({GateType::NOT, {egraph.add({rewrite.type, rewrite.children})}});
+                break;
+        }
+        return egraph.merge(rewrite.target, result);
+    }
+
+    /* Returns 0 or 1 for classes of constants, and -1 for other classes. */
+    [[nodiscard]]
+    int getConstant_(EGraph const& egraph, EClassId id) const
+    {
+        id = egraph.find(id);
+        if (id == egraph.find(false_class_))
+        {
+            return 0;
+        }
+        return id == egraph.find(true_class_) ? 1 : -1;
+    }
+
+    [[nodiscard]]
+    EClassId getConstantClass_(EGraph const& egraph, bool value) const
+    {
+        return egraph.find(value ? true_class_ : false_class_);
+    }
+
+    /* Returns gate type of negation of `type`, or UNDEFINED, if it can not be merged with NOT. */
+    static GateType negate_(GateType type) noexcept
+    {
+        switch (type)
+        {
+            case GateType::AND:
+                return GateType::NAND;
+            case GateType::NAND:
+                return GateType::AND;
+            case GateType::OR:
+                return GateType::NOR;
+            case GateType::NOR:
+                return GateType::OR;
+            case GateType::XOR:
+                return GateType::NXOR;
+            case GateType::NXOR:
+                return GateType::XOR;
+            default:
+                return GateType::UNDEFINED;
+        }
+    }
+
+    /* Appends rewrites of node `node` of class `id`, which are found by rules. */
+    void searchRewrites_(EGraph const& egraph, EClassId id, ENode const& node, std::vector<Rewrite_>& rewrites) const
+    {
+        switch (node.type)
+        {
+            case GateType::NOT:
+            {
+                EClassId const child = node.children.front();
+                if (int const constant = getConstant_(egraph, child); constant >= 0)
+                {
+                    EClassId const negation = getConstantClass_(egraph, constant == 0);
+                    rewrites.push_back({id, Action_::MERGE, node.type, {negation}, "constant_folding"});
+                    return;
+                }
+                for (ENode const& inner : egraph.getNodes(child))
+                {
+                    if (inner.type == GateType::NOT)
+                    {
+                        rewrites.push_back(
+                            {id, Action_::MERGE, node.type, {inner.children.front()}, "reduce_not_composition"});
+                    }
+                    else if (negate_(inner.type) != GateType::UNDEFINED)
+                    {
+                        rewrites.push_back(
+                            {id, Action_::NODE, negate_(inner.type), inner.children, "merge_not_with_others"});
+                    }
+                }
+                return;
+            }
+            case GateType::AND:
+            case GateType::NAND:
+            case GateType::OR:
+            case GateType::NOR:
+            case GateType::XOR:
+            case GateType::NXOR:
+                if (foldConstants_(egraph, id, node, rewrites))
+                {
+                    return;
+                }
+                if (node.type == GateType::NAND || node.type == GateType::NOR || node.type == GateType::NXOR)
+                {
+                    rewrites.push_back({id, Action_::NEGATED_NODE, negate_(node.type), node.children, "split_not"});
+                }
+                searchDeMorgan_(egraph, id, node, rewrites);
+                return;
+            case GateType::MUX:
+                if (int const constant = getConstant_(egraph, node.children.front()); constant >= 0)
+                {
+                    // Selector is the first operand, false selects the second one.
+                    EClassId const selected = node.children.at(static_cast<size_t>(constant) + 1);
+                    rewrites.push_back({id, Action_::MERGE, node.type, {selected}, "constant_folding"});
+                }
+                return;
+            case GateType::IFF:
+            case GateType::BUFF:
+                rewrites.push_back({id, Action_::MERGE, node.type, {node.children.front()}, "reduce_buffer"});
+                return;
+            default:
+                return;
+        }
+    }
+
+    /* Appends rewrite of symmetric node with constant operands, returns true iff it is found. */
+    bool foldConstants_(EGraph const& egraph, EClassId id, ENode const& node, std::vector<Rewrite_>& rewrites) const
+    {
+        bool const negated  = node.type == GateType::NAND || node.type == GateType::NOR || node.type == GateType::NXOR;
+        bool const parity   = node.type == GateType::XOR || node.type == GateType::NXOR;
+        GateType const base = negated ? negate_(node.type) : node.type;
+        // Value of operand, which determines value of gate, for AND and OR.
+        bool const dominant = base == GateType::OR;
+
+        std::vector<EClassId> rest;
+        bool found    = false;
+        bool inverted = negated;
+        for (EClassId const child : node.children)
+        {
+            int const constant = getConstant_(egraph, child);
+            if (constant < 0)
+            {
+                rest.push_back(child);
+                continue;
+            }
+            found = true;
+            if (parity)
+            {
+                inverted ^= constant == 1;
+            }
+            else if ((constant == 1) == dominant)
+            {
+                EClassId const value = getConstantClass_(egraph, dominant != negated);
+                rewrites.push_back({id, Action_::MERGE, node.type, {value}, "constant_folding"});
+                return true;
+            }
+        }
+        if (!found)
+        {
+            return false;
+        }
+
+        if (rest.empty())
+        {
+            // Empty XOR is false, and empty AND and OR are equal to their neutral operand.
+            bool const value = (parity ? false : !dominant) != inverted;
+            rewrites.push_back({id, Action_::MERGE, node.type, {getConstantClass_(egraph, value)}, "constant_folding"});
+        }
+        else if (rest.size() == 1)
+        {
+            if (inverted)
+            {
+                rewrites.push_back({id, Action_::NODE, GateType::NOT, std::move(rest), "constant_folding"});
+            }
+            else
+            {
+                rewrites.push_back({id, Action_::MERGE, node.type, std::move(rest), "constant_folding"});
+            }
+        }
+        else
+        {
+            GateType const type = inverted ? negate_(base) : base;
+            rewrites.push_back({id, Action_::NODE, type, std::move(rest), "constant_folding"});
+        }
+        return true;
+    }
+
+    /* Appends rewrites by de Morgan's laws, in both directions. */
+    static void searchDeMorgan_(EGraph const& egraph, EClassId id, ENode const& node, std::vector<Rewrite_>& rewrites)
+    {
+        if (node.type == GateType::NAND || node.type == GateType::NOR)
+        {
+            GateType const type = node.type == GateType::NAND ? GateType::OR : GateType::AND;
+            rewrites.push_back({id, Action_::NEGATED_OPERANDS, type, node.children, "de_morgan"});
+            return;
+        }
+        if (node.type != GateType::AND && node.type != GateType::OR)
+        {
+            return;
+        }
+
+        // AND(NOT(xs)) = NOR(xs) and OR(NOT(xs)) = NAND(xs).
+        std::vector<EClassId> negations;
+        for (EClassId const child : node.children)
+        {
+            std::vector<ENode> const& nodes = egraph.getNodes(child);
+            auto const it = std::find_if(
+                nodes.begin(), nodes.end(), [](ENode const& inner) { return inner.type == GateType::NOT; });
+            if (it == nodes.end())
+            {
+                return;
+            }
+            negations.push_back(it->children.front());
+        }
+        GateType const type = node.type == GateType::AND ? GateType::NOR : GateType::NAND;
+        rewrites.push_back({id, Action_::NODE, type, std::move(negations), "de_morgan"});
+    }
+
+    /* Returns node of each class, which has the least area flow, for classes, which have acyclic nodes. */
+    std::vector<ENode const*> extract_(EGraph const& egraph, std::vector<double> const& fanouts) const
+    {
+        // Nodes of all classes with their classes, each node waits for extraction of its distinct operands.
+        std::vector<std::pair<EClassId, ENode const*> > nodes;
+        std::vector<size_t> waiting;
+        std::vector<std::vector<size_t> > users(egraph.getClassIdBound());
+        for (EClassId const id : egraph.getClasses())
+        {
+            for (ENode const& node : egraph.getNodes(id))
+            {
+                std::vector<EClassId> children = node.children;
+                std::sort(children.begin(), children.end());
+                children.erase(std::unique(children.begin(), children.end()), children.end());
+                for (EClassId const child : children)
+                {
+                    users.at(child).push_back(nodes.size());
+                }
+                waiting.push_back(children.size());
+                nodes.emplace_back(id, &node);
+            }
+        }
+
+        std::vector<ENode const*> choice(egraph.getClassIdBound(), nullptr);
+        std::vector<double> costs(egraph.getClassIdBound(), 0);
+        auto const getCost = [&](ENode const& node)
+        {
+            auto cost = static_cast<double>(cost_model_.getGateCost(node.type, node.children.size()));
+            std::vector<EClassId> children = node.children;
+            std::sort(children.begin(), children.end());
+            children.erase(std::unique(children.begin(), children.end()), children.end());
+            for (EClassId const child : children)
+            {
+                cost += costs.at(child) / std::max(fanouts.at(child), 1.0);
+            }
+            return cost;
+        };
+
+        using Candidate = std::pair<double, size_t>;
+        std::priority_queue<Candidate, std::vector<Candidate>, std::greater<> > queue;
+        for (size_t i = 0; i < nodes.size(); ++i)
+        {
+            if (waiting.at(i) == 0)
+            {
+                queue.emplace(getCost(*nodes.at(i).second), i);
+            }
+        }
+        while (!queue.empty())
+        {
+            auto const [cost, i] = queue.top();
+            queue.pop();
+            auto const [id, node] = nodes.at(i);
+            if (choice.at(id) != nullptr)
+            {
+                continue;
+            }
+            choice.at(id) = node;
+            costs.at(id)  = cost;
+            for (size_t const user : users.at(id))
+            {
+                if (--waiting.at(user) == 0 && choice.at(nodes.at(user).first) == nullptr)
+                {
+                    queue.emplace(getCost(*nodes.at(user).second), user);
+                }
+            }
+        }
+        return choice;
+    }
+
+    /* Returns classes, reachable from outputs by chosen nodes, operands precede users. */
+    static std::vector<EClassId> collect_(
+        EGraph const& egraph,
+        std::vector<ENode const*> const& choice,
+        std::vector<EClassId> const& output_classes)
+    {
+        std::vector<EClassId> order;
+        std::vector<bool> visited(egraph.getClassIdBound(), false);
+        // Stack of classes with index of the next operand to visit.
+        std::vector<std::pair<EClassId, size_t> > stack;
+        for (EClassId const output_class : output_classes)
+        {
+            if (visited.at(output_class))
+            {
+                continue;
+            }
+            visited.at(output_class) = true;
+            stack.emplace_back(output_class, 0);
+            while (!stack.empty())
+            {
+                auto& [id, next] = stack.back();
+                std::vector<EClassId> const& children = choice.at(id)->children;
+                if (next == children.size())
+                {
+                    order.push_back(id);
+                    stack.pop_back();
+                    continue;
+                }
+                EClassId const child = egraph.find(children.at(next++));
+                if (!visited.at(child))
+                {
+                    visited.at(child) = true;
+                    stack.emplace_back(child, 0);
+                }
+            }
+        }
+        return order;
+    }
+
+    /* Returns cost of gates of circuit, which are reachable from outputs. */
+    [[nodiscard]]
+    size_t getReachableCost_(CircuitT const& circuit) const
+    {
+        size_t cost = 0;
+        std::vector<bool> visited(circuit.getNumberOfGates(), false);
+        GateIdContainer stack(circuit.getOutputGates().begin(), circuit.getOutputGates().end());
+        while (!stack.empty())
+        {
+            GateId const gateId = stack.back();
+            stack.pop_back();
+            if (visited.at(gateId))
+            {
+                continue;
+            }
+            visited.at(gateId) = true;
+            if (circuit.getGateType(gateId) != GateType::INPUT)
+            {
+                cost += cost_model_.getGateCost(circuit, gateId);
+            }
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                stack.push_back(operand);
+            }
+        }
+        return cost;
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_HIGH_EFFORT_EQUALITY_SATURATION_HPP
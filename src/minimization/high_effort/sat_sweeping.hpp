@@ -0,0 +1,342 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_HIGH_EFFORT_SAT_SWEEPING_HPP
+#define CIRBO_SEARCH_MINIMIZATION_HIGH_EFFORT_SAT_SWEEPING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/simulation.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+#include "sat/solver.hpp"
+#include "sat/tseitin.hpp"
+#include "utils/random.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Transformer, that merges functionally equivalent (up to complement) and constant gates.
+ *
+ * Gates are split into candidate classes by signatures of random bit-parallel simulation.
+ * Each candidate is proven or refuted by incremental SAT solver, which gets clauses only
+ * for cones of queried gates. Counterexamples, found by the solver, are added to signatures,
+ * so other wrong candidates of the same class are refuted without SAT calls. Proven gate
+ * is replaced by its representative (or NOT of it), proven constant is replaced by constant gate.
+ *
+ * Note that merged gates are left in circuit, so this algorithm must be followed by
+ * RedundantGatesCleaner (also ReduceNotComposition and DuplicateGatesCleaner are recommended).
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class SatSweeping_ : public ITransformer<CircuitT>
+{
+public:
+    /** Default number of 64-bit words in random simulation signatures. **/
+    static constexpr size_t DefaultWords = 4;
+    /** Default limit of conflicts for one SAT query. **/
+    static constexpr int64_t DefaultConflictLimit = 1000;
+
+private:
+    /* Representative of gate: gate itself, another gate or constant, up to complement. */
+    struct Representative_
+    {
+        GateId gate;
+        bool complement;
+        bool constant;
+    };
+
+    size_t words_;
+    int64_t conflict_limit_;
+    std::mt19937 engine_;
+
+    /* Per gate: value of gate in each counterexample, 64 counterexamples per word. */
+    std::vector<std::vector<uint64_t> > counterexamples_;
+    size_t number_of_counterexamples_ = 0;
+
+public:
+    /**
+     * @param words -- number of 64-bit words in random simulation signatures.
+     * @param conflict_limit -- limit of conflicts for one SAT query, candidate is kept unmerged if exceeded.
+     */
+    explicit SatSweeping_(size_t words = DefaultWords, int64_t conflict_limit = DefaultConflictLimit)
+        : words_(std::max<size_t>(words, 1))
+        , conflict_limit_(conflict_limit)
+        , engine_(utils::getNewMersenneTwisterEngine())
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START SatSweeping");
+
+        log::debug("Simulating circuit on random patterns");
+        Simulation simulation(*circuit, words_);
+        simulation.randomizeInputs(*circuit, engine_);
+        simulation.run(*circuit);
+
+        // Cones of gates are encoded on demand, when they are queried for the first time.
+        sat::Solver solver;
+        sat::TseitinEncoder tseitin(*circuit, solver);
+
+        counterexamples_.assign(circuit->getNumberOfGates(), {});
+        number_of_counterexamples_ = 0;
+        Simulation counterexample_simulation(*circuit, 1);
+
+        // Topsort, from inputs to outputs, so representatives always precede merged gates.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+
+        std::vector<Representative_> representatives(circuit->getNumberOfGates());
+        // Maps hash of normalized signature to gates, which are representatives of their classes.
+        std::unordered_map<uint64_t, GateIdContainer> classes;
+        for (GateId const gateId : gate_sorting)
+        {
+            representatives.at(gateId) = findRepresentative_(
+                *circuit, gateId, simulation, counterexample_simulation, tseitin, solver, classes);
+        }
+
+        log::debug("Merging proven gates");
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit->getNumberOfGates());
+        // Maps representative to a gate, which is proven to be its complement.
+        std::unordered_map<GateId, GateId> complements;
+        auto const redirect = [&representatives](GateId operand)
+        {
+            Representative_ const& representative = representatives.at(operand);
+            return representative.constant || representative.complement ? operand : representative.gate;
+        };
+        for (GateId const gateId : gate_sorting)
+        {
+            Representative_& representative = representatives.at(gateId);
+            if (representative.constant)
+            {
+                GateType const type  = representative.complement ? GateType::CONST_TRUE : GateType::CONST_FALSE;
+                gate_info.at(gateId) = {type, {}};
+                continue;
+            }
+            if (representative.complement)
+            {
+                auto [it, inserted] = complements.emplace(representative.gate, gateId);
+                if (inserted)
+                {
+                    gate_info.at(gateId) = {GateType::NOT, {representative.gate}};
+                    continue;
+                }
+                // Complement of representative is already built, users are redirected to it.
+                representative = {it->second, false, false};
+            }
+
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : circuit->getGateOperands(gateId))
+            {
+                operands.push_back(redirect(operand));
+            }
+            gate_info.at(gateId) = {circuit->getGateType(gateId), std::move(operands)};
+        }
+
+        GateIdContainer new_output_gates{};
+        new_output_gates.reserve(circuit->getOutputGates().size());
+        for (GateId const output_gate : circuit->getOutputGates())
+        {
+            new_output_gates.push_back(redirect(output_gate));
+        }
+
+        log::debug("END SatSweeping");
+        log::debug("=========================================================================================");
+        return {std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)), std::move(encoder)};
+    }
+
+private:
+    /* Returns representative of gate, proving candidates of its class. */
+    Representative_ findRepresentative_(
+        CircuitT const& circuit,
+        GateId gateId,
+        Simulation const& simulation,
+        Simulation& counterexample_simulation,
+        sat::TseitinEncoder& tseitin,
+        sat::Solver& solver,
+        std::unordered_map<uint64_t, GateIdContainer>& classes)
+    {
+        Representative_ const itself{gateId, false, false};
+        GateType const type = circuit.getGateType(gateId);
+        if (type == GateType::INPUT || type == GateType::CONST_FALSE || type == GateType::CONST_TRUE)
+        {
+            if (type == GateType::INPUT)
+            {
+                classes[hashSignature_(simulation, gateId)].push_back(gateId);
+            }
+            return itself;
+        }
+
+        // Signatures are normalized, so that the first simulated value is false.
+        bool const flipped = (simulation.getSignature(gateId)[0] & 1U) != 0;
+
+        if (isConstantCandidate_(simulation, gateId, flipped))
+        {
+            sat::Lit const lit = flipped ? ~tseitin.getLit(gateId) : tseitin.getLit(gateId);
+            sat::SolveResult const result = solver.solve({lit}, conflict_limit_);
+            if (result == sat::SolveResult::UNSAT)
+            {
+                log::debug("Gate ", gateId, " is constant ", flipped);
+                countRule("sat_constant");
+                solver.addClause({~lit});
+                return {gateId, flipped, true};
+            }
+            if (result == sat::SolveResult::SAT)
+            {
+                addCounterexample_(circuit, tseitin, counterexample_simulation);
+            }
+        }
+
+        GateIdContainer& candidates = classes[hashSignature_(simulation, gateId)];
+        for (GateId const candidate : candidates)
+        {
+            bool const complement = flipped != ((simulation.getSignature(candidate)[0] & 1U) != 0);
+            if (!isEquivalenceCandidate_(simulation, gateId, candidate, complement))
+            {
+                continue;
+            }
+
+            sat::Lit const gate_lit      = tseitin.getLit(gateId);
+            sat::Lit const candidate_lit = complement ? ~tseitin.getLit(candidate) : tseitin.getLit(candidate);
+            // Gates are equivalent iff neither `gate & !candidate` nor `!gate & candidate` is satisfiable.
+            sat::SolveResult result = solver.solve({gate_lit, ~candidate_lit}, conflict_limit_);
+            if (result == sat::SolveResult::UNSAT)
+            {
+                result = solver.solve({~gate_lit, candidate_lit}, conflict_limit_);
+            }
+            if (result == sat::SolveResult::UNSAT)
+            {
+                log::debug("Gate ", gateId, " is equivalent to ", complement ? "NOT " : "", candidate);
+                countRule("sat_equivalence");
+                // Proven equivalence simplifies next queries.
+                solver.addClause({~gate_lit, candidate_lit});
+                solver.addClause({gate_lit, ~candidate_lit});
+                return {candidate, complement, false};
+            }
+            if (result == sat::SolveResult::SAT)
+            {
+                addCounterexample_(circuit, tseitin, counterexample_simulation);
+            }
+        }
+        candidates.push_back(gateId);
+        return itself;
+    }
+
+    /* Returns hash of signature, invariant under complement. */
+    [[nodiscard]]
+    uint64_t hashSignature_(Simulation const& simulation, GateId gateId) const
+    {
+        uint64_t const* signature = simulation.getSignature(gateId);
+        uint64_t const mask       = (signature[0] & 1U) != 0 ? ~uint64_t{0} : 0;
+        uint64_t hash             = 0;
+        for (size_t word = 0; word < simulation.getNumberOfWords(); ++word)
+        {
+            hash ^= (signature[word] ^ mask) + 0x9e3779b97f4a7c15ULL + (hash << 6U) + (hash >> 2U);
+        }
+        return hash;
+    }
+
+    /* Returns true iff `gateId` takes value `flipped` on all patterns and counterexamples. */
+    [[nodiscard]]
+    bool isConstantCandidate_(Simulation const& simulation, GateId gateId, bool flipped) const
+    {
+        uint64_t const expected   = flipped ? ~uint64_t{0} : 0;
+        uint64_t const* signature = simulation.getSignature(gateId);
+        for (size_t word = 0; word < simulation.getNumberOfWords(); ++word)
+        {
+            if (signature[word] != expected)
+            {
+                return false;
+            }
+        }
+        std::vector<uint64_t> const& counterexamples = counterexamples_.at(gateId);
+        for (size_t word = 0; word < counterexamples.size(); ++word)
+        {
+            if (((counterexamples[word] ^ expected) & getCounterexampleMask_(word)) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* Returns true iff gates take equal (or opposite if `complement`) values on all patterns and counterexamples. */
+    [[nodiscard]]
+    bool isEquivalenceCandidate_(Simulation const& simulation, GateId lhs, GateId rhs, bool complement) const
+    {
+        uint64_t const expected = complement ? ~uint64_t{0} : 0;
+        for (size_t word = 0; word < simulation.getNumberOfWords(); ++word)
+        {
+            if ((simulation.getSignature(lhs)[word] ^ simulation.getSignature(rhs)[word]) != expected)
+            {
+                return false;
+            }
+        }
+        std::vector<uint64_t> const& lhs_counterexamples = counterexamples_.at(lhs);
+        std::vector<uint64_t> const& rhs_counterexamples = counterexamples_.at(rhs);
+        for (size_t word = 0; word < lhs_counterexamples.size(); ++word)
+        {
+            uint64_t const difference = lhs_counterexamples[word] ^ rhs_counterexamples[word] ^ expected;
+            if ((difference & getCounterexampleMask_(word)) != 0)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* Returns mask of valid counterexample bits in word `word`. */
+    [[nodiscard]]
+    uint64_t getCounterexampleMask_(size_t word) const noexcept
+    {
+        size_t const bits = number_of_counterexamples_ - (word * 64);
+        return bits >= 64 ? ~uint64_t{0} : (uint64_t{1} << bits) - 1;
+    }
+
+    /* Stores values of all gates on inputs of the last model as new counterexample. */
+    void addCounterexample_(
+        CircuitT const& circuit,
+        sat::TseitinEncoder const& tseitin,
+        Simulation& counterexample_simulation)
+    {
+        size_t const word = number_of_counterexamples_ / 64;
+        size_t const bit  = number_of_counterexamples_ % 64;
+        // Inputs outside of encoded cones do not affect queried gates, so any their value is good.
+        for (GateId const input : circuit.getInputGates())
+        {
+            counterexample_simulation.setInputValue(input, bit, tseitin.getModelValue(input));
+        }
+        counterexample_simulation.run(circuit);
+
+        for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+        {
+            std::vector<uint64_t>& counterexamples = counterexamples_.at(gateId);
+            if (bit == 0)
+            {
+                counterexamples.push_back(0);
+            }
+            counterexamples[word] = counterexample_simulation.getSignature(gateId)[0];
+        }
+        ++number_of_counterexamples_;
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_HIGH_EFFORT_SAT_SWEEPING_HPP
@@ -0,0 +1,631 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_CUT_REWRITING_HPP
+#define CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_CUT_REWRITING_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "core/algo.hpp"
+#include "core/cost_model.hpp"
+#include "core/cut_enumeration.hpp"
+#include "core/npn.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+#include "synthesis/exact_synthesis.hpp"
+#include "synthesis/synthesis_cache.hpp"
+#include "utils/cast.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Library of minimum circuits of functions of at most 4 inputs. Circuits of
+ * NPN classes are taken from precomputed database of optimal circuits (see
+ * `app/cirbo_db_generator.cpp`), if it is given. Negations of inputs and
+ * output cost NOT gates, so function, which differs from its class
+ * representative by negations, or whose class is missing in database, is
+ * also synthesized exactly, which is solved once per permutation class (see
+ * `synthesis::ExactSynthesizer`). Result of each function is memoized.
+ *
+ * Library is thread safe, so it may be shared by transformers and threads.
+ * Without database, library is generated on demand, so `getDefault` library
+ * of basis is shared by all passes of process, and each function is
+ * synthesized once per process.
+ */
+class RewritingLibrary
+{
+public:
+    static constexpr size_t MaxInputs = 4;
+    /** Default maximum size of synthesized circuit. **/
+    static constexpr size_t DefaultMaxGates = 7;
+    /** Default limit of conflicts for one SAT query. **/
+    static constexpr int64_t DefaultConflictLimit = 1000;
+
+private:
+    Basis basis_;
+    std::shared_ptr<circuits_db::CircuitDatabase const> database_;
+    size_t max_gates_;
+    int64_t conflict_limit_;
+    std::shared_ptr<synthesis::SynthesisCache> cache_;
+    /* Guards `circuits_`, nodes of map are stable, so returned pointers stay valid. */
+    mutable std::mutex mutex_;
+    std::map<std::pair<size_t, uint64_t>, std::optional<circuits_db::DatabaseCircuit> > circuits_;
+
+public:
+    /**
+     * @param basis -- basis of circuits.
+     * @param database -- optional database of optimal circuits.
+     * @param max_gates -- maximum size of synthesized circuit.
+     * @param conflict_limit -- limit of conflicts for one SAT query, function is left without circuit if exceeded.
+     */
+    explicit RewritingLibrary(
+        Basis basis                                                  = Basis::BENCH,
+        std::shared_ptr<circuits_db::CircuitDatabase const> database = nullptr,
+        size_t max_gates                                             = DefaultMaxGates,
+        int64_t conflict_limit                                       = DefaultConflictLimit)
+        : basis_(basis)
+        , database_(std::move(database))
+        , max_gates_(max_gates)
+        , conflict_limit_(conflict_limit)
+        , cache_(std::make_shared<synthesis::SynthesisCache>())
+    {
+    }
+
+    /**
+     * @return library of basis with default limits and without database, shared by all its users in process.
+     */
+    [[nodiscard]]
+    static std::shared_ptr<RewritingLibrary> getDefault(Basis basis)
+    {
+        static std::mutex mutex;
+        static std::map<Basis, std::shared_ptr<RewritingLibrary> > libraries;
+        std::lock_guard const lock(mutex);
+        auto& library = libraries[basis];
+        if (library == nullptr)
+        {
+            library = std::make_shared<RewritingLibrary>(basis);
+        }
+        return library;
+    }
+
+    [[nodiscard]]
+    Basis getBasis() const noexcept
+    {
+        return basis_;
+    }
+
+    /**
+     * @param truth -- masked truth table of function, in the format of `core/npn.hpp`.
+     * @param inputs -- number of inputs, at most `MaxInputs`.
+     * @return minimum known circuit of function, or nullptr if it is not known.
+     */
+    circuits_db::DatabaseCircuit const* getCircuit(uint64_t truth, size_t inputs)
+    {
+        std::pair<size_t, uint64_t> const key{inputs, truth};
+        {
+            std::lock_guard const lock(mutex_);
+            if (auto const it = circuits_.find(key); it != circuits_.end())
+            {
+                return it->second.has_value() ? &*it->second : nullptr;
+            }
+        }
+        // Synthesis is not guarded, so threads look other functions up meanwhile. If two threads
+        // synthesize the same function, the first result is kept.
+        std::optional<circuits_db::DatabaseCircuit> circuit = findCircuit_(truth, inputs);
+        std::lock_guard const lock(mutex_);
+        auto const it = circuits_.try_emplace(key, std::move(circuit)).first;
+        return it->second.has_value() ? &*it->second : nullptr;
+    }
+
+private:
+    std::optional<circuits_db::DatabaseCircuit> findCircuit_(uint64_t truth, size_t inputs)
+    {
+        std::optional<circuits_db::DatabaseCircuit> result;
+        if (database_ != nullptr)
+        {
+            npn::CanonicalForm const form = npn::canonize(truth, inputs);
+            if (auto const view = database_->find(basis_, form.truth, inputs); view.has_value())
+            {
+                result = circuits_db::restoreCircuit(view->toCircuit(), form.transform);
+                if (form.transform.phase == 0 && !form.transform.output_negated)
+                {
+                    return result;
+                }
+            }
+        }
+        if (result.has_value() && result->gates.empty())
+        {
+            return result;
+        }
+        // Only circuits smaller than the restored one are searched for.
+        size_t const limit = result.has_value() ? result->gates.size() - 1 : max_gates_;
+        auto synthesized =
+            synthesis::ExactSynthesizer(basis_, limit, conflict_limit_, 1, cache_).synthesize(truth, inputs);
+        return synthesized.has_value() ? synthesized : result;
+    }
+};
+
+/**
+ * Transformer, that rewrites gates by minimum circuits of their cut functions,
+ * as DAG-aware rewriting of ABC does.
+ *
+ * Gates are visited from inputs to outputs. For each gate and each of its
+ * 4-input priority cuts, minimum circuit of cut function is taken from
+ * `RewritingLibrary`. Gain is the cost of gates in maximum fanout-free cone
+ * of the gate (found by reference counting, bounded by cut leaves), which are
+ * removed, minus the cost of gates of library circuit, which are not found
+ * in structural hash table of circuit and must be added. Costs are given by
+ * `CostModel`, which counts gates by default. Gate is replaced in
+ * place by the best library circuit with positive gain, and its users are
+ * redirected to the new root. Functions of gates never change, so cuts of the
+ * original circuit stay valid, only cuts with removed leaves are skipped.
+ *
+ * Each gate is visited once, and work per gate is bounded by the number of
+ * cuts, so time is near linear in size of circuit.
+ *
+ * Note that replaced gates are left in circuit, so this algorithm must be followed
+ * by RedundantGatesCleaner and DuplicateGatesCleaner, and preceded by
+ * RedundantGatesCleaner, since dangling gates are counted as users.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class CutRewriting_ : public ITransformer<CircuitT>
+{
+public:
+    static constexpr size_t DefaultCutLimit = CutEnumeration::DefaultCutLimit;
+
+private:
+    /* Key of structural hash table: type and operands (sorted for symmetric types) of gate of arity at most 3. */
+    struct Key_
+    {
+        GateType type;
+        uint8_t arity;
+        std::array<GateId, 3> operands;
+
+        bool operator==(Key_ const&) const = default;
+    };
+
+    struct KeyHash_
+    {
+        size_t operator()(Key_ const& key) const noexcept
+        {
+            size_t hash = static_cast<size_t>(key.type) + (static_cast<size_t>(key.arity) << 8U);
+            for (size_t i = 0; i < key.arity; ++i)
+            {
+                hash ^= key.operands[i] + 0x9e3779b97f4a7c15ULL + (hash << 6U) + (hash >> 2U);
+            }
+            return hash;
+        }
+    };
+
+    /* Gate of library circuit, mapped to circuit: existing gate, or gate, which is to be added. */
+    struct MappedGate_
+    {
+        GateId gate;
+        bool exists;
+    };
+
+    /* Circuit, which is rewritten in place, with reference counts and structural hash table. */
+    struct Network_
+    {
+        GateInfoContainer gate_info;
+        /* Number of users of each gate, outputs of circuit included. */
+        std::vector<uint32_t> references;
+        std::vector<GateIdContainer> users;
+        std::vector<bool> removed;
+        GateIdContainer outputs;
+        std::unordered_map<Key_, GateId, KeyHash_> table;
+    };
+
+    std::shared_ptr<RewritingLibrary> library_;
+    size_t cut_limit_;
+    CostModel cost_model_;
+
+public:
+    /**
+     * @param library -- library of minimum circuits, defines basis of new gates, may be shared by transformers.
+     *                  By default, shared library of BENCH basis is used, see `RewritingLibrary::getDefault`.
+     * @param cut_limit -- maximum number of 4-input priority cuts per gate.
+     * @param cost_model -- costs of gates, gates are counted by default.
+     */
+    explicit CutRewriting_(
+        std::shared_ptr<RewritingLibrary> library = RewritingLibrary::getDefault(Basis::BENCH),
+        size_t cut_limit                          = DefaultCutLimit,
+        CostModel cost_model                      = CostModel::gateCount())
+        : library_(std::move(library))
+        , cut_limit_(std::max<size_t>(cut_limit, 1))
+        , cost_model_(cost_model)
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START CutRewriting");
+
+        log::debug("Enumerating cuts");
+        CutEnumeration const cuts(*circuit, RewritingLibrary::MaxInputs, cut_limit_);
+        // Topsort, from inputs to outputs.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+
+        Network_ network = buildNetwork_(*circuit);
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_CutRewriting@");
+
+        log::debug("Rewriting gates");
+        for (GateId const gateId : gate_sorting)
+        {
+            GateType const type = circuit->getGateType(gateId);
+            if (network.removed[gateId] || type == GateType::INPUT || type == GateType::CONST_FALSE ||
+                type == GateType::CONST_TRUE)
+            {
+                continue;
+            }
+            rewriteGate_(network, gateId, cuts.getCuts(gateId), *encoder, new_gate_name_prefix);
+        }
+
+        log::debug("END CutRewriting");
+        log::debug("=========================================================================================");
+        return {
+            std::make_unique<CircuitT>(std::move(network.gate_info), std::move(network.outputs)), std::move(encoder)};
+    }
+
+private:
+    static Network_ buildNetwork_(CircuitT const& circuit)
+    {
+        Network_ network;
+        size_t const size = circuit.getNumberOfGates();
+        network.gate_info = acquireGateInfoContainer(size);
+        network.references.assign(size, 0);
+        network.users.resize(size);
+        network.removed.assign(size, false);
+        network.outputs = circuit.getOutputGates();
+        network.table.reserve(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            network.gate_info.at(gateId) = {
+                circuit.getGateType(gateId), acquireGateIdContainer(circuit.getGateOperands(gateId))};
+            network.users[gateId] = acquireGateIdContainer(circuit.getGateUsers(gateId));
+            // Operands are counted with multiplicity, as `dereference_` does.
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                ++network.references.at(operand);
+            }
+            if (auto const key = makeKey_(network.gate_info[gateId]); key.has_value())
+            {
+                network.table.try_emplace(*key, gateId);
+            }
+        }
+        for (GateId const output : network.outputs)
+        {
+            ++network.references.at(output);
+        }
+        return network;
+    }
+
+    /* Returns structural hash key of gate, if it is hashed. */
+    static std::optional<Key_> makeKey_(GateInfo const& info)
+    {
+        GateIdContainer const& operands = info.getOperands();
+        if (operands.empty() || operands.size() > 3 || info.getType() == GateType::INPUT)
+        {
+            return std::nullopt;
+        }
+        Key_ key{info.getType(), static_cast<uint8_t>(operands.size()), {}};
+        std::copy(operands.begin(), operands.end(), key.operands.begin());
+        // Operands of symmetric gates are sorted by `GateInfo`.
+        return key;
+    }
+
+    /* Returns existing gate with type and operands, if it is not removed. */
+    static std::optional<GateId> findGate_(
+        Network_ const& network,
+        GateType type,
+        std::span<GateId const> operands)
+    {
+        Key_ key{type, static_cast<uint8_t>(operands.size()), {}};
+        std::copy(operands.begin(), operands.end(), key.operands.begin());
+        if (utils::symmetricOperatorQ(type))
+        {
+            std::sort(key.operands.begin(), key.operands.begin() + key.arity);
+        }
+        auto const it = network.table.find(key);
+        if (it == network.table.end() || network.removed[it->second])
+        {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    /**
+     * Dereferences operands of gate, recursively, and returns the cost of gates
+     * (gate itself included), which lose all references, so they are removed with
+     * the gate. Cone is bounded by `leaves`, if they are given.
+     */
+    static size_t dereference_(
+        Network_& network,
+        GateId gateId,
+        std::span<GateId const> leaves,
+        CostModel const& cost_model)
+    {
+        GateInfo const& info = network.gate_info[gateId];
+        size_t cost          = cost_model.getGateCost(info.getType(), info.getOperands().size());
+        for (GateId const operand : info.getOperands())
+        {
+            if (--network.references[operand] == 0 && isRemovable_(network, operand, leaves))
+            {
+                cost += dereference_(network, operand, leaves, cost_model);
+            }
+        }
+        return cost;
+    }
+
+    /* Reverts `dereference_`. */
+    static void reference_(Network_& network, GateId gateId, std::span<GateId const> leaves)
+    {
+        for (GateId const operand : network.gate_info[gateId].getOperands())
+        {
+            if (network.references[operand]++ == 0 && isRemovable_(network, operand, leaves))
+            {
+                reference_(network, operand, leaves);
+            }
+        }
+    }
+
+    static bool isRemovable_(Network_ const& network, GateId gateId, std::span<GateId const> leaves)
+    {
+        return network.gate_info[gateId].getType() != GateType::INPUT &&
+               std::ranges::find(leaves, gateId) == leaves.end();
+    }
+
+    /* Removes gate, which lost all references, and gates of its cone, which lost all references too. */
+    static void remove_(Network_& network, GateId gateId)
+    {
+        network.removed[gateId] = true;
+        if (auto const key = makeKey_(network.gate_info[gateId]); key.has_value())
+        {
+            auto const it = network.table.find(*key);
+            if (it != network.table.end() && it->second == gateId)
+            {
+                network.table.erase(it);
+            }
+        }
+        for (GateId const operand : network.gate_info[gateId].getOperands())
+        {
+            if (--network.references[operand] == 0 && network.gate_info[operand].getType() != GateType::INPUT)
+            {
+                remove_(network, operand);
+            }
+        }
+    }
+
+    /**
+     * Maps library circuit of cut function onto circuit: its gates are mapped to
+     * existing gates, when they are found in structural hash table, or are marked
+     * as gates to be added.
+     *
+     * @return cost of gates to be added.
+     */
+    static size_t countAddedGates_(
+        Network_ const& network,
+        circuits_db::DatabaseCircuit const& library_circuit,
+        std::span<GateId const> leaves,
+        GateId gateId,
+        CostModel const& cost_model)
+    {
+        size_t added   = 0;
+        auto const add = [&](GateType type, std::span<MappedGate_ const> operands) -> MappedGate_
+        {
+            std::array<GateId, 3> gates{};
+            bool exists = true;
+            for (size_t i = 0; i < operands.size(); ++i)
+            {
+                gates[i] = operands[i].gate;
+                exists   = exists && operands[i].exists;
+            }
+            std::optional<GateId> const found =
+                exists ? findGate_(network, type, std::span<GateId const>(gates.data(), operands.size()))
+                       : std::nullopt;
+            // Gates of the removed cone have no references, they are counted as added, if reused.
+            if (found.has_value() && *found != gateId && network.references[*found] > 0)
+            {
+                return {*found, true};
+            }
+            added += cost_model.getGateCost(type, operands.size());
+            return {0, false};
+        };
+
+        std::vector<MappedGate_> nodes;
+        for (GateId const leaf : leaves)
+        {
+            nodes.push_back({leaf, true});
+        }
+        for (circuits_db::GateRecord const& gate : library_circuit.gates)
+        {
+            std::array<MappedGate_, 3> operands{};
+            for (size_t i = 0; i < gate.arity; ++i)
+            {
+                operands[i] = nodes[gate.operands[i]];
+            }
+            nodes.push_back(add(gate.type, std::span<MappedGate_ const>(operands.data(), gate.arity)));
+        }
+        return added;
+    }
+
+    void rewriteGate_(
+        Network_& network,
+        GateId gateId,
+        std::span<Cut const> cuts,
+        NameEncoder& encoder,
+        std::string const& new_gate_name_prefix)
+    {
+        size_t best_gain                                 = 0;
+        Cut const* best_cut                              = nullptr;
+        circuits_db::DatabaseCircuit const* best_circuit = nullptr;
+
+        for (Cut const& cut : cuts)
+        {
+            auto const leaves = cut.getLeaves();
+            if ((leaves.size() == 1 && leaves.front() == gateId) ||
+                std::ranges::any_of(leaves, [&network](GateId leaf) { return network.removed[leaf]; }))
+            {
+                continue;
+            }
+            uint64_t const truth              = cut.truth[0] & npn::getTruthMask(leaves.size());
+            auto const* const library_circuit = library_->getCircuit(truth, leaves.size());
+            if (library_circuit == nullptr)
+            {
+                continue;
+            }
+
+            size_t const removed = dereference_(network, gateId, leaves, cost_model_);
+            size_t const added   = countAddedGates_(network, *library_circuit, leaves, gateId, cost_model_);
+            reference_(network, gateId, leaves);
+
+            if (removed > added && removed - added > best_gain)
+            {
+                best_gain    = removed - added;
+                best_cut     = &cut;
+                best_circuit = library_circuit;
+            }
+        }
+        if (best_cut == nullptr)
+        {
+            return;
+        }
+
+        log::debug("Gate ", gateId, " is rewritten with cost ", best_gain, " less");
+        countRule("cut_rewritten");
+        GateId const root =
+            buildCircuit_(network, *best_circuit, best_cut->getLeaves(), gateId, encoder, new_gate_name_prefix);
+        replaceGate_(network, gateId, root);
+    }
+
+    /* Adds gates of library circuit, which are not found in structural hash table, and returns its root. */
+    static GateId buildCircuit_(
+        Network_& network,
+        circuits_db::DatabaseCircuit const& library_circuit,
+        std::span<GateId const> leaves,
+        GateId gateId,
+        NameEncoder& encoder,
+        std::string const& new_gate_name_prefix)
+    {
+        std::vector<GateId> library_nodes(leaves.begin(), leaves.end());
+        auto const create = [&](GateType type, GateIdContainer operands) -> GateId
+        {
+            // Replaced gate itself is never reused, since its users are redirected to the root.
+            if (auto const found = findGate_(network, type, operands); found.has_value() && *found != gateId)
+            {
+                return *found;
+            }
+            GateId const id = encoder.encodeGate(getNewGateName_(new_gate_name_prefix, network.gate_info.size()));
+            for (GateId const operand : operands)
+            {
+                ++network.references.at(operand);
+                network.users.at(operand).push_back(id);
+            }
+            network.gate_info.emplace_back(type, std::move(operands));
+            network.references.push_back(0);
+            network.users.push_back(acquireGateIdContainer());
+            network.removed.push_back(false);
+            if (auto const key = makeKey_(network.gate_info.back()); key.has_value())
+            {
+                network.table.try_emplace(*key, id);
+            }
+            return id;
+        };
+
+        for (circuits_db::GateRecord const& gate : library_circuit.gates)
+        {
+            GateIdContainer operands = acquireGateIdContainer();
+            for (size_t i = 0; i < gate.arity; ++i)
+            {
+                operands.push_back(library_nodes[gate.operands[i]]);
+            }
+            library_nodes.push_back(create(gate.type, std::move(operands)));
+        }
+        return library_nodes[library_circuit.output];
+    }
+
+    /* Redirects users and outputs of gate to `replacement` and removes the cone of gate. */
+    static void replaceGate_(Network_& network, GateId gateId, GateId replacement)
+    {
+        GateIdContainer const users = std::move(network.users[gateId]);
+        network.users[gateId]       = acquireGateIdContainer();
+        for (GateId const user : users)
+        {
+            if (network.removed[user])
+            {
+                continue;
+            }
+            GateInfo& info = network.gate_info[user];
+            if (std::ranges::find(info.getOperands(), gateId) == info.getOperands().end())
+            {
+                continue;
+            }
+            if (auto const key = makeKey_(info); key.has_value())
+            {
+                auto const it = network.table.find(*key);
+                if (it != network.table.end() && it->second == user)
+                {
+                    network.table.erase(it);
+                }
+            }
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : info.getOperands())
+            {
+                if (operand == gateId)
+                {
+                    operands.push_back(replacement);
+                    ++network.references[replacement];
+                    --network.references[gateId];
+                }
+                else
+                {
+                    operands.push_back(operand);
+                }
+            }
+            info = {info.getType(), std::move(operands)};
+            network.users[replacement].push_back(user);
+            if (auto const key = makeKey_(info); key.has_value())
+            {
+                network.table.try_emplace(*key, user);
+            }
+        }
+        for (GateId& output : network.outputs)
+        {
+            if (output == gateId)
+            {
+                output = replacement;
+                ++network.references[replacement];
+                --network.references[gateId];
+            }
+        }
+        if (network.references[gateId] == 0)
+        {
+            remove_(network, gateId);
+        }
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_CUT_REWRITING_HPP
@@ -0,0 +1,714 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_DONT_CARE_OPTIMIZATION_HPP
+#define CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_DONT_CARE_OPTIMIZATION_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "core/algo.hpp"
+#include "core/cost_model.hpp"
+#include "core/npn.hpp"
+#include "core/simulation.hpp"
+#include "core/sop.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/local_search/window.hpp"
+#include "minimization/transformer_base.hpp"
+#include "sat/solver.hpp"
+#include "sat/tseitin.hpp"
+#include "utils/random.hpp"
+
+namespace cirbo::minimization
+{
+
+namespace impl
+{
+
+/**
+ * Re-expression of `root`, which is correct under don't cares: `gates` refer
+ * to divisors (first indices) and previous gates, the last gate computes
+ * root. Without gates root is replaced by the first divisor. Maximum
+ * fanout-free cone `mffc` of root is removed, so cost is decreased by `gain`.
+ */
+struct DontCareCandidate_
+{
+    GateId root = 0;
+    std::vector<GateId> mffc;
+    std::vector<GateId> divisors;
+    std::vector<circuits_db::GateRecord> gates;
+    size_t gain = 0;
+};
+
+}  // namespace impl
+
+/**
+ * Transformer, that re-expresses gates under their satisfiability and
+ * observability don't cares.
+ *
+ * Window of each gate is grown towards inputs, reconvergence-driven, up to
+ * `max_inputs` leaves, and fanout window is grown towards outputs up to
+ * `levels` levels of users. Care set of gate is the set of assignments of
+ * leaves, which appear in random bit-parallel simulation (satisfiability don't
+ * cares are the others) on patterns, where flipping the gate changes some
+ * gate on the boundary of fanout window (observability don't cares are the
+ * others, found by re-simulation of fanout window). Gate is then replaced by
+ * a divisor of window (or its negation), which agrees with it on the care
+ * set, or by factored form of irredundant sum of products of incompletely
+ * specified function (see `core/sop.hpp`), if it costs less than its
+ * maximum fanout-free cone. Costs are given by `CostModel`, which counts
+ * gates by default.
+ *
+ * Simulation may miss care assignments, so every change is validated by
+ * incremental SAT solver: values on the boundary of fanout window must be
+ * preserved for all assignments of inputs. Changes are validated one by one
+ * against the circuit with all previous changes, so they are compatible.
+ * Windows, which intersect committed changes, are skipped, hence the pass
+ * is sequential.
+ *
+ * Note that replaced gates are left in circuit, so this algorithm must be followed
+ * by RedundantGatesCleaner (before ConstantGateReducer, which may be needed for new
+ * constants) and DuplicateGatesCleaner, and preceded by RedundantGatesCleaner, since
+ * dangling gates are counted as users.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class DontCareOptimization_ : public ITransformer<CircuitT>
+{
+public:
+    static constexpr size_t MaxInputs        = 12;
+    static constexpr size_t DefaultMaxInputs = 8;
+    static constexpr size_t DefaultLevels    = 3;
+    /** Maximum number of gates in fanout window. **/
+    static constexpr size_t MaxFanoutGates = 64;
+    /** Default number of 64-bit words in random simulation signatures. **/
+    static constexpr size_t DefaultWords = 16;
+    /** Default limit of conflicts for one SAT query. **/
+    static constexpr int64_t DefaultConflictLimit = 1000;
+
+private:
+    size_t max_inputs_;
+    size_t levels_;
+    size_t words_;
+    int64_t conflict_limit_;
+    CostModel cost_model_;
+    std::mt19937 engine_;
+
+public:
+    /**
+     * @param max_inputs -- maximum number of window leaves, at most `MaxInputs`.
+     * @param levels -- number of levels of users in fanout window.
+     * @param words -- number of 64-bit words in random simulation signatures.
+     * @param conflict_limit -- limit of conflicts for one SAT query, change is rejected if exceeded.
+     * @param cost_model -- costs of gates, gates are counted by default.
+     */
+    explicit DontCareOptimization_(
+        size_t max_inputs      = DefaultMaxInputs,
+        size_t levels          = DefaultLevels,
+        size_t words           = DefaultWords,
+        int64_t conflict_limit = DefaultConflictLimit,
+        CostModel cost_model   = CostModel::gateCount())
+        : max_inputs_(std::clamp<size_t>(max_inputs, 1, MaxInputs))
+        , levels_(std::max<size_t>(levels, 1))
+        , words_(std::max<size_t>(words, 1))
+        , conflict_limit_(conflict_limit)
+        , cost_model_(cost_model)
+        , engine_(utils::getNewMersenneTwisterEngine())
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START DontCareOptimization");
+
+        log::debug("Simulating circuit on random patterns");
+        Simulation simulation(*circuit, words_);
+        simulation.randomizeInputs(*circuit, engine_);
+        simulation.run(*circuit);
+
+        // Topsort, from inputs to outputs.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+        size_t const size = circuit->getNumberOfGates();
+        std::vector<size_t> position(size);
+        for (size_t i = 0; i < gate_sorting.size(); ++i)
+        {
+            position.at(gate_sorting[i]) = i;
+        }
+
+        // Solver encodes original circuit on demand, literals of changed gates are overridden.
+        sat::Solver solver;
+        sat::TseitinEncoder tseitin(*circuit, solver);
+        std::vector<sat::Lit> lits(size);
+        auto const get_lit = [&](GateId gateId)
+        { return lits[gateId] == sat::Lit{} ? tseitin.getLit(gateId) : lits[gateId]; };
+
+        log::debug("Optimizing gates under don't cares");
+        impl::WindowScratch_ scratch(*circuit);
+        // Gates, whose values or definitions are changed, and gates, which are used by new definitions.
+        std::vector<bool> taken(size, false);
+        std::vector<bool> used(size, false);
+        std::vector<impl::DontCareCandidate_> committed;
+        for (GateId const root : gate_sorting)
+        {
+            if (taken[root])
+            {
+                continue;
+            }
+            std::vector<GateId> fanout = collectFanout_(*circuit, root, position);
+            std::optional<impl::DontCareCandidate_> candidate =
+                findCandidate_(*circuit, root, fanout, position, simulation, scratch, taken, used);
+            if (!candidate.has_value())
+            {
+                continue;
+            }
+            if (!validate_(*circuit, *candidate, fanout, solver, get_lit, lits))
+            {
+                countRule("dont_care_rejected");
+                continue;
+            }
+
+            log::debug("Gate ", root, " is re-expressed under don't cares with gain ", candidate->gain);
+            bool const substitution = candidate->divisors.size() == 1 && candidate->gates.size() <= 1;
+            countRule(substitution ? "dont_care_substitution" : "dont_care_resynthesis");
+            taken[root] = true;
+            for (GateId const gateId : candidate->mffc)
+            {
+                taken[gateId] = true;
+            }
+            for (GateId const gateId : fanout)
+            {
+                taken[gateId] = true;
+            }
+            for (GateId const gateId : candidate->divisors)
+            {
+                used[gateId] = true;
+            }
+            committed.push_back(std::move(*candidate));
+        }
+
+        GateInfoContainer gate_info = acquireGateInfoContainer(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            gate_info.at(gateId) = {
+                circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
+        }
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_DontCareOptimization@");
+        // Gate, which is replaced by divisor, is redirected to it.
+        std::vector<GateId> redirections(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            redirections[gateId] = gateId;
+        }
+        for (impl::DontCareCandidate_ const& candidate : committed)
+        {
+            commit_(candidate, gate_info, redirections, *encoder, new_gate_name_prefix);
+        }
+
+        auto const resolve = [&redirections](GateId gateId)
+        {
+            while (gateId < redirections.size() && redirections[gateId] != gateId)
+            {
+                gateId = redirections[gateId];
+            }
+            return gateId;
+        };
+        for (auto& info : gate_info)
+        {
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : info.getOperands())
+            {
+                operands.push_back(resolve(operand));
+            }
+            info = {info.getType(), std::move(operands)};
+        }
+        GateIdContainer new_output_gates{};
+        new_output_gates.reserve(circuit->getOutputGates().size());
+        for (GateId const output_gate : circuit->getOutputGates())
+        {
+            new_output_gates.push_back(resolve(output_gate));
+        }
+
+        log::debug("END DontCareOptimization");
+        log::debug("=========================================================================================");
+        return {std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)), std::move(encoder)};
+    }
+
+private:
+    /* Returns users of root up to `levels_` levels, at most `MaxFanoutGates`, in topological order. */
+    std::vector<GateId> collectFanout_(
+        CircuitT const& circuit,
+        GateId root,
+        std::vector<size_t> const& position) const
+    {
+        std::vector<GateId> fanout;
+        std::vector<GateId> frontier{root};
+        for (size_t level = 0; level < levels_ && !frontier.empty(); ++level)
+        {
+            std::vector<GateId> next;
+            for (GateId const gateId : frontier)
+            {
+                for (GateId const user : circuit.getGateUsers(gateId))
+                {
+                    if (fanout.size() < MaxFanoutGates && impl::isWindowGate_(circuit, user) &&
+                        std::ranges::find(fanout, user) == fanout.end())
+                    {
+                        fanout.push_back(user);
+                        next.push_back(user);
+                    }
+                }
+            }
+            frontier = std::move(next);
+        }
+        std::ranges::sort(fanout, [&position](GateId lhs, GateId rhs) { return position[lhs] < position[rhs]; });
+        return fanout;
+    }
+
+    /* Returns gates of fanout window (root included), whose values are seen outside of it. */
+    static std::vector<GateId> getBoundary_(CircuitT const& circuit, GateId root, std::vector<GateId> const& fanout)
+    {
+        auto const is_inside = [&](GateId gateId)
+        { return gateId == root || std::ranges::find(fanout, gateId) != fanout.end(); };
+        std::vector<GateId> boundary;
+        auto const add = [&](GateId gateId)
+        {
+            if (circuit.isOutputGate(gateId) ||
+                !std::ranges::all_of(circuit.getGateUsers(gateId), is_inside))
+            {
+                boundary.push_back(gateId);
+            }
+        };
+        add(root);
+        std::ranges::for_each(fanout, add);
+        return boundary;
+    }
+
+    /* Returns value of gate of given type on one word of patterns. */
+    template<class OperandT>
+    static uint64_t evaluateWord_(GateType type, size_t arity, OperandT const& operand)
+    {
+        switch (type)
+        {
+            case GateType::NOT:
+                return ~operand(0);
+            case GateType::IFF:
+            case GateType::BUFF:
+                return operand(0);
+            case GateType::MUX:
+                // MUX(x, y, z) is y when x is false and z otherwise.
+                return (~operand(0) & operand(1)) | (operand(0) & operand(2));
+            default:
+                break;
+        }
+        uint64_t result = operand(0);
+        for (size_t i = 1; i < arity; ++i)
+        {
+            if (type == GateType::AND || type == GateType::NAND)
+            {
+                result &= operand(i);
+            }
+            else if (type == GateType::OR || type == GateType::NOR)
+            {
+                result |= operand(i);
+            }
+            else
+            {
+                result ^= operand(i);
+            }
+        }
+        bool const negated = type == GateType::NAND || type == GateType::NOR || type == GateType::NXOR;
+        return negated ? ~result : result;
+    }
+
+    /**
+     * Returns truth table over leaves, whose i-th bit is set iff i-th assignment of
+     * leaves appears in simulation on pattern, where root is observable.
+     */
+    sop::TruthTable computeCareSet_(
+        CircuitT const& circuit,
+        GateId root,
+        std::vector<GateId> const& leaves,
+        std::vector<GateId> const& fanout,
+        Simulation const& simulation) const
+    {
+        std::vector<GateId> const boundary = getBoundary_(circuit, root, fanout);
+        std::unordered_map<GateId, uint64_t> flipped;
+        sop::TruthTable care(sop::getWords(leaves.size()), 0);
+        for (size_t word = 0; word < simulation.getNumberOfWords(); ++word)
+        {
+            // Windowed re-simulation with complemented root.
+            flipped[root]    = ~simulation.getSignature(root)[word];
+            auto const value = [&](GateId gateId)
+            {
+                auto const it = flipped.find(gateId);
+                return it == flipped.end() ? simulation.getSignature(gateId)[word] : it->second;
+            };
+            for (GateId const gateId : fanout)
+            {
+                GateIdContainer const& operands = circuit.getGateOperands(gateId);
+                flipped[gateId]                 = evaluateWord_(
+                    circuit.getGateType(gateId), operands.size(), [&](size_t i) { return value(operands[i]); });
+            }
+            uint64_t observable = 0;
+            for (GateId const gateId : boundary)
+            {
+                observable |= flipped.at(gateId) ^ simulation.getSignature(gateId)[word];
+            }
+            flipped.clear();
+
+            for (; observable != 0; observable &= observable - 1)
+            {
+                auto const bit    = static_cast<size_t>(std::countr_zero(observable));
+                size_t assignment = 0;
+                for (size_t i = 0; i < leaves.size(); ++i)
+                {
+                    assignment |= ((simulation.getSignature(leaves[i])[word] >> bit) & 1U) << i;
+                }
+                care[assignment / 64] |= uint64_t{1} << (assignment % 64);
+            }
+        }
+        return care;
+    }
+
+    /* Returns re-expression of root under don't cares with positive gain, if it exists. */
+    std::optional<impl::DontCareCandidate_> findCandidate_(
+        CircuitT const& circuit,
+        GateId root,
+        std::vector<GateId> const& fanout,
+        std::vector<size_t> const& position,
+        Simulation const& simulation,
+        impl::WindowScratch_& scratch,
+        std::vector<bool> const& taken,
+        std::vector<bool> const& used) const
+    {
+        if (!impl::isWindowGate_(circuit, root) || (fanout.empty() && !circuit.isOutputGate(root)))
+        {
+            return std::nullopt;
+        }
+        std::vector<GateId> leaves;
+        std::vector<GateId> gates = impl::collectWindow_(circuit, root, max_inputs_, leaves, scratch);
+        auto const is_taken       = [&taken](GateId gateId) { return taken[gateId]; };
+        if (leaves.size() > max_inputs_ || std::ranges::any_of(gates, is_taken) ||
+            std::ranges::any_of(leaves, is_taken))
+        {
+            return std::nullopt;
+        }
+        // Gates, which are used by committed changes, would survive removal of cone.
+        std::vector<GateId> mffc = impl::collectMffc_(circuit, root, scratch);
+        if (std::ranges::any_of(mffc, [&used](GateId gateId) { return used[gateId]; }))
+        {
+            return std::nullopt;
+        }
+
+        size_t const inputs        = leaves.size();
+        sop::TruthTable const care = computeCareSet_(circuit, root, leaves, fanout, simulation);
+        if (care == sop::makeConstant(true, inputs))
+        {
+            // No don't cares, so refactoring and resubstitution do the same.
+            return std::nullopt;
+        }
+
+        std::ranges::sort(gates, [&position](GateId lhs, GateId rhs) { return position[lhs] < position[rhs]; });
+        auto const truths            = impl::computeWindowTruthTables_(circuit, leaves, gates);
+        sop::TruthTable const& truth = truths.at(root);
+
+        size_t mffc_cost = 0;
+        for (GateId const gateId : mffc)
+        {
+            mffc_cost += cost_model_.getGateCost(circuit, gateId);
+        }
+        std::optional<impl::DontCareCandidate_> best;
+        auto const offer = [&](std::vector<GateId> divisors, std::vector<circuits_db::GateRecord> records)
+        {
+            size_t const cost = getCost_(records);
+            if (cost < mffc_cost && (!best.has_value() || mffc_cost - cost > best->gain))
+            {
+                best = impl::DontCareCandidate_{};
+                best->root     = root;
+                best->mffc     = mffc;
+                best->divisors = std::move(divisors);
+                best->gates    = std::move(records);
+                best->gain     = mffc_cost - cost;
+            }
+        };
+
+        // Substitution by divisor, which agrees with root on care set.
+        auto const agrees = [&](sop::TruthTable const& function, bool complement)
+        {
+            uint64_t const flip = complement ? ~uint64_t{0} : 0;
+            for (size_t word = 0; word < care.size(); ++word)
+            {
+                if (((function[word] ^ truth[word] ^ flip) & care[word]) != 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+        for (GateId const leaf : leaves)
+        {
+            gates.push_back(leaf);
+        }
+        for (GateId const divisor : gates)
+        {
+            if (divisor == root || std::ranges::find(mffc, divisor) != mffc.end())
+            {
+                continue;
+            }
+            if (agrees(truths.at(divisor), false))
+            {
+                offer({divisor}, {});
+                break;
+            }
+            if (agrees(truths.at(divisor), true))
+            {
+                offer({divisor}, {{GateType::NOT, 1, {0, 0, 0}}});
+            }
+        }
+
+        // Resynthesis of incompletely specified function or of its complement.
+        sop::TruthTable lower = truth;
+        sop::TruthTable upper = truth;
+        for (size_t word = 0; word < care.size(); ++word)
+        {
+            lower[word] &= care[word];
+            upper[word] |= ~care[word] & npn::getTruthMask(inputs);
+        }
+        for (bool const complement : {false, true})
+        {
+            // Complement is at least complement of upper bound and at most complement of lower bound.
+            sop::Cover const cover =
+                complement ? sop::computeIsop(sop::negate(upper, inputs), sop::negate(lower, inputs), inputs)
+                           : sop::computeIsop(lower, upper, inputs);
+            std::optional<std::vector<circuits_db::GateRecord> > records =
+                toRecords_(sop::factor(cover, inputs), inputs, complement, mffc_cost);
+            if (records.has_value())
+            {
+                if (records->empty())
+                {
+                    // Root is equal to leaf on care set, it is checked above.
+                    continue;
+                }
+                offer(leaves, std::move(*records));
+            }
+        }
+        return best;
+    }
+
+    /* Returns sum of costs of `records`. */
+    size_t getCost_(std::vector<circuits_db::GateRecord> const& records) const
+    {
+        size_t cost = 0;
+        for (circuits_db::GateRecord const& record : records)
+        {
+            cost += cost_model_.getGateCost(record.type, record.arity);
+        }
+        return cost;
+    }
+
+    /**
+     * Returns gates of factored form over `inputs` divisors (NOT, AND, OR and constants),
+     * if they cost less than `limit`. Without gates root is equal to the first divisor.
+     */
+    std::optional<std::vector<circuits_db::GateRecord> > toRecords_(
+        sop::FactoredForm const& form,
+        size_t inputs,
+        bool complement,
+        size_t limit) const
+    {
+        using circuits_db::GateRecord;
+        std::vector<GateRecord> records;
+        auto const& top = form.nodes.at(form.root);
+        if (top.type == GateType::CONST_FALSE || top.type == GateType::CONST_TRUE)
+        {
+            bool const value = (top.type == GateType::CONST_TRUE) != complement;
+            records.push_back({value ? GateType::CONST_TRUE : GateType::CONST_FALSE, 0, {0, 0, 0}});
+            return records;
+        }
+        if (top.type == GateType::INPUT && top.negated == complement)
+        {
+            // Substitution by leaf is found among divisors.
+            return records;
+        }
+
+        size_t cost    = 0;
+        auto const add = [&](GateRecord record)
+        {
+            cost += cost_model_.getGateCost(record.type, record.arity);
+            records.push_back(record);
+            return inputs + records.size() - 1;
+        };
+        std::vector<size_t> ids(form.nodes.size(), 0);
+        for (size_t node = 0; node < form.nodes.size(); ++node)
+        {
+            auto const& record = form.nodes[node];
+            if (cost >= limit || inputs + records.size() > UINT8_MAX)
+            {
+                return std::nullopt;
+            }
+            if (record.type == GateType::INPUT)
+            {
+                ids[node] = record.variable;
+                if (record.negated)
+                {
+                    ids[node] = add({GateType::NOT, 1, {record.variable, 0, 0}});
+                }
+            }
+            else if (record.type == GateType::AND || record.type == GateType::OR)
+            {
+                auto const lhs = static_cast<uint8_t>(ids[record.lhs]);
+                auto const rhs = static_cast<uint8_t>(ids[record.rhs]);
+                ids[node]      = add({record.type, 2, {lhs, rhs, 0}});
+            }
+        }
+        if (complement)
+        {
+            add({GateType::NOT, 1, {static_cast<uint8_t>(ids[form.root]), 0, 0}});
+        }
+        if (cost >= limit)
+        {
+            return std::nullopt;
+        }
+        return records;
+    }
+
+    /**
+     * Proves by SAT, that values on the boundary of fanout window are preserved, when
+     * root is replaced by candidate. On success literals of root and of fanout window
+     * are overridden by literals of their new values.
+     */
+    template<class GetLitT>
+    bool validate_(
+        CircuitT const& circuit,
+        impl::DontCareCandidate_ const& candidate,
+        std::vector<GateId> const& fanout,
+        sat::Solver& solver,
+        GetLitT const& get_lit,
+        std::vector<sat::Lit>& lits) const
+    {
+        GateId const root                  = candidate.root;
+        std::vector<GateId> const boundary = getBoundary_(circuit, root, fanout);
+
+        // Miter: inputs are gates of circuit, gates are candidate and copy of fanout window.
+        GateInfoContainer gate_info;
+        std::vector<GateId> inputs;
+        std::unordered_map<GateId, GateId> input_ids;
+        auto const input = [&](GateId gateId)
+        {
+            auto [it, inserted] = input_ids.emplace(gateId, gate_info.size());
+            if (inserted)
+            {
+                inputs.push_back(gateId);
+                gate_info.emplace_back(GateType::INPUT, GateIdContainer{});
+            }
+            return it->second;
+        };
+        auto const add = [&](GateType type, GateIdContainer operands)
+        {
+            gate_info.emplace_back(type, std::move(operands));
+            return gate_info.size() - 1;
+        };
+
+        std::vector<GateId> ids;
+        for (GateId const divisor : candidate.divisors)
+        {
+            ids.push_back(input(divisor));
+        }
+        for (circuits_db::GateRecord const& record : candidate.gates)
+        {
+            GateIdContainer operands;
+            for (size_t i = 0; i < record.arity; ++i)
+            {
+                operands.push_back(ids.at(record.operands[i]));
+            }
+            ids.push_back(add(record.type, std::move(operands)));
+        }
+        std::unordered_map<GateId, GateId> copies{{root, ids.back()}};
+        for (GateId const gateId : fanout)
+        {
+            GateIdContainer operands;
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                auto const it = copies.find(operand);
+                operands.push_back(it == copies.end() ? input(operand) : it->second);
+            }
+            copies[gateId] = add(circuit.getGateType(gateId), std::move(operands));
+        }
+        GateIdContainer differences;
+        for (GateId const gateId : boundary)
+        {
+            differences.push_back(add(GateType::XOR, {copies.at(gateId), input(gateId)}));
+        }
+        GateId const miter = differences.size() == 1 ? differences.front() : add(GateType::OR, differences);
+
+        CircuitT const miter_circuit(std::move(gate_info), {miter});
+        sat::TseitinEncoder miter_encoder(miter_circuit, solver);
+        for (GateId const gateId : inputs)
+        {
+            miter_encoder.bind(input_ids.at(gateId), get_lit(gateId));
+        }
+        sat::Lit const difference = miter_encoder.getLit(miter);
+        if (solver.solve({difference}, conflict_limit_) != sat::SolveResult::UNSAT)
+        {
+            return false;
+        }
+        solver.addClause({~difference});
+        for (auto const& [gateId, copy] : copies)
+        {
+            lits[gateId] = miter_encoder.getLit(copy);
+        }
+        return true;
+    }
+
+    /* Writes re-expression to `gate_info`: its last gate takes id of root. */
+    static void commit_(
+        impl::DontCareCandidate_ const& candidate,
+        GateInfoContainer& gate_info,
+        std::vector<GateId>& redirections,
+        NameEncoder& encoder,
+        std::string const& new_gate_name_prefix)
+    {
+        if (candidate.gates.empty())
+        {
+            redirections[candidate.root] = candidate.divisors.front();
+            return;
+        }
+        std::vector<GateId> ids(candidate.divisors.begin(), candidate.divisors.end());
+        for (size_t gate = 0; gate < candidate.gates.size(); ++gate)
+        {
+            GateId id = candidate.root;
+            if (gate + 1 < candidate.gates.size())
+            {
+                id = encoder.encodeGate(getNewGateName_(new_gate_name_prefix, gate_info.size()));
+                gate_info.emplace_back();
+            }
+            circuits_db::GateRecord const& record = candidate.gates[gate];
+            GateIdContainer operands              = acquireGateIdContainer();
+            for (size_t i = 0; i < record.arity; ++i)
+            {
+                operands.push_back(ids[record.operands[i]]);
+            }
+            gate_info.at(id) = {record.type, std::move(operands)};
+            ids.push_back(id);
+        }
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_DONT_CARE_OPTIMIZATION_HPP
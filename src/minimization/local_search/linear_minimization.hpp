@@ -0,0 +1,440 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_LINEAR_MINIMIZATION_HPP
+#define CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_LINEAR_MINIMIZATION_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/cost_model.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+#include "utils/random.hpp"
+
+namespace cirbo::minimization
+{
+
+namespace impl
+{
+
+/**
+ * Straight-line program over GF(2): `pairs` are XORs of two signals, first
+ * signals are leaves, next ones are pairs in order. `rows` are signals, which
+ * XOR of each target is left to, so `cost` is number of two-input XORs.
+ */
+struct LinearProgram_
+{
+    std::vector<std::pair<size_t, size_t> > pairs;
+    std::vector<std::vector<size_t> > rows;
+    size_t cost = 0;
+};
+
+}  // namespace impl
+
+/**
+ * Transformer, that re-synthesizes linear (XOR only) subcircuits.
+ *
+ * Maximal linear subcircuit is a connected component of XOR gates, where gates
+ * are connected, if one is operand of another or they share an operand, so wide
+ * gates, flattened by ConnectSymmetricalGates, are minimized together. Leaves
+ * of subcircuit are non-XOR operands of its gates, and its targets are its
+ * gates, which are outputs or have non-XOR users. Each target is XOR of subset
+ * of leaves, so subcircuit is a GF(2) matrix, which is kept by columns: column
+ * of leaf is a bitset of targets, which depend on it, packed into 64-bit words.
+ *
+ * Matrix is synthesized by Paar's heuristic: pair of signals, shared by most
+ * targets, is replaced by its XOR, while some pair is shared by two targets.
+ * Count of pair is popcount of AND of columns, and only counts of columns,
+ * changed by the step, are recomputed. The first attempt breaks ties by order,
+ * next attempts break them randomly, and the cheapest program is kept.
+ * Subcircuit is replaced, when program costs less than subcircuit. Costs are
+ * given by `CostModel`, which counts two-input gates by default, so gate of
+ * arity `n` counts as `n - 1` XORs.
+ *
+ * Program is cancellation-free: each XOR computes a subset of every target,
+ * which uses it, so targets depend on the same leaves as before, and circuit
+ * stays acyclic. NXOR and NOT gates are leaves.
+ *
+ * Note that replaced gates are left in circuit, so this algorithm must be followed
+ * by RedundantGatesCleaner and DuplicateGatesCleaner, and preceded by
+ * RedundantGatesCleaner, since dangling gates are counted as users.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class LinearMinimization_ : public ITransformer<CircuitT>
+{
+public:
+    static constexpr size_t DefaultMaxInputs  = 256;
+    static constexpr size_t DefaultMaxOutputs = 256;
+    static constexpr size_t DefaultAttempts   = 4;
+
+private:
+    size_t max_inputs_;
+    size_t max_outputs_;
+    size_t attempts_;
+    CostModel cost_model_;
+    std::mt19937 engine_;
+
+public:
+    /**
+     * @param max_inputs -- maximum number of leaves of linear subcircuit.
+     * @param max_outputs -- maximum number of targets of linear subcircuit.
+     * @param attempts -- number of runs of heuristic per subcircuit.
+     * @param cost_model -- costs of gates, two-input gates are counted by default.
+     */
+    explicit LinearMinimization_(
+        size_t max_inputs    = DefaultMaxInputs,
+        size_t max_outputs   = DefaultMaxOutputs,
+        size_t attempts      = DefaultAttempts,
+        CostModel cost_model = CostModel::binaryGateCount())
+        : max_inputs_(std::max<size_t>(max_inputs, 1))
+        , max_outputs_(std::max<size_t>(max_outputs, 1))
+        , attempts_(std::max<size_t>(attempts, 1))
+        , cost_model_(cost_model)
+        , engine_(utils::getNewMersenneTwisterEngine())
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START LinearMinimization");
+
+        // Topsort, from inputs to outputs.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+        size_t const size = circuit->getNumberOfGates();
+
+        log::debug("Collecting linear subcircuits");
+        std::vector<GateId> parent(size);
+        std::iota(parent.begin(), parent.end(), GateId{0});
+        auto const find = [&parent](GateId gateId)
+        {
+            while (parent[gateId] != gateId)
+            {
+                parent[gateId] = parent[parent[gateId]];
+                gateId         = parent[gateId];
+            }
+            return gateId;
+        };
+        for (GateId const gateId : gate_sorting)
+        {
+            if (circuit->getGateType(gateId) != GateType::XOR)
+            {
+                continue;
+            }
+            // Leaves join their XOR users, so targets over common leaves may share XORs.
+            for (GateId const operand : circuit->getGateOperands(gateId))
+            {
+                parent[find(operand)] = find(gateId);
+            }
+        }
+        // Gates of each subcircuit in topological order.
+        std::unordered_map<GateId, std::vector<GateId> > subcircuits;
+        std::vector<GateId> roots;
+        for (GateId const gateId : gate_sorting)
+        {
+            if (circuit->getGateType(gateId) == GateType::XOR)
+            {
+                auto [it, inserted] = subcircuits.try_emplace(find(gateId));
+                if (inserted)
+                {
+                    roots.push_back(it->first);
+                }
+                it->second.push_back(gateId);
+            }
+        }
+
+        GateInfoContainer gate_info = acquireGateInfoContainer(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            gate_info.at(gateId) = {
+                circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
+        }
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_LinearMinimization@");
+        // Target, which is equal to single signal, is redirected to it.
+        std::vector<GateId> redirections(size);
+        std::iota(redirections.begin(), redirections.end(), GateId{0});
+
+        log::debug("Minimizing ", roots.size(), " linear subcircuits");
+        for (GateId const root : roots)
+        {
+            minimize_(*circuit, subcircuits.at(root), gate_info, redirections, *encoder, new_gate_name_prefix);
+        }
+
+        for (auto& info : gate_info)
+        {
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : info.getOperands())
+            {
+                operands.push_back(operand < size ? redirections[operand] : operand);
+            }
+            info = {info.getType(), std::move(operands)};
+        }
+        GateIdContainer new_output_gates{};
+        new_output_gates.reserve(circuit->getOutputGates().size());
+        for (GateId const output_gate : circuit->getOutputGates())
+        {
+            new_output_gates.push_back(redirections[output_gate]);
+        }
+
+        log::debug("END LinearMinimization");
+        log::debug("=========================================================================================");
+        return {std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)), std::move(encoder)};
+    }
+
+private:
+    /* Re-synthesizes linear subcircuit of `gates`, given in topological order, if it gets smaller. */
+    void minimize_(
+        CircuitT const& circuit,
+        std::vector<GateId> const& gates,
+        GateInfoContainer& gate_info,
+        std::vector<GateId>& redirections,
+        NameEncoder& encoder,
+        std::string const& new_gate_name_prefix)
+    {
+        std::unordered_map<GateId, size_t> local;
+        std::vector<GateId> leaves;
+        std::unordered_map<GateId, size_t> leaf_index;
+        std::vector<GateId> targets;
+        size_t cost = 0;
+        for (GateId const gateId : gates)
+        {
+            local.emplace(gateId, local.size());
+            GateIdContainer const& operands = circuit.getGateOperands(gateId);
+            cost += cost_model_.getGateCost(GateType::XOR, operands.size());
+            for (GateId const operand : operands)
+            {
+                if (circuit.getGateType(operand) != GateType::XOR &&
+                    leaf_index.try_emplace(operand, leaves.size()).second)
+                {
+                    leaves.push_back(operand);
+                }
+            }
+            GateIdContainer const& users = circuit.getGateUsers(gateId);
+            if (circuit.isOutputGate(gateId) ||
+                std::ranges::any_of(users, [&](GateId user) { return circuit.getGateType(user) != GateType::XOR; }))
+            {
+                targets.push_back(gateId);
+            }
+        }
+        if (targets.empty() || leaves.size() > max_inputs_ || targets.size() > max_outputs_)
+        {
+            return;
+        }
+
+        // Each gate as XOR of leaves, then columns of leaves over targets.
+        size_t const leaf_words = (leaves.size() + 63) / 64;
+        std::vector<uint64_t> expansions(gates.size() * leaf_words, 0);
+        for (GateId const gateId : gates)
+        {
+            uint64_t* const expansion = expansions.data() + local.at(gateId) * leaf_words;
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                if (auto const it = local.find(operand); it != local.end())
+                {
+                    uint64_t const* const source = expansions.data() + it->second * leaf_words;
+                    for (size_t word = 0; word < leaf_words; ++word)
+                    {
+                        expansion[word] ^= source[word];
+                    }
+                }
+                else
+                {
+                    size_t const leaf = leaf_index.at(operand);
+                    expansion[leaf / 64] ^= uint64_t{1} << (leaf % 64);
+                }
+            }
+        }
+        size_t const target_words = (targets.size() + 63) / 64;
+        std::vector<std::vector<uint64_t> > columns(leaves.size(), std::vector<uint64_t>(target_words, 0));
+        for (size_t target = 0; target < targets.size(); ++target)
+        {
+            uint64_t const* const expansion = expansions.data() + local.at(targets[target]) * leaf_words;
+            for (size_t leaf = 0; leaf < leaves.size(); ++leaf)
+            {
+                if ((expansion[leaf / 64] >> (leaf % 64)) & 1U)
+                {
+                    columns[leaf][target / 64] |= uint64_t{1} << (target % 64);
+                }
+            }
+        }
+
+        impl::LinearProgram_ best = synthesize_(columns, targets.size(), false);
+        size_t best_cost          = getCost_(best);
+        for (size_t attempt = 1; attempt < attempts_ && best_cost < cost; ++attempt)
+        {
+            impl::LinearProgram_ program = synthesize_(columns, targets.size(), true);
+            if (size_t const program_cost = getCost_(program); program_cost < best_cost)
+            {
+                best      = std::move(program);
+                best_cost = program_cost;
+            }
+        }
+        if (best_cost >= cost)
+        {
+            return;
+        }
+        log::debug("Linear subcircuit of ", gates.size(), " gates is re-synthesized with gain ", cost - best_cost);
+        countRule("linear_subcircuit_minimized");
+
+        std::vector<GateId> ids(leaves.begin(), leaves.end());
+        auto const add_gate = [&](GateId lhs, GateId rhs)
+        {
+            GateId const id = encoder.encodeGate(getNewGateName_(new_gate_name_prefix, gate_info.size()));
+            gate_info.emplace_back(GateType::XOR, acquireGateIdContainer({lhs, rhs}));
+            return id;
+        };
+        for (auto const& [lhs, rhs] : best.pairs)
+        {
+            ids.push_back(add_gate(ids[lhs], ids[rhs]));
+        }
+        for (size_t target = 0; target < targets.size(); ++target)
+        {
+            std::vector<size_t> const& row = best.rows[target];
+            GateId const target_id         = targets[target];
+            if (row.empty())
+            {
+                gate_info.at(target_id) = {GateType::CONST_FALSE, {}};
+                continue;
+            }
+            if (row.size() == 1)
+            {
+                redirections[target_id] = ids[row.front()];
+                continue;
+            }
+            // Chain of XORs, the last one takes id of target.
+            GateId previous = ids[row.front()];
+            for (size_t i = 1; i + 1 < row.size(); ++i)
+            {
+                previous = add_gate(previous, ids[row[i]]);
+            }
+            gate_info.at(target_id) = {GateType::XOR, acquireGateIdContainer({previous, ids[row.back()]})};
+        }
+    }
+
+    /* Returns cost of gates, which are built by `program`. */
+    size_t getCost_(impl::LinearProgram_ const& program) const
+    {
+        size_t const empty = static_cast<size_t>(
+            std::ranges::count_if(program.rows, [](std::vector<size_t> const& row) { return row.empty(); }));
+        return program.cost * cost_model_.getGateCost(GateType::XOR, 2) +
+               empty * cost_model_.getGateCost(GateType::CONST_FALSE, 0);
+    }
+
+    /* Runs Paar's heuristic on `columns` over `targets` rows, ties are broken randomly if `randomized`. */
+    impl::LinearProgram_ synthesize_(std::vector<std::vector<uint64_t> > columns, size_t targets, bool randomized)
+    {
+        size_t const words = (targets + 63) / 64;
+        auto const shared  = [&columns, words](size_t lhs, size_t rhs)
+        {
+            size_t count = 0;
+            for (size_t word = 0; word < words; ++word)
+            {
+                count += std::popcount(columns[lhs][word] & columns[rhs][word]);
+            }
+            return count;
+        };
+        // Counts of pairs: counts[j][i] for i < j.
+        std::vector<std::vector<size_t> > counts(columns.size());
+        for (size_t j = 0; j < columns.size(); ++j)
+        {
+            for (size_t i = 0; i < j; ++i)
+            {
+                counts[j].push_back(shared(i, j));
+            }
+        }
+
+        impl::LinearProgram_ program;
+        while (true)
+        {
+            size_t best = 1;
+            size_t ties = 0;
+            std::pair<size_t, size_t> chosen;
+            for (size_t j = 0; j < columns.size(); ++j)
+            {
+                for (size_t i = 0; i < j; ++i)
+                {
+                    size_t const count = counts[j][i];
+                    if (count > best)
+                    {
+                        best   = count;
+                        ties   = 1;
+                        chosen = {i, j};
+                    }
+                    else if (randomized && count == best && ties > 0 && engine_() % ++ties == 0)
+                    {
+                        chosen = {i, j};
+                    }
+                }
+            }
+            if (ties == 0)
+            {
+                break;
+            }
+
+            auto const [lhs, rhs] = chosen;
+            std::vector<uint64_t> pair(words);
+            for (size_t word = 0; word < words; ++word)
+            {
+                pair[word] = columns[lhs][word] & columns[rhs][word];
+                columns[lhs][word] ^= pair[word];
+                columns[rhs][word] ^= pair[word];
+            }
+            program.pairs.push_back(chosen);
+            columns.push_back(std::move(pair));
+            counts.emplace_back();
+            for (size_t i = 0; i + 1 < columns.size(); ++i)
+            {
+                counts.back().push_back(shared(i, columns.size() - 1));
+            }
+            for (size_t const changed : {lhs, rhs})
+            {
+                for (size_t other = 0; other + 1 < columns.size(); ++other)
+                {
+                    if (other != changed)
+                    {
+                        counts[std::max(changed, other)][std::min(changed, other)] = shared(changed, other);
+                    }
+                }
+            }
+        }
+
+        program.rows.resize(targets);
+        program.cost = program.pairs.size();
+        for (size_t column = 0; column < columns.size(); ++column)
+        {
+            for (size_t word = 0; word < words; ++word)
+            {
+                for (uint64_t bits = columns[column][word]; bits != 0; bits &= bits - 1)
+                {
+                    program.rows[word * 64 + std::countr_zero(bits)].push_back(column);
+                }
+            }
+        }
+        for (auto const& row : program.rows)
+        {
+            program.cost += row.empty() ? 0 : row.size() - 1;
+        }
+        return program;
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_LINEAR_MINIMIZATION_HPP
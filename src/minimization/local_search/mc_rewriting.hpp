@@ -0,0 +1,539 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_MC_REWRITING_HPP
+#define CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_MC_REWRITING_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/cost_model.hpp"
+#include "core/cut_enumeration.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/local_search/window.hpp"
+#include "minimization/transformer_base.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Library of XAG circuits with minimum number of AND gates (multiplicative
+ * complexity) of all functions of at most 3 inputs, which need at most 2 AND
+ * gates. Library is built once by enumeration: function of complexity `k` is
+ * an affine function of inputs and outputs of `k` AND gates, whose operands
+ * are affine functions of inputs and outputs of previous AND gates.
+ */
+class MultiplicativeComplexityLibrary
+{
+public:
+    static constexpr size_t MaxInputs = 3;
+    static constexpr size_t MaxAnds   = 2;
+    /** Bit of affine mask, which adds constant 1. **/
+    static constexpr uint8_t Constant = 1U << 7U;
+
+    /**
+     * Circuit of function: signals are inputs, then outputs of AND gates in
+     * order. Affine function is a mask of signals, which are XORed.
+     */
+    struct Implementation
+    {
+        uint8_t ands = 0;
+        std::array<std::pair<uint8_t, uint8_t>, MaxAnds> products{};
+        uint8_t output = 0;
+    };
+
+private:
+    /* Implementations of functions of `i` inputs, by truth table in the format of `core/npn.hpp`. */
+    std::array<std::array<std::optional<Implementation>, 256>, MaxInputs + 1> implementations_;
+
+    MultiplicativeComplexityLibrary()
+    {
+        for (size_t inputs = 0; inputs <= MaxInputs; ++inputs)
+        {
+            enumerate_(inputs);
+        }
+    }
+
+public:
+    [[nodiscard]]
+    static MultiplicativeComplexityLibrary const& getInstance()
+    {
+        static MultiplicativeComplexityLibrary const instance;
+        return instance;
+    }
+
+    /**
+     * @param truth -- masked truth table of function, in the format of `core/npn.hpp`.
+     * @param inputs -- number of inputs, at most `MaxInputs`.
+     * @return circuit of function with minimum number of AND gates, or nullptr if it needs more than `MaxAnds`.
+     */
+    [[nodiscard]]
+    Implementation const* getImplementation(uint64_t truth, size_t inputs) const
+    {
+        auto const& implementation = implementations_.at(inputs).at(truth & 0xFFU);
+        return implementation.has_value() ? &*implementation : nullptr;
+    }
+
+    /**
+     * @return cost of gates of implementation, when it is built by `MultiplicativeComplexityRewriting_`.
+     */
+    [[nodiscard]]
+    static size_t getCost(Implementation const& implementation, CostModel const& model)
+    {
+        auto const affine_cost = [&model](uint8_t mask)
+        {
+            auto const signals  = static_cast<size_t>(std::popcount(static_cast<uint8_t>(mask & ~Constant)));
+            bool const negated  = (mask & Constant) != 0;
+            size_t cost         = negated && signals > 0 ? model.getGateCost(GateType::NOT, 1) : 0;
+            if (signals == 0)
+            {
+                cost += model.getGateCost(negated ? GateType::CONST_TRUE : GateType::CONST_FALSE, 0);
+            }
+            else if (signals > 1)
+            {
+                cost += model.getGateCost(GateType::XOR, signals);
+            }
+            return cost;
+        };
+        size_t cost = affine_cost(implementation.output);
+        for (size_t i = 0; i < implementation.ands; ++i)
+        {
+            auto const [lhs, rhs] = implementation.products[i];
+            cost += affine_cost(lhs) + affine_cost(rhs) + model.getGateCost(GateType::AND, 2);
+        }
+        return cost;
+    }
+
+private:
+    /* Returns truth table of affine function `mask` of `signals`. */
+    static uint8_t evaluate_(uint8_t mask, std::span<uint8_t const> signals)
+    {
+        auto value = static_cast<uint8_t>((mask & Constant) != 0 ? 0xFFU : 0U);
+        for (size_t i = 0; i < signals.size(); ++i)
+        {
+            if (((mask >> i) & 1U) != 0)
+            {
+                value ^= signals[i];
+            }
+        }
+        return value;
+    }
+
+    /* Returns masks of affine functions of `signals` signals, which depend on some signal. */
+    static std::vector<uint8_t> getOperandMasks_(size_t signals)
+    {
+        std::vector<uint8_t> masks;
+        for (uint8_t mask = 1; mask < (1U << signals); ++mask)
+        {
+            masks.push_back(mask);
+            masks.push_back(mask | Constant);
+        }
+        return masks;
+    }
+
+    void enumerate_(size_t inputs)
+    {
+        auto& implementations     = implementations_.at(inputs);
+        auto const truth_mask     = static_cast<uint8_t>((1U << (1U << inputs)) - 1);
+        std::vector<uint8_t> base = {0xAA, 0xCC, 0xF0};
+        base.resize(inputs);
+        size_t found     = 0;
+        auto const store = [&](uint8_t truth, Implementation const& implementation)
+        {
+            truth &= truth_mask;
+            if (!implementations[truth].has_value())
+            {
+                implementations[truth] = implementation;
+                ++found;
+            }
+        };
+        size_t const functions = size_t{1} << (1U << inputs);
+
+        // Each affine function, so output affine mask of next levels includes the new AND gate.
+        auto const store_affine = [&](std::vector<uint8_t> const& signals, Implementation implementation)
+        {
+            auto const last = static_cast<uint8_t>(implementation.ands == 0 ? 0 : 1U << (signals.size() - 1));
+            for (uint8_t mask = 0; mask < (1U << inputs); ++mask)
+            {
+                for (uint8_t const constant : {uint8_t{0}, Constant})
+                {
+                    uint8_t const output  = mask | last | constant;
+                    implementation.output = output;
+                    store(evaluate_(output, signals), implementation);
+                }
+            }
+        };
+
+        store_affine(base, {});
+        if (inputs < 2)
+        {
+            return;
+        }
+        std::vector<uint8_t> const first_masks = getOperandMasks_(inputs);
+        std::vector<std::pair<Implementation, uint8_t> > first_products;
+        std::array<bool, 256> seen{};
+        for (uint8_t const lhs : first_masks)
+        {
+            for (uint8_t const rhs : first_masks)
+            {
+                if (lhs >= rhs)
+                {
+                    continue;
+                }
+                auto const product = static_cast<uint8_t>(evaluate_(lhs, base) & evaluate_(rhs, base) & truth_mask);
+                if (seen[product])
+                {
+                    continue;
+                }
+                seen[product] = true;
+                Implementation implementation;
+                implementation.ands        = 1;
+                implementation.products[0] = {lhs, rhs};
+                std::vector<uint8_t> signals(base);
+                signals.push_back(product);
+                store_affine(signals, implementation);
+                first_products.emplace_back(implementation, product);
+            }
+        }
+
+        std::vector<uint8_t> const second_masks = getOperandMasks_(inputs + 1);
+        for (auto const& [first, product] : first_products)
+        {
+            std::vector<uint8_t> signals(base);
+            signals.push_back(product);
+            std::array<bool, 256> second_seen{};
+            for (uint8_t const lhs : second_masks)
+            {
+                for (uint8_t const rhs : second_masks)
+                {
+                    if (found == functions)
+                    {
+                        return;
+                    }
+                    if (lhs >= rhs)
+                    {
+                        continue;
+                    }
+                    auto const second =
+                        static_cast<uint8_t>(evaluate_(lhs, signals) & evaluate_(rhs, signals) & truth_mask);
+                    if (second_seen[second])
+                    {
+                        continue;
+                    }
+                    second_seen[second] = true;
+                    Implementation implementation = first;
+                    implementation.ands           = 2;
+                    implementation.products[1]    = {lhs, rhs};
+                    std::vector<uint8_t> extended(signals);
+                    extended.push_back(second);
+                    // Affine part may use output of the first AND gate too.
+                    for (uint8_t const previous : {uint8_t{0}, static_cast<uint8_t>(1U << inputs)})
+                    {
+                        for (uint8_t mask = 0; mask < (1U << inputs); ++mask)
+                        {
+                            for (uint8_t const constant : {uint8_t{0}, Constant})
+                            {
+                                implementation.output = mask | previous | (1U << (inputs + 1)) | constant;
+                                store(evaluate_(implementation.output, extended), implementation);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+};
+
+namespace impl
+{
+
+/**
+ * Rewriting of `root` by library circuit of its cut function over `leaves`.
+ * Maximum fanout-free cone `mffc` of root is removed, so cost is decreased by `gain`.
+ */
+struct McRewritingCandidate_
+{
+    GateId root = 0;
+    std::vector<GateId> mffc;
+    std::vector<GateId> leaves;
+    MultiplicativeComplexityLibrary::Implementation const* implementation = nullptr;
+    size_t gain                                                           = 0;
+};
+
+}  // namespace impl
+
+/**
+ * Transformer, that rewrites gates by XAG circuits with minimum number of AND
+ * gates of their 3-input cut functions (see `MultiplicativeComplexityLibrary`).
+ *
+ * For each gate and each of its priority cuts, gain is the cost of maximum
+ * fanout-free cone of the gate, bounded by cut leaves, minus the cost of
+ * library circuit. Costs are given by `CostModel`, which counts AND gates by
+ * default, so XOR and NOT gates are free. Gates with gain are committed
+ * greedily, largest gain first, skipping gates, whose MFFC intersect already
+ * committed ones or contain their leaves.
+ *
+ * Note that replaced gates are left in circuit, so this algorithm must be followed
+ * by RedundantGatesCleaner (before ConstantGateReducer, which may be needed for new
+ * constants), ReduceNotComposition and DuplicateGatesCleaner, and preceded by
+ * RedundantGatesCleaner, since dangling gates are counted as users.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class MultiplicativeComplexityRewriting_ : public ITransformer<CircuitT>
+{
+public:
+    static constexpr size_t DefaultCutLimit = CutEnumeration::DefaultCutLimit;
+
+private:
+    using Library_ = MultiplicativeComplexityLibrary;
+
+    CostModel cost_model_;
+    size_t cut_limit_;
+
+public:
+    /**
+     * @param cost_model -- costs of gates, AND gates are counted by default.
+     * @param cut_limit -- maximum number of 3-input priority cuts per gate.
+     */
+    explicit MultiplicativeComplexityRewriting_(
+        CostModel cost_model = CostModel::multiplicativeComplexity(),
+        size_t cut_limit     = DefaultCutLimit)
+        : cost_model_(cost_model)
+        , cut_limit_(std::max<size_t>(cut_limit, 1))
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START MultiplicativeComplexityRewriting");
+
+        log::debug("Enumerating cuts");
+        CutEnumeration const cuts(*circuit, Library_::MaxInputs, cut_limit_);
+        // Topsort, from inputs to outputs.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+        size_t const size = circuit->getNumberOfGates();
+
+        log::debug("Rewriting gates");
+        impl::WindowScratch_ scratch(*circuit);
+        std::vector<impl::McRewritingCandidate_> candidates;
+        for (GateId const gateId : gate_sorting)
+        {
+            if (!impl::isWindowGate_(*circuit, gateId))
+            {
+                continue;
+            }
+            if (auto candidate = findCandidate_(*circuit, gateId, cuts.getCuts(gateId), scratch); candidate)
+            {
+                candidates.push_back(std::move(*candidate));
+            }
+        }
+        // Stable sort keeps topological order among gates of equal gain.
+        std::ranges::stable_sort(
+            candidates,
+            [](impl::McRewritingCandidate_ const& lhs, impl::McRewritingCandidate_ const& rhs)
+            { return lhs.gain > rhs.gain; });
+
+        GateInfoContainer gate_info = acquireGateInfoContainer(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            gate_info.at(gateId) = {
+                circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
+        }
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_MultiplicativeComplexityRewriting@");
+        // Gate, which is equal to a signal of library circuit, is redirected to it.
+        std::vector<GateId> redirections(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            redirections[gateId] = gateId;
+        }
+        std::vector<bool> taken(size, false);
+        auto const is_taken = [&taken](GateId gateId) { return taken[gateId]; };
+        for (impl::McRewritingCandidate_ const& candidate : candidates)
+        {
+            if (std::ranges::any_of(candidate.mffc, is_taken) || std::ranges::any_of(candidate.leaves, is_taken))
+            {
+                continue;
+            }
+            for (GateId const gateId : candidate.mffc)
+            {
+                taken[gateId] = true;
+            }
+            log::debug("Gate ", candidate.root, " is rewritten with cost ", candidate.gain, " less");
+            countRule("mc_rewritten");
+            commit_(candidate, gate_info, redirections, *encoder, new_gate_name_prefix);
+        }
+
+        auto const resolve = [&redirections](GateId gateId)
+        {
+            while (gateId < redirections.size() && redirections[gateId] != gateId)
+            {
+                gateId = redirections[gateId];
+            }
+            return gateId;
+        };
+        for (auto& info : gate_info)
+        {
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : info.getOperands())
+            {
+                operands.push_back(resolve(operand));
+            }
+            info = {info.getType(), std::move(operands)};
+        }
+        GateIdContainer new_output_gates{};
+        new_output_gates.reserve(circuit->getOutputGates().size());
+        for (GateId const output_gate : circuit->getOutputGates())
+        {
+            new_output_gates.push_back(resolve(output_gate));
+        }
+
+        log::debug("END MultiplicativeComplexityRewriting");
+        log::debug("=========================================================================================");
+        return {std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)), std::move(encoder)};
+    }
+
+private:
+    /* Returns rewriting of `root` by its best cut with positive gain, if it exists. */
+    std::optional<impl::McRewritingCandidate_> findCandidate_(
+        CircuitT const& circuit,
+        GateId root,
+        std::span<Cut const> cuts,
+        impl::WindowScratch_& scratch) const
+    {
+        std::optional<impl::McRewritingCandidate_> best;
+        for (Cut const& cut : cuts)
+        {
+            auto const leaves = cut.getLeaves();
+            if (leaves.size() == 1 && leaves.front() == root)
+            {
+                continue;
+            }
+            auto const* const implementation = Library_::getInstance().getImplementation(
+                cut.truth[0] & ((uint64_t{1} << (uint64_t{1} << leaves.size())) - 1), leaves.size());
+            if (implementation == nullptr)
+            {
+                continue;
+            }
+
+            // Gates between leaves and root form the window, which bounds MFFC.
+            uint32_t const stamp = ++scratch.stamp;
+            scratch.marks[root]  = stamp;
+            std::vector<GateId> stack{root};
+            while (!stack.empty())
+            {
+                GateId const gateId = stack.back();
+                stack.pop_back();
+                for (GateId const operand : circuit.getGateOperands(gateId))
+                {
+                    if (scratch.marks[operand] != stamp && std::ranges::find(leaves, operand) == leaves.end())
+                    {
+                        scratch.marks[operand] = stamp;
+                        stack.push_back(operand);
+                    }
+                }
+            }
+            std::vector<GateId> mffc = impl::collectMffc_(circuit, root, scratch);
+
+            size_t removed = 0;
+            for (GateId const gateId : mffc)
+            {
+                removed += cost_model_.getGateCost(circuit, gateId);
+            }
+            size_t const added = Library_::getCost(*implementation, cost_model_);
+            if (removed > added && (!best.has_value() || removed - added > best->gain))
+            {
+                best = impl::McRewritingCandidate_{
+                    root, std::move(mffc), {leaves.begin(), leaves.end()}, implementation, removed - added};
+            }
+        }
+        return best;
+    }
+
+    /* Writes library circuit to `gate_info`: its last gate takes id of root. */
+    static void commit_(
+        impl::McRewritingCandidate_ const& candidate,
+        GateInfoContainer& gate_info,
+        std::vector<GateId>& redirections,
+        NameEncoder& encoder,
+        std::string const& new_gate_name_prefix)
+    {
+        auto const add_gate = [&](GateType type, GateIdContainer operands, bool is_root)
+        {
+            GateId id = candidate.root;
+            if (!is_root)
+            {
+                id = encoder.encodeGate(getNewGateName_(new_gate_name_prefix, gate_info.size()));
+                gate_info.emplace_back();
+            }
+            gate_info.at(id) = {type, std::move(operands)};
+            return id;
+        };
+        std::vector<GateId> signals(candidate.leaves.begin(), candidate.leaves.end());
+        // Returns gate of affine function, the last added gate is root, if `is_root`.
+        auto const build_affine = [&](uint8_t mask, bool is_root) -> std::optional<GateId>
+        {
+            bool const negated       = (mask & MultiplicativeComplexityLibrary::Constant) != 0;
+            GateIdContainer operands = acquireGateIdContainer();
+            for (size_t i = 0; i < signals.size(); ++i)
+            {
+                if (((mask >> i) & 1U) != 0)
+                {
+                    operands.push_back(signals[i]);
+                }
+            }
+            if (operands.empty())
+            {
+                return add_gate(negated ? GateType::CONST_TRUE : GateType::CONST_FALSE, {}, is_root);
+            }
+            if (operands.size() == 1 && !negated)
+            {
+                if (is_root)
+                {
+                    return std::nullopt;
+                }
+                return operands.front();
+            }
+            if (operands.size() == 1)
+            {
+                return add_gate(GateType::NOT, std::move(operands), is_root);
+            }
+            GateId const sum = add_gate(GateType::XOR, std::move(operands), is_root && !negated);
+            return negated ? add_gate(GateType::NOT, {sum}, is_root) : sum;
+        };
+
+        auto const* const implementation = candidate.implementation;
+        for (size_t i = 0; i < implementation->ands; ++i)
+        {
+            auto const [lhs, rhs] = implementation->products[i];
+            GateId const lhs_gate = *build_affine(lhs, false);
+            GateId const rhs_gate = *build_affine(rhs, false);
+            signals.push_back(add_gate(GateType::AND, acquireGateIdContainer({lhs_gate, rhs_gate}), false));
+        }
+        if (!build_affine(implementation->output, true).has_value())
+        {
+            uint8_t const output = implementation->output;
+            redirections[candidate.root] = signals[static_cast<size_t>(std::countr_zero(output))];
+        }
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_MC_REWRITING_HPP
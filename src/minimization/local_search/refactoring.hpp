@@ -0,0 +1,468 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_REFACTORING_HPP
+#define CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_REFACTORING_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/cost_model.hpp"
+#include "core/sop.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/local_search/window.hpp"
+#include "minimization/transformer_base.hpp"
+#include "utils/parallel.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Thread-safe map from functions of cones to their factored forms. Form of
+ * function or of its complement is kept, whichever needs less gates, so
+ * cones, which repeat across a circuit or across passes, are factored once.
+ */
+class RefactoringCache
+{
+public:
+    struct Entry
+    {
+        sop::FactoredForm form;
+        /* True iff `form` is form of complement of function. */
+        bool complemented = false;
+    };
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::pair<size_t, sop::TruthTable>, std::shared_ptr<Entry const> > entries_;
+    size_t hits_   = 0;
+    size_t misses_ = 0;
+
+public:
+    /* Returns factored form of function, factoring it, if it is not cached. */
+    std::shared_ptr<Entry const> get(sop::TruthTable const& truth, size_t inputs)
+    {
+        {
+            std::lock_guard const lock(mutex_);
+            if (auto const it = entries_.find({inputs, truth}); it != entries_.end())
+            {
+                ++hits_;
+                return it->second;
+            }
+            ++misses_;
+        }
+        auto entry = std::make_shared<Entry const>(factor_(truth, inputs));
+        std::lock_guard const lock(mutex_);
+        return entries_.try_emplace({inputs, truth}, std::move(entry)).first->second;
+    }
+
+    [[nodiscard]]
+    size_t size() const
+    {
+        std::lock_guard const lock(mutex_);
+        return entries_.size();
+    }
+
+    [[nodiscard]]
+    size_t getHits() const
+    {
+        std::lock_guard const lock(mutex_);
+        return hits_;
+    }
+
+    [[nodiscard]]
+    size_t getMisses() const
+    {
+        std::lock_guard const lock(mutex_);
+        return misses_;
+    }
+
+private:
+    static Entry factor_(sop::TruthTable const& truth, size_t inputs)
+    {
+        Entry direct{sop::factor(sop::computeIsop(truth, inputs), inputs), false};
+        Entry complement{sop::factor(sop::computeIsop(sop::negate(truth, inputs), inputs), inputs), true};
+        return estimateCost_(complement) < estimateCost_(direct) ? std::move(complement) : std::move(direct);
+    }
+
+    /* Number of gates of form, when negations of inputs are not shared with circuit. */
+    static size_t estimateCost_(Entry const& entry)
+    {
+        auto const negations = std::ranges::count_if(
+            entry.form.nodes,
+            [](sop::FactoredForm::Node const& node) { return node.type == GateType::INPUT && node.negated; });
+        return entry.form.countOperators() + static_cast<size_t>(negations) + static_cast<size_t>(entry.complemented);
+    }
+};
+
+namespace impl
+{
+
+/* Cone of `root` over `leaves`, whose maximum fanout-free cone is rebuilt by factored form with cost less by `gain`. */
+struct RefactoredCone_
+{
+    GateId root = 0;
+    std::vector<GateId> leaves;
+    /* Existing gate, which computes negation of leaf, if it may be used by new cone. */
+    std::vector<std::optional<GateId> > negations;
+    std::vector<GateId> mffc;
+    std::shared_ptr<RefactoringCache::Entry const> entry;
+    size_t gain = 0;
+};
+
+}  // namespace impl
+
+/**
+ * Transformer, that collapses cones of gates into truth tables and rebuilds
+ * them by factored forms, as refactoring of ABC does.
+ *
+ * Cone of each gate is grown towards inputs, reconvergence-driven, up to
+ * `max_inputs` leaves. Irredundant sum of products of its function (or of its
+ * complement) is found by the Minato-Morreale algorithm and factored
+ * algebraically (see `core/sop.hpp`). Gain is the cost of gates in maximum
+ * fanout-free cone of the gate, bounded by leaves, minus the cost of AND, OR
+ * and NOT gates of the factored form, where negations of leaves, which
+ * already exist in circuit, are free. Costs are given by `CostModel`, which
+ * counts gates by default.
+ *
+ * Cones are processed in parallel on unchanged circuit, and factored forms
+ * are cached by function (see `RefactoringCache`). Then cones with gain are
+ * committed greedily, largest gain first, skipping cones, whose fanout-free
+ * parts intersect already committed ones. Gate keeps its id, so functions of
+ * all gates are preserved, and new cone uses only gates, which precede the
+ * gate in topological order, so circuit stays acyclic.
+ *
+ * Note that replaced gates are left in circuit, so this algorithm must be followed
+ * by RedundantGatesCleaner and DuplicateGatesCleaner, and preceded by
+ * RedundantGatesCleaner, since dangling gates are counted as users.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class Refactoring_ : public ITransformer<CircuitT>
+{
+public:
+    static constexpr size_t MaxInputs        = 12;
+    static constexpr size_t DefaultMaxInputs = 10;
+
+private:
+    size_t max_inputs_;
+    size_t threads_;
+    std::shared_ptr<RefactoringCache> cache_;
+    CostModel cost_model_;
+
+public:
+    /**
+     * @param max_inputs -- maximum number of cone leaves, at most `MaxInputs`.
+     * @param threads -- number of threads, 0 means number of hardware threads.
+     * @param cache -- cache of factored forms, may be shared by transformers.
+     * @param cost_model -- costs of gates, gates are counted by default.
+     */
+    explicit Refactoring_(
+        size_t max_inputs                       = DefaultMaxInputs,
+        size_t threads                          = 0,
+        std::shared_ptr<RefactoringCache> cache = std::make_shared<RefactoringCache>(),
+        CostModel cost_model                    = CostModel::gateCount())
+        : max_inputs_(std::clamp<size_t>(max_inputs, 2, MaxInputs))
+        , threads_(threads == 0 ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : threads)
+        , cache_(std::move(cache))
+        , cost_model_(cost_model)
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START Refactoring");
+
+        // Topsort, from inputs to outputs.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+        size_t const size = circuit->getNumberOfGates();
+        std::vector<size_t> position(size);
+        for (size_t i = 0; i < gate_sorting.size(); ++i)
+        {
+            position.at(gate_sorting[i]) = i;
+        }
+
+        log::debug("Refactoring cones");
+        std::vector<std::optional<impl::RefactoredCone_> > cones(gate_sorting.size());
+        utils::parallelFor(
+            gate_sorting.size(),
+            threads_,
+            [&circuit]() { return impl::WindowScratch_(*circuit); },
+            [&](size_t i, impl::WindowScratch_& scratch)
+            { cones[i] = findCone_(*circuit, gate_sorting[i], position, scratch); });
+
+        log::debug("Committing cones");
+        std::vector<impl::RefactoredCone_*> chosen;
+        for (auto& cone : cones)
+        {
+            if (cone.has_value())
+            {
+                chosen.push_back(&*cone);
+            }
+        }
+        // Stable sort keeps topological order among cones of equal gain.
+        std::ranges::stable_sort(
+            chosen,
+            [](impl::RefactoredCone_ const* lhs, impl::RefactoredCone_ const* rhs) { return lhs->gain > rhs->gain; });
+
+        GateInfoContainer gate_info = acquireGateInfoContainer(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            gate_info.at(gateId) = {
+                circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
+        }
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_Refactoring@");
+        // Gate, whose cone is a literal, is redirected to the gate of literal.
+        std::vector<GateId> redirections(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            redirections[gateId] = gateId;
+        }
+        std::vector<bool> taken(size, false);
+        auto const is_taken = [&taken](GateId gateId) { return taken[gateId]; };
+        for (impl::RefactoredCone_ const* cone : chosen)
+        {
+            // Leaves and negations in committed cones would survive, so gain would be lower.
+            auto const is_taken_negation = [&taken](std::optional<GateId> const& negation)
+            { return negation.has_value() && taken[*negation]; };
+            if (std::ranges::any_of(cone->mffc, is_taken) || std::ranges::any_of(cone->leaves, is_taken) ||
+                std::ranges::any_of(cone->negations, is_taken_negation))
+            {
+                continue;
+            }
+            for (GateId const gateId : cone->mffc)
+            {
+                taken[gateId] = true;
+            }
+            log::debug("Cone of gate ", cone->root, " is refactored with gain ", cone->gain);
+            countRule("cone_refactored");
+            commit_(*cone, gate_info, redirections, *encoder, new_gate_name_prefix);
+        }
+
+        auto const resolve = [&redirections](GateId gateId)
+        {
+            while (gateId < redirections.size() && redirections[gateId] != gateId)
+            {
+                gateId = redirections[gateId];
+            }
+            return gateId;
+        };
+        for (auto& info : gate_info)
+        {
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : info.getOperands())
+            {
+                operands.push_back(resolve(operand));
+            }
+            info = {info.getType(), std::move(operands)};
+        }
+        GateIdContainer new_output_gates{};
+        new_output_gates.reserve(circuit->getOutputGates().size());
+        for (GateId const output_gate : circuit->getOutputGates())
+        {
+            new_output_gates.push_back(resolve(output_gate));
+        }
+
+        log::debug("END Refactoring");
+        log::debug("=========================================================================================");
+        return {std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)), std::move(encoder)};
+    }
+
+private:
+    /* Returns refactored cone of `root` with positive gain, if it exists. */
+    std::optional<impl::RefactoredCone_> findCone_(
+        CircuitT const& circuit,
+        GateId root,
+        std::vector<size_t> const& position,
+        impl::WindowScratch_& scratch) const
+    {
+        if (!impl::isWindowGate_(circuit, root))
+        {
+            return std::nullopt;
+        }
+        impl::RefactoredCone_ cone;
+        cone.root = root;
+        std::vector<GateId> gates = impl::collectWindow_(circuit, root, max_inputs_, cone.leaves, scratch);
+        if (cone.leaves.size() > max_inputs_)
+        {
+            return std::nullopt;
+        }
+
+        cone.mffc        = impl::collectMffc_(circuit, root, scratch);
+        size_t mffc_cost = 0;
+        for (GateId const gateId : cone.mffc)
+        {
+            mffc_cost += cost_model_.getGateCost(circuit, gateId);
+        }
+        if (mffc_cost == 0)
+        {
+            return std::nullopt;
+        }
+
+        std::ranges::sort(gates, [&position](GateId lhs, GateId rhs) { return position[lhs] < position[rhs]; });
+        auto const truths = impl::computeWindowTruthTables_(circuit, cone.leaves, gates);
+        cone.entry        = cache_->get(truths.at(root), cone.leaves.size());
+
+        sop::FactoredForm const& form = cone.entry->form;
+        auto const& top               = form.nodes.at(form.root);
+        cone.negations.resize(cone.leaves.size());
+        size_t const negation_cost = cost_model_.getGateCost(GateType::NOT, 1);
+        size_t cost                = 0;
+        if (top.type == GateType::CONST_FALSE || top.type == GateType::CONST_TRUE)
+        {
+            // Root becomes constant gate.
+            cost = cost_model_.getGateCost(top.type, 0);
+        }
+        else if (top.type == GateType::INPUT)
+        {
+            // Root is redirected to leaf or to its negation, or becomes negation of leaf.
+            if (top.negated != cone.entry->complemented)
+            {
+                cone.negations[top.variable] = findNegation_(circuit, cone.leaves[top.variable], position, cone);
+                cost = cone.negations[top.variable].has_value() ? 0 : negation_cost;
+            }
+        }
+        else
+        {
+            cost = cone.entry->complemented ? negation_cost : 0;
+            for (auto const& node : form.nodes)
+            {
+                if (node.type == GateType::AND || node.type == GateType::OR)
+                {
+                    cost += cost_model_.getGateCost(node.type, 2);
+                }
+                else if (node.type == GateType::INPUT && node.negated)
+                {
+                    cone.negations[node.variable] = findNegation_(circuit, cone.leaves[node.variable], position, cone);
+                    cost += cone.negations[node.variable].has_value() ? 0 : negation_cost;
+                }
+            }
+        }
+        if (cost >= mffc_cost)
+        {
+            return std::nullopt;
+        }
+        cone.gain = mffc_cost - cost;
+        return cone;
+    }
+
+    /**
+     * Returns existing gate, which computes negation of leaf and may be used by
+     * new cone: it precedes root and is not removed with the cone.
+     */
+    static std::optional<GateId> findNegation_(
+        CircuitT const& circuit,
+        GateId leaf,
+        std::vector<size_t> const& position,
+        impl::RefactoredCone_ const& cone)
+    {
+        auto const is_usable = [&](GateId gateId)
+        { return position[gateId] < position[cone.root] && std::ranges::find(cone.mffc, gateId) == cone.mffc.end(); };
+        if (circuit.getGateType(leaf) == GateType::NOT && is_usable(circuit.getGateOperands(leaf).front()))
+        {
+            return circuit.getGateOperands(leaf).front();
+        }
+        for (GateId const user : circuit.getGateUsers(leaf))
+        {
+            if (circuit.getGateType(user) == GateType::NOT && is_usable(user))
+            {
+                return user;
+            }
+        }
+        return std::nullopt;
+    }
+
+    /* Writes factored form of cone to `gate_info`: its root takes id of root of cone. */
+    static void commit_(
+        impl::RefactoredCone_ const& cone,
+        GateInfoContainer& gate_info,
+        std::vector<GateId>& redirections,
+        NameEncoder& encoder,
+        std::string const& new_gate_name_prefix)
+    {
+        sop::FactoredForm const& form = cone.entry->form;
+        bool const complemented       = cone.entry->complemented;
+        auto const create             = [&](GateType type, GateIdContainer operands, bool at_root) -> GateId
+        {
+            GateId id = cone.root;
+            if (!at_root)
+            {
+                id = encoder.encodeGate(getNewGateName_(new_gate_name_prefix, gate_info.size()));
+                gate_info.emplace_back();
+            }
+            gate_info.at(id) = {type, std::move(operands)};
+            return id;
+        };
+        auto const negate = [&](size_t variable, bool at_root) -> GateId
+        {
+            if (cone.negations[variable].has_value())
+            {
+                return *cone.negations[variable];
+            }
+            return create(GateType::NOT, acquireGateIdContainer({cone.leaves[variable]}), at_root);
+        };
+
+        auto const& top = form.nodes.at(form.root);
+        switch (top.type)
+        {
+            case GateType::CONST_FALSE:
+            case GateType::CONST_TRUE:
+            {
+                bool const value = (top.type == GateType::CONST_TRUE) != complemented;
+                create(value ? GateType::CONST_TRUE : GateType::CONST_FALSE, acquireGateIdContainer(), true);
+                return;
+            }
+            case GateType::INPUT:
+            {
+                GateId const literal =
+                    top.negated != complemented ? negate(top.variable, true) : cone.leaves[top.variable];
+                if (literal != cone.root)
+                {
+                    redirections[cone.root] = literal;
+                }
+                return;
+            }
+            default:
+                break;
+        }
+
+        std::vector<GateId> ids(form.nodes.size(), 0);
+        for (size_t node = 0; node < form.nodes.size(); ++node)
+        {
+            auto const& record = form.nodes[node];
+            if (record.type == GateType::INPUT)
+            {
+                ids[node] = record.negated ? negate(record.variable, false) : cone.leaves[record.variable];
+            }
+            else if (record.type == GateType::AND || record.type == GateType::OR)
+            {
+                bool const at_root = node == form.root && !complemented;
+                ids[node] = create(record.type, acquireGateIdContainer({ids[record.lhs], ids[record.rhs]}), at_root);
+            }
+        }
+        if (complemented)
+        {
+            create(GateType::NOT, acquireGateIdContainer({ids[form.root]}), true);
+        }
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_REFACTORING_HPP
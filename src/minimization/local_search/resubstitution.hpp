@@ -0,0 +1,634 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_RESUBSTITUTION_HPP
+#define CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_RESUBSTITUTION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "core/algo.hpp"
+#include "core/cost_model.hpp"
+#include "core/npn.hpp"
+#include "core/simulation.hpp"
+#include "core/sop.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/local_search/window.hpp"
+#include "minimization/transformer_base.hpp"
+#include "utils/parallel.hpp"
+#include "utils/random.hpp"
+
+namespace cirbo::minimization
+{
+
+namespace impl
+{
+
+/**
+ * Re-expression of `root` by `divisors`: `gates` refer to divisors (first
+ * indices) and previous gates, the last gate computes root. Without gates
+ * root is equal to the first divisor. Maximum fanout-free cone `mffc` of root
+ * is removed, so cost is decreased by `gain`.
+ */
+struct ResubstitutionCandidate_
+{
+    GateId root = 0;
+    std::vector<GateId> mffc;
+    std::vector<GateId> divisors;
+    std::vector<circuits_db::GateRecord> gates;
+    size_t gain = 0;
+};
+
+}  // namespace impl
+
+/**
+ * Transformer, that re-expresses gates by at most three existing gates
+ * (divisors), as resubstitution of ABC does.
+ *
+ * Window of each gate is grown towards inputs, reconvergence-driven, up to
+ * `max_inputs` leaves. Divisors are leaves, gates of window outside of maximum
+ * fanout-free cone (MFFC) of the gate, and gates, whose operands are divisors,
+ * which precede the gate in topological order, so at most `max_divisors` gates
+ * depend on leaves only. Gate is replaced by the first found of:
+ *   - equal divisor,
+ *   - negation of divisor or one gate over two divisors,
+ *   - two gates over three divisors, AND, OR and XOR gates,
+ * which costs less than MFFC, so gain is the cost of MFFC minus the cost of new
+ * gates. Costs are given by `CostModel`, which counts gates by default.
+ *
+ * Candidates are filtered by signatures of random bit-parallel simulation,
+ * and are confirmed exactly by truth tables over window leaves. Work per gate
+ * is bounded by sizes of window, so time is linear in size of circuit.
+ *
+ * Windows are processed in parallel on unchanged circuit. Then gates with
+ * gain are committed greedily, largest gain first, skipping gates, whose MFFC
+ * intersect already committed ones or contain their divisors.
+ *
+ * Note that replaced gates are left in circuit, so this algorithm must be followed
+ * by RedundantGatesCleaner and DuplicateGatesCleaner, and preceded by
+ * RedundantGatesCleaner, since dangling gates are counted as users.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class Resubstitution_ : public ITransformer<CircuitT>
+{
+public:
+    static constexpr size_t MaxInputs          = 12;
+    static constexpr size_t DefaultMaxInputs   = 8;
+    static constexpr size_t DefaultMaxDivisors = 30;
+    /** Default number of 64-bit words in random simulation signatures. **/
+    static constexpr size_t DefaultWords = 4;
+
+private:
+    /* Divisor with its simulation signature and truth table over window leaves. */
+    struct Divisor_
+    {
+        GateId gate;
+        uint64_t const* signature;
+        sop::TruthTable truth;
+    };
+
+    size_t max_inputs_;
+    size_t max_divisors_;
+    size_t words_;
+    size_t threads_;
+    CostModel cost_model_;
+    std::mt19937 engine_;
+
+public:
+    /**
+     * @param max_inputs -- maximum number of window leaves, at most `MaxInputs`.
+     * @param max_divisors -- maximum number of divisors of gate.
+     * @param words -- number of 64-bit words in random simulation signatures.
+     * @param threads -- number of threads, 0 means number of hardware threads.
+     * @param cost_model -- costs of gates, gates are counted by default.
+     */
+    explicit Resubstitution_(
+        size_t max_inputs    = DefaultMaxInputs,
+        size_t max_divisors  = DefaultMaxDivisors,
+        size_t words         = DefaultWords,
+        size_t threads       = 0,
+        CostModel cost_model = CostModel::gateCount())
+        : max_inputs_(std::clamp<size_t>(max_inputs, 1, MaxInputs))
+        , max_divisors_(std::max<size_t>(max_divisors, 1))
+        , words_(std::max<size_t>(words, 1))
+        , threads_(threads == 0 ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : threads)
+        , cost_model_(cost_model)
+        , engine_(utils::getNewMersenneTwisterEngine())
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START Resubstitution");
+
+        log::debug("Simulating circuit on random patterns");
+        Simulation simulation(*circuit, words_);
+        simulation.randomizeInputs(*circuit, engine_);
+        simulation.run(*circuit);
+
+        // Topsort, from inputs to outputs.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+        size_t const size = circuit->getNumberOfGates();
+        std::vector<size_t> position(size);
+        for (size_t i = 0; i < gate_sorting.size(); ++i)
+        {
+            position.at(gate_sorting[i]) = i;
+        }
+
+        log::debug("Resubstituting gates");
+        std::vector<std::optional<impl::ResubstitutionCandidate_> > resubstitutions(gate_sorting.size());
+        utils::parallelFor(
+            gate_sorting.size(),
+            threads_,
+            [&circuit]() { return impl::WindowScratch_(*circuit); },
+            [&](size_t i, impl::WindowScratch_& scratch)
+            { resubstitutions[i] = findResubstitution_(*circuit, gate_sorting[i], position, simulation, scratch); });
+
+        log::debug("Committing resubstitutions");
+        std::vector<impl::ResubstitutionCandidate_*> chosen;
+        for (auto& resubstitution : resubstitutions)
+        {
+            if (resubstitution.has_value())
+            {
+                chosen.push_back(&*resubstitution);
+            }
+        }
+        // Stable sort keeps topological order among gates of equal gain.
+        std::ranges::stable_sort(
+            chosen,
+            [](impl::ResubstitutionCandidate_ const* lhs, impl::ResubstitutionCandidate_ const* rhs)
+            { return lhs->gain > rhs->gain; });
+
+        GateInfoContainer gate_info = acquireGateInfoContainer(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            gate_info.at(gateId) = {
+                circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
+        }
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_Resubstitution@");
+        // Gate, which is equal to divisor, is redirected to it.
+        std::vector<GateId> redirections(size);
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            redirections[gateId] = gateId;
+        }
+        std::vector<bool> taken(size, false);
+        auto const is_taken = [&taken](GateId gateId) { return taken[gateId]; };
+        for (impl::ResubstitutionCandidate_ const* resubstitution : chosen)
+        {
+            // Divisors in committed MFFC would survive, so gain would be lower.
+            if (std::ranges::any_of(resubstitution->mffc, is_taken) ||
+                std::ranges::any_of(resubstitution->divisors, is_taken))
+            {
+                continue;
+            }
+            for (GateId const gateId : resubstitution->mffc)
+            {
+                taken[gateId] = true;
+            }
+            log::debug("Gate ", resubstitution->root, " is resubstituted with gain ", resubstitution->gain);
+            countRule("gate_resubstituted");
+            commit_(*resubstitution, gate_info, redirections, *encoder, new_gate_name_prefix);
+        }
+
+        auto const resolve = [&redirections](GateId gateId)
+        {
+            while (gateId < redirections.size() && redirections[gateId] != gateId)
+            {
+                gateId = redirections[gateId];
+            }
+            return gateId;
+        };
+        for (auto& info : gate_info)
+        {
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : info.getOperands())
+            {
+                operands.push_back(resolve(operand));
+            }
+            info = {info.getType(), std::move(operands)};
+        }
+        GateIdContainer new_output_gates{};
+        new_output_gates.reserve(circuit->getOutputGates().size());
+        for (GateId const output_gate : circuit->getOutputGates())
+        {
+            new_output_gates.push_back(resolve(output_gate));
+        }
+
+        log::debug("END Resubstitution");
+        log::debug("=========================================================================================");
+        return {std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)), std::move(encoder)};
+    }
+
+private:
+    /* Returns resubstitution of `root` with positive gain, if it exists. */
+    std::optional<impl::ResubstitutionCandidate_> findResubstitution_(
+        CircuitT const& circuit,
+        GateId root,
+        std::vector<size_t> const& position,
+        Simulation const& simulation,
+        impl::WindowScratch_& scratch) const
+    {
+        if (!impl::isWindowGate_(circuit, root))
+        {
+            return std::nullopt;
+        }
+        std::vector<GateId> leaves;
+        std::vector<GateId> window = impl::collectWindow_(circuit, root, max_inputs_, leaves, scratch);
+        if (leaves.size() > max_inputs_)
+        {
+            return std::nullopt;
+        }
+        std::vector<GateId> mffc = impl::collectMffc_(circuit, root, scratch);
+        std::vector<GateId> const divisors = collectDivisors_(circuit, root, leaves, window, mffc, position, scratch);
+
+        // Truth tables of window gates are needed by divisors outside of window.
+        std::vector<GateId> gates = window;
+        for (GateId const divisor : divisors)
+        {
+            if (!scratch.isInWindow(divisor) && std::ranges::find(leaves, divisor) == leaves.end())
+            {
+                gates.push_back(divisor);
+            }
+        }
+        std::ranges::sort(gates, [&position](GateId lhs, GateId rhs) { return position[lhs] < position[rhs]; });
+        auto truths = impl::computeWindowTruthTables_(circuit, leaves, gates);
+
+        std::vector<Divisor_> candidates;
+        for (GateId const divisor : divisors)
+        {
+            candidates.push_back({divisor, simulation.getSignature(divisor), std::move(truths.at(divisor))});
+        }
+        Divisor_ const target{root, simulation.getSignature(root), std::move(truths.at(root))};
+        // Bits of truth tables of less than 6 leaves beyond `2^leaves` are zero.
+        uint64_t const mask = npn::getTruthMask(leaves.size());
+
+        size_t mffc_cost = 0;
+        for (GateId const gateId : mffc)
+        {
+            mffc_cost += cost_model_.getGateCost(circuit, gateId);
+        }
+        std::optional<impl::ResubstitutionCandidate_> result =
+            searchResubstitution_(candidates, target, mask, mffc_cost);
+        if (result.has_value())
+        {
+            result->root = root;
+            result->mffc = std::move(mffc);
+        }
+        return result;
+    }
+
+    /**
+     * Returns divisors of `root`: leaves and gates of window outside of MFFC,
+     * then gates, whose operands are divisors, which precede root.
+     */
+    std::vector<GateId> collectDivisors_(
+        CircuitT const& circuit,
+        GateId root,
+        std::vector<GateId> const& leaves,
+        std::vector<GateId> const& window,
+        std::vector<GateId> const& mffc,
+        std::vector<size_t> const& position,
+        impl::WindowScratch_ const& scratch) const
+    {
+        std::vector<GateId> divisors;
+        auto const is_divisor = [&divisors](GateId gateId)
+        { return std::ranges::find(divisors, gateId) != divisors.end(); };
+        for (GateId const leaf : leaves)
+        {
+            if (divisors.size() < max_divisors_)
+            {
+                divisors.push_back(leaf);
+            }
+        }
+        for (GateId const gateId : window)
+        {
+            if (divisors.size() < max_divisors_ && std::ranges::find(mffc, gateId) == mffc.end())
+            {
+                divisors.push_back(gateId);
+            }
+        }
+        for (size_t i = 0; i < divisors.size() && divisors.size() < max_divisors_; ++i)
+        {
+            for (GateId const user : circuit.getGateUsers(divisors[i]))
+            {
+                // Users, which follow root, may depend on it.
+                if (divisors.size() == max_divisors_ || position[user] >= position[root] || scratch.isInWindow(user) ||
+                    !impl::isWindowGate_(circuit, user) || is_divisor(user) ||
+                    !std::ranges::all_of(circuit.getGateOperands(user), is_divisor))
+                {
+                    continue;
+                }
+                divisors.push_back(user);
+            }
+        }
+        return divisors;
+    }
+
+    /**
+     * Searches for re-expression of target by divisors, which costs less than
+     * MFFC of target, from ones with less gates to ones with more gates.
+     */
+    std::optional<impl::ResubstitutionCandidate_> searchResubstitution_(
+        std::vector<Divisor_> const& divisors,
+        Divisor_ const& target,
+        uint64_t mask,
+        size_t mffc_cost) const
+    {
+        if (mffc_cost == 0)
+        {
+            return std::nullopt;
+        }
+        auto const binary_cost = [this](GateType type) { return cost_model_.getGateCost(type, 2); };
+        auto const make = [&](std::vector<size_t> const& used, std::vector<circuits_db::GateRecord> gates)
+        {
+            impl::ResubstitutionCandidate_ result;
+            for (size_t const index : used)
+            {
+                result.divisors.push_back(divisors[index].gate);
+            }
+            size_t cost = 0;
+            for (circuits_db::GateRecord const& gate : gates)
+            {
+                cost += cost_model_.getGateCost(gate.type, gate.arity);
+            }
+            result.gain  = mffc_cost - cost;
+            result.gates = std::move(gates);
+            return result;
+        };
+        auto const record = [](GateType type, uint8_t lhs, uint8_t rhs)
+        { return circuits_db::GateRecord{.type = type, .arity = 2, .operands = {lhs, rhs, 0}}; };
+
+        // Equal divisor or its negation.
+        for (size_t i = 0; i < divisors.size(); ++i)
+        {
+            auto const equal = [&](auto const& get, size_t word) { return get(divisors[i], word); };
+            if (matches_(target, mask, equal))
+            {
+                return make({i}, {});
+            }
+            auto const negation = [&](auto const& get, size_t word) { return ~get(divisors[i], word); };
+            if (cost_model_.getGateCost(GateType::NOT, 1) < mffc_cost && matches_(target, mask, negation))
+            {
+                return make({i}, {circuits_db::GateRecord{.type = GateType::NOT, .arity = 1, .operands = {}}});
+            }
+        }
+        size_t min_binary_cost = SIZE_MAX;
+        for (GateType const type : BinaryTypes_)
+        {
+            min_binary_cost = std::min(min_binary_cost, binary_cost(type));
+        }
+        if (min_binary_cost >= mffc_cost)
+        {
+            return std::nullopt;
+        }
+
+        // One gate over two divisors.
+        for (size_t i = 0; i < divisors.size(); ++i)
+        {
+            for (size_t j = i + 1; j < divisors.size(); ++j)
+            {
+                for (GateType const type : BinaryTypes_)
+                {
+                    if (binary_cost(type) >= mffc_cost)
+                    {
+                        continue;
+                    }
+                    auto const function = [&](auto const& get, size_t word)
+                    { return apply_(type, get(divisors[i], word), get(divisors[j], word)); };
+                    if (matches_(target, mask, function))
+                    {
+                        return make({i, j}, {record(type, 0, 1)});
+                    }
+                }
+            }
+        }
+        if (2 * min_binary_cost >= mffc_cost)
+        {
+            return std::nullopt;
+        }
+
+        // Two gates over three divisors: inner gate is AND, OR or XOR, outer gate is any binary gate. Third
+        // operand of AND (OR) must contain target (be contained in it), and of XOR is determined by target.
+        std::array<std::vector<size_t>, 2> supersets;
+        std::array<std::vector<size_t>, 2> subsets;
+        std::unordered_multimap<uint64_t, size_t> by_signature;
+        for (size_t k = 0; k < divisors.size(); ++k)
+        {
+            for (bool const negated : {false, true})
+            {
+                bool superset = true;
+                bool subset   = true;
+                for (size_t word = 0; word < words_; ++word)
+                {
+                    uint64_t const value = negated ? ~target.signature[word] : target.signature[word];
+                    superset             = superset && (value & ~divisors[k].signature[word]) == 0;
+                    subset               = subset && (divisors[k].signature[word] & ~value) == 0;
+                }
+                if (superset)
+                {
+                    supersets[static_cast<size_t>(negated)].push_back(k);
+                }
+                if (subset)
+                {
+                    subsets[static_cast<size_t>(negated)].push_back(k);
+                }
+            }
+            by_signature.emplace(hashSignature_(divisors[k].signature), k);
+        }
+        std::vector<uint64_t> inner_signature(words_);
+        std::vector<uint64_t> required(words_);
+        for (size_t i = 0; i < divisors.size(); ++i)
+        {
+            for (size_t j = i + 1; j < divisors.size(); ++j)
+            {
+                for (GateType const inner : {GateType::AND, GateType::OR, GateType::XOR})
+                {
+                    if (binary_cost(inner) + min_binary_cost >= mffc_cost)
+                    {
+                        continue;
+                    }
+                    for (size_t word = 0; word < words_; ++word)
+                    {
+                        inner_signature[word] =
+                            apply_(inner, divisors[i].signature[word], divisors[j].signature[word]);
+                    }
+                    auto const try_outer =
+                        [&](GateType outer, size_t k) -> std::optional<impl::ResubstitutionCandidate_>
+                    {
+                        if (k == i || k == j)
+                        {
+                            return std::nullopt;
+                        }
+                        auto const function = [&](auto const& get, size_t word)
+                        {
+                            uint64_t const value = apply_(inner, get(divisors[i], word), get(divisors[j], word));
+                            return apply_(outer, value, get(divisors[k], word));
+                        };
+                        if (!matches_(target, mask, function))
+                        {
+                            return std::nullopt;
+                        }
+                        return make({i, j, k}, {record(inner, 0, 1), record(outer, 3, 2)});
+                    };
+
+                    for (GateType const outer : BinaryTypes_)
+                    {
+                        if (binary_cost(inner) + binary_cost(outer) >= mffc_cost)
+                        {
+                            continue;
+                        }
+                        // Negated outer gate computes target, iff non-negated one computes its complement.
+                        bool const negated =
+                            outer == GateType::NAND || outer == GateType::NOR || outer == GateType::NXOR;
+                        uint64_t const flip = negated ? ~uint64_t{0} : 0;
+                        std::vector<size_t> candidates;
+                        if (outer == GateType::XOR || outer == GateType::NXOR)
+                        {
+                            for (size_t word = 0; word < words_; ++word)
+                            {
+                                required[word] = inner_signature[word] ^ target.signature[word] ^ flip;
+                            }
+                            auto const [begin, end] = by_signature.equal_range(hashSignature_(required.data()));
+                            for (auto it = begin; it != end; ++it)
+                            {
+                                candidates.push_back(it->second);
+                            }
+                        }
+                        else if (outer == GateType::AND || outer == GateType::NAND)
+                        {
+                            candidates = supersets[static_cast<size_t>(negated)];
+                        }
+                        else
+                        {
+                            candidates = subsets[static_cast<size_t>(negated)];
+                        }
+                        for (size_t const k : candidates)
+                        {
+                            if (auto result = try_outer(outer, k); result.has_value())
+                            {
+                                return result;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    uint64_t hashSignature_(uint64_t const* signature) const noexcept
+    {
+        uint64_t hash = 0;
+        for (size_t word = 0; word < words_; ++word)
+        {
+            hash ^= signature[word] + 0x9e3779b97f4a7c15ULL + (hash << 6U) + (hash >> 2U);
+        }
+        return hash;
+    }
+
+    static constexpr std::array<GateType, 6> BinaryTypes_{
+        GateType::AND, GateType::OR, GateType::XOR, GateType::NAND, GateType::NOR, GateType::NXOR};
+
+    static uint64_t apply_(GateType type, uint64_t lhs, uint64_t rhs) noexcept
+    {
+        switch (type)
+        {
+            case GateType::AND:
+                return lhs & rhs;
+            case GateType::OR:
+                return lhs | rhs;
+            case GateType::XOR:
+                return lhs ^ rhs;
+            case GateType::NAND:
+                return ~(lhs & rhs);
+            case GateType::NOR:
+                return ~(lhs | rhs);
+            default:
+                return ~(lhs ^ rhs);
+        }
+    }
+
+    /**
+     * Checks, that function of divisors computes target: first on simulation
+     * signatures, then exactly on truth tables over window leaves.
+     *
+     * @param function -- computes word of function, given accessor to words of divisors.
+     */
+    template<class FunctionT>
+    bool matches_(Divisor_ const& target, uint64_t mask, FunctionT const& function) const
+    {
+        auto const signature = [](Divisor_ const& divisor, size_t word) { return divisor.signature[word]; };
+        for (size_t word = 0; word < words_; ++word)
+        {
+            if (function(signature, word) != target.signature[word])
+            {
+                return false;
+            }
+        }
+        auto const truth = [](Divisor_ const& divisor, size_t word) { return divisor.truth[word]; };
+        for (size_t word = 0; word < target.truth.size(); ++word)
+        {
+            if ((function(truth, word) & mask) != target.truth[word])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /* Writes re-expression to `gate_info`: its last gate takes id of root. */
+    static void commit_(
+        impl::ResubstitutionCandidate_ const& resubstitution,
+        GateInfoContainer& gate_info,
+        std::vector<GateId>& redirections,
+        NameEncoder& encoder,
+        std::string const& new_gate_name_prefix)
+    {
+        if (resubstitution.gates.empty())
+        {
+            redirections[resubstitution.root] = resubstitution.divisors.front();
+            return;
+        }
+        std::vector<GateId> ids(resubstitution.divisors.begin(), resubstitution.divisors.end());
+        for (size_t gate = 0; gate < resubstitution.gates.size(); ++gate)
+        {
+            GateId id = resubstitution.root;
+            if (gate + 1 < resubstitution.gates.size())
+            {
+                id = encoder.encodeGate(getNewGateName_(new_gate_name_prefix, gate_info.size()));
+                gate_info.emplace_back();
+            }
+            circuits_db::GateRecord const& record = resubstitution.gates[gate];
+            GateIdContainer operands              = acquireGateIdContainer();
+            for (size_t i = 0; i < record.arity; ++i)
+            {
+                operands.push_back(ids[record.operands[i]]);
+            }
+            gate_info.at(id) = {record.type, std::move(operands)};
+            ids.push_back(id);
+        }
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_RESUBSTITUTION_HPP
@@ -0,0 +1,534 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_SUBCIRCUIT_MINIMIZATION_HPP
+#define CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_SUBCIRCUIT_MINIMIZATION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "core/algo.hpp"
+#include "core/cost_model.hpp"
+#include "core/npn.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+#include "synthesis/exact_synthesis.hpp"
+#include "synthesis/synthesis_cache.hpp"
+#include "utils/parallel.hpp"
+
+namespace cirbo::minimization
+{
+
+namespace impl
+{
+
+/**
+ * Window of circuit: `gates` are computed from `leaves` only, `outputs` are
+ * gates of window, which are used outside of it or are outputs of circuit.
+ * Gates are in topological order.
+ */
+struct Window_
+{
+    std::vector<GateId> leaves;
+    std::vector<GateId> gates;
+    std::vector<GateId> outputs;
+};
+
+/* Circuit over leaves of window, which computes its outputs with cost less by `gain`. */
+struct Replacement_
+{
+    Window_ window;
+    synthesis::SynthesizedCircuit circuit;
+    size_t gain = 0;
+};
+
+}  // namespace impl
+
+/**
+ * Local search transformer, that replaces small windows of circuit by smaller
+ * equivalent subcircuits.
+ *
+ * Window is grown from each gate towards inputs, reconvergence-driven: the
+ * leaf, whose expansion adds the least new leaves, is expanded while number of
+ * leaves and gates is bounded. Functions of window outputs are computed as truth
+ * tables over leaves, and minimum circuit for them is looked up in database of
+ * optimal circuits (single-output windows) or found by exact synthesis, limited
+ * to the size of window minus one. Replacement is taken, if it costs less
+ * than the window. Costs are given by `CostModel`, which counts gates by
+ * default, while exact synthesis minimizes the number of gates in any case.
+ *
+ * Windows are processed in parallel on unchanged circuit. Then windows with
+ * gain are committed greedily, largest gain first, skipping windows that share
+ * gates with already committed ones, so replacements never conflict.
+ *
+ * Note that replaced gates are left in circuit, so this algorithm must be followed
+ * by RedundantGatesCleaner, and preceded by it, since dangling users of gates
+ * make windows have more outputs.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class SubcircuitMinimization_ : public ITransformer<CircuitT>
+{
+public:
+    static constexpr size_t DefaultMaxInputs      = 4;
+    static constexpr size_t DefaultMaxOutputs     = 2;
+    static constexpr size_t DefaultMaxWindowGates = 8;
+    /** Default limit of conflicts for one SAT query. **/
+    static constexpr int64_t DefaultConflictLimit = 1000;
+
+private:
+    Basis basis_;
+    size_t max_inputs_;
+    size_t max_outputs_;
+    size_t max_window_gates_;
+    int64_t conflict_limit_;
+    size_t threads_;
+    std::shared_ptr<circuits_db::CircuitDatabase const> database_;
+    std::shared_ptr<synthesis::SynthesisCache> cache_;
+    CostModel cost_model_;
+
+public:
+    /**
+     * @param basis -- basis of replacements.
+     * @param max_inputs -- maximum number of window leaves, at most `npn::MaxVariables`.
+     * @param max_outputs -- maximum number of window outputs.
+     * @param max_window_gates -- maximum number of window gates.
+     * @param conflict_limit -- limit of conflicts for one SAT query, window is kept if exceeded.
+     * @param threads -- number of threads, 0 means number of hardware threads.
+     * @param database -- optional database of optimal circuits, consulted before exact synthesis.
+     * @param cache -- cache of exact synthesis results, may be shared by transformers.
+     * @param cost_model -- costs of gates, gates are counted by default.
+     */
+    explicit SubcircuitMinimization_(
+        Basis basis                                                  = Basis::BENCH,
+        size_t max_inputs                                            = DefaultMaxInputs,
+        size_t max_outputs                                           = DefaultMaxOutputs,
+        size_t max_window_gates                                      = DefaultMaxWindowGates,
+        int64_t conflict_limit                                       = DefaultConflictLimit,
+        size_t threads                                               = 0,
+        std::shared_ptr<circuits_db::CircuitDatabase const> database = nullptr,
+        std::shared_ptr<synthesis::SynthesisCache> cache             = std::make_shared<synthesis::SynthesisCache>(),
+        CostModel cost_model                                         = CostModel::gateCount())
+        : basis_(basis)
+        , max_inputs_(std::min(max_inputs, npn::MaxVariables))
+        , max_outputs_(std::max<size_t>(max_outputs, 1))
+        , max_window_gates_(std::max<size_t>(max_window_gates, 1))
+        , conflict_limit_(conflict_limit)
+        , threads_(threads == 0 ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : threads)
+        , database_(std::move(database))
+        , cache_(std::move(cache))
+        , cost_model_(cost_model)
+    {
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START SubcircuitMinimization");
+
+        // Topsort, from inputs to outputs.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+        std::vector<size_t> position(circuit->getNumberOfGates());
+        for (size_t i = 0; i < gate_sorting.size(); ++i)
+        {
+            position.at(gate_sorting[i]) = i;
+        }
+        std::vector<bool> is_output(circuit->getNumberOfGates(), false);
+        for (GateId const output : circuit->getOutputGates())
+        {
+            is_output.at(output) = true;
+        }
+
+        log::debug("Minimizing windows");
+        std::vector<std::optional<impl::Replacement_> > replacements(gate_sorting.size());
+        utils::parallelFor(
+            gate_sorting.size(),
+            threads_,
+            [&](size_t i) { replacements[i] = findReplacement_(*circuit, gate_sorting[i], position, is_output); });
+
+        log::debug("Committing replacements");
+        std::vector<impl::Replacement_*> chosen;
+        for (auto& replacement : replacements)
+        {
+            if (replacement.has_value())
+            {
+                chosen.push_back(&*replacement);
+            }
+        }
+        // Stable sort keeps topological order among windows of equal gain.
+        std::ranges::stable_sort(
+            chosen, [](impl::Replacement_ const* lhs, impl::Replacement_ const* rhs) { return lhs->gain > rhs->gain; });
+
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit->getNumberOfGates());
+        for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
+        {
+            gate_info.at(gateId) = {
+                circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
+        }
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_SubcircuitMinimization@");
+        // Window output, which is computed by other node of replacement, is redirected to it.
+        std::vector<GateId> redirections(circuit->getNumberOfGates());
+        for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
+        {
+            redirections[gateId] = gateId;
+        }
+        std::vector<bool> taken(circuit->getNumberOfGates(), false);
+        for (impl::Replacement_ const* replacement : chosen)
+        {
+            auto const& gates = replacement->window.gates;
+            if (std::ranges::any_of(gates, [&taken](GateId gateId) { return taken[gateId]; }))
+            {
+                continue;
+            }
+            for (GateId const gateId : gates)
+            {
+                taken[gateId] = true;
+            }
+            log::debug("Window of gate ", gates.back(), " is replaced with gain ", replacement->gain);
+            countRule("window_replaced");
+            commit_(*replacement, gate_info, redirections, *encoder, new_gate_name_prefix);
+        }
+
+        auto const resolve = [&redirections](GateId gateId)
+        {
+            while (gateId < redirections.size() && redirections[gateId] != gateId)
+            {
+                gateId = redirections[gateId];
+            }
+            return gateId;
+        };
+        for (auto& info : gate_info)
+        {
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : info.getOperands())
+            {
+                operands.push_back(resolve(operand));
+            }
+            info = {info.getType(), std::move(operands)};
+        }
+        GateIdContainer new_output_gates{};
+        new_output_gates.reserve(circuit->getOutputGates().size());
+        for (GateId const output_gate : circuit->getOutputGates())
+        {
+            new_output_gates.push_back(resolve(output_gate));
+        }
+
+        log::debug("END SubcircuitMinimization");
+        log::debug("=========================================================================================");
+        return {std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)), std::move(encoder)};
+    }
+
+private:
+    /* Returns replacement of window of `root` with positive gain, if it exists. */
+    std::optional<impl::Replacement_> findReplacement_(
+        CircuitT const& circuit,
+        GateId root,
+        std::vector<size_t> const& position,
+        std::vector<bool> const& is_output) const
+    {
+        std::optional<impl::Window_> window = extractWindow_(circuit, root, position, is_output);
+        if (!window.has_value())
+        {
+            return std::nullopt;
+        }
+        std::vector<uint64_t> const truths = computeTruthTables_(circuit, *window);
+        size_t const inputs                = window->leaves.size();
+        size_t const size                  = window->gates.size();
+        size_t window_cost                 = 0;
+        for (GateId const gateId : window->gates)
+        {
+            window_cost += cost_model_.getGateCost(circuit, gateId);
+        }
+
+        std::optional<synthesis::SynthesizedCircuit> best;
+        size_t best_cost = window_cost;
+        auto const offer = [&](std::optional<synthesis::SynthesizedCircuit> candidate)
+        {
+            if (!candidate.has_value())
+            {
+                return;
+            }
+            size_t cost = 0;
+            for (circuits_db::GateRecord const& gate : candidate->gates)
+            {
+                cost += cost_model_.getGateCost(gate.type, gate.arity);
+            }
+            if (cost < best_cost)
+            {
+                best      = std::move(candidate);
+                best_cost = cost;
+            }
+        };
+
+        size_t limit = size;
+        if (database_ != nullptr && truths.size() == 1)
+        {
+            std::optional<synthesis::SynthesizedCircuit> found = lookupDatabase_(truths.front(), inputs);
+            if (found.has_value())
+            {
+                limit = found->gates.size();
+            }
+            offer(std::move(found));
+        }
+        if (limit > 0)
+        {
+            synthesis::ExactSynthesizer const synthesizer(basis_, limit - 1, conflict_limit_, 1, cache_);
+            offer(synthesizer.synthesize(truths, inputs));
+        }
+        if (!best.has_value())
+        {
+            return std::nullopt;
+        }
+        return impl::Replacement_{std::move(*window), std::move(*best), window_cost - best_cost};
+    }
+
+    /* Grows reconvergence-driven window of `root`. */
+    std::optional<impl::Window_> extractWindow_(
+        CircuitT const& circuit,
+        GateId root,
+        std::vector<size_t> const& position,
+        std::vector<bool> const& is_output) const
+    {
+        if (!isExpandable_(circuit, root))
+        {
+            return std::nullopt;
+        }
+        impl::Window_ window;
+        window.gates.push_back(root);
+        auto const contains = [&window](GateId gateId)
+        { return std::ranges::find(window.gates, gateId) != window.gates.end(); };
+        auto const add_leaves = [&](GateId gateId)
+        {
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                if (!contains(operand) && std::ranges::find(window.leaves, operand) == window.leaves.end())
+                {
+                    window.leaves.push_back(operand);
+                }
+            }
+        };
+        add_leaves(root);
+        if (window.leaves.size() > max_inputs_)
+        {
+            return std::nullopt;
+        }
+
+        while (window.gates.size() < max_window_gates_)
+        {
+            // Leaf, whose expansion adds the least leaves, so reconvergent paths get inside of window.
+            size_t best_leaf = window.leaves.size();
+            size_t best_cost = SIZE_MAX;
+            for (size_t i = 0; i < window.leaves.size(); ++i)
+            {
+                GateId const leaf = window.leaves[i];
+                if (!isExpandable_(circuit, leaf))
+                {
+                    continue;
+                }
+                size_t cost = 0;
+                for (GateId const operand : circuit.getGateOperands(leaf))
+                {
+                    if (!contains(operand) && std::ranges::find(window.leaves, operand) == window.leaves.end())
+                    {
+                        ++cost;
+                    }
+                }
+                if (cost < best_cost)
+                {
+                    best_leaf = i;
+                    best_cost = cost;
+                }
+            }
+            if (best_leaf == window.leaves.size() || window.leaves.size() - 1 + best_cost > max_inputs_)
+            {
+                break;
+            }
+            GateId const leaf = window.leaves[best_leaf];
+            window.leaves.erase(window.leaves.begin() + static_cast<std::ptrdiff_t>(best_leaf));
+            window.gates.push_back(leaf);
+            add_leaves(leaf);
+        }
+
+        std::ranges::sort(window.gates, [&position](GateId lhs, GateId rhs) { return position[lhs] < position[rhs]; });
+        for (GateId const gateId : window.gates)
+        {
+            auto const& users = circuit.getGateUsers(gateId);
+            if (is_output[gateId] || std::ranges::any_of(users, [&contains](GateId user) { return !contains(user); }))
+            {
+                window.outputs.push_back(gateId);
+            }
+        }
+        if (window.outputs.size() > max_outputs_)
+        {
+            return std::nullopt;
+        }
+        return window;
+    }
+
+    /* Returns true iff gate may be inside of window. */
+    static bool isExpandable_(CircuitT const& circuit, GateId gateId)
+    {
+        switch (circuit.getGateType(gateId))
+        {
+            case GateType::NOT:
+            case GateType::AND:
+            case GateType::NAND:
+            case GateType::OR:
+            case GateType::NOR:
+            case GateType::XOR:
+            case GateType::NXOR:
+            case GateType::IFF:
+            case GateType::MUX:
+            case GateType::BUFF:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /* Returns truth tables of window outputs, in the format of `core/npn.hpp`. */
+    static std::vector<uint64_t> computeTruthTables_(CircuitT const& circuit, impl::Window_ const& window)
+    {
+        std::vector<std::pair<GateId, uint64_t> > values;
+        for (size_t i = 0; i < window.leaves.size(); ++i)
+        {
+            values.emplace_back(window.leaves[i], npn::VariableMasks[i]);
+        }
+        auto const value = [&values](GateId gateId)
+        { return std::ranges::find(values, gateId, &std::pair<GateId, uint64_t>::first)->second; };
+
+        for (GateId const gateId : window.gates)
+        {
+            GateIdContainer const& operands = circuit.getGateOperands(gateId);
+            GateType const type             = circuit.getGateType(gateId);
+            uint64_t result                 = value(operands.front());
+            switch (type)
+            {
+                case GateType::NOT:
+                    result = ~result;
+                    break;
+                case GateType::MUX:
+                    // MUX(x, y, z) is y when x is false and z otherwise.
+                    result = (~result & value(operands[1])) | (result & value(operands[2]));
+                    break;
+                case GateType::AND:
+                case GateType::NAND:
+                case GateType::OR:
+                case GateType::NOR:
+                case GateType::XOR:
+                case GateType::NXOR:
+                    for (size_t i = 1; i < operands.size(); ++i)
+                    {
+                        uint64_t const other = value(operands[i]);
+                        if (type == GateType::AND || type == GateType::NAND)
+                        {
+                            result &= other;
+                        }
+                        else if (type == GateType::OR || type == GateType::NOR)
+                        {
+                            result |= other;
+                        }
+                        else
+                        {
+                            result ^= other;
+                        }
+                    }
+                    if (type == GateType::NAND || type == GateType::NOR || type == GateType::NXOR)
+                    {
+                        result = ~result;
+                    }
+                    break;
+                default:
+                    break;
+            }
+            values.emplace_back(gateId, result);
+        }
+
+        std::vector<uint64_t> truths;
+        for (GateId const output : window.outputs)
+        {
+            truths.push_back(value(output) & npn::getTruthMask(window.leaves.size()));
+        }
+        return truths;
+    }
+
+    /**
+     * Returns circuit of function from database. Database keeps NPN-canonical
+     * functions, so negations of inputs and output cost additional NOT gates.
+     */
+    std::optional<synthesis::SynthesizedCircuit> lookupDatabase_(uint64_t truth, size_t inputs) const
+    {
+        npn::CanonicalForm const form = npn::canonize(truth, inputs);
+        auto const view               = database_->find(basis_, form.truth, inputs);
+        if (!view.has_value())
+        {
+            return std::nullopt;
+        }
+        circuits_db::DatabaseCircuit circuit = circuits_db::restoreCircuit(view->toCircuit(), form.transform);
+        return synthesis::SynthesizedCircuit{
+            .inputs = circuit.inputs, .outputs = {circuit.output}, .gates = std::move(circuit.gates)};
+    }
+
+    /* Writes replacement to `gate_info`: its nodes, which compute window outputs, take their ids. */
+    static void commit_(
+        impl::Replacement_ const& replacement,
+        GateInfoContainer& gate_info,
+        std::vector<GateId>& redirections,
+        NameEncoder& encoder,
+        std::string const& new_gate_name_prefix)
+    {
+        impl::Window_ const& window                  = replacement.window;
+        synthesis::SynthesizedCircuit const& circuit = replacement.circuit;
+        size_t const inputs                          = window.leaves.size();
+
+        std::vector<GateId> ids(window.leaves.begin(), window.leaves.end());
+        for (size_t gate = 0; gate < circuit.gates.size(); ++gate)
+        {
+            auto const node = static_cast<uint8_t>(inputs + gate);
+            auto const it   = std::ranges::find(circuit.outputs, node);
+            GateId id       = 0;
+            if (it != circuit.outputs.end())
+            {
+                id = window.outputs[static_cast<size_t>(it - circuit.outputs.begin())];
+            }
+            else
+            {
+                id = encoder.encodeGate(getNewGateName_(new_gate_name_prefix, gate_info.size()));
+                gate_info.emplace_back();
+            }
+            circuits_db::GateRecord const& record = circuit.gates[gate];
+            GateIdContainer operands              = acquireGateIdContainer();
+            for (size_t i = 0; i < record.arity; ++i)
+            {
+                operands.push_back(ids[record.operands[i]]);
+            }
+            gate_info.at(id) = {record.type, std::move(operands)};
+            ids.push_back(id);
+        }
+        for (size_t output = 0; output < window.outputs.size(); ++output)
+        {
+            GateId const id = ids[circuit.outputs[output]];
+            if (id != window.outputs[output])
+            {
+                redirections[window.outputs[output]] = id;
+            }
+        }
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_SUBCIRCUIT_MINIMIZATION_HPP
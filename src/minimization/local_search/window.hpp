@@ -0,0 +1,259 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_WINDOW_HPP
+#define CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_WINDOW_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/sop.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+
+/**
+ * Helpers of local search transformers, which collapse windows of circuit
+ * (reconvergence-driven cones of gates) into truth tables over their leaves.
+ */
+namespace cirbo::minimization::impl
+{
+
+/* Buffers of one thread, which processes windows of one circuit. */
+struct WindowScratch_
+{
+    /* Number of users of each gate, outputs of circuit included, changed only temporarily. */
+    std::vector<uint32_t> references;
+    /* Gate is in current window iff its mark is equal to `stamp`. */
+    std::vector<uint32_t> marks;
+    uint32_t stamp = 0;
+
+    explicit WindowScratch_(ICircuit const& circuit)
+        : references(circuit.getNumberOfGates(), 0)
+        , marks(circuit.getNumberOfGates(), 0)
+    {
+        for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+        {
+            for (GateId const operand : circuit.getGateOperands(gateId))
+            {
+                ++references.at(operand);
+            }
+        }
+        for (GateId const output : circuit.getOutputGates())
+        {
+            ++references.at(output);
+        }
+    }
+
+    [[nodiscard]]
+    bool isInWindow(GateId gateId) const noexcept
+    {
+        return marks[gateId] == stamp;
+    }
+};
+
+/* Returns true iff gate may be inside of window. */
+inline bool isWindowGate_(ICircuit const& circuit, GateId gateId)
+{
+    switch (circuit.getGateType(gateId))
+    {
+        case GateType::NOT:
+        case GateType::AND:
+        case GateType::NAND:
+        case GateType::OR:
+        case GateType::NOR:
+        case GateType::XOR:
+        case GateType::NXOR:
+        case GateType::IFF:
+        case GateType::MUX:
+        case GateType::BUFF:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Grows reconvergence-driven window of `root`: the leaf, whose expansion adds
+ * the least new leaves, is expanded while number of leaves is at most
+ * `max_leaves`. Gates of window get marked in `scratch`.
+ *
+ * @return gates of window, `root` first.
+ */
+inline std::vector<GateId> collectWindow_(
+    ICircuit const& circuit,
+    GateId root,
+    size_t max_leaves,
+    std::vector<GateId>& leaves,
+    WindowScratch_& scratch)
+{
+    uint32_t const stamp = ++scratch.stamp;
+    std::vector<GateId> gates{root};
+    scratch.marks[root] = stamp;
+    auto const is_new   = [&](GateId gateId)
+    { return scratch.marks[gateId] != stamp && std::ranges::find(leaves, gateId) == leaves.end(); };
+    auto const add_leaves = [&](GateId gateId)
+    {
+        for (GateId const operand : circuit.getGateOperands(gateId))
+        {
+            if (is_new(operand))
+            {
+                leaves.push_back(operand);
+            }
+        }
+    };
+    add_leaves(root);
+
+    while (true)
+    {
+        // Leaf, whose expansion adds the least leaves, so reconvergent paths get inside of window.
+        size_t best_leaf = leaves.size();
+        size_t best_cost = SIZE_MAX;
+        for (size_t i = 0; i < leaves.size(); ++i)
+        {
+            if (!isWindowGate_(circuit, leaves[i]))
+            {
+                continue;
+            }
+            auto const& operands = circuit.getGateOperands(leaves[i]);
+            auto const cost      = static_cast<size_t>(std::ranges::count_if(operands, is_new));
+            if (cost < best_cost)
+            {
+                best_leaf = i;
+                best_cost = cost;
+            }
+        }
+        if (best_leaf == leaves.size() || leaves.size() - 1 + best_cost > max_leaves)
+        {
+            break;
+        }
+        GateId const leaf = leaves[best_leaf];
+        leaves.erase(leaves.begin() + static_cast<std::ptrdiff_t>(best_leaf));
+        gates.push_back(leaf);
+        scratch.marks[leaf] = stamp;
+        add_leaves(leaf);
+    }
+    return gates;
+}
+
+/**
+ * Dereferences operands of gate, recursively, and collects gates (gate
+ * itself included), which lose all references, so they form maximum
+ * fanout-free cone of the gate. Cone is bounded by current window.
+ */
+inline void dereferenceWindow_(
+    ICircuit const& circuit,
+    GateId gateId,
+    WindowScratch_& scratch,
+    std::vector<GateId>& removed)
+{
+    removed.push_back(gateId);
+    for (GateId const operand : circuit.getGateOperands(gateId))
+    {
+        if (--scratch.references[operand] == 0 && scratch.isInWindow(operand))
+        {
+            dereferenceWindow_(circuit, operand, scratch, removed);
+        }
+    }
+}
+
+/* Reverts `dereferenceWindow_`. */
+inline void referenceWindow_(ICircuit const& circuit, GateId gateId, WindowScratch_& scratch)
+{
+    for (GateId const operand : circuit.getGateOperands(gateId))
+    {
+        if (scratch.references[operand]++ == 0 && scratch.isInWindow(operand))
+        {
+            referenceWindow_(circuit, operand, scratch);
+        }
+    }
+}
+
+/* Returns maximum fanout-free cone of `root`, bounded by current window. */
+inline std::vector<GateId> collectMffc_(ICircuit const& circuit, GateId root, WindowScratch_& scratch)
+{
+    std::vector<GateId> mffc;
+    dereferenceWindow_(circuit, root, scratch, mffc);
+    referenceWindow_(circuit, root, scratch);
+    return mffc;
+}
+
+/**
+ * Computes truth tables of gates over leaves (see `core/sop.hpp`).
+ *
+ * @param gates -- gates in topological order, whose operands are leaves or previous gates.
+ */
+inline std::unordered_map<GateId, sop::TruthTable> computeWindowTruthTables_(
+    ICircuit const& circuit,
+    std::vector<GateId> const& leaves,
+    std::vector<GateId> const& gates)
+{
+    size_t const inputs = leaves.size();
+    std::unordered_map<GateId, sop::TruthTable> values;
+    for (size_t i = 0; i < inputs; ++i)
+    {
+        values.emplace(leaves[i], sop::makeVariable(i, inputs));
+    }
+
+    for (GateId const gateId : gates)
+    {
+        GateIdContainer const& operands = circuit.getGateOperands(gateId);
+        GateType const type             = circuit.getGateType(gateId);
+        sop::TruthTable result          = values.at(operands.front());
+        switch (type)
+        {
+            case GateType::NOT:
+                result = sop::negate(std::move(result), inputs);
+                break;
+            case GateType::MUX:
+            {
+                // MUX(x, y, z) is y when x is false and z otherwise.
+                sop::TruthTable const& lhs = values.at(operands[1]);
+                sop::TruthTable const& rhs = values.at(operands[2]);
+                for (size_t word = 0; word < result.size(); ++word)
+                {
+                    result[word] = (~result[word] & lhs[word]) | (result[word] & rhs[word]);
+                }
+                break;
+            }
+            case GateType::AND:
+            case GateType::NAND:
+            case GateType::OR:
+            case GateType::NOR:
+            case GateType::XOR:
+            case GateType::NXOR:
+                for (size_t i = 1; i < operands.size(); ++i)
+                {
+                    sop::TruthTable const& other = values.at(operands[i]);
+                    for (size_t word = 0; word < result.size(); ++word)
+                    {
+                        if (type == GateType::AND || type == GateType::NAND)
+                        {
+                            result[word] &= other[word];
+                        }
+                        else if (type == GateType::OR || type == GateType::NOR)
+                        {
+                            result[word] |= other[word];
+                        }
+                        else
+                        {
+                            result[word] ^= other[word];
+                        }
+                    }
+                }
+                if (type == GateType::NAND || type == GateType::NOR || type == GateType::NXOR)
+                {
+                    result = sop::negate(std::move(result), inputs);
+                }
+                break;
+            default:
+                break;
+        }
+        values.insert_or_assign(gateId, std::move(result));
+    }
+    return values;
+}
+
+}  // namespace cirbo::minimization::impl
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_LOCAL_SEARCH_WINDOW_HPP
@@ -0,0 +1,209 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_BALANCE_SYMMETRICAL_GATES_HPP
+#define CIRBO_SEARCH_MINIMIZATION_BALANCE_SYMMETRICAL_GATES_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <queue>
+#include <ranges>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Transformer, that rebuilds trees of binary symmetrical gates (AND, OR and XOR) as balanced trees
+ * with respect to levels of their operands. For example: AND(AND(AND(0, 1), 2), 3) => AND(AND(0, 1), AND(2, 3))
+ *
+ * Maximal tree (supergate) consists of binary gates of the same type, which have single user
+ * inside of the tree and are not outputs. Tree is rebuilt Huffman-style: two operands with the
+ * least levels are merged first, so depth of tree root gets minimal, while number of gates is
+ * kept. Gates of tree are reused, so no new gates are created. Tree is rebuilt only if depth of
+ * its root decreases.
+ *
+ * Note that this algorithm requires RedundantGatesCleaner to be applied right before and works
+ * best right after DisconnectSymmetricalGates with arity 2.
+ *
+ * @tparam CircuitT
+ */
+template<
+    class CircuitT,
+    bool EnableAND = false,
+    bool EnableOR  = false,
+    bool EnableXOR = false,
+    typename       = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class BalanceSymmetricalGates_ : public ITransformer<CircuitT>
+{
+private:
+    std::set<GateType> validParams;
+
+public:
+    /**
+     * Gates are only reconnected, so only duplicates may appear.
+     */
+    [[nodiscard]]
+    PassContract getContract() const override
+    {
+        return {invariant::NONE, invariant::NONE, invariant::DEDUPLICATED, false};
+    }
+
+    /**
+     * Applies BalanceSymmetricalGates_ transformer to `circuit`
+     * @param circuit -- circuit to transform.
+     * @param encoder -- circuit encoder.
+     * @return  circuit and encoder after transformation.
+     */
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START BalanceSymmetricalGates");
+
+        if constexpr (EnableAND)
+        {
+            validParams.insert(GateType::AND);
+        }
+        if constexpr (EnableOR)
+        {
+            validParams.insert(GateType::OR);
+        }
+        if constexpr (EnableXOR)
+        {
+            validParams.insert(GateType::XOR);
+        }
+
+        log::debug("Top sort");
+        GateIdContainer const gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+
+        log::debug("Rebuild schema");
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit->getNumberOfGates());
+        for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
+        {
+            gate_info.at(gateId) = {
+                circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
+        }
+
+        // Levels of gates in the new circuit: inputs and constants are at level 0.
+        std::vector<size_t> levels(circuit->getNumberOfGates(), 0);
+        auto const compute_level = [&](GateId gateId)
+        {
+            size_t level = 0;
+            for (GateId const operand : gate_info.at(gateId).getOperands())
+            {
+                level = std::max(level, levels.at(operand) + 1);
+            }
+            levels.at(gateId) = level;
+        };
+
+        // From inputs to outputs, so levels of operands are final, when tree root is processed.
+        for (GateId const gateId : std::ranges::reverse_view(gate_sorting))
+        {
+            compute_level(gateId);
+            if (!isBinarySymmetrical_(*circuit, gateId) || isAbsorbed_(*circuit, gateId))
+            {
+                continue;
+            }
+
+            GateIdContainer leaves;
+            GateIdContainer internal;
+            collectTree_(*circuit, gateId, leaves, internal);
+            if (internal.empty())
+            {
+                continue;
+            }
+
+            // Huffman-style merging of operands with the least levels, ties are broken by order of leaves.
+            using Item = std::pair<size_t, size_t>;
+            std::priority_queue<Item, std::vector<Item>, std::greater<> > queue;
+            std::vector<GateId> items(leaves.begin(), leaves.end());
+            for (size_t i = 0; i < leaves.size(); ++i)
+            {
+                queue.emplace(levels.at(leaves[i]), i);
+            }
+            std::vector<std::pair<size_t, size_t> > merges;
+            while (queue.size() > 1)
+            {
+                auto const [lhs_level, lhs] = queue.top();
+                queue.pop();
+                auto const [rhs_level, rhs] = queue.top();
+                queue.pop();
+                merges.emplace_back(lhs, rhs);
+                queue.emplace(std::max(lhs_level, rhs_level) + 1, items.size());
+                items.push_back(SIZE_MAX);
+            }
+            if (queue.top().first >= levels.at(gateId))
+            {
+                continue;
+            }
+
+            // Merges reuse gates of tree, the last one is the tree root.
+            countRule("balanced_tree");
+            internal.push_back(gateId);
+            GateType const type = circuit->getGateType(gateId);
+            for (size_t i = 0; i < merges.size(); ++i)
+            {
+                GateId const newGateId      = internal.at(i);
+                items.at(leaves.size() + i) = newGateId;
+                gate_info.at(newGateId)     = {type, {items.at(merges[i].first), items.at(merges[i].second)}};
+                compute_level(newGateId);
+            }
+        }
+
+        log::debug("END BalanceSymmetricalGates");
+        log::debug("=========================================================================================");
+
+        return {std::make_unique<CircuitT>(std::move(gate_info), circuit->getOutputGates()), std::move(encoder)};
+    };
+
+private:
+    /* Returns true iff gate is binary gate of enabled symmetrical type with distinct operands. */
+    bool isBinarySymmetrical_(CircuitT const& circuit, GateId gateId) const
+    {
+        GateIdContainer const& operands = circuit.getGateOperands(gateId);
+        return validParams.find(circuit.getGateType(gateId)) != validParams.end() && operands.size() == 2 &&
+               operands[0] != operands[1];
+    }
+
+    /* Returns true iff gate is inside of the tree of its single user. */
+    bool isAbsorbed_(CircuitT const& circuit, GateId gateId) const
+    {
+        GateIdContainer const& users = circuit.getGateUsers(gateId);
+        return users.size() == 1 && !circuit.isOutputGate(gateId) && isBinarySymmetrical_(circuit, users.front()) &&
+               circuit.getGateType(users.front()) == circuit.getGateType(gateId);
+    }
+
+    /* Collects leaves and internal gates (root excluded) of the tree of `root`, leaves from left to right. */
+    void collectTree_(CircuitT const& circuit, GateId root, GateIdContainer& leaves, GateIdContainer& internal) const
+    {
+        for (GateId const operand : circuit.getGateOperands(root))
+        {
+            if (isBinarySymmetrical_(circuit, operand) && isAbsorbed_(circuit, operand))
+            {
+                internal.push_back(operand);
+                collectTree_(circuit, operand, leaves, internal);
+            }
+            else
+            {
+                leaves.push_back(operand);
+            }
+        }
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_BALANCE_SYMMETRICAL_GATES_HPP
@@ -64,7 +64,7 @@ public:
             validConnectTypes.insert(GateType::XOR);
         }
 
-        GateInfoContainer gate_info(circuit->getNumberOfGates());
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit->getNumberOfGates());
         BoolVector visit_mask(circuit->getNumberOfGates(), false);
         std::vector<impl::VisitCounter> visit_counters(circuit->getNumberOfGates());
 
@@ -86,7 +86,8 @@ public:
             }
             else
             {
-                gate_info.at(gateId) = {circuit->getGateType(gateId), circuit->getGateOperands(gateId)};
+                gate_info.at(gateId) = {
+                    circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
             }
         }
 
@@ -106,7 +107,7 @@ private:
             (circuit.getGateType(iteration_gate) == GateType::XOR ||
              circuit.getGateType(iteration_gate) == GateType::NXOR);
 
-        GateIdContainer new_operands_{};
+        GateIdContainer new_operands_ = acquireGateIdContainer();
         GateIdContainer gates_to_check{};
 
         std::unordered_map<GateId, size_t> number_of_takes{};
@@ -136,6 +137,7 @@ private:
                     !circuit.isOutputGate(operandId))
                 {
                     // Гейт нам полностью подходит. Мы берем всех его детей.
+                    countRule("merged_gate");
                     visit_queue.push(operandId);
                     number_of_takes[operandId] += number_of_takes[curr_gate];
                 }
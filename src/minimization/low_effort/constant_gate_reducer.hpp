@@ -44,6 +44,19 @@ template<class CircuitT>
 class ConstantGateReducer_ : public ITransformer<CircuitT>
 {
 public:
+    /**
+     * Folded gates are left unreachable, new NOT gates and gadgets for constant outputs may be created.
+     */
+    [[nodiscard]]
+    PassContract getContract() const override
+    {
+        return {
+            invariant::NONE,
+            invariant::CONSTANTS_FOLDED,
+            invariant::NO_DANGLING | invariant::DEDUPLICATED | invariant::NO_NOT_CHAINS,
+            true};
+    }
+
     /**
      * Applies ConstantGateReducer_ transformer to `circuit`
      * @param circuit -- circuit to transform.
@@ -66,7 +79,7 @@ public:
         GateIdContainer const gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
 
         size_t circuit_size = circuit->getNumberOfGates();
-        GateInfoContainer gate_info(circuit_size);
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit_size);
 
         // Surjection of old gate ids to new gate ids.
         std::vector<GateId> old_to_new_gateId(circuit_size, SIZE_MAX);
@@ -74,10 +87,12 @@ public:
         // Evaluate circuit.
         auto result_assignment = circuit->template evaluateCircuit<VectorAssignment<true>>(VectorAssignment<false>{});
 
+        // Buffer is shared between iterations to avoid allocations.
+        GateIdContainer operands = acquireGateIdContainer();
         for (GateId const gate_id : std::ranges::reverse_view(gate_sorting))
         {
             GateType gate_type = circuit->getGateType(gate_id);
-            GateIdContainer operands{};
+            operands.clear();
 
             // After partial circuit calculation, we need to leave only undefined gates.
             // Defined gates from the circuit must be removed, and users of these gates
@@ -129,7 +144,7 @@ public:
                 }
 
                 // Prepare gate_info for current gate.
-                gate_info.at(gate_id) = {gate_type, operands};
+                gate_info.at(gate_id) = {gate_type, acquireGateIdContainer(operands)};
 
                 // If, after the reduction of the assigned gates, current gate left with only one operand,
                 // then all its users must be transferred either to its operand or to its negation.
@@ -192,10 +207,12 @@ public:
             // these gates will be without users and will be removed later by a `RedundantGatesCleaner_` transformer.
             else if (result_assignment->getGateState(gate_id) == GateState::TRUE)
             {
+                countRule("folded_constant");
                 gate_info.at(gate_id) = {GateType::CONST_TRUE, {}};
             }
             else if (result_assignment->getGateState(gate_id) == GateState::FALSE)
             {
+                countRule("folded_constant");
                 gate_info.at(gate_id) = {GateType::CONST_FALSE, {}};
             }
             else
@@ -217,6 +234,7 @@ public:
             }
             else
             {
+                countRule("constant_output");
                 createMiniCircuit_(
                     gate_info,
                     *encoder,
@@ -231,7 +249,7 @@ public:
 
         return {
             std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)),
-            std::make_unique<NameEncoder>(*encoder)};
+            std::move(encoder)};
     };
 
 private:
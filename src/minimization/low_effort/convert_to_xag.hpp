@@ -0,0 +1,119 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_CONVERT_TO_XAG_HPP
+#define CIRBO_SEARCH_MINIMIZATION_CONVERT_TO_XAG_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Transformer, that expresses gates by AND, XOR and NOT gates, so circuit
+ * becomes XOR-AND graph (see `core/structures/xag.hpp`). Each gate keeps its
+ * id, so outputs and users are kept:
+ *   - NAND(x, y) => NOT(AND(x, y)), NXOR(x, y) => NOT(XOR(x, y)),
+ *   - OR(x, y) => NOT(AND(NOT(x), NOT(y))), NOR(x, y) => AND(NOT(x), NOT(y)),
+ *   - MUX(x, y, z) => XOR(y, AND(x, XOR(y, z))), which costs one AND gate,
+ *   - IFF(x) and BUFF(x) => NOT(NOT(x)).
+ *
+ * Note that new NOT gates may form chains and duplicates, so this algorithm must be
+ * followed by ReduceNotComposition, RedundantGatesCleaner and DuplicateGatesCleaner.
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class ConvertToXAG_ : public ITransformer<CircuitT>
+{
+public:
+    /**
+     * Applies ConvertToXAG_ transformer to `circuit`
+     * @param circuit -- circuit to transform.
+     * @param encoder -- circuit encoder.
+     * @return  circuit and encoder after transformation.
+     */
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START ConvertToXAG");
+
+        size_t const size           = circuit->getNumberOfGates();
+        GateInfoContainer gate_info = acquireGateInfoContainer(size);
+        auto const prefix           = (getUniqueId_() + "::new_gate_ConvertToXAG@");
+        auto const add_gate         = [&](GateType type, GateIdContainer operands)
+        {
+            GateId const id = encoder->encodeGate(getNewGateName_(prefix, gate_info.size()));
+            gate_info.emplace_back(type, std::move(operands));
+            return id;
+        };
+        auto const negate_operands = [&](GateId gateId)
+        {
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : circuit->getGateOperands(gateId))
+            {
+                operands.push_back(add_gate(GateType::NOT, acquireGateIdContainer({operand})));
+            }
+            return operands;
+        };
+
+        for (GateId gateId = 0; gateId < size; ++gateId)
+        {
+            GateIdContainer const& operands = circuit->getGateOperands(gateId);
+            GateType const type             = circuit->getGateType(gateId);
+            // New gates are added before gate is written, since they may reallocate `gate_info`.
+            GateInfo info;
+            switch (type)
+            {
+                case GateType::NAND:
+                    info = {GateType::NOT, {add_gate(GateType::AND, acquireGateIdContainer(operands))}};
+                    break;
+                case GateType::NXOR:
+                    info = {GateType::NOT, {add_gate(GateType::XOR, acquireGateIdContainer(operands))}};
+                    break;
+                case GateType::OR:
+                    info = {GateType::NOT, {add_gate(GateType::AND, negate_operands(gateId))}};
+                    break;
+                case GateType::NOR:
+                    info = {GateType::AND, negate_operands(gateId)};
+                    break;
+                case GateType::MUX:
+                {
+                    GateId const difference =
+                        add_gate(GateType::XOR, acquireGateIdContainer({operands.at(1), operands.at(2)}));
+                    GateId const selected =
+                        add_gate(GateType::AND, acquireGateIdContainer({operands.at(0), difference}));
+                    info = {GateType::XOR, acquireGateIdContainer({operands.at(1), selected})};
+                    break;
+                }
+                case GateType::IFF:
+                case GateType::BUFF:
+                    info = {GateType::NOT, {add_gate(GateType::NOT, acquireGateIdContainer(operands))}};
+                    break;
+                default:
+                    gate_info.at(gateId) = {type, acquireGateIdContainer(operands)};
+                    continue;
+            }
+            gate_info.at(gateId) = std::move(info);
+            countRule("converted_to_xag");
+        }
+
+        log::debug("END ConvertToXAG");
+        log::debug("=========================================================================================");
+
+        return {std::make_unique<CircuitT>(std::move(gate_info), circuit->getOutputGates()), std::move(encoder)};
+    };
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_CONVERT_TO_XAG_HPP
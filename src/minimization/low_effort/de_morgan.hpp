@@ -2,7 +2,6 @@
 #define CIRBO_SEARCH_MINIMIZATION_DE_MORGAN_HPP
 
 #include <cstdint>
-#include <map>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -36,13 +35,6 @@ public:
     {
         log::debug("=========================================================================================");
         log::debug("START DeMorgan");
-        std::map<GateType, GateType> inverse_type = {
-            {GateType::AND,  GateType::OR },
-            {GateType::OR,   GateType::AND},
-            {GateType::NAND, GateType::OR },
-            {GateType::NOR,  GateType::AND},
-            {GateType::NXOR, GateType::XOR},
-        };
         bool rehang = false;
 
         auto new_gate_name_prefix = (getUniqueId_() + "::new_gate_de_Morgan@");
@@ -53,7 +45,7 @@ public:
         log::debug("Rebuild schema");
         GateIdContainer indexes_of_not(circuit->getNumberOfGates(), SIZE_MAX);
         GateIdContainer count_branches(circuit->getNumberOfGates(), 0);
-        GateInfoContainer gate_info(circuit->getNumberOfGates());
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit->getNumberOfGates());
 
         for (GateId gateId : gate_sorting)
         {
@@ -72,8 +64,9 @@ public:
                     else
                     {
                         // применяем правило де Моргана
+                        countRule("de_morgan");
                         gate_info.at(indexes_of_not.at(gateId)) = {
-                            inverse_type.at(circuit->getGateType(gateId)),
+                            getDualType_(circuit->getGateType(gateId)),
                             get_new_operands_(
                                 *circuit,
                                 gate_info,
@@ -90,7 +83,8 @@ public:
                 {
                     // заменяем NOT + NOR/NAND/NXOR на OR/AND/XOR
                     gate_info.at(indexes_of_not.at(gateId)) = {
-                        static_cast<GateType>(static_cast<uint8_t>(circuit->getGateType(gateId)) - 1), operands};
+                        static_cast<GateType>(static_cast<uint8_t>(circuit->getGateType(gateId)) - 1),
+                        acquireGateIdContainer(operands)};
 
                     // если хотябы один User гейта не использует его отрицание, то необходимо перевесить гейты, то есть
                     // измениь тип текущего гейта на NOT. Все User'ы использующие правило де Моргана будут ссылаться на
@@ -115,7 +109,7 @@ public:
                 }
                 else
                 {
-                    gate_info.at(gateId) = {circuit->getGateType(gateId), operands};
+                    gate_info.at(gateId) = {circuit->getGateType(gateId), acquireGateIdContainer(operands)};
                 }
             }
             else if (
@@ -130,15 +124,16 @@ public:
             else if (circuit->getGateType(gateId) == GateType::NAND || circuit->getGateType(gateId) == GateType::NOR)
             {
                 // применяем правило де Моргана
+                countRule("de_morgan");
                 gate_info.at(gateId) = {
-                    inverse_type.at(circuit->getGateType(gateId)),
+                    getDualType_(circuit->getGateType(gateId)),
                     get_new_operands_(
                         *circuit, gate_info, *encoder, indexes_of_not, gateId, new_gate_name_prefix, count_branches)};
             }
             else
             {
                 // гейт не трогаем
-                gate_info.at(gateId) = {circuit->getGateType(gateId), operands};
+                gate_info.at(gateId) = {circuit->getGateType(gateId), acquireGateIdContainer(operands)};
             }
         }
 
@@ -146,10 +141,16 @@ public:
         log::debug("=========================================================================================");
 
         return {
-            std::make_unique<CircuitT>(gate_info, circuit->getOutputGates()), std::make_unique<NameEncoder>(*encoder)};
+            std::make_unique<CircuitT>(std::move(gate_info), circuit->getOutputGates()), std::move(encoder)};
     };
 
 private:
+    /* Returns type of gate over negated operands, which is equal to NOT(AND)/NOT(OR) or NAND/NOR. */
+    static constexpr GateType getDualType_(GateType type) noexcept
+    {
+        return type == GateType::AND || type == GateType::NAND ? GateType::OR : GateType::AND;
+    }
+
     GateId find_index_of_not_(CircuitT const& circuit, GateIdContainer const& indexes_of_not, GateId gateId)
     {
         // NOT у гейта будет всегда только один, так как перед алгоритмом DeMorgan_ применяется DuplicatesCleaner,
@@ -179,7 +180,7 @@ private:
         std::string const& new_gate_name_prefix,
         GateIdContainer& count_branches)
     {
-        GateIdContainer new_operands{};
+        GateIdContainer new_operands = acquireGateIdContainer();
         for (GateId operand : circuit.getGateOperands(gateId))
         {
             GateId index_of_not = find_index_of_not_(circuit, indexes_of_not, operand);
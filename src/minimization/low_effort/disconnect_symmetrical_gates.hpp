@@ -64,7 +64,7 @@ public:
         GateIdContainer const gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
 
         log::debug("Rebuild schema");
-        GateInfoContainer gate_info(circuit->getNumberOfGates());
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit->getNumberOfGates());
 
         for (auto gateId : std::ranges::reverse_view(gate_sorting))
         {
@@ -72,7 +72,7 @@ public:
             if ((operands.size() > arity) && (validParams.find(circuit->getGateType(gateId)) != validParams.end()))
             {
                 GateId operandId = 0;
-                GateIdContainer new_operands_{};
+                GateIdContainer new_operands_ = acquireGateIdContainer();
                 for (; operandId < (operands.size() - 1); ++operandId)
                 {
                     new_operands_.push_back(operands.at(operandId));
@@ -81,18 +81,19 @@ public:
                     {
                         GateId const new_gateID =
                             encoder->encodeGate("new_gate_disconnect_gates" + std::to_string((*encoder).size()));
-                        gate_info.emplace_back(circuit->getGateType(gateId), new_operands_);
+                        gate_info.emplace_back(circuit->getGateType(gateId), std::move(new_operands_));
+                        countRule("split_gate");
 
-                        new_operands_.clear();
+                        new_operands_ = acquireGateIdContainer();
                         new_operands_.push_back(new_gateID);
                     }
                 }
                 new_operands_.push_back(operands.at(operandId));
-                gate_info.at(gateId) = {circuit->getGateType(gateId), new_operands_};
+                gate_info.at(gateId) = {circuit->getGateType(gateId), std::move(new_operands_)};
             }
             else
             {
-                gate_info.at(gateId) = {circuit->getGateType(gateId), operands};
+                gate_info.at(gateId) = {circuit->getGateType(gateId), acquireGateIdContainer(operands)};
             }
         }
 
@@ -100,7 +101,7 @@ public:
         log::debug("=========================================================================================");
 
         return {
-            std::make_unique<CircuitT>(gate_info, circuit->getOutputGates()), std::make_unique<NameEncoder>(*encoder)};
+            std::make_unique<CircuitT>(std::move(gate_info), circuit->getOutputGates()), std::move(encoder)};
     };
 };
 
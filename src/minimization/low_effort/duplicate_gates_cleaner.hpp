@@ -37,6 +37,16 @@ template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit,
 class DuplicateGatesCleaner_ : public ITransformer<CircuitT>
 {
 public:
+    /**
+     * Merging of duplicates preserves all invariants. Note that when pass is skipped,
+     * gates are not renumbered, so result differs from running it, up to numbering.
+     */
+    [[nodiscard]]
+    PassContract getContract() const override
+    {
+        return {invariant::NO_DANGLING, invariant::DEDUPLICATED, invariant::NONE, true};
+    }
+
     CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT> circuit,
         std::unique_ptr<NameEncoder> encoder) override
@@ -73,6 +83,7 @@ public:
             {
                 log::debug("Gate number ", gateId, " is a Duplicate and will be removed.");
                 safe_mask.at(gateId) = false;
+                countRule("duplicate_gate");
             }
             else
             {
@@ -85,7 +96,7 @@ public:
         }
 
         log::debug("Building new circuit");
-        GateInfoContainer gate_info(auxiliary_encoder.size());
+        GateInfoContainer gate_info = acquireGateInfoContainer(auxiliary_encoder.size());
         for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
         {
             if (safe_mask.at(gateId))
@@ -98,12 +109,13 @@ public:
                     "; Operands: ",
                     formatOperandsString_(circuit->getGateOperands(gateId), gate_id_to_auxiliary_id).str());
 
-                GateIdContainer masked_operands_{};
+                GateIdContainer masked_operands_ = acquireGateIdContainer();
                 for (GateId const operand : circuit->getGateOperands(gateId))
                 {
                     masked_operands_.push_back(gate_id_to_auxiliary_id.at(operand));
                 }
-                gate_info.at(gate_id_to_auxiliary_id.at(gateId)) = {circuit->getGateType(gateId), masked_operands_};
+                gate_info.at(gate_id_to_auxiliary_id.at(gateId)) = {
+                    circuit->getGateType(gateId), std::move(masked_operands_)};
             }
         }
 
@@ -116,7 +128,9 @@ public:
 
         log::debug("END DuplicateGatesCleaner");
         log::debug("=========================================================================================");
-        return {std::make_unique<CircuitT>(gate_info, new_output_gates), std::make_unique<NameEncoder>(new_encoder)};
+        return {
+            std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)),
+            std::make_unique<NameEncoder>(std::move(new_encoder))};
     };
 
 private:
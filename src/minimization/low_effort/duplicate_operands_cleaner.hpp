@@ -66,7 +66,7 @@ public:
         GateIdContainer const gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
 
         size_t circuit_size = circuit->getNumberOfGates();
-        GateInfoContainer gate_info(circuit_size);
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit_size);
 
         // Surjection of old gate ids to new gate ids.
         GateIdContainer old_to_new_gateId(circuit_size, SIZE_MAX);
@@ -108,6 +108,7 @@ public:
                 // to this operand or to its negation.
                 if (map_count_operands.size() == 1)
                 {
+                    countRule("single_operand");
                     // No need to use getLink_. The map already has the correct (rehung) gates.
                     GateId const unique_operand = map_count_operands.begin()->first;
                     if (gate_type == GateType::AND || gate_type == GateType::OR || gate_type == GateType::XOR)
@@ -135,6 +136,7 @@ public:
                 {
                     // If, as a result of counting of the operands, an empty map is obtained
                     // (it can be in gates of type XOR or NXOR), then we know their assignment.
+                    countRule("cancelled_xor");
                     if (gate_type == GateType::XOR)
                     {
                         old_to_new_gateId.at(gate_id) = id_const_false;
@@ -150,6 +152,10 @@ public:
                     // If gates are found to have opposite operands, then all their users will have to use
                     // constants (CONST_TRUE, CONST_FALSE) as their operands instead of these gates.
                     bool const flag = areThereOppositeOperands_(gate_info, map_count_operands);
+                    if (flag)
+                    {
+                        countRule("opposite_operands");
+                    }
                     if (flag && (gate_type == GateType::AND || gate_type == GateType::NOR))
                     {
                         old_to_new_gateId.at(gate_id) = id_const_false;
@@ -181,7 +187,7 @@ public:
             // The second step. Let's reassemble the operands, knowing that all the reductions are already
             // taken into account in the map.
 
-            GateIdContainer operands{};
+            GateIdContainer operands = acquireGateIdContainer();
 
             // Rebuild the gate if necessary (only XOR or NXOR).
             if (rebuild_gate)
@@ -251,7 +257,7 @@ public:
             }
 
             // Construct the gate.
-            gate_info.at(gate_id) = {gate_type, operands};
+            gate_info.at(gate_id) = {gate_type, std::move(operands)};
         }
 
         // Rebuild OUTPUT.
@@ -266,7 +272,7 @@ public:
 
         return {
             std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)),
-            std::make_unique<NameEncoder>(*encoder)};
+            std::move(encoder)};
     };
 
 private:
@@ -0,0 +1,264 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_EXTRACT_COMMON_PAIRS_HPP
+#define CIRBO_SEARCH_MINIMIZATION_EXTRACT_COMMON_PAIRS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <queue>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Transformer, that extracts pairs of operands, which are shared by several symmetrical gates
+ * (AND, OR and XOR) of the same type, into new gates. For example:
+ * AND(0, 1, 2), AND(0, 1, 3) => AND(4, 2), AND(4, 3), where 4 = AND(0, 1)
+ *
+ * Pair, which is shared by the most gates, is extracted first, and counts of pairs are updated
+ * incrementally, so extraction is repeated while some pair is shared by at least two gates.
+ * Larger shared subsets of operands are extracted as nested pairs. Existing binary gate, which
+ * computes the pair, is reused instead of new gate. Each extraction of pair, shared by `k`
+ * gates, saves `k - 1` two-input gates, when gates are split by DisconnectSymmetricalGates.
+ *
+ * Note that this algorithm requires RedundantGatesCleaner to be applied right before, and gates
+ * with repeated operands do not take part in extraction, so DuplicateOperandsCleaner helps too.
+ *
+ * @tparam CircuitT
+ */
+template<
+    class CircuitT,
+    bool EnableAND = false,
+    bool EnableOR  = false,
+    bool EnableXOR = false,
+    typename       = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class ExtractCommonPairs_ : public ITransformer<CircuitT>
+{
+public:
+    /** Pairs of operands of wider gates are not counted, since their number is quadratic in arity. **/
+    static constexpr size_t MaxArity = 256;
+
+private:
+    struct Pair_
+    {
+        GateId lhs;
+        GateId rhs;
+
+        bool operator==(Pair_ const&) const = default;
+    };
+
+    struct PairHash_
+    {
+        size_t operator()(Pair_ const& pair) const noexcept
+        {
+            size_t hash = pair.lhs;
+            hash ^= pair.rhs + 0x9e3779b97f4a7c15ULL + (hash << 6U) + (hash >> 2U);
+            return hash;
+        }
+    };
+
+public:
+    /**
+     * New gates are used at least twice, or reuse existing gates, but gates may become duplicates.
+     */
+    [[nodiscard]]
+    PassContract getContract() const override
+    {
+        return {invariant::NONE, invariant::NONE, invariant::DEDUPLICATED, false};
+    }
+
+    /**
+     * Applies ExtractCommonPairs_ transformer to `circuit`
+     * @param circuit -- circuit to transform.
+     * @param encoder -- circuit encoder.
+     * @return  circuit and encoder after transformation.
+     */
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START ExtractCommonPairs");
+
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit->getNumberOfGates());
+        for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
+        {
+            gate_info.at(gateId) = {
+                circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
+        }
+
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_ExtractCommonPairs@");
+        if constexpr (EnableAND)
+        {
+            extract_(GateType::AND, gate_info, *encoder, new_gate_name_prefix);
+        }
+        if constexpr (EnableOR)
+        {
+            extract_(GateType::OR, gate_info, *encoder, new_gate_name_prefix);
+        }
+        if constexpr (EnableXOR)
+        {
+            extract_(GateType::XOR, gate_info, *encoder, new_gate_name_prefix);
+        }
+
+        log::debug("END ExtractCommonPairs");
+        log::debug("=========================================================================================");
+
+        return {std::make_unique<CircuitT>(std::move(gate_info), circuit->getOutputGates()), std::move(encoder)};
+    };
+
+private:
+    /* Extracts shared pairs of operands of gates of type `type`. */
+    void extract_(GateType type, GateInfoContainer& gate_info, NameEncoder& encoder, std::string const& prefix)
+    {
+        // Sorted operands of gates, which take part in extraction, empty for others.
+        std::vector<GateIdContainer> operands(gate_info.size());
+        // Gates, which take part in extraction and have operand (or had it before).
+        std::vector<GateIdContainer> users(gate_info.size());
+        std::unordered_map<Pair_, size_t, PairHash_> counts;
+        // Existing binary gates, which compute pairs.
+        std::unordered_map<Pair_, GateId, PairHash_> providers;
+
+        for (GateId gateId = 0; gateId < gate_info.size(); ++gateId)
+        {
+            GateIdContainer const& gate_operands = gate_info[gateId].getOperands();
+            if (gate_info[gateId].getType() != type || gate_operands.size() < 2 || gate_operands.size() > MaxArity ||
+                std::ranges::adjacent_find(gate_operands) != gate_operands.end())
+            {
+                continue;
+            }
+            operands[gateId].assign(gate_operands.begin(), gate_operands.end());
+            for (size_t i = 0; i < gate_operands.size(); ++i)
+            {
+                users[gate_operands[i]].push_back(gateId);
+                for (size_t j = i + 1; j < gate_operands.size(); ++j)
+                {
+                    ++counts[{gate_operands[i], gate_operands[j]}];
+                }
+            }
+            if (gate_operands.size() == 2)
+            {
+                providers.try_emplace({gate_operands[0], gate_operands[1]}, gateId);
+            }
+        }
+
+        // Pairs by count, ties are broken by operands. Entries with outdated counts are skipped.
+        using Entry = std::tuple<size_t, GateId, GateId>;
+        auto const lower_priority = [](Entry const& lhs, Entry const& rhs)
+        {
+            auto const& [lhs_count, lhs_first, lhs_second] = lhs;
+            auto const& [rhs_count, rhs_first, rhs_second] = rhs;
+            return std::tie(lhs_count, rhs_first, rhs_second) < std::tie(rhs_count, lhs_first, lhs_second);
+        };
+        std::priority_queue<Entry, std::vector<Entry>, decltype(lower_priority)> queue(lower_priority);
+        for (auto const& [pair, count] : counts)
+        {
+            if (count >= 2)
+            {
+                queue.emplace(count, pair.lhs, pair.rhs);
+            }
+        }
+        auto const ordered = [](GateId lhs, GateId rhs) { return lhs < rhs ? Pair_{lhs, rhs} : Pair_{rhs, lhs}; };
+
+        while (!queue.empty())
+        {
+            auto const [count, lhs, rhs] = queue.top();
+            queue.pop();
+            Pair_ const pair{lhs, rhs};
+            size_t const actual = counts[pair];
+            if (actual != count)
+            {
+                // Decreased counts are not pushed on update, so entry is renewed here.
+                if (actual >= 2 && actual < count)
+                {
+                    queue.emplace(actual, lhs, rhs);
+                }
+                continue;
+            }
+
+            GateId extracted        = 0;
+            auto const provider     = providers.find(pair);
+            bool const has_provider = provider != providers.end();
+            if (has_provider)
+            {
+                extracted = provider->second;
+            }
+
+            // Gates, which have both operands, found by the shorter list of users. Gates, which
+            // already use provider, are skipped, since repeated operand breaks extraction for XOR.
+            GateIdContainer const& candidates =
+                users[lhs].size() < users[rhs].size() ? users[lhs] : users[rhs];
+            GateIdContainer sharing;
+            // Gates, which keep both operands, so count of pair is restored to it.
+            size_t kept = 0;
+            for (GateId const gateId : candidates)
+            {
+                GateIdContainer const& gate_operands = operands[gateId];
+                if (!std::ranges::binary_search(gate_operands, lhs) || !std::ranges::binary_search(gate_operands, rhs))
+                {
+                    continue;
+                }
+                if (gate_operands.size() == 2 || (has_provider && std::ranges::binary_search(gate_operands, extracted)))
+                {
+                    // Provider itself, its duplicate, or user of provider.
+                    ++kept;
+                    continue;
+                }
+                sharing.push_back(gateId);
+            }
+            if (sharing.empty())
+            {
+                counts[pair] = kept;
+                continue;
+            }
+
+            if (!has_provider)
+            {
+                extracted = encoder.encodeGate(getNewGateName_(prefix, gate_info.size()));
+                gate_info.emplace_back(type, acquireGateIdContainer({lhs, rhs}));
+                operands.push_back({lhs, rhs});
+                users.emplace_back();
+                providers.emplace(pair, extracted);
+            }
+            countRule("extracted_pair");
+
+            for (GateId const gateId : sharing)
+            {
+                GateIdContainer& gate_operands = operands[gateId];
+                for (GateId const operand : gate_operands)
+                {
+                    if (operand != lhs && operand != rhs)
+                    {
+                        --counts[ordered(lhs, operand)];
+                        --counts[ordered(rhs, operand)];
+                        Pair_ const added = ordered(extracted, operand);
+                        if (++counts[added] >= 2)
+                        {
+                            queue.emplace(counts[added], added.lhs, added.rhs);
+                        }
+                    }
+                }
+                std::erase_if(gate_operands, [&](GateId operand) { return operand == lhs || operand == rhs; });
+                gate_operands.insert(std::ranges::lower_bound(gate_operands, extracted), extracted);
+                users[extracted].push_back(gateId);
+                gate_info[gateId] = {type, acquireGateIdContainer(gate_operands)};
+            }
+            counts[pair] = kept;
+        }
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_EXTRACT_COMMON_PAIRS_HPP
@@ -1,7 +1,6 @@
 #ifndef CIRBO_SEARCH_MINIMIZATION_MERGE_NOT_WITH_OTHERS_HPP
 #define CIRBO_SEARCH_MINIMIZATION_MERGE_NOT_WITH_OTHERS_HPP
 
-#include <map>
 #include <memory>
 #include <string>
 #include <utility>
@@ -11,6 +10,7 @@
 #include "core/structures/gate_info.hpp"
 #include "core/types.hpp"
 #include "logger.hpp"
+#include "minimization/rule_rewriter.hpp"
 #include "minimization/transformer_base.hpp"
 
 namespace cirbo::minimization
@@ -40,16 +40,7 @@ public:
         std::unique_ptr<NameEncoder> encoder)
     {
         log::debug("START MergeNotWithOthers");
-        static std::map<GateType, GateType> const inverseType{
-            {GateType::AND,  GateType::NAND},
-            {GateType::OR,   GateType::NOR },
-            {GateType::XOR,  GateType::NXOR},
-            {GateType::NAND, GateType::AND },
-            {GateType::NOR,  GateType::OR  },
-            {GateType::NXOR, GateType::XOR }
-        };
-
-        GateInfoContainer gate_info(circuit->getNumberOfGates());
+        GateInfoContainer gate_info = acquireGateInfoContainer(circuit->getNumberOfGates());
         BoolVector visited(circuit->getNumberOfGates(), false);
         for (GateId gateId : algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit))
         {
@@ -62,15 +53,17 @@ public:
             visited.at(gateId) = true;
 
             if (circuit->getGateType(gateId) == GateType::NOT &&
-                inverseType.find(circuit->getGateType(circuit->getGateOperands(gateId).at(0))) != inverseType.end())
+                getNegatedType(circuit->getGateType(circuit->getGateOperands(gateId).at(0))) != GateType::UNDEFINED)
             {
                 GateId operandId = circuit->getGateOperands(gateId).at(0);
                 if (circuit->getGateUsers(operandId).size() == 1)
                 {
                     // Применяем inverseType и объединяем гейты
                     // NOT + AND = NAND; NOT + NAND = AND; ...
+                    countRule("merged_not");
                     gate_info.at(gateId) = {
-                        inverseType.at(circuit->getGateType(operandId)), circuit->getGateOperands(operandId)};
+                        getNegatedType(circuit->getGateType(operandId)),
+                        acquireGateIdContainer(circuit->getGateOperands(operandId))};
                 }
                 else if (
                     circuit->getGateType(operandId) == GateType::AND ||
@@ -86,10 +79,12 @@ public:
                 {
                     // Разбиваем NAND/NOR/NXOR и переподвешиваем. Users NAND теперь
                     // будут указывать на NOT(AND), а Users NOT(NAND) -- на AND.
+                    countRule("rehung_not");
                     gate_info.at(operandId) = {GateType::NOT, {gateId}};
 
                     gate_info.at(gateId) = {
-                        inverseType.at(circuit->getGateType(operandId)), circuit->getGateOperands(operandId)};
+                        getNegatedType(circuit->getGateType(operandId)),
+                        acquireGateIdContainer(circuit->getGateOperands(operandId))};
                     // Пересобрали операнд здесь, не нужно посещать его позже.
                     visited.at(operandId) = true;
                 }
@@ -97,7 +92,8 @@ public:
             else
             {
                 // Gate is taken as is, but given a new id.
-                gate_info.at(gateId) = {circuit->getGateType(gateId), circuit->getGateOperands(gateId)};
+                gate_info.at(gateId) = {
+                    circuit->getGateType(gateId), acquireGateIdContainer(circuit->getGateOperands(gateId))};
             }
         }
         log::debug("END MergeNotWithOthers");
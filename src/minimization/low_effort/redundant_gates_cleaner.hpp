@@ -33,6 +33,20 @@ template<
 class RedundantGatesCleaner_ : public ITransformer<CircuitT>
 {
 public:
+    /**
+     * Removing unreachable gates preserves all invariants. Note that when inputs are
+     * preserved, unreachable inputs may be left, so nothing is established.
+     */
+    [[nodiscard]]
+    PassContract getContract() const override
+    {
+        if constexpr (preserveInputs)
+        {
+            return {invariant::NONE, invariant::NONE, invariant::NONE, false};
+        }
+        return {invariant::NONE, invariant::NO_DANGLING, invariant::NONE, true};
+    }
+
     /**
      * Applies RedundantGatesCleaner_ transformer to `circuit`
      * @param circuit -- circuit to transform.
@@ -63,18 +77,19 @@ public:
             }
 
             log::debug("Gate '", gate_name, "' (#", gateId, ") is redundant and will be removed");
+            countRule("redundant_gate");
         }
 
         // Second step: recollect each gate data by encoding all its operands with
         // new encoder build above.
-        GateInfoContainer gate_info(new_encoder.size());
+        GateInfoContainer gate_info = acquireGateInfoContainer(new_encoder.size());
         for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
         {
             std::string const& gate_name = encoder->decodeGate(gateId);
             // If new encoder doesn't contain name of a gate, this gate is redundant.
             if (new_encoder.keyExists(gate_name))
             {
-                GateIdContainer encoded_operands_{};
+                GateIdContainer encoded_operands_ = acquireGateIdContainer();
                 for (GateId const operand : circuit->getGateOperands(gateId))
                 {
                     // All operands must be visited, since current gate was visited.
@@ -109,7 +124,7 @@ public:
         log::debug("=========================================================================================");
         return {
             std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)),
-            std::make_unique<NameEncoder>(new_encoder)};
+            std::make_unique<NameEncoder>(std::move(new_encoder))};
     };
 };
 
@@ -1,24 +1,32 @@
 #ifndef CIRBO_SEARCH_MINIMIZATION_SPLIT_NOT_FROM_OTHERS_HPP
 #define CIRBO_SEARCH_MINIMIZATION_SPLIT_NOT_FROM_OTHERS_HPP
 
-#include <cassert>
-#include <cstddef>
-#include <map>
-#include <memory>
-#include <ranges>
-#include <string>
-#include <utility>
-#include <vector>
+#include <string_view>
 
-#include "core/algo.hpp"
-#include "core/structures/gate_info.hpp"
 #include "core/types.hpp"
-#include "logger.hpp"
-#include "minimization/transformer_base.hpp"
+#include "minimization/rule_rewriter.hpp"
 
 namespace cirbo::minimization
 {
 
+namespace rules
+{
+
+/** NAND(xs) = NOT(AND(xs)), same for NOR and NXOR: gate becomes NOT of new positive gate. */
+struct SplitNot
+{
+    static constexpr std::string_view Name = "split_not";
+    using Pattern = minimization::Pattern<TypeOf<GateType::NAND, GateType::NOR, GateType::NXOR> >;
+
+    static void rewrite(RewriteView& view)
+    {
+        GateId const positive = view.addGate(getNegatedType(view.getType()), view.getOperands());
+        view.replace(GateType::NOT, {positive});
+    }
+};
+
+}  // namespace rules
+
 /**
  * Transformer, that split NOT with other operators, preserving functional equivalence on gateId.
  * For example:
@@ -34,61 +42,8 @@ namespace cirbo::minimization
  * @tparam CircuitT
  */
 template<class CircuitT>
-class SplitNotFromOthers_ : public ITransformer<CircuitT>
+class SplitNotFromOthers_ : public RuleRewriter_<CircuitT, RuleSet<rules::SplitNot> >
 {
-public:
-    CircuitAndEncoder<CircuitT, std::string> transform(
-        std::unique_ptr<CircuitT> circuit,
-        std::unique_ptr<NameEncoder> encoder)
-    {
-        static std::map<GateType, GateType> const inverse_type = {
-            {GateType::NAND, GateType::AND},
-            {GateType::NOR,  GateType::OR },
-            {GateType::NXOR, GateType::XOR}
-        };
-
-        log::debug("START SplitNotFromOthers");
-        cirbo::GateIdContainer sorted_gates(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
-
-        size_t circuit_size = circuit->getNumberOfGates();
-        GateInfoContainer gate_info(circuit_size);
-
-        for (auto gateId : std::ranges::reverse_view(sorted_gates))
-        {
-            // В качестве ключей мапы `inverse_type` выступают только отрицания операторов.
-            if (inverse_type.find(circuit->getGateType(gateId)) != inverse_type.end())
-            {
-                // Разделяем NAND/NOR/NXOR на NOT(AND)/NOT(OR)/NOT(XOR) и переподвешиваем.
-                // Например: User'ы NAND теперь будут указывать на NOT(AND).
-
-                // Инвертированный гейт получает новый id.
-                GateId const new_gate_id =
-                    encoder->encodeGate("new_gate_split_not_with_others@" + std::to_string(circuit_size));
-                gate_info.emplace_back(
-                    inverse_type.at(circuit->getGateType(gateId)),
-                    // Оставляем старые операнды т.к. они либо не изменились, либо стали NOT'ами.
-                    circuit->getGateOperands(gateId));
-
-                assert(new_gate_id == circuit_size);
-                ++circuit_size;
-                assert(gate_info.size() == circuit_size);
-
-                // Соответствующий ему NOT будет кодироваться старым id,
-                // т.к. эквивалентен старому гейту.
-                gate_info.at(gateId) = {GateType::NOT, GateIdContainer{new_gate_id}};
-            }
-            else
-            {
-                // Берем гейт "as is".
-                gate_info.at(gateId) = {circuit->getGateType(gateId), circuit->getGateOperands(gateId)};
-            }
-        }
-        log::debug("END SplitNotFromOthers");
-
-        return {
-            std::make_unique<CircuitT>(std::move(gate_info), circuit->getOutputGates()),
-            std::make_unique<NameEncoder>(*encoder)};
-    };
 };
 
 }  // namespace cirbo::minimization
@@ -54,7 +54,7 @@ public:
         for (std::size_t it = 0; it < n; ++it)
         {
             auto comp                    = Composition<CircuitT, OtherTransformersT...>();
-            std::tie(circuit_, encoder_) = comp.transform(std::move(circuit_), std::move(encoder_));
+            std::tie(circuit_, encoder_) = comp.run(std::move(circuit_), std::move(encoder_));
         }
         return CircuitAndEncoder<CircuitT, std::string>(std::move(circuit_), std::move(encoder_));
     }
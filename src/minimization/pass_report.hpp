@@ -0,0 +1,324 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_PASS_REPORT_HPP
+#define CIRBO_SEARCH_MINIMIZATION_PASS_REPORT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "core/cost_model.hpp"
+#include "core/structures/icircuit.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Figures, collected for one transformer invocation.
+ */
+struct PassRecord
+{
+    std::string name;
+    size_t gates_in  = 0;
+    size_t gates_out = 0;
+    /* Costs of circuit by cost model of report (see `PassReport::setCostModel`). */
+    size_t cost_in  = 0;
+    size_t cost_out = 0;
+    /* Wall time of invocation, including nested invocations. */
+    double wall_time_ms = 0;
+    /* Growth of process peak resident set size during invocation. */
+    int64_t peak_rss_delta_kb = 0;
+    /* Number of times each rewriting rule fired. */
+    std::map<std::string, size_t, std::less<>> rules;
+    /* Invocations of transformers, nested into this one (e.g. parts of `Composition`). */
+    std::vector<PassRecord> children;
+};
+
+namespace impl
+{
+
+/**
+ * @return peak resident set size of the process in kilobytes, or 0 if it is unavailable.
+ */
+inline int64_t getPeakRssKb()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#if defined(__APPLE__)
+    // macOS reports `ru_maxrss` in bytes.
+    return static_cast<int64_t>(usage.ru_maxrss) / 1024;
+#else
+    return static_cast<int64_t>(usage.ru_maxrss);
+#endif
+#else
+    return 0;
+#endif
+}
+
+inline void writeJsonString(std::ostream& out, std::string_view value)
+{
+    out << '"';
+    for (char const symbol : value)
+    {
+        switch (symbol)
+        {
+            case '"':
+                out << "\\\"";
+                break;
+            case '\\':
+                out << "\\\\";
+                break;
+            case '\n':
+                out << "\\n";
+                break;
+            case '\t':
+                out << "\\t";
+                break;
+            default:
+                out << symbol;
+        }
+    }
+    out << '"';
+}
+
+}  // namespace impl
+
+/**
+ * Collects tree of `PassRecord`s for transformers, applied in the current thread.
+ * Collection is disabled by default, so it costs nothing unless requested.
+ */
+class PassReport
+{
+private:
+    struct Frame_
+    {
+        PassRecord* record;
+        std::chrono::steady_clock::time_point start;
+        int64_t peak_rss_kb;
+    };
+
+    bool enabled_ = false;
+    CostModel cost_model_;
+    std::vector<PassRecord> records_;
+    /* Currently running invocations, innermost is the last one. */
+    std::vector<Frame_> stack_;
+
+public:
+    /**
+     * @return report of the current thread.
+     */
+    static PassReport& getInstance()
+    {
+        static thread_local PassReport instance;
+        return instance;
+    }
+
+    void setEnabled(bool enabled) noexcept { enabled_ = enabled; }
+
+    [[nodiscard]]
+    bool isEnabled() const noexcept
+    {
+        return enabled_;
+    }
+
+    /**
+     * Sets model, which costs of circuits are measured by. Gates are counted by default.
+     */
+    void setCostModel(CostModel const& cost_model) noexcept { cost_model_ = cost_model; }
+
+    [[nodiscard]]
+    CostModel const& getCostModel() const noexcept
+    {
+        return cost_model_;
+    }
+
+    /**
+     * @return top-level invocations, collected so far.
+     */
+    [[nodiscard]]
+    std::vector<PassRecord> const& getRecords() const noexcept
+    {
+        return records_;
+    }
+
+    void clear()
+    {
+        records_.clear();
+        stack_.clear();
+    }
+
+    /**
+     * Opens record of new invocation, nested into the currently running one.
+     */
+    void begin(std::string name, ICircuit const& circuit)
+    {
+        std::vector<PassRecord>& siblings = stack_.empty() ? records_ : stack_.back().record->children;
+        PassRecord& record                = siblings.emplace_back();
+        record.name                       = std::move(name);
+        record.gates_in                   = circuit.getNumberOfGates();
+        record.cost_in                    = cost_model_.getCircuitCost(circuit);
+        // Only the innermost record gets new children, so pointers to outer records stay valid.
+        stack_.push_back({&record, std::chrono::steady_clock::now(), impl::getPeakRssKb()});
+    }
+
+    /**
+     * Closes record of the innermost running invocation.
+     */
+    void end(size_t gates_out, size_t cost_out)
+    {
+        if (stack_.empty())
+        {
+            return;
+        }
+        Frame_ const frame = stack_.back();
+        stack_.pop_back();
+
+        std::chrono::duration<double, std::milli> const elapsed = std::chrono::steady_clock::now() - frame.start;
+        frame.record->gates_out         = gates_out;
+        frame.record->cost_out          = cost_out;
+        frame.record->wall_time_ms      = elapsed.count();
+        frame.record->peak_rss_delta_kb = impl::getPeakRssKb() - frame.peak_rss_kb;
+    }
+
+    /**
+     * Increments counter of `rule` of the innermost running invocation.
+     */
+    void countRule(std::string_view rule, size_t times = 1)
+    {
+        if (!enabled_ || stack_.empty())
+        {
+            return;
+        }
+        auto& rules = stack_.back().record->rules;
+        auto it     = rules.find(rule);
+        if (it == rules.end())
+        {
+            it = rules.emplace(std::string(rule), 0).first;
+        }
+        it->second += times;
+    }
+
+    /**
+     * Writes collected records as JSON document `{"passes": [...]}`.
+     */
+    void writeJson(std::ostream& out) const
+    {
+        out << "{\"passes\": ";
+        writeJsonRecords_(out, records_, 1);
+        out << "}\n";
+    }
+
+private:
+    static void writeJsonRecords_(std::ostream& out, std::vector<PassRecord> const& records, size_t depth)
+    {
+        if (records.empty())
+        {
+            out << "[]";
+            return;
+        }
+        std::string const indent(2 * depth, ' ');
+        out << "[\n";
+        for (size_t i = 0; i < records.size(); ++i)
+        {
+            PassRecord const& record = records.at(i);
+            out << indent << "  {\"name\": ";
+            impl::writeJsonString(out, record.name);
+            out << ", \"wall_time_ms\": " << record.wall_time_ms
+                << ", \"peak_rss_delta_kb\": " << record.peak_rss_delta_kb << ", \"gates_in\": " << record.gates_in
+                << ", \"gates_out\": " << record.gates_out << ", \"cost_in\": " << record.cost_in
+                << ", \"cost_out\": " << record.cost_out << ", \"rules\": {";
+            bool first = true;
+            for (auto const& [rule, count] : record.rules)
+            {
+                out << (first ? "" : ", ");
+                impl::writeJsonString(out, rule);
+                out << ": " << count;
+                first = false;
+            }
+            out << "}, \"children\": ";
+            writeJsonRecords_(out, record.children, depth + 2);
+            out << "}" << (i + 1 == records.size() ? "\n" : ",\n");
+        }
+        out << indent << "]";
+    }
+};
+
+/**
+ * Records that `rule` fired `times` times in the currently running transformer.
+ * Does nothing when report collection is disabled.
+ */
+inline void countRule(std::string_view rule, size_t times = 1)
+{
+    PassReport::getInstance().countRule(rule, times);
+}
+
+/**
+ * Scoped record of transformer invocation, closed on destruction even if transformer throws.
+ */
+class PassScope
+{
+private:
+    bool active_;
+    size_t gates_out_ = 0;
+    size_t cost_out_  = 0;
+
+public:
+    /**
+     * @param name -- name of transformer.
+     * @param circuit -- circuit, which transformer is applied to.
+     */
+    PassScope(std::string name, ICircuit const& circuit)
+        : active_(PassReport::getInstance().isEnabled())
+    {
+        if (active_)
+        {
+            PassReport::getInstance().begin(std::move(name), circuit);
+        }
+    }
+
+    ~PassScope()
+    {
+        if (active_)
+        {
+            PassReport::getInstance().end(gates_out_, cost_out_);
+        }
+    }
+
+    PassScope(PassScope const&)            = delete;
+    PassScope& operator=(PassScope const&) = delete;
+
+    [[nodiscard]]
+    bool isActive() const noexcept
+    {
+        return active_;
+    }
+
+    /**
+     * Sets circuit, which transformer produced.
+     */
+    void setResult(ICircuit const& circuit)
+    {
+        if (active_)
+        {
+            gates_out_ = circuit.getNumberOfGates();
+            cost_out_  = PassReport::getInstance().getCostModel().getCircuitCost(circuit);
+        }
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_PASS_REPORT_HPP
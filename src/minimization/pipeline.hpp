@@ -0,0 +1,201 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_PIPELINE_HPP
+#define CIRBO_SEARCH_MINIMIZATION_PIPELINE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/cost_model.hpp"
+#include "core/structures/icircuit.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+
+/**
+ * Runtime counterparts of `Composition` and `Nest`. They own transformers
+ * which are chosen at runtime (e.g. parsed from a pipeline description,
+ * see `minimization/pipeline_parser.hpp`), so pipelines can be changed
+ * without rebuilding the binary.
+ */
+namespace cirbo::minimization
+{
+
+template<class CircuitT>
+using TransformerPtr = std::unique_ptr<ITransformer<CircuitT>>;
+
+/**
+ * Runtime composition of transformers, applied in left-to-right order.
+ *
+ * @tparam CircuitT -- class that carries circuit.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+class DynamicComposition : public ITransformer<CircuitT>
+{
+private:
+    std::vector<TransformerPtr<CircuitT>> transformers_;
+
+public:
+    DynamicComposition() = default;
+
+    explicit DynamicComposition(std::vector<TransformerPtr<CircuitT>>&& transformers)
+        : transformers_(std::move(transformers))
+    {
+    }
+
+    void add(TransformerPtr<CircuitT>&& transformer) { transformers_.push_back(std::move(transformer)); }
+
+    [[nodiscard]]
+    size_t size() const noexcept
+    {
+        return transformers_.size();
+    }
+
+    [[nodiscard]]
+    std::vector<TransformerPtr<CircuitT>> const& getTransformers() const noexcept
+    {
+        return transformers_;
+    }
+
+    /**
+     * Takes away owned transformers, leaving composition empty.
+     */
+    [[nodiscard]]
+    std::vector<TransformerPtr<CircuitT>> releaseTransformers() noexcept
+    {
+        return std::move(transformers_);
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        for (auto& transformer : transformers_)
+        {
+            std::tie(circuit, encoder) = transformer->run(std::move(circuit), std::move(encoder));
+        }
+        return {std::move(circuit), std::move(encoder)};
+    }
+};
+
+/**
+ * Runtime nest: applies owned transformer `n` times.
+ *
+ * @tparam CircuitT -- class that carries circuit.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+class DynamicNest : public ITransformer<CircuitT>
+{
+private:
+    TransformerPtr<CircuitT> transformer_;
+    size_t n_;
+
+public:
+    DynamicNest(TransformerPtr<CircuitT>&& transformer, size_t n)
+        : transformer_(std::move(transformer))
+        , n_(n)
+    {
+    }
+
+    [[nodiscard]]
+    size_t getRepetitions() const noexcept
+    {
+        return n_;
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        for (size_t it = 0; it < n_; ++it)
+        {
+            std::tie(circuit, encoder) = transformer_->run(std::move(circuit), std::move(encoder));
+        }
+        return {std::move(circuit), std::move(encoder)};
+    }
+};
+
+/**
+ * Applies owned transformer until cost of circuit stops decreasing, but no
+ * more than `max_iterations` times. Cost is given by `CostModel`, ties are
+ * broken by number of gates. Iteration, that increased cost, is rolled back,
+ * so result is never worse than the best one seen.
+ *
+ * @tparam CircuitT -- class that carries circuit.
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
+class Fixpoint : public ITransformer<CircuitT>
+{
+private:
+    TransformerPtr<CircuitT> transformer_;
+    size_t max_iterations_;
+    CostModel cost_model_;
+
+public:
+    /** Default bound on number of iterations. **/
+    static constexpr size_t DefaultMaxIterations = 16;
+
+    explicit Fixpoint(
+        TransformerPtr<CircuitT>&& transformer,
+        size_t max_iterations = DefaultMaxIterations,
+        CostModel cost_model  = CostModel::gateCount())
+        : transformer_(std::move(transformer))
+        , max_iterations_(max_iterations)
+        , cost_model_(std::move(cost_model))
+    {
+    }
+
+    [[nodiscard]]
+    size_t getMaxIterations() const noexcept
+    {
+        return max_iterations_;
+    }
+
+    [[nodiscard]]
+    CostModel const& getCostModel() const noexcept
+    {
+        return cost_model_;
+    }
+
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        for (size_t it = 0; it < max_iterations_; ++it)
+        {
+            auto const cost_before = getCost_(*circuit);
+            // Copy is kept to be able to roll back non-improving iteration.
+            auto saved_circuit = std::make_unique<CircuitT>(*circuit);
+            auto saved_encoder = std::make_unique<NameEncoder>(*encoder);
+
+            std::tie(circuit, encoder) = transformer_->run(std::move(circuit), std::move(encoder));
+
+            auto const cost_after = getCost_(*circuit);
+            log::debug(
+                "Fixpoint iteration ", it, ": cost ", cost_before.first, " -> ", cost_after.first, ", ",
+                cost_before.second, " -> ", cost_after.second, " gates.");
+            if (cost_after >= cost_before)
+            {
+                if (cost_after > cost_before)
+                {
+                    return {std::move(saved_circuit), std::move(saved_encoder)};
+                }
+                break;
+            }
+        }
+        return {std::move(circuit), std::move(encoder)};
+    }
+
+private:
+    /* Cost of circuit, ties are broken by number of gates. */
+    std::pair<size_t, size_t> getCost_(CircuitT const& circuit) const
+    {
+        return {cost_model_.getCircuitCost(circuit), circuit.getNumberOfGates()};
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_PIPELINE_HPP
@@ -0,0 +1,305 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_PIPELINE_PARSER_HPP
+#define CIRBO_SEARCH_MINIMIZATION_PIPELINE_PARSER_HPP
+
+#include <cctype>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "core/cost_model.hpp"
+#include "core/structures/dag.hpp"
+#include "minimization/pipeline.hpp"
+#include "minimization/registry.hpp"
+
+/**
+ * Parser of textual pipeline descriptions. Grammar:
+ *
+ *   pipeline := item { (';' | ',') item } [';' | ',']
+ *   item     := 'repeat' '(' INT ')' '{' pipeline '}'
+ *             | 'fixpoint' [ '(' [ INT ] [ ',' ] [ 'cost' '=' VALUE ] ')' ] '{' pipeline '}'
+ *             | NAME [ '(' param { ',' param } ')' ]
+ *   param    := NAME [ '=' VALUE ]
+ *
+ * NAME is either a transformer, registered in the registry, or a preset,
+ * which is expanded in place. VALUE may also contain '/' and ':', so it can be
+ * a path or a cost model (see `CostModel::parse`), e.g. `CutRewriting(cost=gates/XOR:0)`.
+ * Fixpoint stops, when cost of circuit (by default, number of gates) stops decreasing,
+ * e.g. `fixpoint(4, cost=mc) { ... }` minimizes number of AND gates.
+ * Everything from '#' to the end of line is a comment.
+ *
+ * Example: "DuplicateGatesCleaner; fixpoint { ConstantGateReducer; DeMorgan }; default"
+ */
+namespace cirbo::minimization
+{
+
+template<class CircuitT>
+class PipelineParser
+{
+private:
+    /* Bound on nesting of presets, protects from recursive presets. */
+    static constexpr size_t MaxPresetDepth = 16;
+
+    TransformerRegistry<CircuitT> const& registry_;
+    std::string_view text_;
+    size_t pos_ = 0;
+    size_t preset_depth_;
+
+public:
+    explicit PipelineParser(TransformerRegistry<CircuitT> const& registry, size_t preset_depth = 0)
+        : registry_(registry)
+        , preset_depth_(preset_depth)
+    {
+    }
+
+    /**
+     * @param text -- pipeline description.
+     * @return transformer, that applies described pipeline.
+     * @throws std::invalid_argument if description is malformed.
+     */
+    [[nodiscard]]
+    std::unique_ptr<DynamicComposition<CircuitT>> parse(std::string_view text)
+    {
+        text_ = text;
+        pos_  = 0;
+
+        auto result = parseSequence_();
+        result->setName("pipeline");
+        skipSpaces_();
+        if (pos_ != text_.size())
+        {
+            fail_("unexpected '" + std::string(1, text_[pos_]) + "'");
+        }
+        return result;
+    }
+
+private:
+    [[noreturn]]
+    void fail_(std::string const& message) const
+    {
+        throw std::invalid_argument(
+            "Pipeline parse error at position " + std::to_string(pos_) + ": " + message + ".");
+    }
+
+    void skipSpaces_()
+    {
+        while (pos_ < text_.size())
+        {
+            if (std::isspace(static_cast<unsigned char>(text_[pos_])))
+            {
+                ++pos_;
+            }
+            else if (text_[pos_] == '#')
+            {
+                while (pos_ < text_.size() && text_[pos_] != '\n')
+                {
+                    ++pos_;
+                }
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    bool consume_(char symbol)
+    {
+        skipSpaces_();
+        if (pos_ < text_.size() && text_[pos_] == symbol)
+        {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect_(char symbol)
+    {
+        if (!consume_(symbol))
+        {
+            fail_("expected '" + std::string(1, symbol) + "'");
+        }
+    }
+
+    static bool isNameSymbol_(char symbol)
+    {
+        return std::isalnum(static_cast<unsigned char>(symbol)) || symbol == '_' || symbol == '-' || symbol == '.';
+    }
+
+    std::string readName_(bool value = false)
+    {
+        skipSpaces_();
+        size_t const begin = pos_;
+        while (pos_ < text_.size() &&
+               (isNameSymbol_(text_[pos_]) || (value && (text_[pos_] == '/' || text_[pos_] == ':'))))
+        {
+            ++pos_;
+        }
+        if (begin == pos_)
+        {
+            fail_("expected name");
+        }
+        return std::string(text_.substr(begin, pos_ - begin));
+    }
+
+    size_t readCount_()
+    {
+        std::string const value = readName_();
+        if (value.find_first_not_of("0123456789") != std::string::npos || value.size() > 9)
+        {
+            fail_("expected non-negative integer, got '" + value + "'");
+        }
+        return std::stoul(value);
+    }
+
+    std::unique_ptr<DynamicComposition<CircuitT>> parseSequence_()
+    {
+        auto sequence = std::make_unique<DynamicComposition<CircuitT>>();
+        while (true)
+        {
+            skipSpaces_();
+            if (pos_ == text_.size() || text_[pos_] == '}')
+            {
+                break;
+            }
+            sequence->add(parseItem_());
+            if (!consume_(';') && !consume_(','))
+            {
+                break;
+            }
+        }
+        return sequence;
+    }
+
+    /* Parses `{ ... }`, block of single transformer is not wrapped into composition. */
+    TransformerPtr<CircuitT> parseBlock_()
+    {
+        expect_('{');
+        auto body = parseSequence_();
+        expect_('}');
+        if (body->size() == 1)
+        {
+            return std::move(body->releaseTransformers().front());
+        }
+        return body;
+    }
+
+    TransformerPtr<CircuitT> parseItem_()
+    {
+        std::string const name = readName_();
+        if (name == "repeat")
+        {
+            expect_('(');
+            size_t const n = readCount_();
+            expect_(')');
+            auto nest = std::make_unique<DynamicNest<CircuitT>>(parseBlock_(), n);
+            nest->setName("repeat(" + std::to_string(n) + ")");
+            return nest;
+        }
+        if (name == "fixpoint")
+        {
+            size_t max_iterations = Fixpoint<CircuitT>::DefaultMaxIterations;
+            std::string cost      = "gates";
+            std::string arguments;
+            if (consume_('('))
+            {
+                skipSpaces_();
+                if (pos_ < text_.size() && std::isdigit(static_cast<unsigned char>(text_[pos_])))
+                {
+                    max_iterations = readCount_();
+                    consume_(',');
+                }
+                if (!consume_(')'))
+                {
+                    if (readName_() != "cost")
+                    {
+                        fail_("fixpoint accepts only number of iterations and cost");
+                    }
+                    expect_('=');
+                    cost      = readName_(true);
+                    arguments = ", cost=" + cost;
+                    expect_(')');
+                }
+            }
+            CostModel cost_model;
+            try
+            {
+                cost_model = CostModel::parse(cost);
+            }
+            catch (std::invalid_argument const& error)
+            {
+                fail_(error.what());
+            }
+            auto fixpoint = std::make_unique<Fixpoint<CircuitT>>(parseBlock_(), max_iterations, std::move(cost_model));
+            fixpoint->setName("fixpoint(" + std::to_string(max_iterations) + arguments + ")");
+            return fixpoint;
+        }
+
+        TransformerParams params;
+        if (consume_('('))
+        {
+            while (!consume_(')'))
+            {
+                std::string key = readName_();
+                std::string value = "true";
+                if (consume_('='))
+                {
+                    value = readName_(true);
+                }
+                params.set(std::move(key), std::move(value));
+                if (!consume_(','))
+                {
+                    expect_(')');
+                    break;
+                }
+            }
+        }
+
+        if (std::string const* preset = registry_.findPreset(name); preset != nullptr && !registry_.contains(name))
+        {
+            if (!params.getValues().empty())
+            {
+                fail_("preset '" + name + "' does not accept parameters");
+            }
+            if (preset_depth_ >= MaxPresetDepth)
+            {
+                fail_("presets are nested too deep, probably '" + name + "' is recursive");
+            }
+            auto expanded = PipelineParser(registry_, preset_depth_ + 1).parse(*preset);
+            expanded->setName(name);
+            return expanded;
+        }
+        if (!registry_.contains(name))
+        {
+            fail_("unknown transformer '" + name + "'");
+        }
+        try
+        {
+            return registry_.create(name, params);
+        }
+        catch (std::invalid_argument const& error)
+        {
+            fail_(error.what());
+        }
+    }
+};
+
+/**
+ * @param text -- pipeline description, see `PipelineParser`.
+ * @param registry -- registry to look transformers and presets up.
+ * @return transformer, that applies described pipeline.
+ */
+inline std::unique_ptr<DynamicComposition<DAG>> parsePipeline(
+    std::string_view text,
+    TransformerRegistry<DAG> const& registry = getDefaultTransformerRegistry())
+{
+    return PipelineParser<DAG>(registry).parse(text);
+}
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_PIPELINE_PARSER_HPP
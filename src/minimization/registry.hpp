@@ -0,0 +1,745 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_REGISTRY_HPP
+#define CIRBO_SEARCH_MINIMIZATION_REGISTRY_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "core/cost_model.hpp"
+#include "core/npn.hpp"
+#include "core/structures/dag.hpp"
+#include "core/structures/icircuit.hpp"
+#include "minimization/pipeline.hpp"
+#include "minimization/strategy.hpp"
+#include "minimization/transformer_base.hpp"
+#include "synthesis/synthesis_cache.hpp"
+#include "utils/cast.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * Parameters of a transformer, given in a runtime pipeline description,
+ * e.g. `DisconnectSymmetricalGates(arity=3, and)`. Parameter without
+ * value (`and`) is considered to be boolean flag set to true.
+ */
+class TransformerParams
+{
+private:
+    std::map<std::string, std::string, std::less<>> values_;
+
+public:
+    TransformerParams() = default;
+
+    TransformerParams(std::initializer_list<std::pair<std::string const, std::string>> values)
+        : values_(values)
+    {
+    }
+
+    void set(std::string key, std::string value) { values_[std::move(key)] = std::move(value); }
+
+    [[nodiscard]]
+    bool contains(std::string_view key) const
+    {
+        return values_.find(key) != values_.end();
+    }
+
+    [[nodiscard]]
+    std::map<std::string, std::string, std::less<>> const& getValues() const noexcept
+    {
+        return values_;
+    }
+
+    /**
+     * @return value of boolean parameter `key`, or `default_value` if it is not set.
+     */
+    [[nodiscard]]
+    bool getBool(std::string_view key, bool default_value = false) const
+    {
+        auto const it = values_.find(key);
+        if (it == values_.end())
+        {
+            return default_value;
+        }
+        std::string const& value = it->second;
+        if (value == "true" || value == "1" || value == "yes" || value == "on")
+        {
+            return true;
+        }
+        if (value == "false" || value == "0" || value == "no" || value == "off")
+        {
+            return false;
+        }
+        throw std::invalid_argument("Parameter '" + it->first + "' expects boolean value, got '" + value + "'.");
+    }
+
+    /**
+     * @return value of integer parameter `key`, or `default_value` if it is not set.
+     */
+    [[nodiscard]]
+    int64_t getInt(std::string_view key, int64_t default_value) const
+    {
+        auto const it = values_.find(key);
+        if (it == values_.end())
+        {
+            return default_value;
+        }
+        size_t parsed = 0;
+        int64_t result = 0;
+        try
+        {
+            result = std::stoll(it->second, &parsed);
+        }
+        catch (std::exception const&)
+        {
+            parsed = 0;
+        }
+        if (parsed == 0 || parsed != it->second.size())
+        {
+            throw std::invalid_argument(
+                "Parameter '" + it->first + "' expects integer value, got '" + it->second + "'.");
+        }
+        return result;
+    }
+
+    /**
+     * @return value of string parameter `key`, or `default_value` if it is not set.
+     */
+    [[nodiscard]]
+    std::string getString(std::string_view key, std::string const& default_value) const
+    {
+        auto const it = values_.find(key);
+        return it == values_.end() ? default_value : it->second;
+    }
+};
+
+/**
+ * Maps names to factories of transformers, so transformers can be chosen at runtime.
+ * Additionally carries named pipeline presets (pipeline descriptions).
+ *
+ * @tparam CircuitT -- class that carries circuit.
+ */
+template<class CircuitT>
+class TransformerRegistry
+{
+public:
+    using Factory = std::function<TransformerPtr<CircuitT>(TransformerParams const&)>;
+
+    struct Entry
+    {
+        std::string name;
+        std::string description;
+        /* Names of parameters, accepted by the transformer. */
+        std::vector<std::string> parameters;
+        Factory factory;
+    };
+
+private:
+    std::map<std::string, Entry, std::less<>> entries_;
+    std::map<std::string, std::string, std::less<>> presets_;
+
+public:
+    /**
+     * Registers new transformer. Already registered transformer with the same name is replaced.
+     */
+    void add(std::string name, std::string description, std::vector<std::string> parameters, Factory factory)
+    {
+        std::string key = name;
+        entries_[std::move(key)] =
+            Entry{std::move(name), std::move(description), std::move(parameters), std::move(factory)};
+    }
+
+    /**
+     * Registers transformer, which has no parameters and is default constructible.
+     */
+    template<class TransformerT>
+    void add(std::string name, std::string description)
+    {
+        add(std::move(name),
+            std::move(description),
+            {},
+            [](TransformerParams const&) -> TransformerPtr<CircuitT> { return std::make_unique<TransformerT>(); });
+    }
+
+    /**
+     * Registers named pipeline description, which may be referenced by name inside other pipelines.
+     */
+    void addPreset(std::string name, std::string pipeline) { presets_[std::move(name)] = std::move(pipeline); }
+
+    [[nodiscard]]
+    bool contains(std::string_view name) const
+    {
+        return entries_.find(name) != entries_.end();
+    }
+
+    [[nodiscard]]
+    std::string const* findPreset(std::string_view name) const
+    {
+        auto const it = presets_.find(name);
+        return it == presets_.end() ? nullptr : &it->second;
+    }
+
+    [[nodiscard]]
+    std::map<std::string, Entry, std::less<>> const& getEntries() const noexcept
+    {
+        return entries_;
+    }
+
+    [[nodiscard]]
+    std::map<std::string, std::string, std::less<>> const& getPresets() const noexcept
+    {
+        return presets_;
+    }
+
+    /**
+     * Instantiates transformer `name` with given parameters.
+     * @throws std::invalid_argument if transformer is unknown, or unsupported parameter is given.
+     */
+    [[nodiscard]]
+    TransformerPtr<CircuitT> create(std::string_view name, TransformerParams const& params = {}) const
+    {
+        auto const it = entries_.find(name);
+        if (it == entries_.end())
+        {
+            throw std::invalid_argument("Unknown transformer '" + std::string(name) + "'.");
+        }
+        for (auto const& [key, _] : params.getValues())
+        {
+            if (std::ranges::find(it->second.parameters, key) == it->second.parameters.end())
+            {
+                throw std::invalid_argument(
+                    "Transformer '" + std::string(name) + "' has no parameter '" + key + "'.");
+            }
+        }
+        TransformerPtr<CircuitT> transformer = it->second.factory(params);
+        transformer->setName(it->second.name);
+        return transformer;
+    }
+};
+
+namespace impl
+{
+
+/** Arities, which are supported by runtime `DisconnectSymmetricalGates`. **/
+constexpr int MinDisconnectArity = 2;
+constexpr int MaxDisconnectArity = 8;
+
+using DAGTransformerFactory = TransformerPtr<DAG> (*)();
+
+/* Index of the enabled types set, which is used to choose template instance. */
+inline size_t symmetricalTypesIndex_(TransformerParams const& params)
+{
+    return static_cast<size_t>(params.getBool("and")) | (static_cast<size_t>(params.getBool("or")) << 1U) |
+           (static_cast<size_t>(params.getBool("xor")) << 2U);
+}
+
+/* Cost model of parameter `cost` (see `CostModel::parse`), or `default_model` if it is not set. */
+inline CostModel getCostModel_(TransformerParams const& params, CostModel const& default_model)
+{
+    return params.contains("cost") ? CostModel::parse(params.getString("cost", "")) : default_model;
+}
+
+template<size_t Types>
+TransformerPtr<DAG> makeConnectSymmetricalGates_()
+{
+    return std::make_unique<ConnectSymmetricalGates<DAG, (Types & 1U) != 0, (Types & 2U) != 0, (Types & 4U) != 0>>();
+}
+
+template<size_t... Types>
+constexpr std::array<DAGTransformerFactory, sizeof...(Types)> connectSymmetricalGatesTable_(
+    std::index_sequence<Types...> /*unused*/)
+{
+    return {&makeConnectSymmetricalGates_<Types>...};
+}
+
+template<size_t Types>
+TransformerPtr<DAG> makeBalanceSymmetricalGates_()
+{
+    return std::make_unique<BalanceSymmetricalGates<DAG, (Types & 1U) != 0, (Types & 2U) != 0, (Types & 4U) != 0>>();
+}
+
+template<size_t... Types>
+constexpr std::array<DAGTransformerFactory, sizeof...(Types)> balanceSymmetricalGatesTable_(
+    std::index_sequence<Types...> /*unused*/)
+{
+    return {&makeBalanceSymmetricalGates_<Types>...};
+}
+
+template<size_t Types>
+TransformerPtr<DAG> makeExtractCommonPairs_()
+{
+    return std::make_unique<ExtractCommonPairs<DAG, (Types & 1U) != 0, (Types & 2U) != 0, (Types & 4U) != 0>>();
+}
+
+template<size_t... Types>
+constexpr std::array<DAGTransformerFactory, sizeof...(Types)> extractCommonPairsTable_(
+    std::index_sequence<Types...> /*unused*/)
+{
+    return {&makeExtractCommonPairs_<Types>...};
+}
+
+template<size_t Index>
+TransformerPtr<DAG> makeDisconnectSymmetricalGates_()
+{
+    constexpr size_t types = Index % 8;
+    constexpr int arity    = MinDisconnectArity + static_cast<int>(Index / 8);
+    return std::make_unique<
+        DisconnectSymmetricalGates<DAG, arity, (types & 1U) != 0, (types & 2U) != 0, (types & 4U) != 0>>();
+}
+
+template<size_t... Indices>
+constexpr std::array<DAGTransformerFactory, sizeof...(Indices)> disconnectSymmetricalGatesTable_(
+    std::index_sequence<Indices...> /*unused*/)
+{
+    return {&makeDisconnectSymmetricalGates_<Indices>...};
+}
+
+inline TransformerPtr<DAG> makeConnectSymmetricalGates(TransformerParams const& params)
+{
+    static constexpr auto table = connectSymmetricalGatesTable_(std::make_index_sequence<8>{});
+    return table[symmetricalTypesIndex_(params)]();
+}
+
+inline TransformerPtr<DAG> makeBalanceSymmetricalGates(TransformerParams const& params)
+{
+    static constexpr auto table = balanceSymmetricalGatesTable_(std::make_index_sequence<8>{});
+    return table[symmetricalTypesIndex_(params)]();
+}
+
+inline TransformerPtr<DAG> makeExtractCommonPairs(TransformerParams const& params)
+{
+    static constexpr auto table = extractCommonPairsTable_(std::make_index_sequence<8>{});
+    return table[symmetricalTypesIndex_(params)]();
+}
+
+inline TransformerPtr<DAG> makeDisconnectSymmetricalGates(TransformerParams const& params)
+{
+    static constexpr size_t arities = MaxDisconnectArity - MinDisconnectArity + 1;
+    static constexpr auto table     = disconnectSymmetricalGatesTable_(std::make_index_sequence<arities * 8>{});
+
+    int64_t const arity = params.getInt("arity", 2);
+    if (arity < MinDisconnectArity || arity > MaxDisconnectArity)
+    {
+        throw std::invalid_argument(
+            "DisconnectSymmetricalGates arity must lie in [" + std::to_string(MinDisconnectArity) + ", " +
+            std::to_string(MaxDisconnectArity) + "], got " + std::to_string(arity) + ".");
+    }
+    return table[(static_cast<size_t>(arity - MinDisconnectArity) * 8) + symmetricalTypesIndex_(params)]();
+}
+
+inline TransformerPtr<DAG> makeRedundantGatesCleaner_(TransformerParams const& params)
+{
+    if (params.getBool("preserve_inputs"))
+    {
+        return std::make_unique<RedundantGatesCleaner_<DAG, true>>();
+    }
+    return std::make_unique<RedundantGatesCleaner_<DAG>>();
+}
+
+inline TransformerPtr<DAG> makeSatSweeping(TransformerParams const& params)
+{
+    int64_t const words          = params.getInt("words", SatSweeping_<DAG>::DefaultWords);
+    int64_t const conflict_limit = params.getInt("conflict_limit", SatSweeping_<DAG>::DefaultConflictLimit);
+    if (words < 1)
+    {
+        throw std::invalid_argument("SatSweeping words must be positive, got " + std::to_string(words) + ".");
+    }
+
+    // Same as `SatSweeping` strategy, but with configured sweeping pass.
+    auto composition = std::make_unique<DynamicComposition<DAG>>();
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<SatSweeping_<DAG>>(static_cast<size_t>(words), conflict_limit));
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG, true>>());
+    composition->add(std::make_unique<ConstantGateReducer_<DAG>>());
+    composition->add(std::make_unique<ReduceNotComposition_<DAG>>());
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<DuplicateGatesCleaner_<DAG>>());
+    return composition;
+}
+
+inline TransformerPtr<DAG> makeEqualitySaturation(TransformerParams const& params)
+{
+    using Transformer        = EqualitySaturation_<DAG>;
+    int64_t const iterations = params.getInt("iterations", Transformer::DefaultIterations);
+    int64_t const growth     = params.getInt("growth", Transformer::DefaultGrowth);
+    if (iterations < 0 || growth < 1)
+    {
+        throw std::invalid_argument("EqualitySaturation expects non-negative iterations and positive growth.");
+    }
+
+    // Same as `EqualitySaturation` strategy, but with configured saturation pass.
+    auto composition = std::make_unique<DynamicComposition<DAG>>();
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<Transformer>(
+        static_cast<size_t>(iterations), static_cast<size_t>(growth), getCostModel_(params, CostModel::gateCount())));
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG, true>>());
+    composition->add(std::make_unique<DuplicateGatesCleaner_<DAG>>());
+    return composition;
+}
+
+inline TransformerPtr<DAG> makeSubcircuitMinimization(TransformerParams const& params)
+{
+    using Transformer            = SubcircuitMinimization_<DAG>;
+    int64_t const inputs         = params.getInt("inputs", Transformer::DefaultMaxInputs);
+    int64_t const outputs        = params.getInt("outputs", Transformer::DefaultMaxOutputs);
+    int64_t const gates          = params.getInt("gates", Transformer::DefaultMaxWindowGates);
+    int64_t const conflict_limit = params.getInt("conflict_limit", Transformer::DefaultConflictLimit);
+    int64_t const threads        = params.getInt("threads", 0);
+    if (inputs < 1 || inputs > static_cast<int64_t>(npn::MaxVariables) || outputs < 1 || gates < 1 || threads < 0)
+    {
+        throw std::invalid_argument(
+            "SubcircuitMinimization expects inputs in [1, " + std::to_string(npn::MaxVariables)
+            + "], positive outputs and gates, non-negative threads.");
+    }
+    std::string const basis = params.getString("basis", "BENCH");
+    if (basis != "AIG" && basis != "XAG" && basis != "BENCH")
+    {
+        throw std::invalid_argument("SubcircuitMinimization basis must be one of AIG, XAG, BENCH, got " + basis + ".");
+    }
+    std::shared_ptr<circuits_db::CircuitDatabase const> database;
+    if (params.contains("database"))
+    {
+        database = std::make_shared<circuits_db::CircuitDatabase const>(params.getString("database", ""));
+    }
+
+    // Same as `SubcircuitMinimization` strategy, but with configured local search pass.
+    auto composition = std::make_unique<DynamicComposition<DAG>>();
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<Transformer>(
+        utils::stringToBasis(basis),
+        static_cast<size_t>(inputs),
+        static_cast<size_t>(outputs),
+        static_cast<size_t>(gates),
+        conflict_limit,
+        static_cast<size_t>(threads),
+        std::move(database),
+        std::make_shared<synthesis::SynthesisCache>(),
+        getCostModel_(params, CostModel::gateCount())));
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG, true>>());
+    composition->add(std::make_unique<ConstantGateReducer_<DAG>>());
+    composition->add(std::make_unique<ReduceNotComposition_<DAG>>());
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<DuplicateGatesCleaner_<DAG>>());
+    return composition;
+}
+
+inline TransformerPtr<DAG> makeCutRewriting(TransformerParams const& params)
+{
+    int64_t const cuts           = params.getInt("cuts", CutRewriting_<DAG>::DefaultCutLimit);
+    int64_t const gates          = params.getInt("gates", RewritingLibrary::DefaultMaxGates);
+    int64_t const conflict_limit = params.getInt("conflict_limit", RewritingLibrary::DefaultConflictLimit);
+    std::string const basis      = params.getString("basis", "BENCH");
+    if (cuts < 1 || gates < 0)
+    {
+        throw std::invalid_argument("CutRewriting expects positive cuts and non-negative gates.");
+    }
+    if (basis != "AIG" && basis != "XAG" && basis != "BENCH")
+    {
+        throw std::invalid_argument("CutRewriting basis must be one of AIG, XAG, BENCH, got " + basis + ".");
+    }
+    std::shared_ptr<circuits_db::CircuitDatabase const> database;
+    if (params.contains("database"))
+    {
+        database = std::make_shared<circuits_db::CircuitDatabase const>(params.getString("database", ""));
+    }
+    // Library without database is generated on demand, so passes with default limits share it.
+    bool const shared = database == nullptr && gates == static_cast<int64_t>(RewritingLibrary::DefaultMaxGates)
+                        && conflict_limit == RewritingLibrary::DefaultConflictLimit;
+    auto library = shared ? RewritingLibrary::getDefault(utils::stringToBasis(basis))
+                          : std::make_shared<RewritingLibrary>(
+                                utils::stringToBasis(basis), std::move(database), static_cast<size_t>(gates), conflict_limit);
+
+    // Same as `CutRewriting` strategy, but with configured rewriting pass.
+    auto composition = std::make_unique<DynamicComposition<DAG>>();
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<CutRewriting_<DAG>>(
+        std::move(library), static_cast<size_t>(cuts), getCostModel_(params, CostModel::gateCount())));
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG, true>>());
+    composition->add(std::make_unique<ConstantGateReducer_<DAG>>());
+    composition->add(std::make_unique<ReduceNotComposition_<DAG>>());
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<DuplicateGatesCleaner_<DAG>>());
+    return composition;
+}
+
+inline TransformerPtr<DAG> makeRefactoring(TransformerParams const& params)
+{
+    using Transformer     = Refactoring_<DAG>;
+    int64_t const inputs  = params.getInt("inputs", Transformer::DefaultMaxInputs);
+    int64_t const threads = params.getInt("threads", 0);
+    if (inputs < 2 || inputs > static_cast<int64_t>(Transformer::MaxInputs) || threads < 0)
+    {
+        throw std::invalid_argument(
+            "Refactoring expects inputs in [2, " + std::to_string(Transformer::MaxInputs)
+            + "] and non-negative threads.");
+    }
+
+    // Same as `Refactoring` strategy, but with configured refactoring pass.
+    auto composition = std::make_unique<DynamicComposition<DAG>>();
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<Transformer>(
+        static_cast<size_t>(inputs),
+        static_cast<size_t>(threads),
+        std::make_shared<RefactoringCache>(),
+        getCostModel_(params, CostModel::gateCount())));
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG, true>>());
+    composition->add(std::make_unique<ConstantGateReducer_<DAG>>());
+    composition->add(std::make_unique<ReduceNotComposition_<DAG>>());
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<DuplicateGatesCleaner_<DAG>>());
+    return composition;
+}
+
+inline TransformerPtr<DAG> makeResubstitution(TransformerParams const& params)
+{
+    using Transformer      = Resubstitution_<DAG>;
+    int64_t const inputs   = params.getInt("inputs", Transformer::DefaultMaxInputs);
+    int64_t const divisors = params.getInt("divisors", Transformer::DefaultMaxDivisors);
+    int64_t const words    = params.getInt("words", Transformer::DefaultWords);
+    int64_t const threads  = params.getInt("threads", 0);
+    if (inputs < 1 || inputs > static_cast<int64_t>(Transformer::MaxInputs) || divisors < 1 || words < 1 ||
+        threads < 0)
+    {
+        throw std::invalid_argument(
+            "Resubstitution expects inputs in [1, " + std::to_string(Transformer::MaxInputs)
+            + "], positive divisors and words, non-negative threads.");
+    }
+
+    // Same as `Resubstitution` strategy, but with configured resubstitution pass.
+    auto composition = std::make_unique<DynamicComposition<DAG>>();
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<Transformer>(
+        static_cast<size_t>(inputs),
+        static_cast<size_t>(divisors),
+        static_cast<size_t>(words),
+        static_cast<size_t>(threads),
+        getCostModel_(params, CostModel::gateCount())));
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<DuplicateGatesCleaner_<DAG>>());
+    return composition;
+}
+
+inline TransformerPtr<DAG> makeDontCareOptimization(TransformerParams const& params)
+{
+    using Transformer            = DontCareOptimization_<DAG>;
+    int64_t const inputs         = params.getInt("inputs", Transformer::DefaultMaxInputs);
+    int64_t const levels         = params.getInt("levels", Transformer::DefaultLevels);
+    int64_t const words          = params.getInt("words", Transformer::DefaultWords);
+    int64_t const conflict_limit = params.getInt("conflict_limit", Transformer::DefaultConflictLimit);
+    if (inputs < 1 || inputs > static_cast<int64_t>(Transformer::MaxInputs) || levels < 1 || words < 1)
+    {
+        throw std::invalid_argument(
+            "DontCareOptimization expects inputs in [1, " + std::to_string(Transformer::MaxInputs)
+            + "], positive levels and words.");
+    }
+
+    // Same as `DontCareOptimization` strategy, but with configured optimization pass.
+    auto composition = std::make_unique<DynamicComposition<DAG>>();
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<Transformer>(
+        static_cast<size_t>(inputs),
+        static_cast<size_t>(levels),
+        static_cast<size_t>(words),
+        conflict_limit,
+        getCostModel_(params, CostModel::gateCount())));
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG, true>>());
+    composition->add(std::make_unique<ConstantGateReducer_<DAG>>());
+    composition->add(std::make_unique<ReduceNotComposition_<DAG>>());
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<DuplicateGatesCleaner_<DAG>>());
+    return composition;
+}
+
+inline TransformerPtr<DAG> makeLinearMinimization(TransformerParams const& params)
+{
+    using Transformer      = LinearMinimization_<DAG>;
+    int64_t const inputs   = params.getInt("inputs", Transformer::DefaultMaxInputs);
+    int64_t const outputs  = params.getInt("outputs", Transformer::DefaultMaxOutputs);
+    int64_t const attempts = params.getInt("attempts", Transformer::DefaultAttempts);
+    if (inputs < 1 || outputs < 1 || attempts < 1)
+    {
+        throw std::invalid_argument("LinearMinimization expects positive inputs, outputs and attempts.");
+    }
+
+    // Same as `LinearMinimization` strategy, but with configured minimization pass.
+    auto composition = std::make_unique<DynamicComposition<DAG>>();
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<Transformer>(
+        static_cast<size_t>(inputs),
+        static_cast<size_t>(outputs),
+        static_cast<size_t>(attempts),
+        getCostModel_(params, CostModel::binaryGateCount())));
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG, true>>());
+    composition->add(std::make_unique<ConstantGateReducer_<DAG>>());
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<DuplicateGatesCleaner_<DAG>>());
+    return composition;
+}
+
+inline TransformerPtr<DAG> makeMultiplicativeComplexityRewriting(TransformerParams const& params)
+{
+    using Transformer  = MultiplicativeComplexityRewriting_<DAG>;
+    int64_t const cuts = params.getInt("cuts", Transformer::DefaultCutLimit);
+    if (cuts < 1)
+    {
+        throw std::invalid_argument("MultiplicativeComplexityRewriting expects positive cuts.");
+    }
+
+    // Same as `MultiplicativeComplexityRewriting` strategy, but with configured rewriting pass.
+    auto composition = std::make_unique<DynamicComposition<DAG>>();
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<Transformer>(
+        getCostModel_(params, CostModel::multiplicativeComplexity()), static_cast<size_t>(cuts)));
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG, true>>());
+    composition->add(std::make_unique<ConstantGateReducer_<DAG>>());
+    composition->add(std::make_unique<ReduceNotComposition_<DAG>>());
+    composition->add(std::make_unique<RedundantGatesCleaner_<DAG>>());
+    composition->add(std::make_unique<DuplicateGatesCleaner_<DAG>>());
+    return composition;
+}
+
+}  // namespace impl
+
+/**
+ * @return new registry, which contains all transformers defined in the library
+ *         (strategies from `minimization/strategy.hpp` and their building blocks)
+ *         and a few pipeline presets.
+ */
+inline TransformerRegistry<DAG> makeDefaultTransformerRegistry()
+{
+    TransformerRegistry<DAG> registry;
+
+    // Strategies, which are safe to use in any order.
+    registry.add<RedundantGatesCleaner<DAG>>(
+        "RedundantGatesCleaner", "Removes gates, that are not reachable from outputs.");
+    registry.add<DuplicateGatesCleaner<DAG>>(
+        "DuplicateGatesCleaner", "Merges gates with the same type and operands.");
+    registry.add<ReduceNotComposition<DAG>>("ReduceNotComposition", "Reduces chains of NOT gates.");
+    registry.add<ConstantGateReducer<DAG>>("ConstantGateReducer", "Propagates constant gates.");
+    registry.add<DuplicateOperandsCleaner<DAG>>(
+        "DuplicateOperandsCleaner", "Reduces repeated and opposite operands of gates.");
+    registry.add<MergeNotWithOthers<DAG>>("MergeNotWithOthers", "Merges NOT gates with their operands (AND -> NAND).");
+    registry.add<DeMorgan<DAG>>("DeMorgan", "Moves NOT gates closer to inputs using de Morgan's laws.");
+    registry.add<SplitNotFromOthers<DAG>>("SplitNotFromOthers", "Splits NAND/NOR/NXOR into NOT and AND/OR/XOR.");
+    registry.add(
+        "ConnectSymmetricalGates",
+        "Merges nested AND/OR/XOR gates into one gate of bigger arity.",
+        {"and", "or", "xor"},
+        impl::makeConnectSymmetricalGates);
+    registry.add(
+        "DisconnectSymmetricalGates",
+        "Splits AND/OR/XOR gates into chains of gates of given arity.",
+        {"arity", "and", "or", "xor"},
+        impl::makeDisconnectSymmetricalGates);
+    registry.add(
+        "BalanceSymmetricalGates",
+        "Rebuilds trees of binary AND/OR/XOR gates as trees of minimal depth.",
+        {"and", "or", "xor"},
+        impl::makeBalanceSymmetricalGates);
+    registry.add(
+        "ExtractCommonPairs",
+        "Extracts pairs of operands, shared by several AND/OR/XOR gates, into new gates.",
+        {"and", "or", "xor"},
+        impl::makeExtractCommonPairs);
+    registry.add<ConvertToXAG<DAG>>("ConvertToXAG", "Expresses gates by AND, XOR and NOT gates.");
+    registry.add(
+        "SatSweeping",
+        "Merges functionally equivalent and constant gates, proven by SAT solver.",
+        {"words", "conflict_limit"},
+        impl::makeSatSweeping);
+    registry.add(
+        "EqualitySaturation",
+        "Applies NOT, de Morgan and constant rewrites at once by e-graph and extracts the cheapest circuit.",
+        {"iterations", "growth", "cost"},
+        impl::makeEqualitySaturation);
+    registry.add(
+        "SubcircuitMinimization",
+        "Replaces small windows of circuit by smaller subcircuits, found by exact synthesis or in database.",
+        {"inputs", "outputs", "gates", "conflict_limit", "threads", "basis", "database", "cost"},
+        impl::makeSubcircuitMinimization);
+    registry.add(
+        "CutRewriting",
+        "Rewrites gates by minimum circuits of their 4-input cut functions.",
+        {"cuts", "gates", "conflict_limit", "basis", "database", "cost"},
+        impl::makeCutRewriting);
+    registry.add(
+        "Refactoring",
+        "Rebuilds cones of gates by factored forms of their irredundant sums of products.",
+        {"inputs", "threads", "cost"},
+        impl::makeRefactoring);
+    registry.add(
+        "Resubstitution",
+        "Re-expresses gates by at most three existing gates of their windows.",
+        {"inputs", "divisors", "words", "threads", "cost"},
+        impl::makeResubstitution);
+    registry.add(
+        "DontCareOptimization",
+        "Re-expresses gates under satisfiability and observability don't cares, validated by SAT solver.",
+        {"inputs", "levels", "words", "conflict_limit", "cost"},
+        impl::makeDontCareOptimization);
+    registry.add(
+        "LinearMinimization",
+        "Re-synthesizes linear subcircuits of XOR gates by Paar's heuristic.",
+        {"inputs", "outputs", "attempts", "cost"},
+        impl::makeLinearMinimization);
+    registry.add(
+        "MultiplicativeComplexityRewriting",
+        "Rewrites gates by circuits with minimum number of AND gates of their 3-input cut functions.",
+        {"cuts", "cost"},
+        impl::makeMultiplicativeComplexityRewriting);
+
+    // Building blocks of strategies. Note that they have preconditions (see their docs).
+    registry.add(
+        "RedundantGatesCleaner_",
+        "Removes gates, that are not reachable from outputs.",
+        {"preserve_inputs"},
+        impl::makeRedundantGatesCleaner_);
+    registry.add<DuplicateGatesCleaner_<DAG>>("DuplicateGatesCleaner_", "Requires clean circuit.");
+    registry.add<ReduceNotComposition_<DAG>>("ReduceNotComposition_", "Leaves redundant gates.");
+    registry.add<ConstantGateReducer_<DAG>>("ConstantGateReducer_", "Leaves redundant gates and NOT chains.");
+    registry.add<DuplicateOperandsCleaner_<DAG>>("DuplicateOperandsCleaner_", "Leaves constant and redundant gates.");
+    registry.add<MergeNotWithOthers_<DAG>>("MergeNotWithOthers_", "Leaves redundant gates.");
+    registry.add<DeMorgan_<DAG>>("DeMorgan_", "Requires clean deduplicated circuit with merged NOT gates.");
+    registry.add<SplitNotFromOthers_<DAG>>("SplitNotFromOthers_", "Splits NAND/NOR/NXOR into NOT and AND/OR/XOR.");
+
+    registry.addPreset("default", "DuplicateGatesCleaner; DuplicateOperandsCleaner");
+    registry.addPreset("fast", "RedundantGatesCleaner; DuplicateGatesCleaner; ConstantGateReducer");
+    registry.addPreset(
+        "aggressive",
+        "DuplicateGatesCleaner;"
+        "fixpoint(8) {"
+        "  DuplicateOperandsCleaner; ConstantGateReducer; MergeNotWithOthers; DeMorgan;"
+        "  ConnectSymmetricalGates(and, or, xor); DuplicateGatesCleaner"
+        "};"
+        "DisconnectSymmetricalGates(arity=2, and, or, xor); DuplicateGatesCleaner");
+    // Iterations are judged by number of AND gates. ConstantGateReducer builds constant outputs
+    // by OR gates, so they are converted again.
+    registry.addPreset(
+        "xag",
+        "ConvertToXAG; fixpoint(4, cost=mc) { MultiplicativeComplexityRewriting; LinearMinimization }; ConvertToXAG");
+
+    return registry;
+}
+
+/**
+ * @return global registry of transformers, see `makeDefaultTransformerRegistry`.
+ */
+inline TransformerRegistry<DAG>& getDefaultTransformerRegistry()
+{
+    static TransformerRegistry<DAG> instance = makeDefaultTransformerRegistry();
+    return instance;
+}
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_REGISTRY_HPP
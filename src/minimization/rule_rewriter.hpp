@@ -0,0 +1,341 @@
+#ifndef CIRBO_SEARCH_MINIMIZATION_RULE_REWRITER_HPP
+#define CIRBO_SEARCH_MINIMIZATION_RULE_REWRITER_HPP
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/transformer_base.hpp"
+
+namespace cirbo::minimization
+{
+
+/**
+ * @return type of negation of gate of type `type`, e.g. NAND for AND, or UNDEFINED,
+ * if there is no such single gate type.
+ */
+constexpr GateType getNegatedType(GateType type) noexcept
+{
+    switch (type)
+    {
+        case GateType::AND:
+            return GateType::NAND;
+        case GateType::NAND:
+            return GateType::AND;
+        case GateType::OR:
+            return GateType::NOR;
+        case GateType::NOR:
+            return GateType::OR;
+        case GateType::XOR:
+            return GateType::NXOR;
+        case GateType::NXOR:
+            return GateType::XOR;
+        default:
+            return GateType::UNDEFINED;
+    }
+}
+
+/**
+ * Gate, matched by rewrite rule. Operands of gate are already rewritten, so
+ * rules see types and operands of operands in the rewritten circuit, built so
+ * far. Rule either keeps gate as is, replaces its type and operands, or
+ * redirects users of gate to another gate, possibly adding new gates.
+ *
+ * Note that `addGate` and `replace` invalidate references, returned by getters of operands.
+ */
+class RewriteView
+{
+private:
+    ICircuit const& circuit_;
+    GateInfoContainer& gate_info_;
+    std::vector<GateId>& redirections_;
+    NameEncoder& encoder_;
+    std::string const& new_gate_name_prefix_;
+    GateId gate_;
+    GateType type_;
+
+public:
+    RewriteView(
+        ICircuit const& circuit,
+        GateInfoContainer& gate_info,
+        std::vector<GateId>& redirections,
+        NameEncoder& encoder,
+        std::string const& new_gate_name_prefix,
+        GateId gateId)
+        : circuit_(circuit)
+        , gate_info_(gate_info)
+        , redirections_(redirections)
+        , encoder_(encoder)
+        , new_gate_name_prefix_(new_gate_name_prefix)
+        , gate_(gateId)
+        , type_(gate_info.at(gateId).getType())
+    {
+    }
+
+    [[nodiscard]]
+    GateId getGate() const noexcept
+    {
+        return gate_;
+    }
+
+    /** Returns type of gate in the original circuit. **/
+    [[nodiscard]]
+    GateType getType() const noexcept
+    {
+        return type_;
+    }
+
+    /** Returns operands of gate in the rewritten circuit. **/
+    [[nodiscard]]
+    GateIdContainer const& getOperands() const
+    {
+        return gate_info_.at(gate_).getOperands();
+    }
+
+    /** Returns type of i-th operand of gate in the rewritten circuit. **/
+    [[nodiscard]]
+    GateType getOperandType(size_t i) const
+    {
+        return gate_info_.at(getOperands().at(i)).getType();
+    }
+
+    /** Returns operands of i-th operand of gate in the rewritten circuit. **/
+    [[nodiscard]]
+    GateIdContainer const& getOperandOperands(size_t i) const
+    {
+        return gate_info_.at(getOperands().at(i)).getOperands();
+    }
+
+    /** Returns number of users of gate `gateId` in the original circuit. **/
+    [[nodiscard]]
+    size_t getNumberOfUsers(GateId gateId) const
+    {
+        return circuit_.getGateUsers(gateId).size();
+    }
+
+    /** Replaces type and operands of gate. **/
+    void replace(GateType type, GateIdContainer operands)
+    {
+        gate_info_.at(gate_) = {type, std::move(operands)};
+    }
+
+    /** Redirects users of gate to gate `target`, gate itself is left unreachable. **/
+    void redirect(GateId target)
+    {
+        redirections_.at(gate_) = target;
+    }
+
+    /** Adds new gate to circuit and returns its id. **/
+    GateId addGate(GateType type, GateIdContainer operands)
+    {
+        GateId const gateId = encoder_.encodeGate(getNewGateName_(new_gate_name_prefix_, gate_info_.size()));
+        gate_info_.emplace_back(type, std::move(operands));
+        redirections_.push_back(gateId);
+        return gateId;
+    }
+};
+
+/** Pattern of gate type, which matches gates of any type. **/
+struct AnyType
+{
+    static constexpr bool contains(GateType /*type*/) noexcept { return true; }
+};
+
+/** Pattern of gate type, which matches gates of one of `Types`. **/
+template<GateType... Types>
+struct TypeOf
+{
+    static constexpr bool contains(GateType type) noexcept { return ((type == Types) || ...); }
+};
+
+/**
+ * Pattern of gate: type of gate matches `Root`, and, if `Operands` are given,
+ * gate has exactly that many operands, and type of i-th rewritten operand
+ * matches i-th of `Operands`.
+ *
+ * @tparam Root -- pattern of gate type, e.g. `TypeOf<GateType::NOT>`.
+ * @tparam Operands -- patterns of types of operands.
+ */
+template<class Root, class... Operands>
+struct Pattern
+{
+    using RootType = Root;
+
+    /** Returns true iff operands of gate match pattern. Type of gate is matched by dispatch of `RuleSet`. **/
+    static bool matchOperands(RewriteView const& view)
+    {
+        if constexpr (sizeof...(Operands) == 0)
+        {
+            return true;
+        }
+        else
+        {
+            return view.getOperands().size() == sizeof...(Operands) &&
+                   matchOperands_(view, std::index_sequence_for<Operands...>{});
+        }
+    }
+
+private:
+    template<size_t... Indices>
+    static bool matchOperands_(RewriteView const& view, std::index_sequence<Indices...> /*unused*/)
+    {
+        return (Operands::contains(view.getOperandType(Indices)) && ...);
+    }
+};
+
+/**
+ * Rule is a type with:
+ *   - `static constexpr std::string_view Name`, which is counted in pass report, when rule is applied;
+ *   - `using Pattern = ...`, see `Pattern`;
+ *   - optional `static bool guard(RewriteView const&)`, extra condition of matched gate;
+ *   - `static void rewrite(RewriteView&)`, replacement of matched gate.
+ */
+template<class Rule>
+concept RewriteRule = requires(RewriteView& view) {
+    { Rule::Name } -> std::convertible_to<std::string_view>;
+    { Rule::Pattern::matchOperands(view) } -> std::same_as<bool>;
+    { Rule::Pattern::RootType::contains(GateType::INPUT) } -> std::same_as<bool>;
+    Rule::rewrite(view);
+};
+
+/**
+ * Set of rewrite rules, compiled to one dispatch table by gate type. Entry of
+ * table tries, in the given order, only rules, whose root pattern contains the
+ * type, so that rules of other types cost nothing, and the first rule, which
+ * matches gate, is applied.
+ *
+ * @tparam Rules -- rules, see `RewriteRule`.
+ */
+template<RewriteRule... Rules>
+class RuleSet
+{
+private:
+    using Dispatcher_ = bool (*)(RewriteView&);
+    static constexpr size_t NumberOfTypes_ = size_t{UINT8_MAX} + 1;
+
+public:
+    /** Applies the first rule, which matches gate, returns true iff there is such rule. **/
+    static bool apply(RewriteView& view)
+    {
+        static constexpr std::array<Dispatcher_, NumberOfTypes_> table =
+            makeTable_(std::make_index_sequence<NumberOfTypes_>{});
+        return table[static_cast<size_t>(view.getType())](view);
+    }
+
+private:
+    template<GateType Type, class Rule>
+    static bool tryRule_(RewriteView& view)
+    {
+        if constexpr (Rule::Pattern::RootType::contains(Type))
+        {
+            if (!Rule::Pattern::matchOperands(view))
+            {
+                return false;
+            }
+            if constexpr (requires { Rule::guard(view); })
+            {
+                if (!Rule::guard(view))
+                {
+                    return false;
+                }
+            }
+            Rule::rewrite(view);
+            countRule(Rule::Name);
+            return true;
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    template<size_t Type>
+    static bool dispatch_(RewriteView& view)
+    {
+        return (tryRule_<static_cast<GateType>(Type), Rules>(view) || ...);
+    }
+
+    template<size_t... Types>
+    static constexpr std::array<Dispatcher_, NumberOfTypes_> makeTable_(std::index_sequence<Types...> /*unused*/)
+    {
+        return {&dispatch_<Types>...};
+    }
+};
+
+/**
+ * Transformer, that applies set of local rewrite rules in one traversal of
+ * circuit. Gates are visited from inputs to outputs, so each rule sees
+ * operands, which are already rewritten, and at most one rule is applied
+ * to each gate. Users of redirected gates (and outputs) are redirected too.
+ *
+ * Note that redirected gates are left in circuit, so this algorithm must be
+ * followed by RedundantGatesCleaner, if some rule redirects gates.
+ *
+ * @tparam CircuitT
+ * @tparam RuleSetT -- rules, see `RuleSet`.
+ */
+template<class CircuitT, class RuleSetT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+class RuleRewriter_ : public ITransformer<CircuitT>
+{
+public:
+    CircuitAndEncoder<CircuitT, std::string> transform(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder) override
+    {
+        log::debug("=========================================================================================");
+        log::debug("START RuleRewriter");
+
+        // Topsort, from inputs to outputs.
+        GateIdContainer gate_sorting(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(*circuit));
+        std::reverse(gate_sorting.begin(), gate_sorting.end());
+        size_t const size = circuit->getNumberOfGates();
+
+        GateInfoContainer gate_info = acquireGateInfoContainer(size);
+        std::vector<GateId> redirections(size);
+        std::iota(redirections.begin(), redirections.end(), GateId{0});
+        auto const new_gate_name_prefix = (getUniqueId_() + "::new_gate_RuleRewriter@");
+
+        for (GateId const gateId : gate_sorting)
+        {
+            // Gate is kept with redirected operands, unless some rule rewrites it.
+            GateIdContainer operands = acquireGateIdContainer();
+            for (GateId const operand : circuit->getGateOperands(gateId))
+            {
+                operands.push_back(redirections.at(operand));
+            }
+            gate_info.at(gateId) = {circuit->getGateType(gateId), std::move(operands)};
+
+            RewriteView view(*circuit, gate_info, redirections, *encoder, new_gate_name_prefix, gateId);
+            RuleSetT::apply(view);
+        }
+
+        GateIdContainer new_output_gates{};
+        new_output_gates.reserve(circuit->getOutputGates().size());
+        for (GateId const output_gate : circuit->getOutputGates())
+        {
+            new_output_gates.push_back(redirections.at(output_gate));
+        }
+
+        log::debug("END RuleRewriter");
+        log::debug("=========================================================================================");
+        return {std::make_unique<CircuitT>(std::move(gate_info), std::move(new_output_gates)), std::move(encoder)};
+    }
+};
+
+}  // namespace cirbo::minimization
+
+#endif  // CIRBO_SEARCH_MINIMIZATION_RULE_REWRITER_HPP
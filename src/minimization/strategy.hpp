@@ -6,12 +6,24 @@
 #include "core/structures/dag.hpp"
 #include "core/structures/icircuit.hpp"
 #include "minimization/composition.hpp"
+#include "minimization/high_effort/equality_saturation.hpp"
+#include "minimization/high_effort/sat_sweeping.hpp"
+#include "minimization/local_search/cut_rewriting.hpp"
+#include "minimization/local_search/dont_care_optimization.hpp"
+#include "minimization/local_search/linear_minimization.hpp"
+#include "minimization/local_search/mc_rewriting.hpp"
+#include "minimization/local_search/refactoring.hpp"
+#include "minimization/local_search/resubstitution.hpp"
+#include "minimization/local_search/subcircuit_minimization.hpp"
+#include "minimization/low_effort/balance_symmetrical_gates.hpp"
 #include "minimization/low_effort/connect_symmetrical_gates.hpp"
 #include "minimization/low_effort/constant_gate_reducer.hpp"
+#include "minimization/low_effort/convert_to_xag.hpp"
 #include "minimization/low_effort/de_morgan.hpp"
 #include "minimization/low_effort/disconnect_symmetrical_gates.hpp"
 #include "minimization/low_effort/duplicate_gates_cleaner.hpp"
 #include "minimization/low_effort/duplicate_operands_cleaner.hpp"
+#include "minimization/low_effort/extract_common_pairs.hpp"
 #include "minimization/low_effort/merge_not_with_others.hpp"
 #include "minimization/low_effort/reduce_not_composition.hpp"
 #include "minimization/low_effort/redundant_gates_cleaner.hpp"
@@ -166,6 +178,63 @@ using DisconnectSymmetricalGates = Composition<
     RedundantGatesCleaner_<DAG>,
     DisconnectSymmetricalGates_<DAG, arity, EnableAND, EnableOR, EnableXOR> >;
 
+/**
+ * Transformer, that rebuilds trees of binary symmetrical gates (AND, OR and XOR) as trees of minimal
+ * depth with respect to levels of their operands, keeping number of gates.
+ * For example: AND(AND(AND(0, 1), 2), 3) => AND(AND(0, 1), AND(2, 3))
+ *
+ * @tparam CircuitT
+ * @param EnableAND
+ * @param EnableOR
+ * @param EnableXOR
+ */
+template<
+    class CircuitT,
+    bool EnableAND = false,
+    bool EnableOR  = false,
+    bool EnableXOR = false,
+    typename       = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using BalanceSymmetricalGates = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    BalanceSymmetricalGates_<DAG, EnableAND, EnableOR, EnableXOR> >;
+
+/**
+ * Transformer, that extracts pairs of operands, shared by several symmetrical gates (AND, OR and XOR)
+ * of the same type, into new gates, most shared pairs first.
+ * For example: AND(0, 1, 2), AND(0, 1, 3) => AND(4, 2), AND(4, 3), where 4 = AND(0, 1)
+ *
+ * @tparam CircuitT
+ * @param EnableAND
+ * @param EnableOR
+ * @param EnableXOR
+ */
+template<
+    class CircuitT,
+    bool EnableAND = false,
+    bool EnableOR  = false,
+    bool EnableXOR = false,
+    typename       = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using ExtractCommonPairs = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    ExtractCommonPairs_<DAG, EnableAND, EnableOR, EnableXOR> >;
+
+/**
+ * Transformer, that expresses all gates by AND, XOR and NOT gates, so circuit becomes
+ * XOR-AND graph (see `core/structures/xag.hpp`). For example: OR(0, 1) => NOT(AND(NOT(0), NOT(1)))
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using ConvertToXAG = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    ConvertToXAG_<DAG>,
+    ReduceNotComposition_<DAG>,
+    RedundantGatesCleaner_<DAG>,
+    DuplicateGatesCleaner_<DAG> >;
+
 /**
  * Transformer, that moves NOT closer to INPUT using de Morgan's low: NOT(AND(1, 2)) = OR(NOT(1), NOT(2));
  *                                                                    NOT(OR(1, 2)) = AND(NOT(1), NOT(2))
@@ -199,6 +268,253 @@ using DeMorgan = Composition<
 template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
 using SplitNotFromOthers = Composition<CircuitT, SplitNotFromOthers_<DAG> >;
 
+/**
+ * Transformer, that merges functionally equivalent (up to complement) and constant gates,
+ * found by random simulation and proven by SAT solver. For example:
+ *
+ *    Before            |          After
+ *
+ * INPUT(0)             |       INPUT(0)
+ * INPUT(1)             |       INPUT(1)
+ * 2 = AND(0, 1)        |       2 = AND(0, 1)
+ * 3 = NOT(0)           |       5 = OR(0, 1)
+ * 4 = NOT(1)           |       6 = NOT(2)
+ * 5 = OR(0, 1)         |       7 = AND(5, 6)
+ * 6 = OR(3, 4)         |       OUTPUT(7)
+ * 7 = AND(5, 6)        |
+ * OUTPUT(7)            |
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using SatSweeping = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    SatSweeping_<DAG>,
+    RedundantGatesCleaner_<DAG, true>,  // true == save at least one input
+    ConstantGateReducer_<DAG>,
+    ReduceNotComposition_<DAG>,
+    RedundantGatesCleaner_<DAG>,
+    DuplicateGatesCleaner_<DAG> >;
+
+/**
+ * Transformer, that applies NOT, de Morgan and constant rewrites all at once by equality
+ * saturation, and extracts the cheapest circuit of found equivalent ones. For example:
+ *
+ *    Before            |          After
+ *
+ * INPUT(0)             |       INPUT(0)
+ * INPUT(1)             |       INPUT(1)
+ * 2 = NOT(0)           |       5 = OR(0, 1)
+ * 3 = NOT(1)           |       OUTPUT(5)
+ * 4 = AND(2, 3)        |
+ * 5 = NOT(4)           |
+ * OUTPUT(5)            |
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using EqualitySaturation = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    EqualitySaturation_<DAG>,
+    RedundantGatesCleaner_<DAG, true>,  // true == save at least one input
+    DuplicateGatesCleaner_<DAG> >;
+
+/**
+ * Transformer, that replaces small windows of circuit (up to 4 leaves and 8 gates)
+ * by smaller equivalent subcircuits of BENCH basis, found by exact synthesis. For example:
+ *
+ *    Before            |          After
+ *
+ * INPUT(0)             |       INPUT(0)
+ * INPUT(1)             |       INPUT(1)
+ * 2 = NOT(0)           |       4 = OR(0, 1)
+ * 3 = NOT(1)           |       OUTPUT(4)
+ * 4 = NAND(2, 3)       |
+ * OUTPUT(4)            |
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using SubcircuitMinimization = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    SubcircuitMinimization_<DAG>,
+    RedundantGatesCleaner_<DAG, true>,  // true == save at least one input
+    ConstantGateReducer_<DAG>,
+    ReduceNotComposition_<DAG>,
+    RedundantGatesCleaner_<DAG>,
+    DuplicateGatesCleaner_<DAG> >;
+
+/**
+ * Transformer, that rewrites gates by minimum circuits of their 4-input cut functions,
+ * reusing existing gates, when it is profitable. For example:
+ *
+ *    Before            |          After
+ *
+ * INPUT(0)             |       INPUT(0)
+ * INPUT(1)             |       INPUT(1)
+ * INPUT(2)             |       INPUT(2)
+ * 3 = AND(0, 1)        |       6 = OR(1, 2)
+ * 4 = AND(0, 2)        |       7 = AND(0, 6)
+ * 5 = OR(3, 4)         |       OUTPUT(7)
+ * OUTPUT(5)            |
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using CutRewriting = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    CutRewriting_<DAG>,
+    RedundantGatesCleaner_<DAG, true>,  // true == save at least one input
+    ConstantGateReducer_<DAG>,
+    ReduceNotComposition_<DAG>,
+    RedundantGatesCleaner_<DAG>,
+    DuplicateGatesCleaner_<DAG> >;
+
+/**
+ * Transformer, that collapses cones of up to 10 inputs into truth tables and
+ * rebuilds them by factored forms of their irredundant sums of products,
+ * when it takes less gates. For example:
+ *
+ *    Before            |          After
+ *
+ * INPUT(0)             |       INPUT(0)
+ * INPUT(1)             |       INPUT(1)
+ * INPUT(2)             |       INPUT(2)
+ * INPUT(3)             |       INPUT(3)
+ * 4 = AND(0, 1)        |       9 = OR(1, 2)
+ * 5 = AND(0, 2)        |       10 = OR(9, 3)
+ * 6 = AND(0, 3)        |       8 = AND(0, 10)
+ * 7 = OR(4, 5)         |       OUTPUT(8)
+ * 8 = OR(7, 6)         |
+ * OUTPUT(8)            |
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using Refactoring = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    Refactoring_<DAG>,
+    RedundantGatesCleaner_<DAG, true>,  // true == save at least one input
+    ConstantGateReducer_<DAG>,
+    ReduceNotComposition_<DAG>,
+    RedundantGatesCleaner_<DAG>,
+    DuplicateGatesCleaner_<DAG> >;
+
+/**
+ * Transformer, that re-expresses gates by at most three existing gates of
+ * their windows, when it removes more gates, than it adds. For example:
+ *
+ *    Before            |          After
+ *
+ * INPUT(0)             |       INPUT(0)
+ * INPUT(1)             |       INPUT(1)
+ * INPUT(2)             |       INPUT(2)
+ * 3 = AND(0, 1)        |       3 = AND(0, 1)
+ * 4 = OR(0, 2)         |       4 = OR(0, 2)
+ * 5 = NOT(3)           |       6 = XOR(3, 4)
+ * 6 = AND(4, 5)        |       OUTPUT(3)
+ * OUTPUT(3)            |       OUTPUT(4)
+ * OUTPUT(4)            |       OUTPUT(6)
+ * OUTPUT(6)            |
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using Resubstitution = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    Resubstitution_<DAG>,
+    RedundantGatesCleaner_<DAG>,
+    DuplicateGatesCleaner_<DAG> >;
+
+/**
+ * Transformer, that re-expresses gates under their satisfiability and observability
+ * don't cares, validating every change by SAT solver. For example:
+ *
+ *    Before            |          After
+ *
+ * INPUT(0)             |       INPUT(0)
+ * INPUT(1)             |       INPUT(1)
+ * INPUT(2)             |       INPUT(2)
+ * 3 = AND(0, 1)        |       4 = OR(1, 2)
+ * 4 = OR(3, 2)         |       5 = AND(0, 4)
+ * 5 = AND(0, 4)        |       OUTPUT(5)
+ * OUTPUT(5)            |
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using DontCareOptimization = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    DontCareOptimization_<DAG>,
+    RedundantGatesCleaner_<DAG, true>,  // true == save at least one input
+    ConstantGateReducer_<DAG>,
+    ReduceNotComposition_<DAG>,
+    RedundantGatesCleaner_<DAG>,
+    DuplicateGatesCleaner_<DAG> >;
+
+/**
+ * Transformer, that re-synthesizes linear (XOR only) subcircuits with less
+ * two-input XOR gates. For example:
+ *
+ *    Before            |          After
+ *
+ * INPUT(0)             |       INPUT(0)
+ * INPUT(1)             |       INPUT(1)
+ * INPUT(2)             |       INPUT(2)
+ * INPUT(3)             |       INPUT(3)
+ * 4 = XOR(0, 1, 2)     |       6 = XOR(0, 1)
+ * 5 = XOR(0, 1, 3)     |       4 = XOR(6, 2)
+ * OUTPUT(4)            |       5 = XOR(6, 3)
+ * OUTPUT(5)            |       OUTPUT(4)
+ *                      |       OUTPUT(5)
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using LinearMinimization = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    LinearMinimization_<DAG>,
+    RedundantGatesCleaner_<DAG, true>,  // true == save at least one input
+    ConstantGateReducer_<DAG>,
+    RedundantGatesCleaner_<DAG>,
+    DuplicateGatesCleaner_<DAG> >;
+
+/**
+ * Transformer, that rewrites gates by circuits with minimum number of AND gates
+ * of their 3-input cut functions, while XOR and NOT gates are free. For example:
+ *
+ *    Before            |          After
+ *
+ * INPUT(0)             |       INPUT(0)
+ * INPUT(1)             |       INPUT(1)
+ * INPUT(2)             |       INPUT(2)
+ * 3 = AND(0, 1)        |       7 = XOR(0, 1)
+ * 4 = AND(0, 2)        |       8 = XOR(0, 2)
+ * 5 = AND(1, 2)        |       9 = AND(7, 8)
+ * 6 = OR(3, 4, 5)      |       6 = XOR(0, 9)
+ * OUTPUT(6)            |       OUTPUT(6)
+ *
+ * @tparam CircuitT
+ */
+template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT> > >
+using MultiplicativeComplexityRewriting = Composition<
+    CircuitT,
+    RedundantGatesCleaner_<DAG>,
+    MultiplicativeComplexityRewriting_<DAG>,
+    RedundantGatesCleaner_<DAG, true>,  // true == save at least one input
+    ConstantGateReducer_<DAG>,
+    ReduceNotComposition_<DAG>,
+    RedundantGatesCleaner_<DAG>,
+    DuplicateGatesCleaner_<DAG> >;
+
 }  // namespace cirbo::minimization
 
 #endif  // CIRBO_SEARCH_MINIMIZATION_STRATEGY_HPP
\ No newline at end of file
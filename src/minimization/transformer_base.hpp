@@ -5,10 +5,18 @@
 #include <random>
 #include <string>
 #include <type_traits>
+#include <typeinfo>
 #include <utility>
 
+#if defined(__GNUG__)
+#include <cstdlib>
+#include <cxxabi.h>
+#endif
+
 #include "core/structures/icircuit.hpp"
 #include "core/types.hpp"
+#include "logger.hpp"
+#include "minimization/pass_report.hpp"
 #include "utils/encoder.hpp"
 #include "utils/random.hpp"
 
@@ -20,6 +28,23 @@ using utils::NameEncoder;
 template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
 using CircuitAndEncoder = std::pair<std::unique_ptr<CircuitT>, std::unique_ptr<NameEncoder>>;
 
+/**
+ * Describes how transformer interacts with circuit invariants (see `invariant`).
+ * Default contract is the safe one: nothing is required or established,
+ * all invariants are invalidated and transformer is never skipped.
+ */
+struct PassContract
+{
+    /* Invariants, which must hold for transformer to work correctly. */
+    InvariantSet required = invariant::NONE;
+    /* Invariants, which hold after transformation. */
+    InvariantSet established = invariant::NONE;
+    /* Invariants, which may be broken by transformation. Others are preserved. */
+    InvariantSet invalidated = invariant::ALL;
+    /* If true, transformation may be skipped when all `established` invariants already hold. */
+    bool skippable = false;
+};
+
 /**
  * Base interface for all circuit transformers.
  *
@@ -28,17 +53,152 @@ using CircuitAndEncoder = std::pair<std::unique_ptr<CircuitT>, std::unique_ptr<N
 template<class CircuitT, typename = std::enable_if_t<std::is_base_of_v<ICircuit, CircuitT>>>
 class ITransformer
 {
+private:
+    std::string name_;
+
 public:
     virtual ~ITransformer() = default;
 
+    /**
+     * Applies transformer to copies of `circuit` and `encoder`, originals are left untouched.
+     */
     CircuitAndEncoder<CircuitT, std::string> apply(CircuitT const& circuit, NameEncoder const& encoder)
     {
-        return transform(std::make_unique<CircuitT>(circuit), std::make_unique<NameEncoder>(encoder));
+        return run(std::make_unique<CircuitT>(circuit), std::make_unique<NameEncoder>(encoder));
+    }
+
+    /**
+     * Applies transformer to `circuit` and `encoder`, taking their ownership,
+     * so no deep copies are made. Preferred way to run pipelines.
+     */
+    CircuitAndEncoder<CircuitT, std::string> apply(CircuitT&& circuit, NameEncoder&& encoder)
+    {
+        return run(
+            std::make_unique<CircuitT>(std::move(circuit)), std::make_unique<NameEncoder>(std::move(encoder)));
+    }
+
+    /**
+     * Applies transformer to `circuit` and `encoder`, taking their ownership.
+     */
+    CircuitAndEncoder<CircuitT, std::string> apply(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder)
+    {
+        return run(std::move(circuit), std::move(encoder));
     }
 
+    /**
+     * Invokes `transform` and, if `PassReport` collection is enabled, records its
+     * figures. Transformers, which apply other transformers, must invoke them
+     * with this method, so nested invocations are reported as well.
+     *
+     * Also maintains circuit invariants according to `getContract`: skippable
+     * transformation is not performed if its result already holds.
+     */
+    CircuitAndEncoder<CircuitT, std::string> run(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder)
+    {
+        PassContract const contract = getContract();
+        InvariantSet const before   = circuit->getInvariants();
+
+        if (contract.skippable && contract.established != invariant::NONE &&
+            circuit->hasInvariants(contract.established))
+        {
+            if (PassReport::getInstance().isEnabled())
+            {
+                PassScope scope(getName(), *circuit);
+                countRule("skipped");
+                scope.setResult(*circuit);
+            }
+            return {std::move(circuit), std::move(encoder)};
+        }
+        if (!circuit->hasInvariants(contract.required))
+        {
+            log::debug("Precondition of transformer is not known to hold, result may be not fully simplified.");
+        }
+
+        // Invariants of result are ones preserved or established by this transformer, and ones
+        // set on the result by transformers applied inside (e.g. parts of `Composition`).
+        circuit->setInvariants(invariant::NONE);
+        auto result = transformMeasured_(std::move(circuit), std::move(encoder));
+        result.first->setInvariants(static_cast<InvariantSet>(
+            result.first->getInvariants() | (before & ~contract.invalidated) | contract.established));
+        return result;
+    }
+
+    /**
+     * @return description of how transformer interacts with circuit invariants.
+     */
+    [[nodiscard]]
+    virtual PassContract getContract() const
+    {
+        return {};
+    }
+
+    /**
+     * @return name of transformer, used in reports. Defaults to the name of transformer's type.
+     */
+    [[nodiscard]]
+    virtual std::string getName() const
+    {
+        if (!name_.empty())
+        {
+            return name_;
+        }
+        return getTypeName_(typeid(*this).name());
+    }
+
+    /**
+     * Overrides name of transformer, e.g. with the name it is registered under.
+     */
+    void setName(std::string name) { name_ = std::move(name); }
+
+    /**
+     * Transforms circuit. Implementations own both `circuit` and `encoder`, so
+     * they should move them (or their parts) into the result instead of copying.
+     */
     virtual CircuitAndEncoder<CircuitT, std::string> transform(
         std::unique_ptr<CircuitT>,
         std::unique_ptr<NameEncoder>) = 0;
+
+private:
+    CircuitAndEncoder<CircuitT, std::string> transformMeasured_(
+        std::unique_ptr<CircuitT> circuit,
+        std::unique_ptr<NameEncoder> encoder)
+    {
+        if (!PassReport::getInstance().isEnabled())
+        {
+            return transform(std::move(circuit), std::move(encoder));
+        }
+        PassScope scope(getName(), *circuit);
+        auto result = transform(std::move(circuit), std::move(encoder));
+        scope.setResult(*result.first);
+        return result;
+    }
+
+    /* Demangles type name and drops library namespaces from it. */
+    static std::string getTypeName_(char const* mangled)
+    {
+        std::string name = mangled;
+#if defined(__GNUG__)
+        int status      = 0;
+        char* demangled = abi::__cxa_demangle(mangled, nullptr, nullptr, &status);
+        if (status == 0 && demangled != nullptr)
+        {
+            name = demangled;
+        }
+        std::free(demangled);
+#endif
+        for (std::string const prefix : {"cirbo::minimization::", "cirbo::"})
+        {
+            for (size_t pos = name.find(prefix); pos != std::string::npos; pos = name.find(prefix, pos))
+            {
+                name.erase(pos, prefix.size());
+            }
+        }
+        return name;
+    }
 };
 
 static std::string getUniqueId_()
@@ -0,0 +1,805 @@
+#ifndef CIRBO_SEARCH_SAT_SOLVER_HPP
+#define CIRBO_SEARCH_SAT_SOLVER_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+/**
+ * Embedded incremental CDCL SAT solver. Intended for many small queries,
+ * made by circuit analyses (e.g. SAT sweeping), where external solver
+ * invocation costs more than solving itself.
+ */
+namespace cirbo::sat
+{
+
+using Var = uint32_t;
+
+/** Literal: variable with sign, encoded as `2 * var + sign`. **/
+class Lit
+{
+private:
+    uint32_t x_ = std::numeric_limits<uint32_t>::max();
+
+    explicit constexpr Lit(uint32_t x) noexcept
+        : x_(x)
+    {
+    }
+
+public:
+    constexpr Lit() noexcept = default;
+
+    constexpr Lit(Var var, bool negative) noexcept
+        : x_((var << 1U) | static_cast<uint32_t>(negative))
+    {
+    }
+
+    [[nodiscard]]
+    constexpr Var getVar() const noexcept
+    {
+        return x_ >> 1U;
+    }
+
+    [[nodiscard]]
+    constexpr bool isNegative() const noexcept
+    {
+        return (x_ & 1U) != 0;
+    }
+
+    /* Returns dense index of literal, suitable to index arrays. */
+    [[nodiscard]]
+    constexpr uint32_t getIndex() const noexcept
+    {
+        return x_;
+    }
+
+    constexpr Lit operator~() const noexcept { return Lit(x_ ^ 1U); }
+
+    constexpr bool operator==(Lit const& other) const noexcept = default;
+};
+
+/** Positive literal of variable. **/
+constexpr Lit posLit(Var var) noexcept { return {var, false}; }
+
+/** Negative literal of variable. **/
+constexpr Lit negLit(Var var) noexcept { return {var, true}; }
+
+/** Result of a SAT query. **/
+enum class SolveResult : uint8_t
+{
+    SAT,
+    UNSAT,
+    /* Conflict limit was reached before the answer was found. */
+    UNKNOWN
+};
+
+/**
+ * CDCL solver with two watched literals, first UIP clause learning, VSIDS
+ * decisions with phase saving, Luby restarts, LBD-based reduction of learned
+ * clauses and solving under assumptions.
+ *
+ * Solver is incremental: variables and clauses may be added between
+ * `solve` calls, learned clauses are kept, assumptions are dropped.
+ */
+class Solver
+{
+public:
+    /** Number of conflicts in the first restart interval, next intervals follow Luby sequence. **/
+    static constexpr size_t RestartBase = 100;
+    /** Number of learned clauses, after which they are reduced for the first time. **/
+    static constexpr size_t FirstReduce = 2000;
+    /** Growth of learned clauses limit after every reduction. **/
+    static constexpr size_t ReduceIncrement = 300;
+    /** Learned clauses with LBD not greater than this are never removed. **/
+    static constexpr uint32_t GlueLbd = 2;
+
+private:
+    using ClauseRef                       = uint32_t;
+    static constexpr ClauseRef NoReason   = std::numeric_limits<ClauseRef>::max();
+    static constexpr double ActivityDecay = 0.95;
+    static constexpr double ActivityLimit = 1e100;
+
+    struct Clause_
+    {
+        std::vector<Lit> lits;
+        bool learnt  = false;
+        bool deleted = false;
+        /* Literal block distance: number of decision levels among literals, computed when learned. */
+        uint32_t lbd = 0;
+    };
+
+    /* Binary max-heap of variables, ordered by activity. */
+    class VarOrder_
+    {
+    private:
+        static constexpr size_t NotInHeap = std::numeric_limits<size_t>::max();
+
+        std::vector<Var> heap_;
+        /* Position of variable in heap, or `NotInHeap`. */
+        std::vector<size_t> positions_;
+
+    public:
+        void grow() { positions_.push_back(NotInHeap); }
+
+        [[nodiscard]]
+        bool empty() const noexcept
+        {
+            return heap_.empty();
+        }
+
+        [[nodiscard]]
+        bool contains(Var var) const noexcept
+        {
+            return positions_[var] != NotInHeap;
+        }
+
+        void insert(Var var, std::vector<double> const& activity)
+        {
+            if (contains(var))
+            {
+                return;
+            }
+            positions_[var] = heap_.size();
+            heap_.push_back(var);
+            siftUp_(heap_.size() - 1, activity);
+        }
+
+        /* Restores heap order after activity of `var` was increased. */
+        void increase(Var var, std::vector<double> const& activity)
+        {
+            if (contains(var))
+            {
+                siftUp_(positions_[var], activity);
+            }
+        }
+
+        Var pop(std::vector<double> const& activity)
+        {
+            Var const top   = heap_.front();
+            positions_[top] = NotInHeap;
+            if (heap_.size() > 1)
+            {
+                heap_.front()             = heap_.back();
+                positions_[heap_.front()] = 0;
+                heap_.pop_back();
+                siftDown_(0, activity);
+            }
+            else
+            {
+                heap_.pop_back();
+            }
+            return top;
+        }
+
+    private:
+        void siftUp_(size_t index, std::vector<double> const& activity)
+        {
+            Var const var = heap_[index];
+            while (index > 0 && activity[heap_[(index - 1) / 2]] < activity[var])
+            {
+                heap_[index]             = heap_[(index - 1) / 2];
+                positions_[heap_[index]] = index;
+                index                    = (index - 1) / 2;
+            }
+            heap_[index]    = var;
+            positions_[var] = index;
+        }
+
+        void siftDown_(size_t index, std::vector<double> const& activity)
+        {
+            Var const var = heap_[index];
+            while ((2 * index) + 1 < heap_.size())
+            {
+                size_t child = (2 * index) + 1;
+                if (child + 1 < heap_.size() && activity[heap_[child + 1]] > activity[heap_[child]])
+                {
+                    ++child;
+                }
+                if (activity[heap_[child]] <= activity[var])
+                {
+                    break;
+                }
+                heap_[index]             = heap_[child];
+                positions_[heap_[index]] = index;
+                index                    = child;
+            }
+            heap_[index]    = var;
+            positions_[var] = index;
+        }
+    };
+
+    struct Analysis_
+    {
+        uint32_t backtrack_level;
+        uint32_t lbd;
+    };
+
+    /* Values of variables: 0 -- unassigned, 1 -- true, -1 -- false. */
+    std::vector<int8_t> values_;
+    std::vector<uint32_t> levels_;
+    std::vector<ClauseRef> reasons_;
+    std::vector<double> activity_;
+    /* Saved phases: whether variable was false, when it was unassigned last time. */
+    std::vector<bool> polarity_;
+    VarOrder_ order_;
+    std::vector<Lit> trail_;
+    /* Positions in trail, where decision levels start. */
+    std::vector<size_t> trail_limits_;
+    size_t propagated_ = 0;
+
+    std::vector<Clause_> clauses_;
+    /* Slots of deleted clauses, reused by new clauses. */
+    std::vector<ClauseRef> free_clauses_;
+    /* For each literal -- clauses, watching it (literal is one of their first two literals). */
+    std::vector<std::vector<ClauseRef>> watches_;
+    size_t learnts_     = 0;
+    size_t max_learnts_ = FirstReduce;
+
+    /* Scratch buffers of conflict analysis. */
+    std::vector<bool> seen_;
+    std::vector<uint64_t> level_stamps_;
+    uint64_t stamp_ = 0;
+
+    std::vector<bool> model_;
+    /* Set once formula is proven unsatisfiable without assumptions. */
+    bool inconsistent_         = false;
+    double activity_increment_ = 1;
+
+    size_t conflicts_    = 0;
+    size_t decisions_    = 0;
+    size_t propagations_ = 0;
+    size_t restarts_     = 0;
+    size_t reductions_   = 0;
+
+public:
+    /**
+     * @return new variable.
+     */
+    Var newVar()
+    {
+        auto const var = static_cast<Var>(values_.size());
+        values_.push_back(0);
+        levels_.push_back(0);
+        reasons_.push_back(NoReason);
+        activity_.push_back(0);
+        polarity_.push_back(true);
+        seen_.push_back(false);
+        level_stamps_.push_back(0);
+        watches_.emplace_back();
+        watches_.emplace_back();
+        order_.grow();
+        order_.insert(var, activity_);
+        return var;
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfVars() const noexcept
+    {
+        return values_.size();
+    }
+
+    /* Returns number of stored clauses of size at least two, both original and learned. */
+    [[nodiscard]]
+    size_t getNumberOfClauses() const noexcept
+    {
+        return clauses_.size() - free_clauses_.size();
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfLearnts() const noexcept
+    {
+        return learnts_;
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfConflicts() const noexcept
+    {
+        return conflicts_;
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfDecisions() const noexcept
+    {
+        return decisions_;
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfPropagations() const noexcept
+    {
+        return propagations_;
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfRestarts() const noexcept
+    {
+        return restarts_;
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfReductions() const noexcept
+    {
+        return reductions_;
+    }
+
+    /* Returns false iff formula is known to be unsatisfiable. */
+    [[nodiscard]]
+    bool isConsistent() const noexcept
+    {
+        return !inconsistent_;
+    }
+
+    /**
+     * Adds clause to the formula. Must be called between `solve` calls.
+     *
+     * @return false iff formula became unsatisfiable.
+     */
+    bool addClause(std::vector<Lit> lits)
+    {
+        assert(getDecisionLevel_() == 0);
+        if (inconsistent_)
+        {
+            return false;
+        }
+
+        // Remove duplicates and false literals, skip satisfied clauses.
+        std::ranges::sort(lits, {}, &Lit::getIndex);
+        size_t size = 0;
+        for (size_t i = 0; i < lits.size(); ++i)
+        {
+            Lit const lit = lits[i];
+            assert(lit.getVar() < getNumberOfVars());
+            if (getValue_(lit) == 1 || (i + 1 < lits.size() && lits[i + 1] == ~lit))
+            {
+                return true;
+            }
+            if (getValue_(lit) == 0 && (size == 0 || lits[size - 1] != lit))
+            {
+                lits[size++] = lit;
+            }
+        }
+        lits.resize(size);
+
+        if (lits.empty())
+        {
+            inconsistent_ = true;
+            return false;
+        }
+        if (lits.size() == 1)
+        {
+            assign_(lits[0], NoReason);
+            inconsistent_ = propagate_() != NoReason;
+            return !inconsistent_;
+        }
+        attachClause_(std::move(lits), false, 0);
+        return true;
+    }
+
+    /**
+     * Checks satisfiability of the formula under `assumptions`.
+     *
+     * @param assumptions -- literals, which are assumed to be true during this call only.
+     * @param conflict_limit -- maximum number of conflicts, negative means no limit.
+     * @return SAT, UNSAT or UNKNOWN, if conflict limit is reached.
+     */
+    SolveResult solve(std::vector<Lit> const& assumptions = {}, int64_t conflict_limit = -1)
+    {
+        if (inconsistent_)
+        {
+            return SolveResult::UNSAT;
+        }
+
+        size_t const limit = conflict_limit < 0 ? std::numeric_limits<size_t>::max() : conflicts_ + conflict_limit;
+        SolveResult result = SolveResult::UNKNOWN;
+        for (size_t restart = 0; result == SolveResult::UNKNOWN && conflicts_ < limit; ++restart)
+        {
+            size_t const budget = std::min(RestartBase * getLuby_(restart), limit - conflicts_);
+            result              = search_(assumptions, budget);
+            cancelUntil_(0);
+            if (result == SolveResult::UNKNOWN)
+            {
+                ++restarts_;
+                if (learnts_ >= max_learnts_)
+                {
+                    reduceLearnts_();
+                }
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @return value of variable in the model, found by the last successful `solve` call.
+     */
+    [[nodiscard]]
+    bool getModelValue(Var var) const
+    {
+        return model_.at(var);
+    }
+
+    /**
+     * @return value of literal in the model, found by the last successful `solve` call.
+     */
+    [[nodiscard]]
+    bool getModelValue(Lit lit) const
+    {
+        return model_.at(lit.getVar()) != lit.isNegative();
+    }
+
+private:
+    /* Returns i-th (0-based) element of Luby sequence: 1 1 2 1 1 2 4 1 1 2 ... */
+    static size_t getLuby_(size_t i)
+    {
+        size_t size     = 1;
+        size_t exponent = 0;
+        while (size < i + 1)
+        {
+            ++exponent;
+            size = (2 * size) + 1;
+        }
+        while (size - 1 != i)
+        {
+            size = (size - 1) / 2;
+            --exponent;
+            i %= size;
+        }
+        return size_t{1} << exponent;
+    }
+
+    /* Runs CDCL until answer is found or `budget` conflicts happen. */
+    SolveResult search_(std::vector<Lit> const& assumptions, size_t budget)
+    {
+        std::vector<Lit> learnt;
+        size_t conflicts = 0;
+        while (true)
+        {
+            ClauseRef const conflict = propagate_();
+            if (conflict != NoReason)
+            {
+                ++conflicts_;
+                ++conflicts;
+                if (getDecisionLevel_() == 0)
+                {
+                    inconsistent_ = true;
+                    return SolveResult::UNSAT;
+                }
+                auto const [backtrack_level, lbd] = analyze_(conflict, learnt);
+                cancelUntil_(backtrack_level);
+                if (learnt.size() == 1)
+                {
+                    assign_(learnt[0], NoReason);
+                }
+                else
+                {
+                    Lit const asserting = learnt[0];
+                    assign_(asserting, attachClause_(learnt, true, lbd));
+                }
+                decayActivity_();
+                if (conflicts >= budget)
+                {
+                    return SolveResult::UNKNOWN;
+                }
+                continue;
+            }
+
+            // Assumptions are decided first, one per decision level.
+            Lit next{};
+            while (getDecisionLevel_() < assumptions.size())
+            {
+                Lit const assumption = assumptions[getDecisionLevel_()];
+                if (getValue_(assumption) == 1)
+                {
+                    // Already true, open dummy decision level to keep levels and assumptions aligned.
+                    trail_limits_.push_back(trail_.size());
+                }
+                else if (getValue_(assumption) == -1)
+                {
+                    return SolveResult::UNSAT;
+                }
+                else
+                {
+                    next = assumption;
+                    break;
+                }
+            }
+
+            if (next == Lit{})
+            {
+                next = pickBranchLit_();
+                if (next == Lit{})
+                {
+                    model_.assign(getNumberOfVars(), false);
+                    for (Var var = 0; var < getNumberOfVars(); ++var)
+                    {
+                        model_[var] = values_[var] == 1;
+                    }
+                    return SolveResult::SAT;
+                }
+                ++decisions_;
+            }
+            trail_limits_.push_back(trail_.size());
+            assign_(next, NoReason);
+        }
+    }
+
+    [[nodiscard]]
+    uint32_t getDecisionLevel_() const noexcept
+    {
+        return static_cast<uint32_t>(trail_limits_.size());
+    }
+
+    [[nodiscard]]
+    int8_t getValue_(Lit lit) const noexcept
+    {
+        int8_t const value = values_[lit.getVar()];
+        return lit.isNegative() ? static_cast<int8_t>(-value) : value;
+    }
+
+    void assign_(Lit lit, ClauseRef reason)
+    {
+        assert(getValue_(lit) == 0);
+        values_[lit.getVar()]  = lit.isNegative() ? -1 : 1;
+        levels_[lit.getVar()]  = getDecisionLevel_();
+        reasons_[lit.getVar()] = reason;
+        trail_.push_back(lit);
+    }
+
+    ClauseRef attachClause_(std::vector<Lit> lits, bool learnt, uint32_t lbd)
+    {
+        auto ref = static_cast<ClauseRef>(clauses_.size());
+        if (free_clauses_.empty())
+        {
+            clauses_.emplace_back();
+        }
+        else
+        {
+            ref = free_clauses_.back();
+            free_clauses_.pop_back();
+        }
+        watches_[lits[0].getIndex()].push_back(ref);
+        watches_[lits[1].getIndex()].push_back(ref);
+        clauses_[ref] = Clause_{std::move(lits), learnt, false, lbd};
+        learnts_ += learnt ? 1 : 0;
+        return ref;
+    }
+
+    void cancelUntil_(uint32_t level)
+    {
+        if (getDecisionLevel_() <= level)
+        {
+            return;
+        }
+        for (size_t i = trail_.size(); i > trail_limits_[level]; --i)
+        {
+            Lit const lit  = trail_[i - 1];
+            Var const var  = lit.getVar();
+            values_[var]   = 0;
+            reasons_[var]  = NoReason;
+            polarity_[var] = lit.isNegative();
+            order_.insert(var, activity_);
+        }
+        trail_.resize(trail_limits_[level]);
+        trail_limits_.resize(level);
+        propagated_ = std::min(propagated_, trail_.size());
+    }
+
+    /* Performs unit propagation, returns conflicting clause or `NoReason`. */
+    ClauseRef propagate_()
+    {
+        while (propagated_ < trail_.size())
+        {
+            Lit const false_lit = ~trail_[propagated_++];
+            ++propagations_;
+            std::vector<ClauseRef>& watchers = watches_[false_lit.getIndex()];
+
+            size_t kept = 0;
+            for (size_t i = 0; i < watchers.size(); ++i)
+            {
+                ClauseRef const ref    = watchers[i];
+                std::vector<Lit>& lits = clauses_[ref].lits;
+                // Make sure the false literal is the second one.
+                if (lits[0] == false_lit)
+                {
+                    std::swap(lits[0], lits[1]);
+                }
+                if (getValue_(lits[0]) == 1)
+                {
+                    watchers[kept++] = ref;
+                    continue;
+                }
+
+                // Look for a new literal to watch.
+                bool moved = false;
+                for (size_t k = 2; k < lits.size(); ++k)
+                {
+                    if (getValue_(lits[k]) != -1)
+                    {
+                        std::swap(lits[1], lits[k]);
+                        watches_[lits[1].getIndex()].push_back(ref);
+                        moved = true;
+                        break;
+                    }
+                }
+                if (moved)
+                {
+                    continue;
+                }
+
+                watchers[kept++] = ref;
+                if (getValue_(lits[0]) == -1)
+                {
+                    // Conflict: keep the rest of watchers and stop.
+                    for (++i; i < watchers.size(); ++i)
+                    {
+                        watchers[kept++] = watchers[i];
+                    }
+                    watchers.resize(kept);
+                    propagated_ = trail_.size();
+                    return ref;
+                }
+                assign_(lits[0], ref);
+            }
+            watchers.resize(kept);
+        }
+        return NoReason;
+    }
+
+    /**
+     * Derives first UIP clause from conflict. Asserting literal is put first,
+     * literal of the backtrack level is put second.
+     * @return level to backtrack to and LBD of learned clause.
+     */
+    Analysis_ analyze_(ClauseRef conflict, std::vector<Lit>& learnt)
+    {
+        learnt.clear();
+        learnt.emplace_back();  // Place for asserting literal.
+
+        size_t pending = 0;
+        Lit resolved{};
+        size_t index     = trail_.size();
+        ClauseRef reason = conflict;
+
+        do
+        {
+            assert(reason != NoReason);
+            for (Lit const lit : clauses_[reason].lits)
+            {
+                if (resolved != Lit{} && lit == resolved)
+                {
+                    continue;
+                }
+                Var const var = lit.getVar();
+                if (seen_[var] || levels_[var] == 0)
+                {
+                    continue;
+                }
+                seen_[var] = true;
+                bumpActivity_(var);
+                if (levels_[var] == getDecisionLevel_())
+                {
+                    ++pending;
+                }
+                else
+                {
+                    learnt.push_back(lit);
+                }
+            }
+
+            // Next literal of the current level to resolve on.
+            do
+            {
+                --index;
+            } while (!seen_[trail_[index].getVar()]);
+            resolved                 = trail_[index];
+            reason                   = reasons_[resolved.getVar()];
+            seen_[resolved.getVar()] = false;
+            --pending;
+        } while (pending > 0);
+        learnt[0] = ~resolved;
+
+        // LBD: number of distinct decision levels among literals.
+        ++stamp_;
+        uint32_t lbd = 0;
+        for (size_t i = 0; i < learnt.size(); ++i)
+        {
+            seen_[learnt[i].getVar()] = false;
+            uint32_t const level      = levels_[learnt[i].getVar()];
+            if (level >= level_stamps_.size())
+            {
+                // Dummy levels of assumptions may outnumber variables.
+                level_stamps_.resize(level + 1, 0);
+            }
+            if (level_stamps_[level] != stamp_)
+            {
+                level_stamps_[level] = stamp_;
+                ++lbd;
+            }
+        }
+
+        if (learnt.size() == 1)
+        {
+            return {0, lbd};
+        }
+        // Literal with the highest level goes second, to be watched after backtracking.
+        size_t max_index = 1;
+        for (size_t i = 2; i < learnt.size(); ++i)
+        {
+            if (levels_[learnt[i].getVar()] > levels_[learnt[max_index].getVar()])
+            {
+                max_index = i;
+            }
+        }
+        std::swap(learnt[1], learnt[max_index]);
+        return {levels_[learnt[1].getVar()], lbd};
+    }
+
+    /* Removes half of learned clauses with the highest LBD. Must be called at decision level 0. */
+    void reduceLearnts_()
+    {
+        assert(getDecisionLevel_() == 0);
+        std::vector<ClauseRef> candidates;
+        for (ClauseRef ref = 0; ref < clauses_.size(); ++ref)
+        {
+            Clause_ const& clause = clauses_[ref];
+            if (clause.learnt && !clause.deleted && clause.lbd > GlueLbd)
+            {
+                candidates.push_back(ref);
+            }
+        }
+        std::ranges::stable_sort(candidates, std::greater<>{}, [this](ClauseRef ref) { return clauses_[ref].lbd; });
+        candidates.resize(candidates.size() / 2);
+
+        // Reasons of level 0 are never used by analysis, so they may refer to removed clauses.
+        std::ranges::fill(reasons_, NoReason);
+        for (ClauseRef const ref : candidates)
+        {
+            clauses_[ref] = Clause_{{}, true, true, 0};
+            free_clauses_.push_back(ref);
+            --learnts_;
+        }
+        // Watchers must not refer to reused slots, so they are cleaned eagerly.
+        for (auto& watchers : watches_)
+        {
+            std::erase_if(watchers, [this](ClauseRef ref) { return clauses_[ref].deleted; });
+        }
+        max_learnts_ += ReduceIncrement;
+        ++reductions_;
+    }
+
+    void bumpActivity_(Var var)
+    {
+        activity_[var] += activity_increment_;
+        if (activity_[var] > ActivityLimit)
+        {
+            for (double& activity : activity_)
+            {
+                activity /= ActivityLimit;
+            }
+            activity_increment_ /= ActivityLimit;
+        }
+        order_.increase(var, activity_);
+    }
+
+    void decayActivity_() { activity_increment_ /= ActivityDecay; }
+
+    /* Returns unassigned variable with the highest activity in its saved phase, or default literal if none. */
+    Lit pickBranchLit_()
+    {
+        while (!order_.empty())
+        {
+            Var const var = order_.pop(activity_);
+            if (values_[var] == 0)
+            {
+                return {var, polarity_[var]};
+            }
+        }
+        return {};
+    }
+};
+
+}  // namespace cirbo::sat
+
+#endif  // CIRBO_SEARCH_SAT_SOLVER_HPP
@@ -0,0 +1,226 @@
+#ifndef CIRBO_SEARCH_SAT_TSEITIN_HPP
+#define CIRBO_SEARCH_SAT_TSEITIN_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "sat/solver.hpp"
+
+namespace cirbo::sat
+{
+
+/**
+ * Tseitin encoder of a circuit into `Solver`, which adds clauses on demand:
+ * only for gates in the cone of a queried gate, each gate at most once. So
+ * one solver may be reused by many queries, each paying only for the part of
+ * circuit it touches.
+ *
+ * Encoding is circuit-aware: NOT, IFF and BUFF gates get no variables and
+ * clauses, they share (complemented) literal of their operand. Constant gates
+ * share one variable, fixed by a unit clause.
+ */
+class TseitinEncoder
+{
+private:
+    ICircuit const& circuit_;
+    Solver& solver_;
+    /* Literal of each gate, default literal if gate is not encoded yet. */
+    std::vector<Lit> lits_;
+    size_t encoded_ = 0;
+    /* Literal, which is always true, allocated on first use. */
+    Lit true_lit_{};
+
+public:
+    /**
+     * @param circuit -- circuit to encode, must outlive encoder.
+     * @param solver -- solver to add clauses to, must outlive encoder.
+     */
+    TseitinEncoder(ICircuit const& circuit, Solver& solver)
+        : circuit_(circuit)
+        , solver_(solver)
+        , lits_(circuit.getNumberOfGates())
+    {
+    }
+
+    [[nodiscard]]
+    bool isEncoded(GateId gateId) const
+    {
+        return lits_.at(gateId) != Lit{};
+    }
+
+    [[nodiscard]]
+    size_t getNumberOfEncodedGates() const noexcept
+    {
+        return encoded_;
+    }
+
+    /**
+     * @return literal, which is equal to the value of gate. Cone of gate is encoded if needed.
+     */
+    Lit getLit(GateId gateId)
+    {
+        if (!isEncoded(gateId))
+        {
+            encodeCone_(gateId);
+        }
+        return lits_[gateId];
+    }
+
+    /**
+     * Makes not yet encoded gate share literal `lit` instead of getting its own
+     * clauses. For example, it lets two circuits of a miter share inputs.
+     */
+    void bind(GateId gateId, Lit lit)
+    {
+        assert(!isEncoded(gateId));
+        lits_.at(gateId) = lit;
+        ++encoded_;
+    }
+
+    /**
+     * @return value of gate in the last model of solver. Value of gate, which
+     *         is not encoded, is arbitrary and not consistent with other gates.
+     */
+    [[nodiscard]]
+    bool getModelValue(GateId gateId) const
+    {
+        return isEncoded(gateId) && solver_.getModelValue(lits_[gateId]);
+    }
+
+private:
+    /* Encodes gates of cone in topological order, without recursion. */
+    void encodeCone_(GateId root)
+    {
+        // Pairs of gate and flag, whether its operands are already processed.
+        std::vector<std::pair<GateId, bool> > stack{{root, false}};
+        while (!stack.empty())
+        {
+            auto const [gateId, expanded] = stack.back();
+            stack.pop_back();
+            if (isEncoded(gateId))
+            {
+                continue;
+            }
+            if (expanded)
+            {
+                encodeGate_(gateId);
+                continue;
+            }
+            stack.emplace_back(gateId, true);
+            for (GateId const operand : circuit_.getGateOperands(gateId))
+            {
+                if (!isEncoded(operand))
+                {
+                    stack.emplace_back(operand, false);
+                }
+            }
+        }
+    }
+
+    Lit getTrueLit_()
+    {
+        if (true_lit_ == Lit{})
+        {
+            true_lit_ = posLit(solver_.newVar());
+            solver_.addClause({true_lit_});
+        }
+        return true_lit_;
+    }
+
+    /* Adds clauses, defining literal of gate through literals of its operands, which must be encoded. */
+    void encodeGate_(GateId gateId)
+    {
+        GateIdContainer const& operands = circuit_.getGateOperands(gateId);
+        auto const operand              = [this, &operands](size_t i) { return lits_[operands[i]]; };
+        GateType const type             = circuit_.getGateType(gateId);
+        ++encoded_;
+
+        switch (type)
+        {
+            case GateType::INPUT:
+                lits_[gateId] = posLit(solver_.newVar());
+                return;
+            case GateType::CONST_FALSE:
+                lits_[gateId] = ~getTrueLit_();
+                return;
+            case GateType::CONST_TRUE:
+                lits_[gateId] = getTrueLit_();
+                return;
+            case GateType::NOT:
+                lits_[gateId] = ~operand(0);
+                return;
+            case GateType::IFF:
+            case GateType::BUFF:
+                lits_[gateId] = operand(0);
+                return;
+            default:
+                break;
+        }
+
+        Lit const out = posLit(solver_.newVar());
+        lits_[gateId] = out;
+        switch (type)
+        {
+            case GateType::MUX:
+                solver_.addClause({operand(0), ~operand(1), out});
+                solver_.addClause({operand(0), operand(1), ~out});
+                solver_.addClause({~operand(0), ~operand(2), out});
+                solver_.addClause({~operand(0), operand(2), ~out});
+                return;
+            case GateType::AND:
+            case GateType::NAND:
+            case GateType::OR:
+            case GateType::NOR:
+            {
+                // OR is encoded as AND of negated operands with negated output.
+                bool const negate_operands = type == GateType::OR || type == GateType::NOR;
+                bool const negate_output   = type == GateType::NAND || type == GateType::OR;
+                Lit const result           = negate_output ? ~out : out;
+                std::vector<Lit> clause{result};
+                for (size_t i = 0; i < operands.size(); ++i)
+                {
+                    Lit const lit = negate_operands ? ~operand(i) : operand(i);
+                    solver_.addClause({~result, lit});
+                    clause.push_back(~lit);
+                }
+                solver_.addClause(std::move(clause));
+                return;
+            }
+            case GateType::XOR:
+            case GateType::NXOR:
+            {
+                // Chain of binary XORs through auxiliary variables, the last one is output.
+                Lit const result = type == GateType::NXOR ? ~out : out;
+                Lit accumulator  = operand(0);
+                for (size_t i = 1; i < operands.size(); ++i)
+                {
+                    Lit const next = i + 1 == operands.size() ? result : posLit(solver_.newVar());
+                    solver_.addClause({~next, accumulator, operand(i)});
+                    solver_.addClause({~next, ~accumulator, ~operand(i)});
+                    solver_.addClause({next, ~accumulator, operand(i)});
+                    solver_.addClause({next, accumulator, ~operand(i)});
+                    accumulator = next;
+                }
+                if (operands.size() == 1)
+                {
+                    solver_.addClause({~result, accumulator});
+                    solver_.addClause({result, ~accumulator});
+                }
+                return;
+            }
+            default:
+                log::error("TseitinEncoder: unsupported gate type.");
+                std::abort();
+        }
+    }
+};
+
+}  // namespace cirbo::sat
+
+#endif  // CIRBO_SEARCH_SAT_TSEITIN_HPP
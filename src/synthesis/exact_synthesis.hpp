@@ -0,0 +1,672 @@
+#ifndef CIRBO_SEARCH_SYNTHESIS_EXACT_SYNTHESIS_HPP
+#define CIRBO_SEARCH_SYNTHESIS_EXACT_SYNTHESIS_HPP
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "core/npn.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "sat/solver.hpp"
+#include "synthesis/synthesis_cache.hpp"
+
+namespace cirbo::synthesis
+{
+
+/**
+ * Tables of 2-input gate functions: bit `a + 2 * b` is the value on operands
+ * `a` and `b`. NOT gates are encoded as functions, ignoring one operand.
+ */
+namespace table
+{
+constexpr uint8_t AND        = 0x8;
+constexpr uint8_t NAND       = 0x7;
+constexpr uint8_t OR         = 0xE;
+constexpr uint8_t NOR        = 0x1;
+constexpr uint8_t XOR        = 0x6;
+constexpr uint8_t NXOR       = 0x9;
+constexpr uint8_t NOT_FIRST  = 0x5;
+constexpr uint8_t NOT_SECOND = 0x3;
+}  // namespace table
+
+/* Returns tables of gate functions, allowed in basis. */
+[[nodiscard]]
+inline std::vector<uint8_t> getBasisTables(Basis basis)
+{
+    switch (basis)
+    {
+        case Basis::AIG:
+            return {table::AND, table::NOT_FIRST, table::NOT_SECOND};
+        case Basis::XAG:
+            return {table::AND, table::XOR, table::NOT_FIRST, table::NOT_SECOND};
+        case Basis::BENCH:
+            return {
+                table::AND,
+                table::NAND,
+                table::OR,
+                table::NOR,
+                table::XOR,
+                table::NXOR,
+                table::NOT_FIRST,
+                table::NOT_SECOND};
+    }
+    throw std::invalid_argument("Unsupported basis.");
+}
+
+/* Returns gate of type, corresponding to table of function, applied to operands `first` and `second`. */
+[[nodiscard]]
+inline circuits_db::GateRecord makeGateRecord(uint8_t function, uint8_t first, uint8_t second)
+{
+    switch (function)
+    {
+        case table::NOT_FIRST:
+            return {GateType::NOT, 1, {first, 0, 0}};
+        case table::NOT_SECOND:
+            return {GateType::NOT, 1, {second, 0, 0}};
+        case table::AND:
+            return {GateType::AND, 2, {first, second, 0}};
+        case table::NAND:
+            return {GateType::NAND, 2, {first, second, 0}};
+        case table::OR:
+            return {GateType::OR, 2, {first, second, 0}};
+        case table::NOR:
+            return {GateType::NOR, 2, {first, second, 0}};
+        case table::XOR:
+            return {GateType::XOR, 2, {first, second, 0}};
+        case table::NXOR:
+            return {GateType::NXOR, 2, {first, second, 0}};
+        default:
+            throw std::invalid_argument("Gate function is not supported.");
+    }
+}
+
+/**
+ * SAT-based exact synthesis of circuits of at most `npn::MaxVariables` inputs
+ * and a few outputs. Circuit of `r` gates is encoded as: for each gate --
+ * choice of operands among previous nodes and its function from basis, for
+ * each output -- choice of gate, for each gate and input assignment -- value
+ * of the gate. The first satisfiable size among `r = 1, 2, ...` gives circuit
+ * of minimum size, every gate, NOT included, costs one. Several sizes are
+ * queried in parallel, each by own solver.
+ *
+ * Symmetries are broken: NOT gates take one operand and binary gates take two
+ * distinct ones, every gate is used, and operand pairs of consecutive gates
+ * are ordered co-lexicographically (independent gates may be swapped).
+ *
+ * Results are kept in `SynthesisCache`, keyed by function with inputs
+ * permuted to the smallest truth tables, since permutation of inputs is free.
+ */
+class ExactSynthesizer
+{
+public:
+    static constexpr size_t DefaultMaxGates = 12;
+
+private:
+    Basis basis_;
+    std::vector<uint8_t> tables_;
+    size_t max_gates_;
+    int64_t conflict_limit_;
+    size_t threads_;
+    std::shared_ptr<SynthesisCache> cache_;
+
+public:
+    /**
+     * @param basis -- basis of resulting circuits.
+     * @param max_gates -- maximum size of circuit to look for.
+     * @param conflict_limit -- conflict limit of each SAT query, negative means no limit.
+     * @param threads -- number of sizes, queried in parallel.
+     * @param cache -- cache of results, may be shared by synthesizers.
+     */
+    explicit ExactSynthesizer(
+        Basis basis,
+        size_t max_gates                      = DefaultMaxGates,
+        int64_t conflict_limit                = -1,
+        size_t threads                        = 1,
+        std::shared_ptr<SynthesisCache> cache = std::make_shared<SynthesisCache>())
+        : basis_(basis)
+        , tables_(getBasisTables(basis))
+        , max_gates_(max_gates)
+        , conflict_limit_(conflict_limit)
+        , threads_(std::max<size_t>(threads, 1))
+        , cache_(std::move(cache))
+    {
+    }
+
+    [[nodiscard]]
+    Basis getBasis() const noexcept
+    {
+        return basis_;
+    }
+
+    [[nodiscard]]
+    SynthesisCache& getCache() const noexcept
+    {
+        return *cache_;
+    }
+
+    /**
+     * @param truths -- truth tables of outputs, in the format of `core/npn.hpp`.
+     * @param inputs -- number of inputs.
+     * @return circuit of minimum size, or nullopt if minimum is larger than
+     *         maximum size, or can't be proven within conflict limit.
+     */
+    [[nodiscard]]
+    std::optional<SynthesizedCircuit> synthesize(std::vector<uint64_t> truths, size_t inputs) const
+    {
+        if (inputs > npn::MaxVariables || truths.empty())
+        {
+            throw std::invalid_argument("ExactSynthesizer: too many inputs or no outputs.");
+        }
+        for (uint64_t& truth : truths)
+        {
+            truth &= npn::getTruthMask(inputs);
+        }
+
+        std::array<uint8_t, npn::MaxVariables> permutation{};
+        SynthesisCache::Key key{basis_, static_cast<uint8_t>(inputs), canonize_(truths, inputs, permutation)};
+        std::optional<SynthesizedCircuit> circuit;
+        if (!cache_->find(key, max_gates_, conflict_limit_, circuit))
+        {
+            circuit = synthesizeCanonical_(key.truths, inputs);
+            cache_->insert(key, circuit, max_gates_, conflict_limit_);
+        }
+        if (!circuit.has_value())
+        {
+            return std::nullopt;
+        }
+
+        // Canonical input `i` is original input `permutation[i]`.
+        auto const remap = [&permutation, inputs](uint8_t node)
+        { return node < inputs ? permutation[node] : node; };
+        for (auto& gate : circuit->gates)
+        {
+            for (size_t i = 0; i < gate.arity; ++i)
+            {
+                gate.operands[i] = remap(gate.operands[i]);
+            }
+        }
+        for (uint8_t& output : circuit->outputs)
+        {
+            output = remap(output);
+        }
+        return circuit;
+    }
+
+    /**
+     * Single-output version of `synthesize`.
+     */
+    [[nodiscard]]
+    std::optional<circuits_db::DatabaseCircuit> synthesize(uint64_t truth, size_t inputs) const
+    {
+        auto circuit = synthesize(std::vector<uint64_t>{truth}, inputs);
+        if (!circuit.has_value())
+        {
+            return std::nullopt;
+        }
+        return circuits_db::DatabaseCircuit{
+            .inputs = circuit->inputs,
+            .output = circuit->outputs.front(),
+            .gates  = std::move(circuit->gates)};
+    }
+
+private:
+    /* Encoding of circuit of fixed size and its decoding from model. */
+    struct Encoding_
+    {
+        size_t inputs;
+        size_t gates;
+        size_t rows;
+        /* Selection variable of each gate and each pair of operands, in co-lexicographic order. */
+        std::vector<std::vector<std::pair<std::array<uint8_t, 2>, sat::Var> > > selections;
+        /* Four variables of function table of each gate. */
+        std::vector<std::array<sat::Var, 4> > functions;
+        /* Selection variable of each gate for each output. */
+        std::vector<std::vector<sat::Var> > outputs;
+        /* Value of each gate on each row, gate-major. */
+        std::vector<sat::Var> values;
+
+        [[nodiscard]]
+        sat::Lit getValue(size_t gate, size_t row) const
+        {
+            return sat::posLit(values[(gate * rows) + row]);
+        }
+    };
+
+    /* Result of query for one size. */
+    struct Attempt_
+    {
+        sat::SolveResult result = sat::SolveResult::UNKNOWN;
+        std::vector<circuits_db::GateRecord> gates;
+        std::vector<uint8_t> outputs;
+    };
+
+    /**
+     * Permutes inputs to get lexicographically smallest tuple of truth tables.
+     *
+     * @param permutation -- is set to original input of each canonical input.
+     */
+    static std::vector<uint64_t> canonize_(
+        std::vector<uint64_t> truths,
+        size_t inputs,
+        std::array<uint8_t, npn::MaxVariables>& permutation)
+    {
+        std::vector<uint64_t> best = truths;
+        std::iota(permutation.begin(), permutation.end(), 0);
+        std::array<uint8_t, npn::MaxVariables> order = permutation;
+        std::array<uint8_t, npn::MaxVariables> current{};
+        auto const end = order.begin() + static_cast<std::ptrdiff_t>(inputs);
+        while (std::next_permutation(order.begin(), end))
+        {
+            // Bubble variables to positions, prescribed by `order`.
+            std::vector<uint64_t> permuted = truths;
+            std::iota(current.begin(), current.end(), 0);
+            for (size_t i = 0; i < inputs; ++i)
+            {
+                size_t j = i;
+                while (current[j] != order[i])
+                {
+                    ++j;
+                }
+                for (; j > i; --j)
+                {
+                    std::swap(current[j], current[j - 1]);
+                    for (uint64_t& truth : permuted)
+                    {
+                        truth = npn::swapAdjacentVariables(truth, j - 1);
+                    }
+                }
+            }
+            if (permuted < best)
+            {
+                best        = std::move(permuted);
+                permutation = order;
+            }
+        }
+        return best;
+    }
+
+    std::optional<SynthesizedCircuit> synthesizeCanonical_(std::vector<uint64_t> const& truths, size_t inputs) const
+    {
+        SynthesizedCircuit circuit{.inputs = static_cast<uint8_t>(inputs), .outputs = {}, .gates = {}};
+        circuit.outputs.resize(truths.size());
+
+        // Outputs, which are inputs or constants, need no search; equal ones share a gate.
+        std::vector<uint64_t> targets;
+        std::vector<size_t> target_of_output(truths.size(), SIZE_MAX);
+        std::vector<std::pair<size_t, bool> > constants;
+        size_t lower_bound = 0;
+        for (size_t output = 0; output < truths.size(); ++output)
+        {
+            uint64_t const truth = truths[output];
+            bool trivial         = false;
+            for (size_t i = 0; i < inputs && !trivial; ++i)
+            {
+                if (truth == (npn::VariableMasks[i] & npn::getTruthMask(inputs)))
+                {
+                    circuit.outputs[output] = static_cast<uint8_t>(i);
+                    trivial                 = true;
+                }
+            }
+            if (!trivial && (truth == 0 || truth == npn::getTruthMask(inputs)))
+            {
+                constants.emplace_back(output, truth != 0);
+                trivial = true;
+            }
+            if (trivial)
+            {
+                continue;
+            }
+            auto const it = std::ranges::find(targets, truth);
+            target_of_output[output] = static_cast<size_t>(it - targets.begin());
+            if (it == targets.end())
+            {
+                targets.push_back(truth);
+            }
+            // Each binary gate joins at most two components, so all essential inputs need that many gates.
+            size_t essential = 0;
+            for (size_t i = 0; i < inputs; ++i)
+            {
+                essential += npn::flipVariable(truth, i) != truth ? 1 : 0;
+            }
+            lower_bound = std::max(lower_bound, essential - 1);
+        }
+
+        if (!targets.empty())
+        {
+            auto attempt = searchMinimum_(targets, inputs, std::max({lower_bound, targets.size(), size_t{1}}));
+            if (!attempt.has_value())
+            {
+                return std::nullopt;
+            }
+            circuit.gates = std::move(attempt->gates);
+            for (size_t output = 0; output < truths.size(); ++output)
+            {
+                if (target_of_output[output] != SIZE_MAX)
+                {
+                    circuit.outputs[output] = attempt->outputs[target_of_output[output]];
+                }
+            }
+        }
+        for (auto const& [output, value] : constants)
+        {
+            if (circuit.gates.size() >= max_gates_)
+            {
+                return std::nullopt;
+            }
+            circuit.gates.push_back({value ? GateType::CONST_TRUE : GateType::CONST_FALSE, 0, {}});
+            circuit.outputs[output] = static_cast<uint8_t>(inputs + circuit.gates.size() - 1);
+        }
+        return circuit;
+    }
+
+    /* Queries sizes from `first` on, `threads_` at a time, until the smallest satisfiable one is known. */
+    std::optional<Attempt_> searchMinimum_(std::vector<uint64_t> const& targets, size_t inputs, size_t first) const
+    {
+        for (size_t size = first; size <= max_gates_; size += threads_)
+        {
+            size_t const batch = std::min(threads_, max_gates_ - size + 1);
+            std::vector<Attempt_> attempts(batch);
+            std::vector<std::thread> pool;
+            for (size_t i = 1; i < batch; ++i)
+            {
+                pool.emplace_back([&, i] { attempts[i] = attemptSize_(targets, inputs, size + i); });
+            }
+            attempts[0] = attemptSize_(targets, inputs, size);
+            for (auto& thread : pool)
+            {
+                thread.join();
+            }
+
+            for (Attempt_& attempt : attempts)
+            {
+                if (attempt.result == sat::SolveResult::SAT)
+                {
+                    return std::move(attempt);
+                }
+                if (attempt.result == sat::SolveResult::UNKNOWN)
+                {
+                    // Minimality can't be proven.
+                    return std::nullopt;
+                }
+            }
+        }
+        return std::nullopt;
+    }
+
+    Attempt_ attemptSize_(std::vector<uint64_t> const& targets, size_t inputs, size_t gates) const
+    {
+        log::debug("ExactSynthesizer: trying ", gates, " gates.");
+        sat::Solver solver;
+        Encoding_ const encoding = encode_(solver, targets, inputs, gates);
+        Attempt_ attempt;
+        attempt.result = solver.solve({}, conflict_limit_);
+        if (attempt.result == sat::SolveResult::SAT)
+        {
+            decode_(solver, encoding, attempt);
+        }
+        return attempt;
+    }
+
+    Encoding_ encode_(sat::Solver& solver, std::vector<uint64_t> const& targets, size_t inputs, size_t gates) const
+    {
+        Encoding_ encoding{
+            .inputs     = inputs,
+            .gates      = gates,
+            .rows       = size_t{1} << inputs,
+            .selections = std::vector<std::vector<std::pair<std::array<uint8_t, 2>, sat::Var> > >(gates),
+            .functions  = std::vector<std::array<sat::Var, 4> >(gates),
+            .outputs    = std::vector<std::vector<sat::Var> >(targets.size()),
+            .values     = std::vector<sat::Var>(gates << inputs)};
+        for (sat::Var& var : encoding.values)
+        {
+            var = solver.newVar();
+        }
+
+        for (size_t gate = 0; gate < gates; ++gate)
+        {
+            size_t const node = inputs + gate;
+            for (sat::Var& var : encoding.functions[gate])
+            {
+                var = solver.newVar();
+            }
+            // Function must belong to basis.
+            for (size_t function = 0; function < 16; ++function)
+            {
+                if (std::ranges::find(tables_, function) == tables_.end())
+                {
+                    solver.addClause(differsFromFunction_(encoding, gate, static_cast<uint8_t>(function)));
+                }
+            }
+
+            // Exactly one pair of operands is selected. NOT takes equal operands, other gates take distinct ones.
+            std::vector<sat::Lit> at_least_one;
+            for (size_t second = 0; second < node; ++second)
+            {
+                for (size_t first = 0; first <= second; ++first)
+                {
+                    sat::Var const selection = solver.newVar();
+                    encoding.selections[gate].push_back(
+                        {{static_cast<uint8_t>(first), static_cast<uint8_t>(second)}, selection});
+                    at_least_one.push_back(sat::posLit(selection));
+                    encodeSemantics_(solver, encoding, gate, first, second, selection);
+
+                    std::vector<uint8_t> const forbidden = first == second
+                                                               ? notTables_(true)
+                                                               : notTables_(false);
+                    for (uint8_t const function : forbidden)
+                    {
+                        auto clause = differsFromFunction_(encoding, gate, function);
+                        clause.push_back(sat::negLit(selection));
+                        solver.addClause(std::move(clause));
+                    }
+                }
+            }
+            for (size_t i = 0; i < at_least_one.size(); ++i)
+            {
+                for (size_t j = i + 1; j < at_least_one.size(); ++j)
+                {
+                    solver.addClause({~at_least_one[i], ~at_least_one[j]});
+                }
+            }
+            solver.addClause(std::move(at_least_one));
+
+            // Operand pairs of consecutive gates are ordered.
+            if (gate > 0)
+            {
+                auto const& previous = encoding.selections[gate - 1];
+                auto const& current  = encoding.selections[gate];
+                for (size_t i = 0; i < previous.size(); ++i)
+                {
+                    for (size_t j = 0; j < i; ++j)
+                    {
+                        solver.addClause({sat::negLit(previous[i].second), sat::negLit(current[j].second)});
+                    }
+                }
+            }
+        }
+
+        // Each output is exactly one gate, which computes it.
+        for (size_t target = 0; target < targets.size(); ++target)
+        {
+            std::vector<sat::Lit> at_least_one;
+            for (size_t gate = 0; gate < gates; ++gate)
+            {
+                sat::Var const selection = solver.newVar();
+                encoding.outputs[target].push_back(selection);
+                at_least_one.push_back(sat::posLit(selection));
+                for (size_t row = 0; row < encoding.rows; ++row)
+                {
+                    sat::Lit const value = encoding.getValue(gate, row);
+                    solver.addClause(
+                        {sat::negLit(selection), ((targets[target] >> row) & 1U) != 0 ? value : ~value});
+                }
+            }
+            for (size_t i = 0; i < at_least_one.size(); ++i)
+            {
+                for (size_t j = i + 1; j < at_least_one.size(); ++j)
+                {
+                    solver.addClause({~at_least_one[i], ~at_least_one[j]});
+                }
+            }
+            solver.addClause(std::move(at_least_one));
+        }
+
+        // Every gate is an operand of a later gate, or an output.
+        for (size_t gate = 0; gate < gates; ++gate)
+        {
+            auto const node = static_cast<uint8_t>(inputs + gate);
+            std::vector<sat::Lit> used;
+            for (size_t user = gate + 1; user < gates; ++user)
+            {
+                for (auto const& [operands, selection] : encoding.selections[user])
+                {
+                    if (operands[0] == node || operands[1] == node)
+                    {
+                        used.push_back(sat::posLit(selection));
+                    }
+                }
+            }
+            for (auto const& output : encoding.outputs)
+            {
+                used.push_back(sat::posLit(output[gate]));
+            }
+            solver.addClause(std::move(used));
+        }
+        return encoding;
+    }
+
+    /* Returns NOT tables, if `unary`, or tables of gates, which are applicable to two distinct operands. */
+    static std::vector<uint8_t> notTables_(bool unary)
+    {
+        if (unary)
+        {
+            // Equal operands: anything but NOT of the first one is forbidden, so NOT is encoded once.
+            std::vector<uint8_t> forbidden;
+            for (uint8_t function = 0; function < 16; ++function)
+            {
+                if (function != table::NOT_FIRST)
+                {
+                    forbidden.push_back(function);
+                }
+            }
+            return forbidden;
+        }
+        return {table::NOT_FIRST, table::NOT_SECOND};
+    }
+
+    /* Returns clause, which holds iff function of gate is not `function`. */
+    static std::vector<sat::Lit> differsFromFunction_(Encoding_ const& encoding, size_t gate, uint8_t function)
+    {
+        std::vector<sat::Lit> clause;
+        for (size_t bit = 0; bit < 4; ++bit)
+        {
+            bool const value = ((function >> bit) & 1U) != 0;
+            clause.push_back(sat::Lit(encoding.functions[gate][bit], value));
+        }
+        return clause;
+    }
+
+    /* Adds clauses: if pair of operands is selected, gate value is its function of operand values. */
+    static void encodeSemantics_(
+        sat::Solver& solver,
+        Encoding_ const& encoding,
+        size_t gate,
+        size_t first,
+        size_t second,
+        sat::Var selection)
+    {
+        for (size_t row = 0; row < encoding.rows; ++row)
+        {
+            for (size_t bit = 0; bit < 4; ++bit)
+            {
+                bool const a = (bit & 1U) != 0;
+                bool const b = (bit & 2U) != 0;
+                if (first == second && a != b)
+                {
+                    continue;
+                }
+                std::vector<sat::Lit> premise{sat::negLit(selection)};
+                if (!addOperandPremise_(encoding, first, row, a, premise)
+                    || !addOperandPremise_(encoding, second, row, b, premise))
+                {
+                    continue;
+                }
+                sat::Lit const value         = encoding.getValue(gate, row);
+                sat::Lit const function      = sat::posLit(encoding.functions[gate][bit]);
+                std::vector<sat::Lit> clause = premise;
+                clause.push_back(~value);
+                clause.push_back(function);
+                solver.addClause(std::move(clause));
+                premise.push_back(value);
+                premise.push_back(~function);
+                solver.addClause(std::move(premise));
+            }
+        }
+    }
+
+    /**
+     * Adds literal, which is false iff node has value `value` on row. Inputs have
+     * known values: returns false if premise can't hold, so clause is not needed.
+     */
+    static bool addOperandPremise_(
+        Encoding_ const& encoding,
+        size_t node,
+        size_t row,
+        bool value,
+        std::vector<sat::Lit>& premise)
+    {
+        if (node < encoding.inputs)
+        {
+            return (((row >> node) & 1U) != 0) == value;
+        }
+        sat::Lit const lit = encoding.getValue(node - encoding.inputs, row);
+        premise.push_back(value ? ~lit : lit);
+        return true;
+    }
+
+    static void decode_(sat::Solver const& solver, Encoding_ const& encoding, Attempt_& attempt)
+    {
+        for (size_t gate = 0; gate < encoding.gates; ++gate)
+        {
+            uint8_t function = 0;
+            for (size_t bit = 0; bit < 4; ++bit)
+            {
+                function |= static_cast<uint8_t>(solver.getModelValue(encoding.functions[gate][bit]) ? 1U << bit : 0U);
+            }
+            for (auto const& [operands, selection] : encoding.selections[gate])
+            {
+                if (solver.getModelValue(selection))
+                {
+                    attempt.gates.push_back(makeGateRecord(function, operands[0], operands[1]));
+                    break;
+                }
+            }
+        }
+        for (auto const& output : encoding.outputs)
+        {
+            for (size_t gate = 0; gate < encoding.gates; ++gate)
+            {
+                if (solver.getModelValue(output[gate]))
+                {
+                    attempt.outputs.push_back(static_cast<uint8_t>(encoding.inputs + gate));
+                    break;
+                }
+            }
+        }
+    }
+};
+
+}  // namespace cirbo::synthesis
+
+#endif  // CIRBO_SEARCH_SYNTHESIS_EXACT_SYNTHESIS_HPP
@@ -0,0 +1,149 @@
+#ifndef CIRBO_SEARCH_SYNTHESIS_SYNTHESIS_CACHE_HPP
+#define CIRBO_SEARCH_SYNTHESIS_SYNTHESIS_CACHE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "core/types.hpp"
+
+namespace cirbo::synthesis
+{
+
+/**
+ * Multi-output circuit with at most `npn::MaxVariables` inputs. Inputs have
+ * ids `0..inputs - 1`, i-th gate has id `inputs + i`, outputs are any of them.
+ */
+struct SynthesizedCircuit
+{
+    uint8_t inputs = 0;
+    std::vector<uint8_t> outputs;
+    std::vector<circuits_db::GateRecord> gates;
+
+    bool operator==(SynthesizedCircuit const&) const = default;
+
+    /* Returns truth tables of outputs, in the format of `core/npn.hpp`. */
+    [[nodiscard]]
+    std::vector<uint64_t> computeTruthTables() const
+    {
+        std::vector<uint64_t> const values = circuits_db::simulateGates(inputs, gates);
+        std::vector<uint64_t> result;
+        for (uint8_t const output : outputs)
+        {
+            result.push_back(values.at(output));
+        }
+        return result;
+    }
+};
+
+/**
+ * Thread-safe map from multi-output functions to results of their exact
+ * synthesis. It outlives synthesis calls (and may be shared by synthesizers),
+ * so functions, which repeat across a circuit or a batch, are solved once.
+ * Failures are cached together with limits they happened under, and are
+ * reused only by calls with no larger limits.
+ */
+class SynthesisCache
+{
+public:
+    struct Key
+    {
+        Basis basis;
+        uint8_t inputs;
+        std::vector<uint64_t> truths;
+
+        auto operator<=>(Key const&) const = default;
+    };
+
+private:
+    struct Entry_
+    {
+        std::optional<SynthesizedCircuit> circuit;
+        size_t max_gates;
+        int64_t conflict_limit;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<Key, Entry_> entries_;
+    size_t hits_   = 0;
+    size_t misses_ = 0;
+
+public:
+    /**
+     * Looks up result of synthesis under given limits.
+     *
+     * @param result -- is set to cached result, nullopt if synthesis failed.
+     * @return true iff cached result applies.
+     */
+    bool find(Key const& key, size_t max_gates, int64_t conflict_limit, std::optional<SynthesizedCircuit>& result)
+    {
+        std::lock_guard const lock(mutex_);
+        auto const it = entries_.find(key);
+        if (it == entries_.end() || !applies_(it->second, max_gates, conflict_limit))
+        {
+            ++misses_;
+            return false;
+        }
+        ++hits_;
+        result = it->second.circuit;
+        if (result.has_value() && result->gates.size() > max_gates)
+        {
+            // Minimum circuit is found under larger limits, so this call would fail.
+            result.reset();
+        }
+        return true;
+    }
+
+    void insert(Key key, std::optional<SynthesizedCircuit> circuit, size_t max_gates, int64_t conflict_limit)
+    {
+        std::lock_guard const lock(mutex_);
+        auto const it = entries_.find(key);
+        if (it != entries_.end() && it->second.circuit.has_value())
+        {
+            return;
+        }
+        entries_.insert_or_assign(std::move(key), Entry_{std::move(circuit), max_gates, conflict_limit});
+    }
+
+    [[nodiscard]]
+    size_t size() const
+    {
+        std::lock_guard const lock(mutex_);
+        return entries_.size();
+    }
+
+    [[nodiscard]]
+    size_t getHits() const
+    {
+        std::lock_guard const lock(mutex_);
+        return hits_;
+    }
+
+    [[nodiscard]]
+    size_t getMisses() const
+    {
+        std::lock_guard const lock(mutex_);
+        return misses_;
+    }
+
+private:
+    static bool applies_(Entry_ const& entry, size_t max_gates, int64_t conflict_limit) noexcept
+    {
+        if (entry.circuit.has_value())
+        {
+            return true;
+        }
+        bool const enough_conflicts =
+            entry.conflict_limit < 0 || (conflict_limit >= 0 && entry.conflict_limit >= conflict_limit);
+        return entry.max_gates >= max_gates && enough_conflicts;
+    }
+};
+
+}  // namespace cirbo::synthesis
+
+#endif  // CIRBO_SEARCH_SYNTHESIS_SYNTHESIS_CACHE_HPP
@@ -0,0 +1,157 @@
+#ifndef CIRBO_SEARCH_UTILS_BUFFER_POOL_HPP
+#define CIRBO_SEARCH_UTILS_BUFFER_POOL_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace cirbo::utils
+{
+
+/** Default upper bound on the number of buffers, kept by one pool. **/
+constexpr size_t DefaultBufferPoolCapacity = size_t{1} << 22;
+
+/**
+ * Pool of `std::vector<T>` buffers, which allows to reuse already allocated
+ * memory instead of returning it to the allocator and requesting it again.
+ *
+ * Minimization pipeline rebuilds circuit on each pass, so buffers released
+ * by a previous (consumed) circuit are taken by the next one, hence in a
+ * steady state passes work in a double buffering manner and don't allocate
+ * operand containers at all.
+ *
+ * Pool is not thread safe, use `getBufferPool` to get thread local instance.
+ *
+ * @tparam T -- type of buffer elements.
+ */
+template<class T>
+class BufferPool
+{
+private:
+    /* Cleared buffers with non-zero capacity. */
+    std::vector<std::vector<T> > free_buffers_;
+    /* Maximum number of buffers pool keeps, other released buffers are freed. */
+    size_t capacity_ = DefaultBufferPoolCapacity;
+
+public:
+    BufferPool() = default;
+    ~BufferPool() = default;
+
+    BufferPool(BufferPool const&)            = delete;
+    BufferPool& operator=(BufferPool const&) = delete;
+
+    /**
+     * @return empty buffer, which may already have some capacity.
+     */
+    [[nodiscard]]
+    std::vector<T> acquire() noexcept
+    {
+        if (free_buffers_.empty())
+        {
+            return {};
+        }
+        std::vector<T> buffer = std::move(free_buffers_.back());
+        free_buffers_.pop_back();
+        return buffer;
+    }
+
+    /**
+     * @param size -- required size of buffer.
+     * @return buffer of `size` value-initialized elements.
+     */
+    [[nodiscard]]
+    std::vector<T> acquire(size_t const size)
+    {
+        std::vector<T> buffer = acquire();
+        buffer.resize(size);
+        return buffer;
+    }
+
+    /**
+     * @param source -- container to copy.
+     * @return buffer, which carries copy of `source` elements.
+     */
+    [[nodiscard]]
+    std::vector<T> acquireCopy(std::vector<T> const& source)
+    {
+        std::vector<T> buffer = acquire();
+        buffer.assign(source.begin(), source.end());
+        return buffer;
+    }
+
+    /**
+     * Takes ownership of buffer to reuse its memory later.
+     * @param buffer -- buffer to release, is left empty.
+     */
+    void release(std::vector<T>&& buffer)
+    {
+        if (buffer.capacity() == 0 || free_buffers_.size() >= capacity_)
+        {
+            std::vector<T>().swap(buffer);
+            return;
+        }
+        buffer.clear();
+        free_buffers_.push_back(std::move(buffer));
+    }
+
+    /* Returns number of buffers, that are ready to be reused. */
+    [[nodiscard]]
+    size_t size() const noexcept
+    {
+        return free_buffers_.size();
+    }
+
+    /* Sets maximum number of buffers kept by pool. */
+    void setCapacity(size_t const capacity)
+    {
+        capacity_ = capacity;
+        if (free_buffers_.size() > capacity_)
+        {
+            free_buffers_.resize(capacity_);
+        }
+    }
+
+    /* Frees all buffers kept by pool. */
+    void clear() noexcept { std::vector<std::vector<T> >().swap(free_buffers_); }
+};
+
+namespace impl
+{
+
+/* Functions, which clear pools of the calling thread, one per type of elements. */
+inline std::vector<void (*)()>& getBufferPoolClearers()
+{
+    static thread_local std::vector<void (*)()> clearers;
+    return clearers;
+}
+
+}  // namespace impl
+
+/**
+ * @return thread local pool of buffers with elements of type `T`.
+ */
+template<class T>
+BufferPool<T>& getBufferPool()
+{
+    static thread_local BufferPool<T> instance;
+    [[maybe_unused]] static thread_local bool const registered =
+        (impl::getBufferPoolClearers().push_back([]() { getBufferPool<T>().clear(); }), true);
+    return instance;
+}
+
+/**
+ * Frees buffers, kept by all pools of the calling thread. Pools keep memory of the
+ * largest circuit processed so far, so this should be called, when circuit is done,
+ * e.g. between circuits of a batch.
+ */
+inline void clearBufferPools()
+{
+    for (auto const clear : impl::getBufferPoolClearers())
+    {
+        clear();
+    }
+}
+
+}  // namespace cirbo::utils
+
+#endif  // CIRBO_SEARCH_UTILS_BUFFER_POOL_HPP
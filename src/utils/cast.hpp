@@ -70,7 +70,8 @@ inline std::string basisToString(Basis basis) noexcept
 {
     static std::unordered_map<Basis, std::string> const _type_map{
         {Basis::AIG,   "AIG"  },
-        {Basis::BENCH, "BENCH"}
+        {Basis::BENCH, "BENCH"},
+        {Basis::XAG,   "XAG"  }
     };
 
     return _type_map.at(basis);
@@ -84,7 +85,8 @@ inline Basis stringToBasis(std::string const& basis_name) noexcept
 {
     static std::unordered_map<std::string, Basis> const _type_map{
         {"AIG",   Basis::AIG  },
-        {"BENCH", Basis::BENCH}
+        {"BENCH", Basis::BENCH},
+        {"XAG",   Basis::XAG  }
     };
 
     return _type_map.at(basis_name);
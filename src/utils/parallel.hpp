@@ -0,0 +1,82 @@
+#ifndef CIRBO_SEARCH_UTILS_PARALLEL_HPP
+#define CIRBO_SEARCH_UTILS_PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cirbo::utils
+{
+
+/**
+ * Calls `body(i, state)` for each `i` in `[0, size)` on at most `threads` threads,
+ * calling thread included. Indices are taken one by one, so threads stay busy,
+ * when work per index varies. Each thread makes its own `state` by `make_state()`,
+ * e.g. scratch buffers, which are reused by all its indices.
+ *
+ * If `body` throws, other threads stop after their current index, and the
+ * exception is rethrown in the calling thread.
+ *
+ * @param size -- number of indices.
+ * @param threads -- maximum number of threads.
+ * @param make_state -- factory of per-thread state.
+ * @param body -- work for one index.
+ */
+template<class MakeStateT, class BodyT>
+void parallelFor(size_t size, size_t threads, MakeStateT const& make_state, BodyT const& body)
+{
+    std::atomic<size_t> next = 0;
+    std::mutex mutex;
+    std::exception_ptr error;
+    auto const work = [&]()
+    {
+        try
+        {
+            auto state = make_state();
+            for (size_t i = next++; i < size; i = next++)
+            {
+                body(i, state);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard const lock(mutex);
+            error = std::current_exception();
+            next  = size;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < std::min(threads, size); ++i)
+    {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+/**
+ * Calls `body(i)` for each `i` in `[0, size)` on at most `threads` threads,
+ * see `parallelFor` with per-thread state.
+ */
+template<class BodyT>
+void parallelFor(size_t size, size_t threads, BodyT const& body)
+{
+    parallelFor(
+        size, threads, []() { return nullptr; }, [&body](size_t i, std::nullptr_t /*unused*/) { body(i); });
+}
+
+}  // namespace cirbo::utils
+
+#endif  // CIRBO_SEARCH_UTILS_PARALLEL_HPP
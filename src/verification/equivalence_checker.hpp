@@ -0,0 +1,397 @@
+#ifndef CIRBO_SEARCH_VERIFICATION_EQUIVALENCE_CHECKER_HPP
+#define CIRBO_SEARCH_VERIFICATION_EQUIVALENCE_CHECKER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/simulation.hpp"
+#include "core/structures/icircuit.hpp"
+#include "core/types.hpp"
+#include "logger.hpp"
+#include "sat/solver.hpp"
+#include "sat/tseitin.hpp"
+#include "utils/encoder.hpp"
+#include "utils/random.hpp"
+
+namespace cirbo::verification
+{
+
+/** Result of verification of one output. **/
+enum class OutputStatus : uint8_t
+{
+    EQUIVALENT,
+    DIFFERENT,
+    /* SAT conflict limit was reached. */
+    UNDECIDED
+};
+
+inline std::string_view outputStatusToString(OutputStatus status)
+{
+    switch (status)
+    {
+        case OutputStatus::EQUIVALENT:
+            return "EQUIVALENT";
+        case OutputStatus::DIFFERENT:
+            return "DIFFERENT";
+        default:
+            return "UNDECIDED";
+    }
+}
+
+/** Verification result of one pair of matched outputs. **/
+struct OutputVerdict
+{
+    /* Name of output in the first circuit. */
+    std::string name;
+    OutputStatus status = OutputStatus::UNDECIDED;
+    /* True if outputs were distinguished by simulation, without SAT call. */
+    bool by_simulation = false;
+    /* Time of SAT check of this output. */
+    double milliseconds = 0;
+    /* Values of inputs (by name), on which outputs differ. */
+    std::vector<std::pair<std::string, bool> > counterexample;
+};
+
+/** Result of equivalence check of two circuits. **/
+struct EquivalenceReport
+{
+    std::vector<OutputVerdict> outputs;
+    double simulation_milliseconds = 0;
+    /* Whether names of outputs do not match, so outputs are matched by positions. */
+    bool outputs_matched_by_positions = false;
+
+    [[nodiscard]]
+    bool isEquivalent() const
+    {
+        return std::ranges::all_of(
+            outputs, [](OutputVerdict const& verdict) { return verdict.status == OutputStatus::EQUIVALENT; });
+    }
+
+    /**
+     * Writes human-readable report, one line per output.
+     */
+    void write(std::ostream& out) const
+    {
+        out << "simulation: " << simulation_milliseconds << " ms\n";
+        if (outputs_matched_by_positions)
+        {
+            out << "outputs: matched by positions, names do not match\n";
+        }
+        for (OutputVerdict const& verdict : outputs)
+        {
+            out << "output " << verdict.name << ": " << outputStatusToString(verdict.status);
+            if (verdict.by_simulation)
+            {
+                out << " (by simulation)";
+            }
+            else
+            {
+                out << " (by SAT, " << verdict.milliseconds << " ms)";
+            }
+            for (auto const& [input, value] : verdict.counterexample)
+            {
+                out << " " << input << "=" << value;
+            }
+            out << "\n";
+        }
+    }
+};
+
+/**
+ * Checks, that two circuits compute the same function. Circuits are joined in a
+ * miter: inputs with equal names are shared, outputs are matched by names, or by
+ * positions if names do not match (minimization may rename outputs).
+ *
+ * Outputs are first compared by bit-parallel simulation on random patterns, which
+ * refutes most of wrong outputs. Remaining outputs are proven by SAT solver, in
+ * parallel: each thread owns incremental solver and takes outputs one by one, so
+ * cones, encoded for previous outputs, are reused.
+ */
+class EquivalenceChecker
+{
+public:
+    /** Default number of 64-bit words of simulation signatures. **/
+    static constexpr size_t DefaultWords = 64;
+
+private:
+    static constexpr GateId NoGate = std::numeric_limits<GateId>::max();
+
+    /* Input of miter and corresponding inputs of circuits, `NoGate` if circuit has no such input. */
+    struct Input_
+    {
+        std::string name;
+        GateId lhs;
+        GateId rhs;
+    };
+
+    size_t words_;
+    size_t threads_;
+    int64_t conflict_limit_;
+
+public:
+    /**
+     * @param words -- number of 64-bit words of simulation signatures.
+     * @param threads -- number of SAT threads, 0 means number of hardware threads.
+     * @param conflict_limit -- limit of conflicts per output, negative means no limit.
+     */
+    explicit EquivalenceChecker(size_t words = DefaultWords, size_t threads = 0, int64_t conflict_limit = -1)
+        : words_(std::max<size_t>(words, 1))
+        , threads_(threads == 0 ? std::max<size_t>(std::thread::hardware_concurrency(), 1) : threads)
+        , conflict_limit_(conflict_limit)
+    {
+    }
+
+    /**
+     * @return report with verdict for each output of `lhs`.
+     * @throws std::invalid_argument if circuits have different number of outputs.
+     */
+    EquivalenceReport check(
+        ICircuit const& lhs,
+        utils::NameEncoder const& lhs_encoder,
+        ICircuit const& rhs,
+        utils::NameEncoder const& rhs_encoder) const
+    {
+        log::debug("START EquivalenceChecker");
+        std::vector<Input_> const inputs                      = matchInputs_(lhs, lhs_encoder, rhs, rhs_encoder);
+        EquivalenceReport report;
+        std::vector<std::pair<GateId, GateId> > const outputs =
+            matchOutputs_(lhs, lhs_encoder, rhs, rhs_encoder, report.outputs_matched_by_positions);
+
+        report.outputs.resize(outputs.size());
+        for (size_t i = 0; i < outputs.size(); ++i)
+        {
+            report.outputs[i].name = lhs_encoder.decodeGate(outputs[i].first);
+        }
+
+        auto const start   = std::chrono::steady_clock::now();
+        auto const pending = simulate_(lhs, rhs, inputs, outputs, report);
+        report.simulation_milliseconds =
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        log::debug("Simulation left ", pending.size(), " of ", outputs.size(), " outputs for SAT.");
+
+        std::atomic<size_t> next{0};
+        auto const worker    = [&]() { solve_(lhs, rhs, inputs, outputs, pending, next, report); };
+        size_t const threads = std::min(threads_, pending.size());
+        std::vector<std::thread> pool;
+        for (size_t i = 1; i < threads; ++i)
+        {
+            pool.emplace_back(worker);
+        }
+        if (threads > 0)
+        {
+            worker();
+        }
+        for (auto& thread : pool)
+        {
+            thread.join();
+        }
+
+        log::debug("END EquivalenceChecker");
+        return report;
+    }
+
+private:
+    static std::vector<Input_> matchInputs_(
+        ICircuit const& lhs,
+        utils::NameEncoder const& lhs_encoder,
+        ICircuit const& rhs,
+        utils::NameEncoder const& rhs_encoder)
+    {
+        std::vector<Input_> inputs;
+        std::unordered_map<std::string, size_t> by_name;
+        for (GateId const input : lhs.getInputGates())
+        {
+            by_name[lhs_encoder.decodeGate(input)] = inputs.size();
+            inputs.push_back(Input_{lhs_encoder.decodeGate(input), input, NoGate});
+        }
+        // Inputs, present in only one circuit, are free inputs of miter.
+        for (GateId const input : rhs.getInputGates())
+        {
+            std::string const& name = rhs_encoder.decodeGate(input);
+            if (auto it = by_name.find(name); it != by_name.end())
+            {
+                inputs[it->second].rhs = input;
+            }
+            else
+            {
+                inputs.push_back(Input_{name, NoGate, input});
+            }
+        }
+        return inputs;
+    }
+
+    /* Matches outputs by names, or by positions, if names do not match, `by_positions` is set then. */
+    static std::vector<std::pair<GateId, GateId> > matchOutputs_(
+        ICircuit const& lhs,
+        utils::NameEncoder const& lhs_encoder,
+        ICircuit const& rhs,
+        utils::NameEncoder const& rhs_encoder,
+        bool& by_positions)
+    {
+        GateIdContainer const& lhs_outputs = lhs.getOutputGates();
+        GateIdContainer const& rhs_outputs = rhs.getOutputGates();
+        if (lhs_outputs.size() != rhs_outputs.size())
+        {
+            throw std::invalid_argument(
+                "Circuits have different number of outputs: " + std::to_string(lhs_outputs.size()) + " and " +
+                std::to_string(rhs_outputs.size()) + ".");
+        }
+
+        std::vector<std::pair<GateId, GateId> > outputs;
+        std::unordered_map<std::string, GateId> by_name;
+        for (GateId const output : rhs_outputs)
+        {
+            by_name.emplace(rhs_encoder.decodeGate(output), output);
+        }
+        for (GateId const output : lhs_outputs)
+        {
+            auto it = by_name.find(lhs_encoder.decodeGate(output));
+            if (by_name.size() != rhs_outputs.size() || it == by_name.end())
+            {
+                log::debug("Output names do not match, outputs are matched by positions.");
+                by_positions = true;
+                outputs.clear();
+                for (size_t i = 0; i < lhs_outputs.size(); ++i)
+                {
+                    outputs.emplace_back(lhs_outputs[i], rhs_outputs[i]);
+                }
+                return outputs;
+            }
+            outputs.emplace_back(output, it->second);
+        }
+        return outputs;
+    }
+
+    /* Compares outputs on random patterns, returns indices of outputs, which are not refuted. */
+    std::vector<size_t> simulate_(
+        ICircuit const& lhs,
+        ICircuit const& rhs,
+        std::vector<Input_> const& inputs,
+        std::vector<std::pair<GateId, GateId> > const& outputs,
+        EquivalenceReport& report) const
+    {
+        Simulation lhs_simulation(lhs, words_);
+        Simulation rhs_simulation(rhs, words_);
+        std::mt19937 engine = utils::getNewMersenneTwisterEngine();
+        std::uniform_int_distribution<uint64_t> dist;
+        std::vector<uint64_t> words(words_);
+        for (Input_ const& input : inputs)
+        {
+            std::ranges::generate(words, [&]() { return dist(engine); });
+            if (input.lhs != NoGate)
+            {
+                lhs_simulation.setInputWords(input.lhs, words.data());
+            }
+            if (input.rhs != NoGate)
+            {
+                rhs_simulation.setInputWords(input.rhs, words.data());
+            }
+        }
+        lhs_simulation.run(lhs);
+        rhs_simulation.run(rhs);
+
+        std::vector<size_t> pending;
+        for (size_t i = 0; i < outputs.size(); ++i)
+        {
+            uint64_t const* lhs_signature = lhs_simulation.getSignature(outputs[i].first);
+            uint64_t const* rhs_signature = rhs_simulation.getSignature(outputs[i].second);
+            size_t word = 0;
+            while (word < words_ && lhs_signature[word] == rhs_signature[word])
+            {
+                ++word;
+            }
+            if (word == words_)
+            {
+                pending.push_back(i);
+                continue;
+            }
+
+            size_t const pattern =
+                (word * 64) + static_cast<size_t>(std::countr_zero(lhs_signature[word] ^ rhs_signature[word]));
+            OutputVerdict& verdict = report.outputs[i];
+            verdict.status         = OutputStatus::DIFFERENT;
+            verdict.by_simulation  = true;
+            for (Input_ const& input : inputs)
+            {
+                bool const value = input.lhs != NoGate ? lhs_simulation.getValue(input.lhs, pattern)
+                                                       : rhs_simulation.getValue(input.rhs, pattern);
+                verdict.counterexample.emplace_back(input.name, value);
+            }
+        }
+        return pending;
+    }
+
+    /* Proves outputs from `pending`, taking them one by one, until all are taken. */
+    void solve_(
+        ICircuit const& lhs,
+        ICircuit const& rhs,
+        std::vector<Input_> const& inputs,
+        std::vector<std::pair<GateId, GateId> > const& outputs,
+        std::vector<size_t> const& pending,
+        std::atomic<size_t>& next,
+        EquivalenceReport& report) const
+    {
+        sat::Solver solver;
+        sat::TseitinEncoder lhs_tseitin(lhs, solver);
+        sat::TseitinEncoder rhs_tseitin(rhs, solver);
+        for (Input_ const& input : inputs)
+        {
+            if (input.lhs != NoGate && input.rhs != NoGate)
+            {
+                rhs_tseitin.bind(input.rhs, lhs_tseitin.getLit(input.lhs));
+            }
+        }
+
+        for (size_t taken = next++; taken < pending.size(); taken = next++)
+        {
+            size_t const index = pending[taken];
+            auto const start   = std::chrono::steady_clock::now();
+
+            // Selector, which forces outputs to differ.
+            sat::Lit const lhs_output = lhs_tseitin.getLit(outputs[index].first);
+            sat::Lit const rhs_output = rhs_tseitin.getLit(outputs[index].second);
+            sat::Lit const differ     = sat::posLit(solver.newVar());
+            solver.addClause({~differ, lhs_output, rhs_output});
+            solver.addClause({~differ, ~lhs_output, ~rhs_output});
+            sat::SolveResult const result = solver.solve({differ}, conflict_limit_);
+
+            // Only this thread writes verdict of this output.
+            OutputVerdict& verdict = report.outputs[index];
+            if (result == sat::SolveResult::UNSAT)
+            {
+                verdict.status = OutputStatus::EQUIVALENT;
+            }
+            else if (result == sat::SolveResult::SAT)
+            {
+                verdict.status = OutputStatus::DIFFERENT;
+                for (Input_ const& input : inputs)
+                {
+                    bool const value = input.lhs != NoGate ? lhs_tseitin.getModelValue(input.lhs)
+                                                           : rhs_tseitin.getModelValue(input.rhs);
+                    verdict.counterexample.emplace_back(input.name, value);
+                }
+            }
+            solver.addClause({~differ});
+            verdict.milliseconds =
+                std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        }
+    }
+};
+
+}  // namespace cirbo::verification
+
+#endif  // CIRBO_SEARCH_VERIFICATION_EQUIVALENCE_CHECKER_HPP
@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+#include "circuits_db/circuit_database.hpp"
+#include "circuits_db/database_builder.hpp"
+#include "core/npn.hpp"
+
+using namespace cirbo;
+using namespace cirbo::circuits_db;
+
+namespace
+{
+
+std::string getTemporaryPath(std::string const& name)
+{
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/* x0 & x1 */
+DatabaseCircuit makeAnd()
+{
+    return {
+        .inputs = 2,
+        .output = 2,
+        .gates  = {{GateType::AND, 2, {0, 1, 0}}}
+    };
+}
+
+/* MAJ(x0, x1, x2) in XAG basis: ((x0 ^ x1) & (x1 ^ x2)) ^ x1. */
+DatabaseCircuit makeMajority()
+{
+    return {
+        .inputs = 3,
+        .output = 6,
+        .gates  = {{GateType::XOR, 2, {0, 1, 0}},
+                   {GateType::XOR, 2, {1, 2, 0}},
+                   {GateType::AND, 2, {3, 4, 0}},
+                   {GateType::XOR, 2, {5, 1, 0}}}
+    };
+}
+
+}  // namespace
+
+TEST_CASE("CircuitDatabase TruthTable", "[circuits_db]")
+{
+    uint64_t const x0 = npn::VariableMasks[0];
+    uint64_t const x1 = npn::VariableMasks[1];
+    uint64_t const x2 = npn::VariableMasks[2];
+    CHECK(makeAnd().computeTruthTable() == ((x0 & x1) & npn::getTruthMask(2)));
+    CHECK(makeMajority().computeTruthTable() == (((x0 & x1) | (x0 & x2) | (x1 & x2)) & npn::getTruthMask(3)));
+}
+
+TEST_CASE("CircuitDatabase WriteAndLookup", "[circuits_db]")
+{
+    DatabaseBuilder builder;
+    CHECK(builder.add(Basis::AIG, makeAnd()));
+    CHECK(builder.add(Basis::XAG, makeAnd()));
+    CHECK(builder.add(Basis::XAG, makeMajority()));
+
+    // Larger circuit of the same function is rejected.
+    DatabaseCircuit larger = makeAnd();
+    larger.gates.push_back({GateType::AND, 2, {2, 2, 0}});
+    larger.output = 3;
+    CHECK(!builder.add(Basis::XAG, larger));
+    CHECK(builder.getNumberOfCircuits() == 3);
+
+    std::string const path = getTemporaryPath("cirbo_circuit_database_test.db");
+    builder.writeFile(path);
+    {
+        CircuitDatabase const database(path);
+        CHECK(database.hasBasis(Basis::AIG));
+        CHECK(database.hasBasis(Basis::XAG));
+        CHECK(!database.hasBasis(Basis::BENCH));
+        CHECK(database.getNumberOfCircuits(Basis::XAG) == 2);
+
+        uint64_t const majority = makeMajority().computeTruthTable();
+        auto const view         = database.find(Basis::XAG, majority, 3);
+        REQUIRE(view.has_value());
+        CHECK(view->getNumberOfInputs() == 3);
+        CHECK(view->getNumberOfGates() == 4);
+        CHECK(view->toCircuit() == makeMajority());
+
+        CHECK(!database.find(Basis::AIG, majority, 3).has_value());
+        CHECK(!database.find(Basis::XAG, majority, 4).has_value());
+        CHECK(!database.find(Basis::BENCH, majority, 3).has_value());
+
+        DatabaseBuilder restored;
+        restored.merge(database);
+        CHECK(restored.getNumberOfCircuits() == 3);
+        REQUIRE(restored.find(Basis::AIG, makeAnd().computeTruthTable(), 2) != nullptr);
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("CircuitDatabase ManyCircuits", "[circuits_db]")
+{
+    // All 2-input functions of a single gate and of its negation.
+    DatabaseBuilder builder;
+    for (GateType const type : {GateType::AND, GateType::OR, GateType::XOR, GateType::NAND, GateType::NOR})
+    {
+        for (uint8_t const lhs : {0, 1})
+        {
+            DatabaseCircuit circuit{
+                .inputs = 2,
+                .output = 3,
+                .gates  = {{GateType::NOT, 1, {lhs, 0, 0}}, {type, 2, {2, static_cast<uint8_t>(1 - lhs), 0}}}
+            };
+            builder.add(Basis::BENCH, circuit);
+        }
+    }
+    std::string const path = getTemporaryPath("cirbo_circuit_database_many_test.db");
+    builder.writeFile(path);
+    {
+        CircuitDatabase const database(path);
+        CHECK(database.getNumberOfCircuits(Basis::BENCH) == builder.getNumberOfCircuits());
+        size_t visited = 0;
+        database.forEachCircuit(
+            Basis::BENCH,
+            [&](CircuitView const& view)
+            {
+                DatabaseCircuit const circuit = view.toCircuit();
+                auto const found = database.find(Basis::BENCH, circuit.computeTruthTable(), circuit.inputs);
+                REQUIRE(found.has_value());
+                CHECK(found->toCircuit() == circuit);
+                ++visited;
+            });
+        CHECK(visited == builder.getNumberOfCircuits());
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("CircuitDatabase RejectsMalformedFile", "[circuits_db]")
+{
+    std::string const path = getTemporaryPath("cirbo_circuit_database_malformed_test.db");
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "definitely not a database";
+    }
+    CHECK_THROWS_AS(CircuitDatabase(path), std::runtime_error);
+    std::filesystem::remove(path);
+    CHECK_THROWS_AS(CircuitDatabase(path), std::runtime_error);
+
+    DatabaseCircuit invalid = makeAnd();
+    invalid.gates.front().operands[0] = 5;
+    CHECK_THROWS_AS(DatabaseBuilder().add(Basis::AIG, invalid), std::invalid_argument);
+}
+
+TEST_CASE("CircuitDatabase RejectsMalformedRecord", "[circuits_db]")
+{
+    DatabaseBuilder builder;
+    CHECK(builder.add(Basis::AIG, makeAnd()));
+    std::string const path = getTemporaryPath("cirbo_circuit_database_malformed_record_test.db");
+    builder.writeFile(path);
+    {
+        // The only record starts records, its gate refers to itself by the first operand.
+        std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+        uint64_t records_offset = 0;
+        file.seekg(impl::FileHeaderSize + 24);
+        file.read(reinterpret_cast<char*>(&records_offset), sizeof(records_offset));
+        file.seekp(static_cast<std::streamoff>(records_offset + impl::RecordHeaderSize + 2));
+        file.put(2);
+    }
+    {
+        CircuitDatabase const database(path);
+        CHECK_THROWS_AS(database.find(Basis::AIG, makeAnd().computeTruthTable(), 2), std::runtime_error);
+        CHECK_THROWS_AS(database.forEachCircuit(Basis::AIG, [](CircuitView const&) {}), std::runtime_error);
+    }
+    std::filesystem::remove(path);
+}
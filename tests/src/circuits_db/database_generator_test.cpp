@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "circuits_db/circuit_database.hpp"
+#include "circuits_db/database_generator.hpp"
+#include "synthesis/exact_synthesis.hpp"
+
+using namespace cirbo;
+using namespace cirbo::circuits_db;
+
+TEST_CASE("DatabaseGenerator NpnClasses", "[database_generator]")
+{
+    // Numbers of NPN classes of functions of 0, 1, 2 and 3 inputs are 1, 2, 4 and 14.
+    CHECK(DatabaseGenerator::enumerateNpnClasses(0).size() == 1);
+    CHECK(DatabaseGenerator::enumerateNpnClasses(2).size() == 1 + 2 + 4);
+    CHECK(DatabaseGenerator::enumerateNpnClasses(3).size() == 1 + 2 + 4 + 14);
+}
+
+TEST_CASE("DatabaseGenerator GenerateAndResume", "[database_generator]")
+{
+    std::string const path = (std::filesystem::temp_directory_path() / "cirbo_database_generator_test.db").string();
+    std::filesystem::remove(path);
+    auto const tasks = DatabaseGenerator::enumerateNpnClasses(3);
+
+    // Half of the job, then the whole job, which must reuse results of the first run.
+    DatabaseGenerator const generator(synthesis::ExactSynthesizer(Basis::XAG), 2, std::chrono::milliseconds(0));
+    std::vector<GenerationTask> const half(tasks.begin(), tasks.begin() + static_cast<std::ptrdiff_t>(tasks.size() / 2));
+    GenerationStatistics const first = generator.run(half, path);
+    CHECK(first.solved == half.size());
+    CHECK(first.failed == 0);
+    CHECK(first.checkpoints == first.solved);
+
+    GenerationStatistics const second = generator.run(tasks, path);
+    CHECK(second.skipped == first.solved);
+    CHECK(second.solved == tasks.size() - first.solved);
+
+    {
+        CircuitDatabase const database(path);
+        CHECK(database.getNumberOfCircuits(Basis::XAG) == tasks.size());
+        for (GenerationTask const& task : tasks)
+        {
+            auto const view = database.find(Basis::XAG, task.truth, task.inputs);
+            REQUIRE(view.has_value());
+            CHECK(view->toCircuit().computeTruthTable() == task.truth);
+        }
+    }
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("DatabaseGenerator ShardsAndMerge", "[database_generator]")
+{
+    std::string const path = (std::filesystem::temp_directory_path() / "cirbo_database_generator_shards.db").string();
+    std::vector<std::string> const shards = {
+        DatabaseGenerator::getShardPath(path, 0, 2), DatabaseGenerator::getShardPath(path, 1, 2)};
+    for (std::string const& file : {path, shards.at(0), shards.at(1)})
+    {
+        std::filesystem::remove(file);
+    }
+    auto const tasks = DatabaseGenerator::enumerateNpnClasses(3);
+    CHECK(DatabaseGenerator::getShardPath(path, 0, 1) == path);
+    CHECK(shards.at(0) != shards.at(1));
+
+    // Shards share output path, but write own files, so neither overwrites the other.
+    DatabaseGenerator const generator(synthesis::ExactSynthesizer(Basis::XAG), 2, std::chrono::milliseconds(0));
+    GenerationStatistics const first  = generator.run(tasks, path, 0, 2);
+    GenerationStatistics const second = generator.run(tasks, path, 1, 2);
+    CHECK(first.solved == (tasks.size() + 1) / 2);
+    CHECK(second.solved == tasks.size() / 2);
+    CHECK_FALSE(std::filesystem::exists(path));
+
+    CHECK(DatabaseGenerator::merge(shards, path) == tasks.size());
+    GenerationStatistics const all = generator.run(tasks, path);
+    CHECK(all.skipped == tasks.size());
+    CHECK(all.solved == 0);
+
+    for (std::string const& file : {path, shards.at(0), shards.at(1)})
+    {
+        std::filesystem::remove(file);
+    }
+}
@@ -0,0 +1,48 @@
+#include "core/cost_model.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+
+TEST_CASE("CostModel NamedModels", "[cost_model]")
+{
+    auto dag = cirbo::DAG(
+        {
+            {cirbo::GateType::INPUT, {}       },
+            {cirbo::GateType::INPUT, {}       },
+            {cirbo::GateType::INPUT, {}       },
+            {cirbo::GateType::XOR,   {0, 1, 2}},
+            {cirbo::GateType::AND,   {0, 3}   },
+            {cirbo::GateType::NOT,   {4}      }
+    },
+        {5});
+
+    REQUIRE(cirbo::CostModel::gateCount().getCircuitCost(dag) == 6);
+    REQUIRE(cirbo::CostModel::binaryGateCount().getCircuitCost(dag) == 7);
+    REQUIRE(cirbo::CostModel::multiplicativeComplexity().getCircuitCost(dag) == 1);
+}
+
+TEST_CASE("CostModel Parse", "[cost_model]")
+{
+    cirbo::CostModel const model = cirbo::CostModel::parse("binary/XOR:0/MUX:3:2/INPUT:0");
+
+    REQUIRE(model.getGateCost(cirbo::GateType::INPUT, 0) == 0);
+    REQUIRE(model.getGateCost(cirbo::GateType::XOR, 5) == 0);
+    REQUIRE(model.getGateCost(cirbo::GateType::MUX, 3) == 5);
+    REQUIRE(model.getGateCost(cirbo::GateType::AND, 4) == 3);
+    REQUIRE(model.getGateCost(cirbo::GateType::NOT, 1) == 1);
+
+    // Named model replaces all weights, given before it.
+    REQUIRE(cirbo::CostModel::parse("XOR:0/mc").getGateCost(cirbo::GateType::XOR, 2) == 0);
+    REQUIRE(cirbo::CostModel::parse("XOR:5/mc").getGateCost(cirbo::GateType::AND, 2) == 1);
+    REQUIRE(cirbo::CostModel::parse("gates").getGateCost(cirbo::GateType::OR, 8) == 1);
+
+    CHECK_THROWS_AS(cirbo::CostModel::parse(""), std::invalid_argument);
+    CHECK_THROWS_AS(cirbo::CostModel::parse("area"), std::invalid_argument);
+    CHECK_THROWS_AS(cirbo::CostModel::parse("gates/"), std::invalid_argument);
+    CHECK_THROWS_AS(cirbo::CostModel::parse("FOO:1"), std::invalid_argument);
+    CHECK_THROWS_AS(cirbo::CostModel::parse("AND:-1"), std::invalid_argument);
+    CHECK_THROWS_AS(cirbo::CostModel::parse("AND:1:"), std::invalid_argument);
+}
@@ -0,0 +1,171 @@
+#include <catch2/catch_test_macros.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "core/cut_enumeration.hpp"
+#include "core/simulation.hpp"
+#include "core/structures/dag.hpp"
+
+using namespace cirbo;
+
+namespace
+{
+
+/* Checks, that truth tables of all cuts agree with values of gates on all simulated patterns. */
+void checkCutFunctions(DAG const& dag, CutEnumeration const& cuts)
+{
+    std::mt19937_64 engine(42);
+    Simulation simulation(dag, 4);
+    simulation.randomizeInputs(dag, engine);
+    simulation.run(dag);
+
+    for (GateId gateId = 0; gateId < dag.getNumberOfGates(); ++gateId)
+    {
+        for (Cut const& cut : cuts.getCuts(gateId))
+        {
+            bool agrees = true;
+            for (size_t pattern = 0; pattern < simulation.getNumberOfPatterns(); ++pattern)
+            {
+                size_t assignment = 0;
+                for (size_t i = 0; i < cut.size; ++i)
+                {
+                    assignment |= static_cast<size_t>(simulation.getValue(cut.leaves[i], pattern)) << i;
+                }
+                agrees &= cut.getValue(assignment) == simulation.getValue(gateId, pattern);
+            }
+            CHECK(agrees);
+        }
+    }
+}
+
+/* Random circuit of binary and ternary gates of all supported types. */
+DAG makeRandomCircuit(size_t inputs, size_t gates, uint64_t seed)
+{
+    std::mt19937_64 engine(seed);
+    GateInfoContainer info(inputs, {GateType::INPUT, {}});
+    constexpr std::array types{
+        GateType::AND,
+        GateType::NAND,
+        GateType::OR,
+        GateType::NOR,
+        GateType::XOR,
+        GateType::NXOR,
+        GateType::NOT,
+        GateType::MUX};
+    for (size_t i = 0; i < gates; ++i)
+    {
+        GateType const type = types.at(engine() % types.size());
+        size_t const arity  = type == GateType::NOT ? 1 : (type == GateType::MUX ? 3 : 2 + (engine() % 2));
+        GateIdContainer operands;
+        for (size_t j = 0; j < arity; ++j)
+        {
+            operands.push_back(engine() % info.size());
+        }
+        info.emplace_back(type, operands);
+    }
+    return {info, {info.size() - 1, info.size() - 2}};
+}
+
+}  // namespace
+
+TEST_CASE("CutEnumeration SmallCircuit", "[cut_enumeration]")
+{
+    auto dag = DAG(
+        {
+            {GateType::INPUT, {}    },
+            {GateType::INPUT, {}    },
+            {GateType::INPUT, {}    },
+            {GateType::AND,   {0, 1}},
+            {GateType::XOR,   {3, 2}},
+            {GateType::NOT,   {4}   }
+    },
+        {5});
+
+    CutEnumeration const cuts(dag, 3, 8);
+    CHECK(cuts.getCuts(0).size() == 1);
+    CHECK(cuts.getCuts(3).size() == 2);
+
+    // Cut {0, 1, 2} of the output computes NOT((x0 & x1) ^ x2).
+    bool found = false;
+    for (Cut const& cut : cuts.getCuts(5))
+    {
+        if (cut.size == 3 && cut.leaves[0] == 0 && cut.leaves[1] == 1 && cut.leaves[2] == 2)
+        {
+            found = true;
+            for (size_t assignment = 0; assignment < 8; ++assignment)
+            {
+                bool const x0 = (assignment & 1U) != 0;
+                bool const x1 = (assignment & 2U) != 0;
+                bool const x2 = (assignment & 4U) != 0;
+                CHECK(cut.getValue(assignment) == !((x0 && x1) != x2));
+            }
+        }
+    }
+    CHECK(found);
+    checkCutFunctions(dag, cuts);
+}
+
+TEST_CASE("CutEnumeration Constants", "[cut_enumeration]")
+{
+    auto dag = DAG(
+        {
+            {GateType::INPUT,      {}    },
+            {GateType::CONST_TRUE, {}    },
+            {GateType::AND,        {0, 1}},
+            {GateType::NAND,       {1, 1}}
+    },
+        {2, 3});
+
+    CutEnumeration const cuts(dag);
+    checkCutFunctions(dag, cuts);
+    // NAND of constants is constant, so it has a cut without leaves.
+    CHECK(cuts.getCuts(3)[1].size == 0);
+    CHECK(!cuts.getCuts(3)[1].getValue(0));
+}
+
+TEST_CASE("CutEnumeration RandomCircuits", "[cut_enumeration]")
+{
+    for (size_t const cut_size : {2, 4, 6, 8})
+    {
+        DAG const dag = makeRandomCircuit(10, 200, cut_size);
+        CutEnumeration const cuts(dag, cut_size, 6);
+        checkCutFunctions(dag, cuts);
+
+        for (GateId gateId = 0; gateId < dag.getNumberOfGates(); ++gateId)
+        {
+            auto const gate_cuts = cuts.getCuts(gateId);
+            REQUIRE(gate_cuts.size() <= 7);
+            for (size_t i = 1; i < gate_cuts.size(); ++i)
+            {
+                CHECK(gate_cuts[i].size <= cut_size);
+                // Priority cuts are not dominated by each other.
+                for (size_t j = 1; j < gate_cuts.size(); ++j)
+                {
+                    CHECK((i == j || !gate_cuts[i].dominates(gate_cuts[j])));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("CutEnumeration ParallelMatchesSequential", "[cut_enumeration]")
+{
+    DAG const dag = makeRandomCircuit(64, 2000, 7);
+    CutEnumeration const sequential(dag, 5, 8, 1);
+    CutEnumeration const parallel(dag, 5, 8, 4);
+
+    REQUIRE(sequential.getNumberOfCuts() == parallel.getNumberOfCuts());
+    for (GateId gateId = 0; gateId < dag.getNumberOfGates(); ++gateId)
+    {
+        auto const lhs = sequential.getCuts(gateId);
+        auto const rhs = parallel.getCuts(gateId);
+        REQUIRE(lhs.size() == rhs.size());
+        for (size_t i = 0; i < lhs.size(); ++i)
+        {
+            CHECK(lhs[i].leaves == rhs[i].leaves);
+            CHECK(lhs[i].truth == rhs[i].truth);
+        }
+    }
+}
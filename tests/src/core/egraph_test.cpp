@@ -0,0 +1,53 @@
+#include "core/egraph.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/types.hpp"
+
+TEST_CASE("EGraph HashConsing", "[egraph]")
+{
+    cirbo::EGraph egraph;
+    cirbo::EClassId const a = egraph.add({cirbo::GateType::INPUT, {}, 0});
+    cirbo::EClassId const b = egraph.add({cirbo::GateType::INPUT, {}, 1});
+
+    REQUIRE(a != b);
+    REQUIRE(egraph.add({cirbo::GateType::INPUT, {}, 0}) == a);
+
+    // Operands of symmetric operators are unordered.
+    cirbo::EClassId const conjunction = egraph.add({cirbo::GateType::AND, {a, b}});
+    REQUIRE(egraph.add({cirbo::GateType::AND, {b, a}}) == conjunction);
+    REQUIRE(egraph.add({cirbo::GateType::MUX, {a, a, b}}) != egraph.add({cirbo::GateType::MUX, {a, b, a}}));
+
+    REQUIRE(egraph.getNumberOfClasses() == 5);
+    REQUIRE(egraph.getNumberOfNodes() == 5);
+}
+
+TEST_CASE("EGraph Congruence", "[egraph]")
+{
+    cirbo::EGraph egraph;
+    cirbo::EClassId const a   = egraph.add({cirbo::GateType::INPUT, {}, 0});
+    cirbo::EClassId const b   = egraph.add({cirbo::GateType::INPUT, {}, 1});
+    cirbo::EClassId const c   = egraph.add({cirbo::GateType::INPUT, {}, 2});
+    cirbo::EClassId const f_a = egraph.add({cirbo::GateType::NOT, {a}});
+    cirbo::EClassId const f_b = egraph.add({cirbo::GateType::NOT, {b}});
+    cirbo::EClassId const g_a = egraph.add({cirbo::GateType::AND, {f_a, c}});
+    cirbo::EClassId const g_b = egraph.add({cirbo::GateType::AND, {c, f_b}});
+
+    REQUIRE(egraph.merge(a, b));
+    REQUIRE_FALSE(egraph.merge(b, a));
+    REQUIRE_FALSE(egraph.isClean());
+    egraph.rebuild();
+
+    // Equality of operands is propagated to users transitively.
+    REQUIRE(egraph.isClean());
+    REQUIRE(egraph.find(f_a) == egraph.find(f_b));
+    REQUIRE(egraph.find(g_a) == egraph.find(g_b));
+    REQUIRE(egraph.getNodes(f_a).size() == 1);
+    REQUIRE(egraph.getNodes(a).size() == 2);
+    REQUIRE(egraph.getNumberOfClasses() == 4);
+    REQUIRE(egraph.getNumberOfNodes() == 5);
+    REQUIRE(egraph.getClasses().size() == 4);
+
+    // Hash-consing uses canonical operands after rebuild.
+    REQUIRE(egraph.add({cirbo::GateType::NOT, {b}}) == egraph.find(f_a));
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "core/npn.hpp"
+
+using namespace cirbo;
+
+namespace
+{
+
+/* Random NPN transform of `variables` variables. */
+npn::Transform makeRandomTransform(size_t variables, std::mt19937_64& engine)
+{
+    npn::Transform transform;
+    std::shuffle(
+        transform.permutation.begin(), transform.permutation.begin() + static_cast<std::ptrdiff_t>(variables), engine);
+    transform.phase          = static_cast<uint8_t>(engine() & ((1U << variables) - 1));
+    transform.output_negated = (engine() & 1U) != 0;
+    return transform;
+}
+
+}  // namespace
+
+TEST_CASE("Npn VariableOperations", "[npn]")
+{
+    uint64_t const x0 = npn::VariableMasks[0];
+    uint64_t const x1 = npn::VariableMasks[1];
+    uint64_t const x5 = npn::VariableMasks[5];
+
+    CHECK(npn::flipVariable(x0, 0) == ~x0);
+    CHECK(npn::flipVariable(x0 & x1, 1) == (x0 & ~x1));
+    CHECK(npn::flipVariable(x5, 5) == ~x5);
+    for (size_t i = 0; i + 1 < npn::MaxVariables; ++i)
+    {
+        uint64_t const xi   = npn::VariableMasks[i];
+        uint64_t const next = npn::VariableMasks[i + 1];
+        CHECK(npn::swapAdjacentVariables(xi, i) == next);
+        CHECK(npn::swapAdjacentVariables(xi & ~next, i) == (next & ~xi));
+    }
+}
+
+TEST_CASE("Npn ExhaustiveClassCounts", "[npn]")
+{
+    // Numbers of NPN classes of functions of 2, 3 and 4 variables.
+    std::vector<std::pair<size_t, size_t>> const expected{
+        {2, 4  },
+        {3, 14 },
+        {4, 222}
+    };
+    for (auto const& [variables, classes] : expected)
+    {
+        std::set<uint64_t> representatives;
+        for (uint64_t truth = 0; truth < (uint64_t{1} << (size_t{1} << variables)); ++truth)
+        {
+            npn::CanonicalForm const form = npn::canonize(truth, variables);
+            REQUIRE(npn::applyTransform(truth, variables, form.transform) == form.truth);
+            REQUIRE(npn::restoreFunction(form.truth, variables, form.transform) == truth);
+            representatives.insert(form.truth);
+        }
+        CHECK(representatives.size() == classes);
+    }
+}
+
+TEST_CASE("Npn HeuristicTransformIsExact", "[npn]")
+{
+    std::mt19937_64 engine(17);
+    for (size_t const variables : {5, 6})
+    {
+        for (size_t i = 0; i < 2000; ++i)
+        {
+            uint64_t const truth          = engine() & npn::getTruthMask(variables);
+            npn::CanonicalForm const form = npn::canonize(truth, variables);
+            CHECK(npn::applyTransform(truth, variables, form.transform) == form.truth);
+            CHECK(npn::restoreFunction(form.truth, variables, form.transform) == truth);
+        }
+    }
+}
+
+TEST_CASE("Npn HeuristicIsInvariantForDistinctWeights", "[npn]")
+{
+    // Cofactor weights of all variables differ, so transformed copies share representative.
+    uint64_t const x0    = npn::VariableMasks[0];
+    uint64_t const x1    = npn::VariableMasks[1];
+    uint64_t const x2    = npn::VariableMasks[2];
+    uint64_t const x3    = npn::VariableMasks[3];
+    uint64_t const x4    = npn::VariableMasks[4];
+    uint64_t const x5    = npn::VariableMasks[5];
+    uint64_t const truth = (x0 & x1 & x2 & x3 & x4) | (x1 & x2 & x3 & x4 & x5) | (x2 & x3 & x4 & ~x0) | (x3 & x4 & x5)
+                         | (x4 & ~x1 & ~x2);
+
+    std::mt19937_64 engine(3);
+    uint64_t const canonical = npn::canonize(truth, 6).truth;
+    for (size_t i = 0; i < 200; ++i)
+    {
+        uint64_t const transformed = npn::applyTransform(truth, 6, makeRandomTransform(6, engine));
+        CHECK(npn::canonize(transformed, 6).truth == canonical);
+    }
+}
+
+TEST_CASE("Npn Benchmark", "[.][benchmark][npn]")
+{
+    std::mt19937_64 engine(1);
+    for (size_t variables = 2; variables <= npn::MaxVariables; ++variables)
+    {
+        std::vector<uint64_t> functions(100000);
+        std::ranges::generate(functions, [&engine, variables] { return engine() & npn::getTruthMask(variables); });
+
+        auto const start  = std::chrono::steady_clock::now();
+        uint64_t checksum = 0;
+        for (uint64_t const truth : functions)
+        {
+            checksum ^= npn::canonize(truth, variables).truth;
+        }
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << variables << " variables: " << static_cast<double>(functions.size()) / elapsed.count()
+                  << " canonizations per second (checksum " << checksum << ")\n";
+    }
+}
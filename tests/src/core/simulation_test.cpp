@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include <random>
+
+#include "core/simulation.hpp"
+#include "core/structures/dag.hpp"
+
+using namespace cirbo;
+
+TEST_CASE("Simulation AllGateTypes", "[simulation]")
+{
+    auto dag = DAG(
+        {
+            {GateType::INPUT,       {}       },
+            {GateType::INPUT,       {}       },
+            {GateType::INPUT,       {}       },
+            {GateType::AND,         {0, 1, 2}},
+            {GateType::NOR,         {0, 1}   },
+            {GateType::XOR,         {0, 1, 2}},
+            {GateType::NOT,         {3}      },
+            {GateType::MUX,         {0, 1, 2}},
+            {GateType::CONST_TRUE,  {}       },
+            {GateType::NXOR,        {5, 8}   }
+    },
+        {6, 7, 9});
+
+    Simulation simulation(dag, 1);
+    // Patterns 0..7 enumerate all assignments of three inputs.
+    for (size_t pattern = 0; pattern < 8; ++pattern)
+    {
+        for (GateId input = 0; input < 3; ++input)
+        {
+            simulation.setInputValue(input, pattern, ((pattern >> input) & 1U) != 0);
+        }
+    }
+    simulation.run(dag);
+
+    for (size_t pattern = 0; pattern < 8; ++pattern)
+    {
+        bool const x = (pattern & 1U) != 0;
+        bool const y = (pattern & 2U) != 0;
+        bool const z = (pattern & 4U) != 0;
+        REQUIRE(simulation.getValue(3, pattern) == (x && y && z));
+        REQUIRE(simulation.getValue(4, pattern) == !(x || y));
+        REQUIRE(simulation.getValue(5, pattern) == (x != y != z));
+        REQUIRE(simulation.getValue(6, pattern) == !(x && y && z));
+        REQUIRE(simulation.getValue(7, pattern) == (x ? z : y));
+        REQUIRE(simulation.getValue(8, pattern));
+        REQUIRE(simulation.getValue(9, pattern) == simulation.getValue(5, pattern));
+    }
+}
+
+TEST_CASE("Simulation RandomInputs", "[simulation]")
+{
+    auto dag = DAG(
+        {
+            {GateType::INPUT, {}    },
+            {GateType::INPUT, {}    },
+            {GateType::OR,    {0, 1}},
+            {GateType::NOT,   {0}   },
+            {GateType::NOT,   {1}   },
+            {GateType::NAND,  {3, 4}}
+    },
+        {2, 5});
+
+    std::mt19937 engine(42);
+    Simulation simulation(dag, 3);
+    simulation.randomizeInputs(dag, engine);
+    simulation.run(dag);
+
+    REQUIRE(simulation.getNumberOfPatterns() == 192);
+    for (size_t word = 0; word < simulation.getNumberOfWords(); ++word)
+    {
+        REQUIRE(simulation.getSignature(2)[word] == simulation.getSignature(5)[word]);
+    }
+}
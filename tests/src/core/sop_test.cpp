@@ -0,0 +1,107 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+#include "core/sop.hpp"
+
+using namespace cirbo;
+
+namespace
+{
+
+sop::TruthTable makeRandomTable(size_t variables, std::mt19937_64& engine)
+{
+    sop::TruthTable truth(sop::getWords(variables));
+    for (uint64_t& word : truth)
+    {
+        word = engine() & npn::getTruthMask(variables);
+    }
+    return truth;
+}
+
+}  // namespace
+
+TEST_CASE("Sop Cofactors", "[sop]")
+{
+    for (size_t const variables : {3, 8})
+    {
+        sop::TruthTable const x0 = sop::makeVariable(0, variables);
+        sop::TruthTable const x2 = sop::makeVariable(variables - 1, variables);
+        sop::TruthTable product  = x0;
+        for (size_t word = 0; word < product.size(); ++word)
+        {
+            product[word] &= x2[word];
+        }
+
+        CHECK(sop::dependsOn(product, 0));
+        CHECK(sop::dependsOn(product, variables - 1));
+        CHECK_FALSE(sop::dependsOn(product, 1));
+        CHECK(sop::cofactor(product, variables - 1, true) == x0);
+        CHECK(sop::cofactor(product, 0, false) == sop::makeConstant(false, variables));
+        CHECK(sop::negate(sop::negate(product, variables), variables) == product);
+    }
+}
+
+TEST_CASE("Sop IsopIsExact", "[sop]")
+{
+    std::mt19937_64 engine(7);
+    for (size_t variables = 0; variables <= 10; ++variables)
+    {
+        for (size_t iteration = 0; iteration < 20; ++iteration)
+        {
+            sop::TruthTable const truth = makeRandomTable(variables, engine);
+            sop::Cover const cover      = sop::computeIsop(truth, variables);
+            REQUIRE(sop::evaluate(cover, variables) == truth);
+
+            // Irredundant: no cube may be dropped.
+            for (size_t skipped = 0; skipped < cover.size(); ++skipped)
+            {
+                sop::Cover smaller = cover;
+                smaller.erase(smaller.begin() + static_cast<std::ptrdiff_t>(skipped));
+                CHECK(sop::evaluate(smaller, variables) != truth);
+            }
+        }
+    }
+}
+
+TEST_CASE("Sop IsopUsesDontCares", "[sop]")
+{
+    // x0 & x1 | x0 & !x1 & x2, where x0 & !x1 & !x2 is don't care, is just x0.
+    sop::TruthTable const x0 = sop::makeVariable(0, 3);
+    sop::TruthTable const x1 = sop::makeVariable(1, 3);
+    sop::TruthTable const x2 = sop::makeVariable(2, 3);
+    sop::TruthTable const lower{(x0[0] & x1[0]) | (x0[0] & ~x1[0] & x2[0])};
+
+    sop::Cover const cover = sop::computeIsop(lower, x0, 3);
+
+    REQUIRE(cover.size() == 1);
+    CHECK(cover.front() == sop::Cube{.mask = 0b001, .values = 0b001});
+    CHECK(sop::computeIsop(lower, 3).size() == 2);
+}
+
+TEST_CASE("Sop FactoringSharesLiterals", "[sop]")
+{
+    // x0 x1 + x0 x2 + x3 is x0 (x1 + x2) + x3.
+    sop::Cover const cover{{0b0011, 0b0011}, {0b0101, 0b0101}, {0b1000, 0b1000}};
+
+    sop::FactoredForm const form = sop::factor(cover, 4);
+
+    CHECK(form.countOperators() == 3);
+    CHECK(form.evaluate(4) == sop::evaluate(cover, 4));
+
+    std::mt19937_64 engine(42);
+    for (size_t variables = 0; variables <= 10; ++variables)
+    {
+        sop::TruthTable const truth = makeRandomTable(variables, engine);
+        sop::Cover const isop       = sop::computeIsop(truth, variables);
+        size_t literals             = 0;
+        for (sop::Cube const& cube : isop)
+        {
+            literals += static_cast<size_t>(std::popcount(cube.mask));
+        }
+        sop::FactoredForm const factored = sop::factor(isop, variables);
+        REQUIRE(factored.evaluate(variables) == truth);
+        CHECK(factored.countOperators() < std::max<size_t>(literals, 1));
+    }
+}
@@ -193,3 +193,22 @@ TEST_CASE("DAG CalculationManyOperands", "[dag]")
     REQUIRE(dag.getGateUsers(3) == cirbo::GateIdContainer({}));
     REQUIRE(dag.getGateUsers(4) == cirbo::GateIdContainer({}));
 }
+
+TEST_CASE("DAG MoveConstruction", "[dag]")
+{
+    auto dag = cirbo::DAG(
+        {
+            {cirbo::GateType::INPUT, {}    },
+            {cirbo::GateType::INPUT, {}    },
+            {cirbo::GateType::AND,   {0, 1}}
+    },
+        {2});
+
+    auto moved = cirbo::DAG(std::move(dag));
+
+    REQUIRE(moved.getNumberOfGates() == 3);
+    REQUIRE(moved.getInputGates() == cirbo::GateIdContainer({0, 1}));
+    REQUIRE(moved.getOutputGates() == cirbo::GateIdContainer({2}));
+    REQUIRE(moved.getGateOperands(2) == cirbo::GateIdContainer({0, 1}));
+    REQUIRE(moved.getGateUsers(1) == cirbo::GateIdContainer({2}));
+}
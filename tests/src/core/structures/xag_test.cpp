@@ -0,0 +1,54 @@
+#include "core/structures/xag.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <stdexcept>
+
+#include "core/cost_model.hpp"
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+
+TEST_CASE("XAG SimpleConstruction", "[xag]")
+{
+    auto xag = cirbo::XAG(
+        {
+            {cirbo::GateType::INPUT, {}       },
+            {cirbo::GateType::INPUT, {}       },
+            {cirbo::GateType::INPUT, {}       },
+            {cirbo::GateType::AND,   {0, 1}   },
+            {cirbo::GateType::XOR,   {3, 2}   },
+            {cirbo::GateType::NOT,   {4}      },
+            {cirbo::GateType::AND,   {0, 1, 2}}
+    },
+        {5, 6});
+
+    REQUIRE(xag.getNumberOfGates() == 7);
+    REQUIRE(xag.getGateUsers(3) == cirbo::GateIdContainer({4}));
+    REQUIRE(xag.getMultiplicativeComplexity() == 3);
+    REQUIRE(cirbo::CostModel::multiplicativeComplexity().getCircuitCost(xag) == 3);
+    REQUIRE(cirbo::CostModel::gateCount().getCircuitCost(xag) == xag.getNumberOfGates());
+}
+
+TEST_CASE("XAG RejectsOtherGates", "[xag]")
+{
+    auto dag = cirbo::DAG(
+        {
+            {cirbo::GateType::INPUT, {}    },
+            {cirbo::GateType::INPUT, {}    },
+            {cirbo::GateType::OR,    {0, 1}}
+    },
+        {2});
+
+    REQUIRE_THROWS_AS(cirbo::XAG(dag), std::invalid_argument);
+    REQUIRE(cirbo::CostModel::multiplicativeComplexity().getCircuitCost(dag) == 1);
+}
+
+TEST_CASE("CostModel Weights", "[xag]")
+{
+    cirbo::CostModel model;
+    model.setWeight(cirbo::GateType::XOR, 2, 1).setWeight(cirbo::GateType::NOT, 0);
+
+    REQUIRE(model.getGateCost(cirbo::GateType::AND, 5) == 1);
+    REQUIRE(model.getGateCost(cirbo::GateType::XOR, 2) == 2);
+    REQUIRE(model.getGateCost(cirbo::GateType::XOR, 4) == 4);
+    REQUIRE(model.getGateCost(cirbo::GateType::NOT, 1) == 0);
+}
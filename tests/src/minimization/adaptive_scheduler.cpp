@@ -0,0 +1,117 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/adaptive_scheduler.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+std::string const dag =
+    "INPUT(0)\n"
+    "INPUT(1)\n"
+    "INPUT(2)\n"
+    "OUTPUT(9)\n"
+    "3 = NOT(0)\n"
+    "4 = NOT(3)\n"
+    "5 = AND(4, 0)\n"
+    "6 = AND(0, 4)\n"
+    "7 = OR(5, 6, 1)\n"
+    "8 = OR(1, 2, 2)\n"
+    "9 = AND(7, 8)\n";
+
+}  // namespace
+
+TEST_CASE("AdaptiveScheduler ReducesAndStopsWhenStale", "[adaptive_scheduler]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto statistics = std::make_shared<SchedulerStatistics>();
+    // Budget is big enough to never be exhausted, so scheduler must stop because passes became stale.
+    auto scheduler = makeAdaptiveScheduler(std::chrono::minutes(10), statistics);
+
+    auto [result, _] = scheduler->apply(*circuit, encoder);
+
+    auto [expected, expected_encoder] =
+        parsePipeline("fixpoint { default; ConstantGateReducer }")->apply(*circuit, encoder);
+    REQUIRE(result->getNumberOfGates() <= expected->getNumberOfGates());
+    REQUIRE(statistics->getArms().size() == getDefaultScheduledPasses().size());
+
+    size_t total_gain = 0;
+    for (auto const& arm : statistics->getArms())
+    {
+        REQUIRE(arm.pulls >= 1);
+        total_gain += arm.gain;
+    }
+    REQUIRE(total_gain == circuit->getNumberOfGates() - result->getNumberOfGates());
+}
+
+TEST_CASE("AdaptiveScheduler SharesStatistics", "[adaptive_scheduler]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto statistics = std::make_shared<SchedulerStatistics>();
+    auto first      = makeAdaptiveScheduler(std::chrono::minutes(10), statistics, {"DuplicateGatesCleaner"});
+    auto second     = makeAdaptiveScheduler(std::chrono::minutes(10), statistics, {"DuplicateGatesCleaner"});
+
+    auto [first_result, first_encoder]   = first->apply(*circuit, encoder);
+    size_t const pulls                   = statistics->getTotalPulls();
+    auto [second_result, second_encoder] = second->apply(*circuit, encoder);
+
+    REQUIRE(statistics->getArms().size() == 1);
+    REQUIRE(statistics->getTotalPulls() == 2 * pulls);
+    REQUIRE(second_result->getNumberOfGates() == first_result->getNumberOfGates());
+}
+
+TEST_CASE("AdaptiveScheduler RollsBackGrowth", "[adaptive_scheduler]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "INPUT(3)\n"
+        "OUTPUT(4)\n"
+        "4 = AND(0, 1, 2, 3)\n",
+        encoder);
+
+    auto statistics = std::make_shared<SchedulerStatistics>();
+    auto scheduler =
+        makeAdaptiveScheduler(std::chrono::minutes(10), statistics, {"DisconnectSymmetricalGates(arity=2, and)"});
+
+    auto [result, _] = scheduler->apply(*circuit, encoder);
+
+    REQUIRE(result->getNumberOfGates() == 5);
+    REQUIRE(result->getGateOperands(4).size() == 4);
+    REQUIRE(statistics->getArms().at(0).pulls == AdaptiveScheduler<DAG>::DefaultPatience);
+    REQUIRE(statistics->getArms().at(0).gain == 0);
+}
+
+TEST_CASE("AdaptiveScheduler ArmsOfPipeline", "[adaptive_scheduler]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto statistics = std::make_shared<SchedulerStatistics>();
+    auto scheduler  = makeAdaptiveScheduler(
+        std::chrono::minutes(10),
+        statistics,
+        parsePipeline("DuplicateGatesCleaner; fixpoint { ConstantGateReducer; DeMorgan }")->releaseTransformers());
+
+    auto [result, _] = scheduler->apply(*circuit, encoder);
+
+    REQUIRE(result->getNumberOfGates() <= circuit->getNumberOfGates());
+    REQUIRE(statistics->getArms().size() == 2);
+    REQUIRE(statistics->getArms().at(0).name == "DuplicateGatesCleaner");
+    REQUIRE(statistics->getArms().at(1).name == "fixpoint(16)");
+}
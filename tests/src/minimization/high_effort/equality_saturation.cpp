@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/cost_model.hpp"
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+/* Returns options of random circuits of NOT, AND, OR, XOR gates, their negations and constant. */
+RandomCircuitOptions getRandomCircuitOptions(size_t gates)
+{
+    return {
+        .inputs   = 8,
+        .gates    = gates,
+        .outputs  = 4,
+        .window   = 10,
+        .types    = {{"NOT", 1}, {"NOT", 1}, {"AND", 2}, {"NAND", 2}, {"OR", 2}, {"NOR", 2}, {"XOR", 2}, {"NXOR", 2}},
+        .constant = true};
+}
+
+}  // namespace
+
+
+TEST_CASE("EqualitySaturation NotAndDeMorgan", "[equality_saturation]")
+{
+    utils::NameEncoder encoder;
+    // Neither of passes reduces circuit alone: DeMorgan needs NAND, merged by MergeNotWithOthers,
+    // and then NOT gates of inputs must be reduced by ReduceNotComposition.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(5)\n"
+        "2 = NOT(0)\n"
+        "3 = NOT(1)\n"
+        "4 = AND(2, 3)\n"
+        "5 = NOT(4)\n",
+        encoder);
+
+    auto [result, result_encoder] = Composition<DAG, EqualitySaturation<DAG> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == 3);
+    GateId const output = result->getOutputGates().at(0);
+    REQUIRE(result->getGateType(output) == GateType::OR);
+    REQUIRE(result->getGateOperands(output).size() == 2);
+}
+
+TEST_CASE("EqualitySaturation FoldsConstants", "[equality_saturation]")
+{
+    utils::NameEncoder encoder;
+    // 5 = NOT(XOR(0, 1, 1)) = XOR(0, 1).
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(6)\n"
+        "OUTPUT(7)\n"
+        "2 = CONST(1)\n"
+        "3 = AND(0, 2)\n"
+        "4 = XOR(3, 2, 1)\n"
+        "5 = NOT(4)\n"
+        "6 = MUX(2, 1, 5)\n"
+        "7 = NOR(5, 2)\n",
+        encoder);
+
+    auto [result, result_encoder] = Composition<DAG, EqualitySaturation<DAG> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == 4);
+    GateId const output = result->getOutputGates().at(0);
+    REQUIRE(result->getGateType(output) == GateType::XOR);
+    REQUIRE(result->getGateType(result->getOutputGates().at(1)) == GateType::CONST_FALSE);
+}
+
+TEST_CASE("EqualitySaturation KeepsOptimalCircuits", "[equality_saturation]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "OUTPUT(4)\n"
+        "OUTPUT(5)\n"
+        "3 = NAND(0, 1)\n"
+        "4 = XOR(3, 2)\n"
+        "5 = NOT(3)\n",
+        encoder);
+
+    auto [result, result_encoder] = Composition<DAG, EqualitySaturation<DAG> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == circuit->getNumberOfGates());
+}
+
+TEST_CASE("EqualitySaturation RandomCircuits", "[equality_saturation]")
+{
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        utils::NameEncoder encoder;
+        auto circuit = parseCircuit(makeRandomCircuit(getRandomCircuitOptions(100), seed), encoder);
+        auto [cleaned, cleaned_encoder] = RedundantGatesCleaner<DAG>().apply(*circuit, encoder);
+
+        auto [result, result_encoder] = Composition<DAG, EqualitySaturation<DAG> >().apply(*cleaned, *cleaned_encoder);
+
+        REQUIRE(equivalentOnAllInputs(*cleaned, *cleaned_encoder, *result, *result_encoder));
+        REQUIRE(result->getNumberOfGates() <= cleaned->getNumberOfGates());
+    }
+}
+
+TEST_CASE("EqualitySaturation FromRegistry", "[equality_saturation]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(makeRandomCircuit(getRandomCircuitOptions(80), 42), encoder);
+    auto [cleaned, cleaned_encoder] = RedundantGatesCleaner<DAG>().apply(*circuit, encoder);
+
+    // NOT gates are free, so they are never worth keeping in place of NAND, NOR and NXOR.
+    auto [result, result_encoder] = parsePipeline("EqualitySaturation(iterations=4, growth=2, cost=gates/NOT:0)")
+                                        ->apply(*cleaned, *cleaned_encoder);
+
+    REQUIRE(equivalentOnAllInputs(*cleaned, *cleaned_encoder, *result, *result_encoder));
+    CostModel const model = CostModel::parse("gates/NOT:0");
+    REQUIRE(model.getCircuitCost(*result) <= model.getCircuitCost(*cleaned));
+
+    CHECK_THROWS_AS(parsePipeline("EqualitySaturation(iterations=-1)"), std::invalid_argument);
+    CHECK_THROWS_AS(parsePipeline("EqualitySaturation(growth=0)"), std::invalid_argument);
+    CHECK_THROWS_AS(parsePipeline("EqualitySaturation(cost=area)"), std::invalid_argument);
+}
+
+TEST_CASE("EqualitySaturation ConstantOutputs", "[equality_saturation]")
+{
+    utils::NameEncoder encoder;
+    // Output is folded to constant, and constant must be reduced.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(3)\n"
+        "2 = CONST(0)\n"
+        "3 = AND(0, 2, 1)\n",
+        encoder);
+
+    auto [result, result_encoder] = parsePipeline("EqualitySaturation; ConstantGateReducer")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE_FALSE(result->getInputGates().empty());
+}
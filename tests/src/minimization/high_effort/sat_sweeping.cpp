@@ -0,0 +1,134 @@
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+TEST_CASE("SatSweeping MergesEquivalentAndComplementGates", "[sat_sweeping]")
+{
+    utils::NameEncoder encoder;
+    // 4 and 5 are equal, 7 is complement of 3, but all are structurally different.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "OUTPUT(8)\n"
+        "OUTPUT(9)\n"
+        "3 = AND(0, 1)\n"
+        "4 = XOR(0, 1)\n"
+        "5 = OR(3, 4)\n"
+        "6 = OR(0, 1)\n"
+        "10 = NOT(0)\n"
+        "11 = NOT(1)\n"
+        "7 = OR(10, 11)\n"
+        "8 = AND(5, 2)\n"
+        "9 = AND(6, 7, 2)\n",
+        encoder);
+
+    auto [result, result_encoder] = SatSweeping<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() < circuit->getNumberOfGates());
+    // Gates 5 and 6 are merged, gate 7 became NOT(3).
+    REQUIRE(result->getNumberOfGates() == 9);
+}
+
+TEST_CASE("SatSweeping MergesConstants", "[sat_sweeping]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(6)\n"
+        "2 = XOR(0, 1)\n"
+        "3 = NXOR(0, 1)\n"
+        "4 = AND(2, 3)\n"
+        "5 = OR(4, 1)\n"
+        "6 = AND(5, 0)\n",
+        encoder);
+
+    auto [result, result_encoder] = SatSweeping<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == 3);
+    REQUIRE(result->getGateType(result->getOutputGates().at(0)) == GateType::AND);
+}
+
+TEST_CASE("SatSweeping KeepsDifferentGates", "[sat_sweeping]")
+{
+    utils::NameEncoder encoder;
+    // Gates differ only on one assignment of many inputs, so simulation rarely distinguishes them.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "INPUT(3)\n"
+        "INPUT(4)\n"
+        "INPUT(5)\n"
+        "INPUT(6)\n"
+        "INPUT(7)\n"
+        "INPUT(8)\n"
+        "INPUT(9)\n"
+        "OUTPUT(10)\n"
+        "OUTPUT(11)\n"
+        "10 = AND(0, 1, 2, 3, 4, 5, 6, 7, 8, 9)\n"
+        "11 = AND(0, 1, 2, 3, 4, 5, 6, 7, 8)\n",
+        encoder);
+
+    auto [result, result_encoder] = SatSweeping<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(result->getNumberOfGates() == circuit->getNumberOfGates());
+    REQUIRE(result->getOutputGates().at(0) != result->getOutputGates().at(1));
+}
+
+TEST_CASE("SatSweeping FromRegistry", "[sat_sweeping]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(4)\n"
+        "2 = NAND(0, 1)\n"
+        "3 = NOT(2)\n"
+        "5 = AND(1, 0)\n"
+        "4 = XOR(3, 5)\n",
+        encoder);
+
+    auto [result, result_encoder] =
+        parsePipeline("SatSweeping(words=1, conflict_limit=100)")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    // Output is proven to be constant and replaced by gadget of `ConstantGateReducer`.
+    REQUIRE(result->getNumberOfGates() == 3);
+}
+
+TEST_CASE("SatSweeping ConstantOutputs", "[sat_sweeping]")
+{
+    // Output is a tautology, so it is merged with constant, and constant must be reduced.
+    std::string const bench =
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(4)\n"
+        "2 = NOT(0)\n"
+        "3 = AND(0, 1)\n"
+        "4 = OR(3, 2, 0)\n";
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(bench, encoder);
+
+    auto [swept, swept_encoder]   = SatSweeping<DAG>().apply(*circuit, encoder);
+    auto [result, result_encoder] = ConstantGateReducer<DAG>().apply(*swept, *swept_encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE_FALSE(result->getInputGates().empty());
+
+    auto [piped, piped_encoder] = parsePipeline("SatSweeping; ConstantGateReducer")->apply(*circuit, encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *piped, *piped_encoder));
+}
@@ -0,0 +1,101 @@
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/pass_report.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+std::string const dag =
+    "INPUT(0)\n"
+    "INPUT(1)\n"
+    "OUTPUT(6)\n"
+    "2 = NOT(0)\n"
+    "3 = NOT(2)\n"
+    "4 = AND(3, 1)\n"
+    "5 = AND(0, 1)\n"
+    "6 = OR(4, 5)\n"
+    "7 = OR(0, 1)\n";
+
+}  // namespace
+
+TEST_CASE("Invariants ParsedCircuitHasNone", "[invariants]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    REQUIRE(circuit->getInvariants() == invariant::NONE);
+    REQUIRE(circuit->hasInvariants(invariant::NONE));
+    REQUIRE_FALSE(circuit->hasInvariants(invariant::NO_DANGLING));
+}
+
+TEST_CASE("Invariants EstablishedAndInvalidated", "[invariants]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto [cleaned, cleaned_encoder] = DuplicateGatesCleaner<DAG>().apply(*circuit, encoder);
+    REQUIRE(cleaned->getInvariants() == (invariant::NO_DANGLING | invariant::DEDUPLICATED));
+
+    auto [reduced, reduced_encoder] = ReduceNotComposition_<DAG>().apply(*cleaned, *cleaned_encoder);
+    REQUIRE(reduced->getInvariants() == invariant::NO_NOT_CHAINS);
+
+    auto [folded, folded_encoder] = ConstantGateReducer<DAG>().apply(*circuit, encoder);
+    REQUIRE(folded->hasInvariants(invariant::ALL));
+
+    // Passes without contract drop all invariants.
+    auto [merged, merged_encoder] = MergeNotWithOthers_<DAG>().apply(*folded, *folded_encoder);
+    REQUIRE(merged->getInvariants() == invariant::NONE);
+}
+
+TEST_CASE("Invariants SkipsPassWhosePostconditionHolds", "[invariants]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    PassReport::getInstance().clear();
+    PassReport::getInstance().setEnabled(true);
+    using Pipeline = Composition<
+        DAG,
+        RedundantGatesCleaner_<DAG>,
+        RedundantGatesCleaner_<DAG>,
+        DuplicateGatesCleaner_<DAG>,
+        RedundantGatesCleaner_<DAG>,
+        DuplicateGatesCleaner_<DAG> >;
+    auto [result, result_encoder] = Pipeline().apply(*circuit, encoder);
+    PassReport::getInstance().setEnabled(false);
+
+    auto const& passes = PassReport::getInstance().getRecords().at(0).children;
+    REQUIRE(passes.size() == 5);
+    REQUIRE(passes.at(0).rules.count("skipped") == 0);
+    REQUIRE(passes.at(1).rules.at("skipped") == 1);
+    REQUIRE(passes.at(2).rules.count("skipped") == 0);
+    REQUIRE(passes.at(3).rules.at("skipped") == 1);
+    REQUIRE(passes.at(4).rules.at("skipped") == 1);
+    PassReport::getInstance().clear();
+
+    REQUIRE(result->getNumberOfGates() == 7);
+    REQUIRE(result->hasInvariants(invariant::NO_DANGLING | invariant::DEDUPLICATED));
+}
+
+TEST_CASE("Invariants PreservedInputsEstablishNothing", "[invariants]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto [result, _] = Composition<DAG, RedundantGatesCleaner_<DAG, true>, RedundantGatesCleaner_<DAG> >().apply(
+        *circuit, encoder);
+
+    REQUIRE(result->getNumberOfGates() == 7);
+    REQUIRE(result->getInvariants() == invariant::NO_DANGLING);
+}
@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+TEST_CASE("CutRewriting Distributivity", "[cut_rewriting]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "OUTPUT(5)\n"
+        "3 = AND(0, 1)\n"
+        "4 = AND(0, 2)\n"
+        "5 = OR(3, 4)\n",
+        encoder);
+
+    auto [result, result_encoder] = CutRewriting<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == 5);
+}
+
+TEST_CASE("CutRewriting ReusesExistingGates", "[cut_rewriting]")
+{
+    utils::NameEncoder encoder;
+    // Output 7 is NOR(0, 1), which already exists as gate 4, so its whole cone is removed.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(4)\n"
+        "OUTPUT(7)\n"
+        "4 = NOR(0, 1)\n"
+        "2 = NOT(0)\n"
+        "3 = NOT(1)\n"
+        "7 = AND(2, 3)\n",
+        encoder);
+
+    auto [result, result_encoder] = CutRewriting<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == 3);
+    REQUIRE(result->getOutputGates().at(0) == result->getOutputGates().at(1));
+}
+
+TEST_CASE("CutRewriting RandomCircuits", "[cut_rewriting]")
+{
+    auto library = std::make_shared<RewritingLibrary>();
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        utils::NameEncoder encoder;
+        auto circuit =
+            parseCircuit(makeRandomCircuit({.inputs = 6, .gates = 120, .outputs = 4, .window = 8}, seed), encoder);
+        auto [cleaned, cleaned_encoder] = RedundantGatesCleaner<DAG>().apply(*circuit, encoder);
+
+        auto [rewritten, rewritten_encoder] = CutRewriting_<DAG>(library).apply(*cleaned, *cleaned_encoder);
+        auto [result, result_encoder]       = RedundantGatesCleaner<DAG>().apply(*rewritten, *rewritten_encoder);
+
+        REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+        REQUIRE(result->getNumberOfGates() <= cleaned->getNumberOfGates());
+    }
+}
+
+TEST_CASE("CutRewriting SharedLibrary", "[cut_rewriting]")
+{
+    auto const library = RewritingLibrary::getDefault(Basis::XAG);
+    REQUIRE(library == RewritingLibrary::getDefault(Basis::XAG));
+    REQUIRE(library != RewritingLibrary::getDefault(Basis::AIG));
+    REQUIRE(library->getBasis() == Basis::XAG);
+
+    // Threads look the same functions up concurrently, and get the same memoized circuits.
+    uint64_t const majority = 0xE8;
+    std::vector<circuits_db::DatabaseCircuit const*> circuits(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < circuits.size(); ++i)
+    {
+        threads.emplace_back(
+            [&library, &circuits, i]()
+            {
+                for (uint64_t truth = 0; truth < 16; ++truth)
+                {
+                    static_cast<void>(library->getCircuit(truth, 2));
+                }
+                circuits[i] = library->getCircuit(majority, 3);
+            });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    REQUIRE(circuits.front() != nullptr);
+    REQUIRE(circuits.front()->computeTruthTable() == majority);
+    for (auto const* circuit : circuits)
+    {
+        REQUIRE(circuit == circuits.front());
+    }
+}
+
+TEST_CASE("CutRewriting FromRegistry", "[cut_rewriting]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(makeRandomCircuit({.inputs = 6, .gates = 60, .outputs = 2, .window = 8}, 42), encoder);
+
+    auto [result, result_encoder] =
+        parsePipeline("fixpoint(4) { CutRewriting(cuts=4, basis=AIG) }")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() <= circuit->getNumberOfGates());
+
+    CHECK_THROWS_AS(parsePipeline("CutRewriting(cuts=0)"), std::invalid_argument);
+}
+
+TEST_CASE("CutRewriting ConstantOutputs", "[cut_rewriting]")
+{
+    // Output is a tautology, so it is rewritten to constant, and constant must be reduced.
+    std::string const bench =
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(4)\n"
+        "2 = NOT(0)\n"
+        "3 = AND(0, 1)\n"
+        "4 = OR(3, 2, 0)\n";
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(bench, encoder);
+
+    auto [rewritten, rewritten_encoder] = CutRewriting<DAG>().apply(*circuit, encoder);
+    auto [result, result_encoder]       = ConstantGateReducer<DAG>().apply(*rewritten, *rewritten_encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE_FALSE(result->getInputGates().empty());
+
+    auto [piped, piped_encoder] = parsePipeline("CutRewriting; ConstantGateReducer")->apply(*circuit, encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *piped, *piped_encoder));
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+TEST_CASE("DontCareOptimization UsesSatisfiabilityDontCares", "[dont_care_optimization]")
+{
+    utils::NameEncoder encoder;
+    // Window of z has leaves a and b, whose assignment a = 1, b = 0 is impossible, so z is false.
+    auto circuit = parseCircuit(
+        "INPUT(p)\n"
+        "INPUT(q)\n"
+        "OUTPUT(a)\n"
+        "OUTPUT(b)\n"
+        "OUTPUT(z)\n"
+        "a = AND(p, q)\n"
+        "b = OR(p, q)\n"
+        "nb = NOT(b)\n"
+        "z = AND(a, nb)\n",
+        encoder);
+
+    auto [optimized, optimized_encoder] = DontCareOptimization_<DAG>(2).apply(*circuit, encoder);
+    auto [result, result_encoder]       = RedundantGatesCleaner<DAG>().apply(*optimized, *optimized_encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGatesWithoutInputs() == 3);
+    CHECK(result->getGateType(result->getOutputGates().at(2)) == GateType::CONST_FALSE);
+}
+
+TEST_CASE("DontCareOptimization UsesObservabilityDontCares", "[dont_care_optimization]")
+{
+    utils::NameEncoder encoder;
+    // Gate h is observable only when x is true, where it is equal to c + d.
+    auto circuit = parseCircuit(
+        "INPUT(x)\n"
+        "INPUT(c)\n"
+        "INPUT(d)\n"
+        "OUTPUT(y)\n"
+        "xc = AND(x, c)\n"
+        "h = OR(xc, d)\n"
+        "y = AND(x, h)\n",
+        encoder);
+
+    auto [result, result_encoder] = DontCareOptimization<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGatesWithoutInputs() == 2);
+}
+
+TEST_CASE("DontCareOptimization RandomCircuits", "[dont_care_optimization]")
+{
+    size_t removed = 0;
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        utils::NameEncoder encoder;
+        auto circuit = parseCircuit(makeRandomCircuit({.inputs = 10, .gates = 150, .outputs = 4}, seed), encoder);
+        auto [cleaned, cleaned_encoder] = RedundantGatesCleaner<DAG>().apply(*circuit, encoder);
+
+        auto [result, result_encoder] = DontCareOptimization<DAG>().apply(*cleaned, *cleaned_encoder);
+
+        REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+        REQUIRE(result->getNumberOfGates() <= cleaned->getNumberOfGates());
+        removed += cleaned->getNumberOfGates() - result->getNumberOfGates();
+    }
+    CHECK(removed > 0);
+}
+
+TEST_CASE("DontCareOptimization FromRegistry", "[dont_care_optimization]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(makeRandomCircuit({.inputs = 8, .gates = 80, .outputs = 2}, 42), encoder);
+
+    auto [result, result_encoder] =
+        parsePipeline("fixpoint(4) { DontCareOptimization(inputs=6, levels=2, words=8) }")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() <= circuit->getNumberOfGates());
+
+    CHECK_THROWS_AS(parsePipeline("DontCareOptimization(inputs=13)"), std::invalid_argument);
+    CHECK_THROWS_AS(parsePipeline("DontCareOptimization(levels=0)"), std::invalid_argument);
+}
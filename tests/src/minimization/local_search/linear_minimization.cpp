@@ -0,0 +1,185 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+/* Returns number of two-input XORs, which XOR gates are split into. */
+size_t countXors(DAG const& circuit)
+{
+    size_t xors = 0;
+    for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        if (circuit.getGateType(gateId) == GateType::XOR)
+        {
+            xors += circuit.getGateOperands(gateId).size() - 1;
+        }
+    }
+    return xors;
+}
+
+/* Returns random circuit of mostly XOR gates, whose operands are `inputs` inputs and recent gates. */
+std::string makeLinearCircuit(size_t inputs, size_t gates, unsigned seed)
+{
+    std::mt19937 engine(seed);
+    std::ostringstream bench;
+    for (size_t i = 0; i < inputs; ++i)
+    {
+        bench << "INPUT(" << i << ")\n";
+    }
+    for (size_t gate = inputs + gates - 4; gate < inputs + gates; ++gate)
+    {
+        bench << "OUTPUT(" << gate << ")\n";
+    }
+    for (size_t gate = inputs; gate < inputs + gates; ++gate)
+    {
+        std::uniform_int_distribution<size_t> operand(gate > 12 ? gate - 12 : 0, gate - 1);
+        char const* const type = engine() % 6 == 0 ? "AND" : "XOR";
+        size_t const lhs       = operand(engine);
+        size_t rhs             = operand(engine);
+        while (rhs == lhs)
+        {
+            rhs = operand(engine);
+        }
+        bench << gate << " = " << type << "(" << lhs << ", " << rhs << ")\n";
+    }
+    return bench.str();
+}
+
+}  // namespace
+
+TEST_CASE("LinearMinimization SharedXors", "[linear_minimization]")
+{
+    utils::NameEncoder encoder;
+    // 7 = XOR(XOR(0, 1), 2, 3) is 8 = XOR(7, 3) for 7 = XOR(XOR(0, 1), 2), so 4 XORs are enough.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "INPUT(3)\n"
+        "OUTPUT(4)\n"
+        "OUTPUT(5)\n"
+        "OUTPUT(6)\n"
+        "4 = XOR(0, 1, 2)\n"
+        "5 = XOR(0, 1, 3)\n"
+        "6 = XOR(0, 1, 2, 3)\n",
+        encoder);
+
+    auto [result, result_encoder] = Composition<DAG, LinearMinimization<DAG> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(countXors(*circuit) == 7);
+    REQUIRE(countXors(*result) == 4);
+    REQUIRE(result->getNumberOfGates() == 8);
+}
+
+TEST_CASE("LinearMinimization CancelledLeaves", "[linear_minimization]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "OUTPUT(6)\n"
+        "OUTPUT(7)\n"
+        "3 = AND(0, 2)\n"
+        "4 = XOR(0, 1)\n"
+        "5 = XOR(4, 3)\n"
+        "6 = XOR(5, 1)\n"
+        "7 = XOR(4, 4)\n",
+        encoder);
+
+    auto [result, result_encoder] = Composition<DAG, LinearMinimization<DAG> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(countXors(*result) == 1);
+}
+
+TEST_CASE("LinearMinimization KeepsOptimalSubcircuits", "[linear_minimization]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "OUTPUT(4)\n"
+        "OUTPUT(5)\n"
+        "3 = XOR(0, 1)\n"
+        "4 = XOR(3, 2)\n"
+        "5 = AND(3, 4)\n",
+        encoder);
+
+    auto [result, result_encoder] = Composition<DAG, LinearMinimization<DAG> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == circuit->getNumberOfGates());
+    REQUIRE(countXors(*result) == 2);
+}
+
+TEST_CASE("LinearMinimization RandomCircuits", "[linear_minimization]")
+{
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        utils::NameEncoder encoder;
+        auto circuit = parseCircuit(makeLinearCircuit(10, 120, seed), encoder);
+        auto [cleaned, cleaned_encoder] = RedundantGatesCleaner<DAG>().apply(*circuit, encoder);
+
+        auto [result, result_encoder] =
+            parsePipeline("ConnectSymmetricalGates(xor); LinearMinimization")->apply(*cleaned, *cleaned_encoder);
+
+        REQUIRE(equivalentOnAllInputs(*cleaned, *cleaned_encoder, *result, *result_encoder));
+        REQUIRE(countXors(*result) <= countXors(*cleaned));
+    }
+}
+
+TEST_CASE("LinearMinimization FromRegistry", "[linear_minimization]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(makeLinearCircuit(8, 80, 42), encoder);
+
+    auto [result, result_encoder] =
+        parsePipeline("LinearMinimization(inputs=16, outputs=16, attempts=2)")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+
+    CHECK_THROWS_AS(parsePipeline("LinearMinimization(inputs=0)"), std::invalid_argument);
+    CHECK_THROWS_AS(parsePipeline("LinearMinimization(attempts=0)"), std::invalid_argument);
+}
+
+TEST_CASE("LinearMinimization ConstantOutputs", "[linear_minimization]")
+{
+    // Output 3 is XOR(0, 1, 0, 1), that is constant, and constant must be reduced.
+    std::string const bench =
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(3)\n"
+        "2 = XOR(0, 1)\n"
+        "3 = XOR(2, 0, 1)\n";
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(bench, encoder);
+
+    auto [minimized, minimized_encoder] = LinearMinimization<DAG>().apply(*circuit, encoder);
+    auto [result, result_encoder]       = ConstantGateReducer<DAG>().apply(*minimized, *minimized_encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE_FALSE(result->getInputGates().empty());
+
+    auto [piped, piped_encoder] = parsePipeline("LinearMinimization; ConstantGateReducer")->apply(*circuit, encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *piped, *piped_encoder));
+}
@@ -0,0 +1,128 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/structures/dag.hpp"
+#include "core/structures/xag.hpp"
+#include "core/types.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+/* NOT, MUX and all binary gates of BENCH. */
+std::vector<RandomGate> const random_gates = {
+    {"NOT",  1},
+    {"MUX",  3},
+    {"AND",  2},
+    {"OR",   2},
+    {"XOR",  2},
+    {"NAND", 2},
+    {"NOR",  2},
+    {"NXOR", 2}
+};
+
+/* Returns truth table of library circuit over `inputs` inputs. */
+uint8_t evaluate(MultiplicativeComplexityLibrary::Implementation const& implementation, size_t inputs)
+{
+    std::vector<uint8_t> signals = {0xAA, 0xCC, 0xF0};
+    signals.resize(inputs);
+    auto const affine = [&signals](uint8_t mask)
+    {
+        auto value = static_cast<uint8_t>((mask & MultiplicativeComplexityLibrary::Constant) != 0 ? 0xFF : 0);
+        for (size_t i = 0; i < signals.size(); ++i)
+        {
+            value ^= ((mask >> i) & 1U) != 0 ? signals[i] : 0;
+        }
+        return value;
+    };
+    for (size_t i = 0; i < implementation.ands; ++i)
+    {
+        auto const [lhs, rhs] = implementation.products[i];
+        signals.push_back(affine(lhs) & affine(rhs));
+    }
+    return affine(implementation.output) & static_cast<uint8_t>((1U << (1U << inputs)) - 1);
+}
+
+}  // namespace
+
+TEST_CASE("MultiplicativeComplexityRewriting Library", "[mc_rewriting]")
+{
+    auto const& library = MultiplicativeComplexityLibrary::getInstance();
+    for (size_t inputs = 0; inputs <= MultiplicativeComplexityLibrary::MaxInputs; ++inputs)
+    {
+        for (uint64_t truth = 0; truth < (uint64_t{1} << (uint64_t{1} << inputs)); ++truth)
+        {
+            auto const* const implementation = library.getImplementation(truth, inputs);
+            REQUIRE(implementation != nullptr);
+            REQUIRE(evaluate(*implementation, inputs) == truth);
+        }
+    }
+    // XOR of three inputs, majority and AND of three inputs.
+    REQUIRE(library.getImplementation(0x96, 3)->ands == 0);
+    REQUIRE(library.getImplementation(0xE8, 3)->ands == 1);
+    REQUIRE(library.getImplementation(0x80, 3)->ands == 2);
+}
+
+TEST_CASE("MultiplicativeComplexityRewriting Majority", "[mc_rewriting]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "OUTPUT(6)\n"
+        "3 = AND(0, 1)\n"
+        "4 = AND(0, 2)\n"
+        "5 = AND(1, 2)\n"
+        "6 = OR(3, 4, 5)\n",
+        encoder);
+
+    auto [result, result_encoder] =
+        Composition<DAG, ConvertToXAG<DAG>, MultiplicativeComplexityRewriting<DAG> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(XAG(*result).getMultiplicativeComplexity() == 1);
+}
+
+TEST_CASE("MultiplicativeComplexityRewriting RandomCircuits", "[mc_rewriting]")
+{
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        utils::NameEncoder encoder;
+        auto circuit =
+            parseCircuit(makeRandomCircuit({.inputs = 8, .gates = 80, .types = random_gates}, seed), encoder);
+        auto [xag, xag_encoder] = ConvertToXAG<DAG>().apply(*circuit, encoder);
+
+        auto const pipeline = parsePipeline("MultiplicativeComplexityRewriting; LinearMinimization; ConvertToXAG");
+        auto [result, result_encoder] = pipeline->apply(*xag, *xag_encoder);
+
+        REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+        REQUIRE(XAG(*result).getMultiplicativeComplexity() <= XAG(*xag).getMultiplicativeComplexity());
+    }
+}
+
+TEST_CASE("MultiplicativeComplexityRewriting FromRegistry", "[mc_rewriting]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(makeRandomCircuit({.inputs = 8, .gates = 80, .types = random_gates}, 42), encoder);
+
+    auto [result, result_encoder] = parsePipeline("xag")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE_NOTHROW(XAG(*result));
+
+    CHECK_THROWS_AS(parsePipeline("MultiplicativeComplexityRewriting(cuts=0)"), std::invalid_argument);
+}
@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+TEST_CASE("Refactoring FactorsCone", "[refactoring]")
+{
+    utils::NameEncoder encoder;
+    // a b + a c + a d is a (b + c + d).
+    auto circuit = parseCircuit(
+        "INPUT(a)\n"
+        "INPUT(b)\n"
+        "INPUT(c)\n"
+        "INPUT(d)\n"
+        "OUTPUT(y)\n"
+        "ab = AND(a, b)\n"
+        "ac = AND(a, c)\n"
+        "ad = AND(a, d)\n"
+        "x = OR(ab, ac)\n"
+        "y = OR(x, ad)\n",
+        encoder);
+
+    auto [result, result_encoder] = Refactoring<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGatesWithoutInputs() == 3);
+}
+
+TEST_CASE("Refactoring ReusesExistingNegation", "[refactoring]")
+{
+    utils::NameEncoder encoder;
+    // Output y is NOT(a), which already exists as gate na, so y is redirected to it.
+    auto circuit = parseCircuit(
+        "INPUT(a)\n"
+        "INPUT(b)\n"
+        "OUTPUT(na)\n"
+        "OUTPUT(y)\n"
+        "na = NOT(a)\n"
+        "ab = AND(a, b)\n"
+        "nab = NOT(ab)\n"
+        "t = AND(nab, b)\n"
+        "y = OR(t, na)\n",
+        encoder);
+
+    auto [result, result_encoder] = Refactoring<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGatesWithoutInputs() == 1);
+    REQUIRE(result->getOutputGates().at(0) == result->getOutputGates().at(1));
+}
+
+TEST_CASE("Refactoring RandomCircuits", "[refactoring]")
+{
+    auto cache = std::make_shared<RefactoringCache>();
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        utils::NameEncoder encoder;
+        auto circuit = parseCircuit(makeRandomCircuit({.inputs = 10, .gates = 150, .outputs = 4}, seed), encoder);
+        auto [cleaned, cleaned_encoder] = RedundantGatesCleaner<DAG>().apply(*circuit, encoder);
+
+        // Parallel processing of cones gives the same result.
+        size_t gates = 0;
+        for (size_t const threads : {1, 4})
+        {
+            auto [refactored, refactored_encoder] =
+                Refactoring_<DAG>(10, threads, cache).apply(*cleaned, *cleaned_encoder);
+            auto [result, result_encoder] = RedundantGatesCleaner<DAG>().apply(*refactored, *refactored_encoder);
+
+            REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+            REQUIRE(result->getNumberOfGates() <= cleaned->getNumberOfGates());
+            if (gates != 0)
+            {
+                CHECK(result->getNumberOfGates() == gates);
+            }
+            gates = result->getNumberOfGates();
+        }
+    }
+    CHECK(cache->getHits() > 0);
+}
+
+TEST_CASE("Refactoring FromRegistry", "[refactoring]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(makeRandomCircuit({.inputs = 8, .gates = 80, .outputs = 2}, 42), encoder);
+
+    auto [result, result_encoder] =
+        parsePipeline("fixpoint(4) { Refactoring(inputs=8, threads=2) }")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() <= circuit->getNumberOfGates());
+
+    CHECK_THROWS_AS(parsePipeline("Refactoring(inputs=13)"), std::invalid_argument);
+}
+
+TEST_CASE("Refactoring ConstantOutputs", "[refactoring]")
+{
+    // Output is a tautology, so it is rewritten to constant, and constant must be reduced.
+    std::string const bench =
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(4)\n"
+        "2 = NOT(0)\n"
+        "3 = AND(0, 1)\n"
+        "4 = OR(3, 2, 0)\n";
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(bench, encoder);
+
+    auto [rewritten, rewritten_encoder] = Refactoring<DAG>().apply(*circuit, encoder);
+    auto [result, result_encoder]       = ConstantGateReducer<DAG>().apply(*rewritten, *rewritten_encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE_FALSE(result->getInputGates().empty());
+
+    auto [piped, piped_encoder] = parsePipeline("Refactoring; ConstantGateReducer")->apply(*circuit, encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *piped, *piped_encoder));
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "core/cost_model.hpp"
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+TEST_CASE("Resubstitution ReusesEqualGate", "[resubstitution]")
+{
+    utils::NameEncoder encoder;
+    // By De Morgan's law y is equal to existing gate ab, so its cone is removed.
+    auto circuit = parseCircuit(
+        "INPUT(a)\n"
+        "INPUT(b)\n"
+        "OUTPUT(ab)\n"
+        "OUTPUT(y)\n"
+        "ab = AND(a, b)\n"
+        "na = NOT(a)\n"
+        "nb = NOT(b)\n"
+        "o = OR(na, nb)\n"
+        "y = NOT(o)\n",
+        encoder);
+
+    auto [result, result_encoder] = Resubstitution<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGatesWithoutInputs() == 1);
+    REQUIRE(result->getOutputGates().at(0) == result->getOutputGates().at(1));
+}
+
+TEST_CASE("Resubstitution ReplacesConeByOneGate", "[resubstitution]")
+{
+    utils::NameEncoder encoder;
+    // Since a b implies a + c, gate y = (a + c) & !(a b) is XOR of them.
+    auto circuit = parseCircuit(
+        "INPUT(a)\n"
+        "INPUT(b)\n"
+        "INPUT(c)\n"
+        "OUTPUT(ab)\n"
+        "OUTPUT(ac)\n"
+        "OUTPUT(y)\n"
+        "ab = AND(a, b)\n"
+        "ac = OR(a, c)\n"
+        "nab = NOT(ab)\n"
+        "y = AND(ac, nab)\n",
+        encoder);
+
+    auto [result, result_encoder] = Resubstitution<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGatesWithoutInputs() == 3);
+    CHECK(result->getGateType(result->getOutputGates().at(2)) == GateType::XOR);
+}
+
+TEST_CASE("Resubstitution RespectsCostModel", "[resubstitution]")
+{
+    utils::NameEncoder encoder;
+    // Cone of y is replaced by XOR gate, unless XOR gates cost more than the cone.
+    std::string const bench =
+        "INPUT(a)\n"
+        "INPUT(b)\n"
+        "INPUT(c)\n"
+        "OUTPUT(ab)\n"
+        "OUTPUT(ac)\n"
+        "OUTPUT(y)\n"
+        "ab = AND(a, b)\n"
+        "ac = OR(a, c)\n"
+        "nab = NOT(ab)\n"
+        "y = AND(ac, nab)\n";
+    auto circuit = parseCircuit(bench, encoder);
+
+    auto [kept, kept_encoder] = parsePipeline("Resubstitution(cost=gates/XOR:3)")->apply(*circuit, encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *kept, *kept_encoder));
+    REQUIRE(kept->getNumberOfGatesWithoutInputs() == 4);
+
+    // Expensive NOT gate is removed, either with cone of y or merged into NAND gate.
+    CostModel const model         = CostModel::parse("gates/XOR:2/NOT:3");
+    auto [result, result_encoder] = parsePipeline("Resubstitution(cost=gates/XOR:2/NOT:3)")->apply(*circuit, encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(model.getCircuitCost(*result) < model.getCircuitCost(*circuit));
+    for (GateId gateId = 0; gateId < result->getNumberOfGates(); ++gateId)
+    {
+        CHECK(result->getGateType(gateId) != GateType::NOT);
+    }
+
+    CHECK_THROWS_AS(parsePipeline("Resubstitution(cost=area)"), std::invalid_argument);
+}
+
+TEST_CASE("Resubstitution RandomCircuits", "[resubstitution]")
+{
+    size_t removed = 0;
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        utils::NameEncoder encoder;
+        auto circuit = parseCircuit(makeRandomCircuit({.inputs = 10, .gates = 150, .outputs = 4}, seed), encoder);
+        auto [cleaned, cleaned_encoder] = RedundantGatesCleaner<DAG>().apply(*circuit, encoder);
+
+        for (size_t const threads : {1, 4})
+        {
+            auto [resubstituted, resubstituted_encoder] =
+                Resubstitution_<DAG>(8, 30, 4, threads).apply(*cleaned, *cleaned_encoder);
+            auto [result, result_encoder] =
+                RedundantGatesCleaner<DAG>().apply(*resubstituted, *resubstituted_encoder);
+
+            REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+            REQUIRE(result->getNumberOfGates() <= cleaned->getNumberOfGates());
+            removed += cleaned->getNumberOfGates() - result->getNumberOfGates();
+        }
+    }
+    CHECK(removed > 0);
+}
+
+TEST_CASE("Resubstitution FromRegistry", "[resubstitution]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(makeRandomCircuit({.inputs = 8, .gates = 80, .outputs = 2}, 42), encoder);
+
+    auto [result, result_encoder] =
+        parsePipeline("fixpoint(4) { Resubstitution(inputs=6, divisors=20, threads=2) }")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() <= circuit->getNumberOfGates());
+
+    CHECK_THROWS_AS(parsePipeline("Resubstitution(inputs=13)"), std::invalid_argument);
+    CHECK_THROWS_AS(parsePipeline("Resubstitution(divisors=0)"), std::invalid_argument);
+}
@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "circuits_db/circuit_database.hpp"
+#include "circuits_db/database_generator.hpp"
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "synthesis/exact_synthesis.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+/* Full adder, where XORs are built of AND, OR and NOT gates. */
+std::string const BadFullAdder =
+    "INPUT(0)\n"
+    "INPUT(1)\n"
+    "INPUT(2)\n"
+    "OUTPUT(sum)\n"
+    "OUTPUT(carry)\n"
+    "n0 = NOT(0)\n"
+    "n1 = NOT(1)\n"
+    "a = AND(0, n1)\n"
+    "b = AND(n0, 1)\n"
+    "x = OR(a, b)\n"
+    "nx = NOT(x)\n"
+    "n2 = NOT(2)\n"
+    "c = AND(x, n2)\n"
+    "d = AND(nx, 2)\n"
+    "sum = OR(c, d)\n"
+    "e = AND(0, 1)\n"
+    "f = AND(x, 2)\n"
+    "carry = OR(e, f)\n";
+
+}  // namespace
+
+TEST_CASE("SubcircuitMinimization ReplacesWindow", "[subcircuit_minimization]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(4)\n"
+        "2 = NOT(0)\n"
+        "3 = NOT(1)\n"
+        "4 = NAND(2, 3)\n",
+        encoder);
+
+    auto [result, result_encoder] = SubcircuitMinimization<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == 3);
+    REQUIRE(result->getGateType(result->getOutputGates().at(0)) == GateType::OR);
+}
+
+TEST_CASE("SubcircuitMinimization MultiOutputWindows", "[subcircuit_minimization]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(BadFullAdder, encoder);
+
+    // Parallel processing of windows gives the same result.
+    size_t gates = 0;
+    for (size_t const threads : {1, 4})
+    {
+        auto transformer = parsePipeline("SubcircuitMinimization(inputs=3, threads=" + std::to_string(threads) + ")");
+        auto [result, result_encoder] = transformer->apply(*circuit, encoder);
+        REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+        REQUIRE(result->getNumberOfGates() < circuit->getNumberOfGates());
+        if (gates != 0)
+        {
+            CHECK(result->getNumberOfGates() == gates);
+        }
+        gates = result->getNumberOfGates();
+    }
+}
+
+TEST_CASE("SubcircuitMinimization FromRegistry", "[subcircuit_minimization]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(BadFullAdder, encoder);
+
+    auto [result, result_encoder] =
+        parsePipeline("fixpoint(4) { SubcircuitMinimization(inputs=3, gates=6, threads=2) }")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    // Full adder needs 5 gates in BENCH basis.
+    REQUIRE(result->getNumberOfGatesWithoutInputs() <= 7);
+
+    CHECK_THROWS_AS(parsePipeline("SubcircuitMinimization(inputs=7)"), std::invalid_argument);
+    CHECK_THROWS_AS(parsePipeline("SubcircuitMinimization(basis=MIG)"), std::invalid_argument);
+}
+
+TEST_CASE("SubcircuitMinimization WithDatabase", "[subcircuit_minimization]")
+{
+    std::string const path =
+        (std::filesystem::temp_directory_path() / "cirbo_subcircuit_minimization_test.db").string();
+    std::filesystem::remove(path);
+    circuits_db::DatabaseGenerator const generator(
+        synthesis::ExactSynthesizer(Basis::BENCH), 2, std::chrono::seconds(600));
+    generator.run(circuits_db::DatabaseGenerator::enumerateNpnClasses(3), path);
+
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "OUTPUT(6)\n"
+        "OUTPUT(9)\n"
+        "3 = NOT(0)\n"
+        "4 = NOT(1)\n"
+        "5 = NAND(3, 4)\n"
+        "6 = AND(5, 2)\n"
+        "7 = AND(0, 2)\n"
+        "8 = NOT(7)\n"
+        "9 = AND(8, 1)\n",
+        encoder);
+
+    auto [result, result_encoder] =
+        parsePipeline("SubcircuitMinimization(inputs=3, outputs=1, database=" + path + ")")->apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() < circuit->getNumberOfGates());
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("SubcircuitMinimization ConstantOutputs", "[subcircuit_minimization]")
+{
+    // Output is a tautology, so it is rewritten to constant, and constant must be reduced.
+    std::string const bench =
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(4)\n"
+        "2 = NOT(0)\n"
+        "3 = AND(0, 1)\n"
+        "4 = OR(3, 2, 0)\n";
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(bench, encoder);
+
+    auto [rewritten, rewritten_encoder] = SubcircuitMinimization<DAG>().apply(*circuit, encoder);
+    auto [result, result_encoder]       = ConstantGateReducer<DAG>().apply(*rewritten, *rewritten_encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE_FALSE(result->getInputGates().empty());
+
+    auto [piped, piped_encoder] =
+        parsePipeline("SubcircuitMinimization; ConstantGateReducer")->apply(*circuit, encoder);
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *piped, *piped_encoder));
+}
@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/algo.hpp"
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+/* Returns number of gates on the longest path from inputs to `gateId`. */
+size_t getLevel(DAG const& circuit, GateId gateId)
+{
+    std::vector<size_t> levels(circuit.getNumberOfGates(), 0);
+    for (GateId const gate : std::ranges::reverse_view(algo::TopSortAlgorithm<algo::DFSTopSort>::sorting(circuit)))
+    {
+        for (GateId const operand : circuit.getGateOperands(gate))
+        {
+            levels.at(gate) = std::max(levels.at(gate), levels.at(operand) + 1);
+        }
+    }
+    return levels.at(gateId);
+}
+
+size_t getDepth(DAG const& circuit)
+{
+    size_t depth = 0;
+    for (GateId const output : circuit.getOutputGates())
+    {
+        depth = std::max(depth, getLevel(circuit, output));
+    }
+    return depth;
+}
+
+}  // namespace
+
+TEST_CASE("BalanceSymmetricalGates Chain", "[balance_symmetrical_gates]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "INPUT(3)\n"
+        "OUTPUT(6)\n"
+        "4 = AND(0, 1)\n"
+        "5 = AND(4, 2)\n"
+        "6 = AND(5, 3)\n",
+        encoder);
+
+    auto [result, result_encoder] =
+        Composition<DAG, BalanceSymmetricalGates<DAG, true, true, true> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == circuit->getNumberOfGates());
+    REQUIRE(getDepth(*circuit) == 3);
+    REQUIRE(getDepth(*result) == 2);
+}
+
+TEST_CASE("BalanceSymmetricalGates ArrivalTimes", "[balance_symmetrical_gates]")
+{
+    utils::NameEncoder encoder;
+    // Gate 6 is at level 3, so it must be merged last: OR(6, OR(3, OR(1, 2))) is at level 4,
+    // while naive balanced tree OR(OR(6, 1), OR(2, 3)) is at level 5.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "INPUT(3)\n"
+        "OUTPUT(6)\n"
+        "OUTPUT(9)\n"
+        "4 = NOT(0)\n"
+        "5 = NOT(4)\n"
+        "6 = XOR(5, 1)\n"
+        "7 = OR(6, 1)\n"
+        "8 = OR(7, 2)\n"
+        "9 = OR(8, 3)\n",
+        encoder);
+
+    auto [result, result_encoder] =
+        Composition<DAG, BalanceSymmetricalGates<DAG, false, true, false> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == circuit->getNumberOfGates());
+    REQUIRE(getLevel(*circuit, circuit->getOutputGates().at(1)) == 6);
+    REQUIRE(getLevel(*result, result->getOutputGates().at(1)) == 4);
+}
+
+TEST_CASE("BalanceSymmetricalGates KeepsSharedGates", "[balance_symmetrical_gates]")
+{
+    utils::NameEncoder encoder;
+    // Gate 4 has two users, so it is a leaf of both trees, and trees of 2 gates are already balanced.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "INPUT(3)\n"
+        "OUTPUT(5)\n"
+        "OUTPUT(6)\n"
+        "4 = AND(0, 1)\n"
+        "5 = AND(4, 2)\n"
+        "6 = AND(4, 3)\n",
+        encoder);
+
+    auto [result, _] =
+        Composition<DAG, BalanceSymmetricalGates<DAG, true, true, true> >().apply(*circuit, encoder);
+
+    for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
+    {
+        REQUIRE(result->getGateOperands(gateId) == circuit->getGateOperands(gateId));
+    }
+}
+
+TEST_CASE("BalanceSymmetricalGates RandomCircuits", "[balance_symmetrical_gates]")
+{
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        std::mt19937 engine(seed);
+        std::ostringstream bench;
+        size_t const inputs = 8;
+        size_t const gates  = 100;
+        for (size_t i = 0; i < inputs; ++i)
+        {
+            bench << "INPUT(" << i << ")\n";
+        }
+        bench << "OUTPUT(" << inputs + gates - 1 << ")\n";
+        bench << "OUTPUT(" << inputs + gates - 2 << ")\n";
+        for (size_t gate = inputs; gate < inputs + gates; ++gate)
+        {
+            // Operands are mostly recent gates, so long chains of gates appear.
+            std::uniform_int_distribution<size_t> operand(gate > 4 ? gate - 4 : 0, gate - 1);
+            char const* const types[] = {"AND", "OR", "XOR", "NOT"};
+            std::string const type    = types[engine() % 4];
+            size_t const lhs          = operand(engine);
+            bench << gate << " = " << type << "(" << lhs;
+            if (type != "NOT")
+            {
+                bench << ", " << std::uniform_int_distribution<size_t>(0, gate - 1)(engine);
+            }
+            bench << ")\n";
+        }
+
+        utils::NameEncoder encoder;
+        auto circuit = parseCircuit(bench.str(), encoder);
+        auto [cleaned, cleaned_encoder] = RedundantGatesCleaner<DAG>().apply(*circuit, encoder);
+
+        auto [result, result_encoder] =
+            parsePipeline("BalanceSymmetricalGates(and, or, xor)")->apply(*cleaned, *cleaned_encoder);
+
+        REQUIRE(equivalentOnAllInputs(*cleaned, *cleaned_encoder, *result, *result_encoder));
+        REQUIRE(result->getNumberOfGates() == cleaned->getNumberOfGates());
+        REQUIRE(getDepth(*result) <= getDepth(*cleaned));
+    }
+}
@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/structures/dag.hpp"
+#include "core/structures/xag.hpp"
+#include "core/types.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+/* Gates of all types, which are converted, of arity 3. */
+std::vector<RandomGate> const random_gates = {
+    {"NOT",  1},
+    {"BUFF", 1},
+    {"MUX",  3},
+    {"AND",  3},
+    {"OR",   3},
+    {"XOR",  3},
+    {"NAND", 3},
+    {"NOR",  3},
+    {"NXOR", 3}
+};
+
+}  // namespace
+
+
+TEST_CASE("ConvertToXAG AllTypes", "[convert_to_xag]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "OUTPUT(3)\n"
+        "OUTPUT(4)\n"
+        "OUTPUT(5)\n"
+        "OUTPUT(6)\n"
+        "OUTPUT(7)\n"
+        "3 = OR(0, 1, 2)\n"
+        "4 = NAND(0, 1)\n"
+        "5 = NOR(1, 2)\n"
+        "6 = NXOR(0, 2)\n"
+        "7 = MUX(0, 1, 2)\n",
+        encoder);
+
+    auto [result, result_encoder] = ConvertToXAG<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE_NOTHROW(XAG(*result));
+    // OR of 3 operands costs 2 AND gates, others cost one AND gate each, NXOR is free.
+    REQUIRE(XAG(*result).getMultiplicativeComplexity() == 5);
+}
+
+TEST_CASE("ConvertToXAG RandomCircuits", "[convert_to_xag]")
+{
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        utils::NameEncoder encoder;
+        auto circuit =
+            parseCircuit(makeRandomCircuit({.inputs = 8, .gates = 60, .types = random_gates}, seed), encoder);
+
+        auto [result, result_encoder] = parsePipeline("ConvertToXAG")->apply(*circuit, encoder);
+
+        REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+        REQUIRE_NOTHROW(XAG(*result));
+    }
+}
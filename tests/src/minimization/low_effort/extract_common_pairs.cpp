@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+/* Returns number of two-input gates, which symmetrical gates are split into. */
+size_t countBinaryGates(DAG const& circuit)
+{
+    size_t gates = 0;
+    for (GateId gateId = 0; gateId < circuit.getNumberOfGates(); ++gateId)
+    {
+        gates += std::max<size_t>(circuit.getGateOperands(gateId).size(), 2) - 1;
+    }
+    return gates - circuit.getInputGates().size();
+}
+
+}  // namespace
+
+TEST_CASE("ExtractCommonPairs SharedPair", "[extract_common_pairs]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "INPUT(3)\n"
+        "INPUT(4)\n"
+        "OUTPUT(5)\n"
+        "OUTPUT(6)\n"
+        "OUTPUT(7)\n"
+        "5 = AND(0, 1, 2)\n"
+        "6 = AND(0, 1, 3)\n"
+        "7 = AND(4, 1, 0)\n",
+        encoder);
+
+    auto [result, result_encoder] =
+        Composition<DAG, ExtractCommonPairs<DAG, true, true, true> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(countBinaryGates(*circuit) == 6);
+    REQUIRE(countBinaryGates(*result) == 4);
+    REQUIRE(result->getNumberOfGates() == 9);
+}
+
+TEST_CASE("ExtractCommonPairs ReusesExistingGate", "[extract_common_pairs]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "INPUT(3)\n"
+        "OUTPUT(4)\n"
+        "OUTPUT(5)\n"
+        "OUTPUT(6)\n"
+        "4 = OR(0, 1)\n"
+        "5 = OR(0, 1, 2)\n"
+        "6 = OR(0, 1, 3)\n",
+        encoder);
+
+    auto [result, result_encoder] =
+        Composition<DAG, ExtractCommonPairs<DAG, false, true, false> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(result->getNumberOfGates() == 7);
+    REQUIRE(countBinaryGates(*result) == 3);
+}
+
+TEST_CASE("ExtractCommonPairs LargerSubset", "[extract_common_pairs]")
+{
+    utils::NameEncoder encoder;
+    // Shared subset {0, 1, 2} is extracted as two nested pairs.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "INPUT(2)\n"
+        "INPUT(3)\n"
+        "INPUT(4)\n"
+        "INPUT(5)\n"
+        "OUTPUT(6)\n"
+        "OUTPUT(7)\n"
+        "OUTPUT(8)\n"
+        "6 = XOR(0, 1, 2, 3)\n"
+        "7 = XOR(0, 1, 2, 4)\n"
+        "8 = XOR(0, 1, 2, 5)\n",
+        encoder);
+
+    auto [result, result_encoder] =
+        Composition<DAG, ExtractCommonPairs<DAG, true, true, true> >().apply(*circuit, encoder);
+
+    REQUIRE(equivalentOnAllInputs(*circuit, encoder, *result, *result_encoder));
+    REQUIRE(countBinaryGates(*circuit) == 9);
+    REQUIRE(countBinaryGates(*result) == 5);
+}
+
+TEST_CASE("ExtractCommonPairs RandomCircuits", "[extract_common_pairs]")
+{
+    char const* const types[] = {"AND", "OR", "XOR"};
+    for (unsigned seed = 0; seed < 10; ++seed)
+    {
+        std::mt19937 engine(seed);
+        std::ostringstream bench;
+        size_t const inputs = 10;
+        size_t const gates  = 60;
+        for (size_t i = 0; i < inputs; ++i)
+        {
+            bench << "INPUT(" << i << ")\n";
+        }
+        for (size_t gate = inputs; gate < inputs + gates; ++gate)
+        {
+            bench << "OUTPUT(" << gate << ")\n";
+        }
+        for (size_t gate = inputs; gate < inputs + gates; ++gate)
+        {
+            // Wide gates over a small pool of operands share many pairs.
+            std::vector<size_t> operands(std::min<size_t>(gate, 14));
+            std::iota(operands.begin(), operands.end(), gate - operands.size());
+            std::shuffle(operands.begin(), operands.end(), engine);
+            operands.resize(2 + (engine() % 5));
+            bench << gate << " = " << types[engine() % 3] << "(" << operands.front();
+            for (size_t i = 1; i < operands.size(); ++i)
+            {
+                bench << ", " << operands[i];
+            }
+            bench << ")\n";
+        }
+
+        utils::NameEncoder encoder;
+        auto circuit = parseCircuit(bench.str(), encoder);
+        auto [cleaned, cleaned_encoder] =
+            Composition<DAG, RedundantGatesCleaner<DAG>, DuplicateOperandsCleaner<DAG> >().apply(*circuit, encoder);
+
+        auto [result, result_encoder] =
+            parsePipeline("ExtractCommonPairs(and, or, xor)")->apply(*cleaned, *cleaned_encoder);
+
+        REQUIRE(equivalentOnAllInputs(*cleaned, *cleaned_encoder, *result, *result_encoder));
+        REQUIRE(countBinaryGates(*result) <= countBinaryGates(*cleaned));
+    }
+}
@@ -0,0 +1,154 @@
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "core/cost_model.hpp"
+#include "core/structures/dag.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/nest.hpp"
+#include "minimization/pass_report.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+/* Enables report for the scope of a test. */
+struct ReportGuard
+{
+    ReportGuard()
+    {
+        PassReport::getInstance().clear();
+        PassReport::getInstance().setEnabled(true);
+    }
+
+    ~ReportGuard()
+    {
+        PassReport::getInstance().setEnabled(false);
+        PassReport::getInstance().setCostModel(CostModel::gateCount());
+        PassReport::getInstance().clear();
+    }
+};
+
+std::string const dag =
+    "INPUT(0)\n"
+    "INPUT(1)\n"
+    "OUTPUT(5)\n"
+    "2 = AND(0, 1)\n"
+    "3 = AND(0, 1)\n"
+    "4 = OR(0, 1)\n"
+    "5 = OR(2, 3)\n";
+
+}  // namespace
+
+TEST_CASE("PassReport DisabledByDefault", "[pass_report]")
+{
+    PassReport::getInstance().clear();
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto [result, _] = DuplicateGatesCleaner<DAG>().apply(*circuit, encoder);
+
+    REQUIRE(PassReport::getInstance().getRecords().empty());
+}
+
+TEST_CASE("PassReport NestedRecords", "[pass_report]")
+{
+    ReportGuard guard;
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto [result, _] = DuplicateGatesCleaner<DAG>().apply(*circuit, encoder);
+
+    auto const& records = PassReport::getInstance().getRecords();
+    REQUIRE(records.size() == 1);
+    REQUIRE(records.at(0).gates_in == 6);
+    REQUIRE(records.at(0).gates_out == 4);
+    REQUIRE(records.at(0).children.size() == 2);
+
+    PassRecord const& cleaner = records.at(0).children.at(0);
+    REQUIRE(cleaner.name.find("RedundantGatesCleaner_") != std::string::npos);
+    REQUIRE(cleaner.gates_in == 6);
+    REQUIRE(cleaner.gates_out == 5);
+    REQUIRE(cleaner.rules.at("redundant_gate") == 1);
+
+    PassRecord const& deduplicator = records.at(0).children.at(1);
+    REQUIRE(deduplicator.name.find("DuplicateGatesCleaner_") != std::string::npos);
+    REQUIRE(deduplicator.gates_out == 4);
+    REQUIRE(deduplicator.rules.at("duplicate_gate") == 1);
+}
+
+TEST_CASE("PassReport NestAndPipelineNames", "[pass_report]")
+{
+    ReportGuard guard;
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto [nested, nested_encoder] = Nest<DAG, 2, RedundantGatesCleaner_<DAG> >().apply(*circuit, encoder);
+    // Each iteration is recorded as composition, which contains its transformers.
+    auto const& iterations = PassReport::getInstance().getRecords().at(0).children;
+    REQUIRE(iterations.size() == 2);
+    REQUIRE(iterations.at(1).children.size() == 1);
+    REQUIRE(iterations.at(1).gates_in == iterations.at(0).gates_out);
+
+    PassReport::getInstance().clear();
+    auto [result, _] = parsePipeline("repeat(2) { DuplicateGatesCleaner }")->apply(*circuit, encoder);
+
+    auto const& records = PassReport::getInstance().getRecords();
+    REQUIRE(records.size() == 1);
+    REQUIRE(records.at(0).name == "pipeline");
+    auto const& nest = records.at(0).children.at(0);
+    REQUIRE(nest.name == "repeat(2)");
+    REQUIRE(nest.children.size() == 2);
+    REQUIRE(nest.children.at(0).name == "DuplicateGatesCleaner");
+    REQUIRE(nest.children.at(1).gates_in == 4);
+    REQUIRE(nest.children.at(1).gates_out == 4);
+}
+
+TEST_CASE("PassReport Json", "[pass_report]")
+{
+    ReportGuard guard;
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto [result, _] = parsePipeline("DuplicateGatesCleaner")->apply(*circuit, encoder);
+
+    std::ostringstream out;
+    PassReport::getInstance().writeJson(out);
+    std::string const json = out.str();
+    REQUIRE(json.rfind("{\"passes\": [", 0) == 0);
+    REQUIRE(json.find("\"name\": \"DuplicateGatesCleaner\"") != std::string::npos);
+    REQUIRE(json.find("\"duplicate_gate\": 1") != std::string::npos);
+    REQUIRE(json.find("\"wall_time_ms\": ") != std::string::npos);
+    REQUIRE(json.find("\"peak_rss_delta_kb\": ") != std::string::npos);
+}
+
+TEST_CASE("PassReport CostModel", "[pass_report]")
+{
+    ReportGuard guard;
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto [counted, counted_encoder] = DuplicateGatesCleaner<DAG>().apply(*circuit, encoder);
+    REQUIRE(PassReport::getInstance().getRecords().at(0).cost_in == 6);
+    REQUIRE(PassReport::getInstance().getRecords().at(0).cost_out == 4);
+
+    PassReport::getInstance().clear();
+    PassReport::getInstance().setCostModel(CostModel::parse("gates/INPUT:0/AND:3"));
+    auto [result, _] = DuplicateGatesCleaner<DAG>().apply(*circuit, encoder);
+
+    auto const& records = PassReport::getInstance().getRecords();
+    REQUIRE(records.at(0).gates_out == 4);
+    REQUIRE(records.at(0).cost_in == 8);
+    REQUIRE(records.at(0).cost_out == 4);
+
+    std::ostringstream out;
+    PassReport::getInstance().writeJson(out);
+    REQUIRE(out.str().find("\"cost_in\": 8, \"cost_out\": 4") != std::string::npos);
+}
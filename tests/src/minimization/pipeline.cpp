@@ -0,0 +1,127 @@
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "io/parsers/bench_to_circuit.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/pipeline.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "minimization/registry.hpp"
+#include "minimization/strategy.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+
+namespace
+{
+
+std::string const dag =
+    "INPUT(0)\n"
+    "INPUT(1)\n"
+    "INPUT(2)\n"
+    "OUTPUT(7)\n"
+    "3 = NOT(0)\n"
+    "4 = AND(0, 3)\n"
+    "5 = OR(1, 2, 4)\n"
+    "6 = OR(1, 2, 4)\n"
+    "7 = AND(5, 6, 6)\n";
+
+}  // namespace
+
+TEST_CASE("Pipeline DefaultPresetMatchesStaticComposition", "[pipeline]")
+{
+    std::istringstream stream(dag);
+    io::parsers::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+
+    std::unique_ptr<DAG> csat_instance = parser.instantiate();
+    utils::NameEncoder encoder         = parser.getEncoder();
+
+    auto [expected, expected_encoder] =
+        Composition<DAG, DuplicateGatesCleaner<DAG>, DuplicateOperandsCleaner<DAG> >().apply(*csat_instance, encoder);
+    auto [circuit, circuit_encoder] = parsePipeline("default")->apply(*csat_instance, encoder);
+
+    REQUIRE(circuit->getNumberOfGates() == expected->getNumberOfGates());
+    REQUIRE(circuit->getOutputGates() == expected->getOutputGates());
+    for (GateId gateId = 0; gateId < circuit->getNumberOfGates(); ++gateId)
+    {
+        REQUIRE(circuit->getGateType(gateId) == expected->getGateType(gateId));
+        REQUIRE(circuit->getGateOperands(gateId) == expected->getGateOperands(gateId));
+    }
+}
+
+TEST_CASE("Pipeline Structure", "[pipeline]")
+{
+    auto pipeline = parsePipeline(
+        "DuplicateGatesCleaner, # comment\n"
+        "repeat(3) { ConstantGateReducer; DeMorgan };"
+        "fixpoint(4) { DisconnectSymmetricalGates(arity=3, and, xor=false) };");
+
+    REQUIRE(pipeline->size() == 3);
+    auto const* nest = dynamic_cast<DynamicNest<DAG> const*>(pipeline->getTransformers().at(1).get());
+    REQUIRE(nest != nullptr);
+    REQUIRE(nest->getRepetitions() == 3);
+    auto const* fixpoint = dynamic_cast<Fixpoint<DAG> const*>(pipeline->getTransformers().at(2).get());
+    REQUIRE(fixpoint != nullptr);
+    REQUIRE(fixpoint->getMaxIterations() == 4);
+
+    auto const* disconnect = dynamic_cast<DisconnectSymmetricalGates<DAG, 3, true, false, false> const*>(
+        parsePipeline("DisconnectSymmetricalGates(arity=3, and)")->getTransformers().at(0).get());
+    REQUIRE(disconnect != nullptr);
+}
+
+TEST_CASE("Pipeline FixpointCostModel", "[pipeline]")
+{
+    auto pipeline = parsePipeline("fixpoint(4, cost=mc) { DeMorgan }; fixpoint(cost=gates/XOR:0) { DeMorgan }");
+
+    auto const* mc = dynamic_cast<Fixpoint<DAG> const*>(pipeline->getTransformers().at(0).get());
+    REQUIRE(mc != nullptr);
+    REQUIRE(mc->getMaxIterations() == 4);
+    REQUIRE(mc->getName() == "fixpoint(4, cost=mc)");
+    REQUIRE(mc->getCostModel().getGateCost(GateType::AND, 2) == 1);
+    REQUIRE(mc->getCostModel().getGateCost(GateType::XOR, 2) == 0);
+
+    auto const* gates = dynamic_cast<Fixpoint<DAG> const*>(pipeline->getTransformers().at(1).get());
+    REQUIRE(gates != nullptr);
+    REQUIRE(gates->getMaxIterations() == Fixpoint<DAG>::DefaultMaxIterations);
+    REQUIRE(gates->getCostModel().getGateCost(GateType::NOT, 1) == 1);
+    REQUIRE(gates->getCostModel().getGateCost(GateType::XOR, 2) == 0);
+
+    REQUIRE_THROWS_AS(parsePipeline("fixpoint(cost=area) { DeMorgan }"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parsePipeline("fixpoint(4, depth=2) { DeMorgan }"), std::invalid_argument);
+}
+
+TEST_CASE("Pipeline Errors", "[pipeline]")
+{
+    REQUIRE_THROWS_AS(parsePipeline("UnknownTransformer"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parsePipeline("DeMorgan(arity=2)"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parsePipeline("DisconnectSymmetricalGates(arity=42)"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parsePipeline("DisconnectSymmetricalGates(arity=two)"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parsePipeline("repeat(2) { DeMorgan"), std::invalid_argument);
+    REQUIRE_THROWS_AS(parsePipeline("DeMorgan DeMorgan"), std::invalid_argument);
+
+    TransformerRegistry<DAG> registry = makeDefaultTransformerRegistry();
+    registry.addPreset("loop", "DeMorgan; loop");
+    REQUIRE_THROWS_AS(PipelineParser<DAG>(registry).parse("loop"), std::invalid_argument);
+}
+
+TEST_CASE("Pipeline FixpointReachesStableCircuit", "[pipeline]")
+{
+    std::istringstream stream(dag);
+    io::parsers::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+
+    std::unique_ptr<DAG> csat_instance = parser.instantiate();
+    utils::NameEncoder encoder         = parser.getEncoder();
+
+    auto [circuit, _] = parsePipeline("aggressive")->apply(*csat_instance, encoder);
+
+    // AND(OR(1, 2, 0 & !0), ...) collapses to single OR of two inputs.
+    REQUIRE(circuit->getNumberOfGates() == 3);
+    REQUIRE(circuit->getOutputGates().size() == 1);
+    REQUIRE(circuit->getGateType(circuit->getOutputGates().at(0)) == GateType::OR);
+}
@@ -0,0 +1,107 @@
+#include "minimization/rule_rewriter.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "minimization/composition.hpp"
+#include "minimization/strategy.hpp"
+#include "testing/circuits.hpp"
+
+using namespace cirbo;
+using namespace cirbo::minimization;
+using namespace cirbo::testing;
+
+namespace
+{
+
+/* IFF(x) = x. */
+struct ReduceIff
+{
+    static constexpr std::string_view Name = "reduce_iff";
+    using Pattern                          = minimization::Pattern<TypeOf<GateType::IFF> >;
+
+    static void rewrite(RewriteView& view) { view.redirect(view.getOperands().at(0)); }
+};
+
+/* AND(x, NOT(x)) = 0, for two-operand AND only. */
+struct AndOfComplements
+{
+    static constexpr std::string_view Name = "and_of_complements";
+    using Pattern = minimization::Pattern<TypeOf<GateType::AND>, AnyType, TypeOf<GateType::NOT> >;
+
+    static bool guard(RewriteView const& view) { return view.getOperandOperands(1).at(0) == view.getOperands().at(0); }
+
+    static void rewrite(RewriteView& view) { view.replace(GateType::CONST_FALSE, {}); }
+};
+
+}  // namespace
+
+TEST_CASE("RuleRewriter AppliesRulesInOnePass", "[rule_rewriter]")
+{
+    utils::NameEncoder encoder;
+    // Chains of NOT and IFF are reduced, and NAND is split, in one traversal.
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(6)\n"
+        "2 = NOT(0)\n"
+        "3 = IFF(2)\n"
+        "4 = NOT(3)\n"
+        "5 = NOT(4)\n"
+        "6 = NAND(5, 1)\n",
+        encoder);
+
+    using Rewriter = RuleRewriter_<DAG, RuleSet<ReduceIff, rules::ReduceNot, rules::SplitNot> >;
+    auto [result, _] = Composition<DAG, Rewriter, RedundantGatesCleaner_<DAG> >().apply(*circuit, encoder);
+
+    REQUIRE(result->getNumberOfGates() == 5);
+    GateId const output = result->getOutputGates().at(0);
+    REQUIRE(result->getGateType(output) == GateType::NOT);
+    GateId const conjunction = result->getGateOperands(output).at(0);
+    REQUIRE(result->getGateType(conjunction) == GateType::AND);
+    for (GateId const operand : result->getGateOperands(conjunction))
+    {
+        REQUIRE((result->getGateType(operand) == GateType::INPUT || result->getGateType(operand) == GateType::NOT));
+    }
+}
+
+TEST_CASE("RuleRewriter PatternsAndGuards", "[rule_rewriter]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(3)\n"
+        "OUTPUT(4)\n"
+        "OUTPUT(5)\n"
+        "2 = NOT(0)\n"
+        "3 = AND(0, 2)\n"
+        "4 = AND(1, 2)\n"
+        "5 = AND(0, 1, 2)\n",
+        encoder);
+
+    using Rewriter = RuleRewriter_<DAG, RuleSet<AndOfComplements> >;
+    auto [result, _] = Composition<DAG, Rewriter>().apply(*circuit, encoder);
+
+    // Only 3 matches both pattern and guard: 4 fails guard and 5 fails pattern.
+    GateId const complements = encoder.encodeGate("3");
+    REQUIRE(result->getNumberOfGates() == circuit->getNumberOfGates());
+    REQUIRE(result->getGateType(complements) == GateType::CONST_FALSE);
+    REQUIRE(result->getGateOperands(complements).empty());
+    REQUIRE(result->getGateType(encoder.encodeGate("4")) == GateType::AND);
+    REQUIRE(result->getGateType(encoder.encodeGate("5")) == GateType::AND);
+    REQUIRE(result->getOutputGates() == circuit->getOutputGates());
+}
+
+TEST_CASE("RuleRewriter NegatedType", "[rule_rewriter]")
+{
+    REQUIRE(getNegatedType(GateType::AND) == GateType::NAND);
+    REQUIRE(getNegatedType(GateType::NOR) == GateType::OR);
+    REQUIRE(getNegatedType(GateType::NXOR) == GateType::XOR);
+    REQUIRE(getNegatedType(GateType::NOT) == GateType::UNDEFINED);
+    REQUIRE(getNegatedType(GateType::MUX) == GateType::UNDEFINED);
+}
@@ -0,0 +1,133 @@
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+#include "sat/solver.hpp"
+
+using namespace cirbo::sat;
+
+namespace
+{
+
+/* Adds clauses, stating that `pigeons` pigeons sit in `holes` holes, at most one per hole. */
+void addPigeonhole(Solver& solver, size_t pigeons, size_t holes)
+{
+    std::vector<std::vector<Var>> placed(pigeons);
+    for (size_t pigeon = 0; pigeon < pigeons; ++pigeon)
+    {
+        std::vector<Lit> clause;
+        for (size_t hole = 0; hole < holes; ++hole)
+        {
+            placed[pigeon].push_back(solver.newVar());
+            clause.push_back(posLit(placed[pigeon].back()));
+        }
+        solver.addClause(clause);
+    }
+    for (size_t hole = 0; hole < holes; ++hole)
+    {
+        for (size_t first = 0; first < pigeons; ++first)
+        {
+            for (size_t second = first + 1; second < pigeons; ++second)
+            {
+                solver.addClause({negLit(placed[first][hole]), negLit(placed[second][hole])});
+            }
+        }
+    }
+}
+
+}  // namespace
+
+TEST_CASE("Solver SimpleSat", "[sat_solver]")
+{
+    Solver solver;
+    Var const x = solver.newVar();
+    Var const y = solver.newVar();
+    Var const z = solver.newVar();
+
+    REQUIRE(solver.addClause({posLit(x), posLit(y)}));
+    REQUIRE(solver.addClause({negLit(x), posLit(z)}));
+    REQUIRE(solver.addClause({negLit(y), posLit(z)}));
+    REQUIRE(solver.addClause({negLit(z), negLit(x)}));
+
+    REQUIRE(solver.solve() == SolveResult::SAT);
+    REQUIRE(solver.getModelValue(z));
+    REQUIRE_FALSE(solver.getModelValue(x));
+    REQUIRE(solver.getModelValue(posLit(y)));
+}
+
+TEST_CASE("Solver Assumptions", "[sat_solver]")
+{
+    Solver solver;
+    Var const x = solver.newVar();
+    Var const y = solver.newVar();
+    REQUIRE(solver.addClause({negLit(x), posLit(y)}));
+
+    REQUIRE(solver.solve({posLit(x), negLit(y)}) == SolveResult::UNSAT);
+    // Assumptions do not persist between calls.
+    REQUIRE(solver.solve({posLit(x)}) == SolveResult::SAT);
+    REQUIRE(solver.getModelValue(y));
+    REQUIRE(solver.isConsistent());
+
+    REQUIRE(solver.addClause({negLit(y)}));
+    REQUIRE(solver.solve({posLit(x)}) == SolveResult::UNSAT);
+    REQUIRE(solver.solve() == SolveResult::SAT);
+    REQUIRE_FALSE(solver.getModelValue(x));
+}
+
+TEST_CASE("Solver PigeonholeIsUnsat", "[sat_solver]")
+{
+    Solver solver;
+    // Five pigeons do not fit into four holes.
+    addPigeonhole(solver, 5, 4);
+
+    REQUIRE(solver.solve({}, 1) == SolveResult::UNKNOWN);
+    REQUIRE(solver.solve() == SolveResult::UNSAT);
+    REQUIRE_FALSE(solver.isConsistent());
+    REQUIRE_FALSE(solver.addClause({posLit(0)}));
+}
+
+TEST_CASE("Solver EmptyAndTautologicalClauses", "[sat_solver]")
+{
+    Solver solver;
+    Var const x = solver.newVar();
+
+    REQUIRE(solver.addClause({posLit(x), negLit(x)}));
+    REQUIRE(solver.getNumberOfClauses() == 0);
+    REQUIRE(solver.addClause({posLit(x), posLit(x)}));
+    REQUIRE(solver.solve() == SolveResult::SAT);
+    REQUIRE(solver.getModelValue(x));
+    REQUIRE_FALSE(solver.addClause({negLit(x)}));
+    REQUIRE(solver.solve() == SolveResult::UNSAT);
+}
+
+TEST_CASE("Solver RestartsAndReducesLearnts", "[sat_solver]")
+{
+    Solver solver;
+    addPigeonhole(solver, 8, 7);
+
+    REQUIRE(solver.solve() == SolveResult::UNSAT);
+    REQUIRE(solver.getNumberOfRestarts() > 0);
+    REQUIRE(solver.getNumberOfReductions() > 0);
+}
+
+TEST_CASE("Solver IncrementalQueries", "[sat_solver]")
+{
+    Solver solver;
+    // Chain x0 -> x1 -> ... -> x99.
+    constexpr Var chain = 100;
+    for (Var var = 0; var < chain; ++var)
+    {
+        solver.newVar();
+    }
+    for (Var var = 0; var + 1 < chain; ++var)
+    {
+        solver.addClause({negLit(var), posLit(var + 1)});
+    }
+
+    for (Var var = 1; var < chain; ++var)
+    {
+        REQUIRE(solver.solve({posLit(0), negLit(var)}) == SolveResult::UNSAT);
+        REQUIRE(solver.solve({posLit(var), negLit(0)}) == SolveResult::SAT);
+        REQUIRE(solver.getModelValue(chain - 1));
+    }
+    REQUIRE(solver.isConsistent());
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "core/structures/dag.hpp"
+#include "sat/solver.hpp"
+#include "sat/tseitin.hpp"
+
+using namespace cirbo;
+using namespace cirbo::sat;
+
+TEST_CASE("TseitinEncoder EncodesOnlyCone", "[tseitin]")
+{
+    auto dag = DAG(
+        {
+            {GateType::INPUT, {}    },
+            {GateType::INPUT, {}    },
+            {GateType::INPUT, {}    },
+            {GateType::AND,   {0, 1}},
+            {GateType::NOT,   {3}   },
+            {GateType::OR,    {1, 2}},
+            {GateType::XOR,   {4, 5}}
+    },
+        {6});
+
+    Solver solver;
+    TseitinEncoder tseitin(dag, solver);
+
+    Lit const negated_and = tseitin.getLit(4);
+    REQUIRE(tseitin.isEncoded(3));
+    REQUIRE_FALSE(tseitin.isEncoded(2));
+    REQUIRE_FALSE(tseitin.isEncoded(5));
+    // NOT shares variable with its operand.
+    REQUIRE(negated_and == ~tseitin.getLit(3));
+    REQUIRE(solver.getNumberOfVars() == 3);
+
+    REQUIRE(solver.solve({~negated_and}) == SolveResult::SAT);
+    REQUIRE(tseitin.getModelValue(0));
+    REQUIRE(tseitin.getModelValue(1));
+
+    // Cone of the output reuses already encoded gates.
+    Lit const output = tseitin.getLit(6);
+    REQUIRE(tseitin.getNumberOfEncodedGates() == 7);
+    REQUIRE(solver.getNumberOfVars() == 6);
+    REQUIRE(solver.solve({output, ~tseitin.getLit(2), ~tseitin.getLit(1)}) == SolveResult::SAT);
+    REQUIRE(solver.solve({output, ~tseitin.getLit(0), tseitin.getLit(1)}) == SolveResult::UNSAT);
+}
+
+TEST_CASE("TseitinEncoder AllGateTypes", "[tseitin]")
+{
+    auto dag = DAG(
+        {
+            {GateType::INPUT,       {}       },
+            {GateType::INPUT,       {}       },
+            {GateType::INPUT,       {}       },
+            {GateType::NAND,        {0, 1, 2}},
+            {GateType::NOR,         {0, 1}   },
+            {GateType::NXOR,        {0, 1, 2}},
+            {GateType::MUX,         {0, 1, 2}},
+            {GateType::CONST_TRUE,  {}       },
+            {GateType::CONST_FALSE, {}       },
+            {GateType::IFF,         {7}      }
+    },
+        {3, 4, 5, 6, 8, 9});
+
+    Solver solver;
+    TseitinEncoder tseitin(dag, solver);
+    Lit const x = tseitin.getLit(0);
+    Lit const y = tseitin.getLit(1);
+    Lit const z = tseitin.getLit(2);
+    for (GateId const output : dag.getOutputGates())
+    {
+        tseitin.getLit(output);
+    }
+
+    for (size_t pattern = 0; pattern < 8; ++pattern)
+    {
+        bool const xv = (pattern & 1U) != 0;
+        bool const yv = (pattern & 2U) != 0;
+        bool const zv = (pattern & 4U) != 0;
+        REQUIRE(solver.solve({xv ? x : ~x, yv ? y : ~y, zv ? z : ~z}) == SolveResult::SAT);
+        REQUIRE(solver.getModelValue(tseitin.getLit(3)) == !(xv && yv && zv));
+        REQUIRE(solver.getModelValue(tseitin.getLit(4)) == !(xv || yv));
+        REQUIRE(solver.getModelValue(tseitin.getLit(5)) == !(xv != yv != zv));
+        REQUIRE(solver.getModelValue(tseitin.getLit(6)) == (xv ? zv : yv));
+        REQUIRE_FALSE(solver.getModelValue(tseitin.getLit(8)));
+        REQUIRE(solver.getModelValue(tseitin.getLit(9)));
+    }
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch_test_macros.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "core/npn.hpp"
+#include "synthesis/exact_synthesis.hpp"
+
+using namespace cirbo;
+using namespace cirbo::synthesis;
+
+namespace
+{
+
+uint64_t const x0 = npn::VariableMasks[0];
+uint64_t const x1 = npn::VariableMasks[1];
+uint64_t const x2 = npn::VariableMasks[2];
+
+/* Returns size of minimum circuit of function, checking that circuit computes it. */
+size_t getMinimumSize(Basis basis, uint64_t truth, size_t inputs)
+{
+    auto const circuit = ExactSynthesizer(basis).synthesize(truth, inputs);
+    REQUIRE(circuit.has_value());
+    CHECK(circuit->computeTruthTable() == (truth & npn::getTruthMask(inputs)));
+    return circuit->gates.size();
+}
+
+}  // namespace
+
+TEST_CASE("ExactSynthesis TrivialFunctions", "[exact_synthesis]")
+{
+    CHECK(getMinimumSize(Basis::AIG, x1, 2) == 0);
+    CHECK(getMinimumSize(Basis::AIG, 0, 2) == 1);
+    CHECK(getMinimumSize(Basis::AIG, ~uint64_t{0}, 0) == 1);
+    CHECK(getMinimumSize(Basis::AIG, ~x0, 1) == 1);
+}
+
+TEST_CASE("ExactSynthesis TwoInputs", "[exact_synthesis]")
+{
+    CHECK(getMinimumSize(Basis::BENCH, x0 ^ x1, 2) == 1);
+    CHECK(getMinimumSize(Basis::BENCH, ~(x0 | x1), 2) == 1);
+    CHECK(getMinimumSize(Basis::BENCH, x0 & ~x1, 2) == 2);
+    CHECK(getMinimumSize(Basis::AIG, x0 & x1, 2) == 1);
+    CHECK(getMinimumSize(Basis::AIG, x0 & ~x1, 2) == 2);
+    CHECK(getMinimumSize(Basis::AIG, x0 | x1, 2) == 4);
+    CHECK(getMinimumSize(Basis::XAG, x0 ^ x1, 2) == 1);
+}
+
+TEST_CASE("ExactSynthesis Majority", "[exact_synthesis]")
+{
+    uint64_t const majority = (x0 & x1) | (x0 & x2) | (x1 & x2);
+    CHECK(getMinimumSize(Basis::XAG, majority, 3) == 4);
+    CHECK(getMinimumSize(Basis::BENCH, majority, 3) == 4);
+    CHECK(getMinimumSize(Basis::BENCH, x0 ^ x1 ^ x2, 3) == 2);
+}
+
+TEST_CASE("ExactSynthesis MaxGates", "[exact_synthesis]")
+{
+    CHECK(!ExactSynthesizer(Basis::AIG, 3).synthesize(x0 | x1, 2).has_value());
+}
+
+TEST_CASE("ExactSynthesis FullAdder", "[exact_synthesis]")
+{
+    std::vector<uint64_t> const truths{x0 ^ x1 ^ x2, (x0 & x1) | (x0 & x2) | (x1 & x2)};
+    for (Basis const basis : {Basis::BENCH, Basis::XAG})
+    {
+        for (size_t const threads : {1, 4})
+        {
+            auto const circuit = ExactSynthesizer(basis, ExactSynthesizer::DefaultMaxGates, -1, threads)
+                                     .synthesize(truths, 3);
+            REQUIRE(circuit.has_value());
+            CHECK(circuit->gates.size() == 5);
+            CHECK(circuit->computeTruthTables() == std::vector<uint64_t>{truths[0] & 0xFF, truths[1] & 0xFF});
+        }
+    }
+}
+
+TEST_CASE("ExactSynthesis SharedAndTrivialOutputs", "[exact_synthesis]")
+{
+    std::vector<uint64_t> const truths{x0 & x1, x1, 0, x0 & x1};
+    auto const circuit = ExactSynthesizer(Basis::AIG).synthesize(truths, 2);
+    REQUIRE(circuit.has_value());
+    CHECK(circuit->gates.size() == 2);
+    CHECK(circuit->outputs[0] == circuit->outputs[3]);
+    CHECK(circuit->outputs[1] == 1);
+    CHECK(circuit->computeTruthTables() == std::vector<uint64_t>{x0 & x1 & 0xF, x1 & 0xF, 0, x0 & x1 & 0xF});
+}
+
+TEST_CASE("ExactSynthesis Cache", "[exact_synthesis]")
+{
+    ExactSynthesizer const synthesizer(Basis::AIG);
+    uint64_t const truth = x0 & ~x1 & x2;
+    REQUIRE(synthesizer.synthesize(truth, 3).has_value());
+    CHECK(synthesizer.getCache().getMisses() == 1);
+
+    // Same function and its input permutations are solved once.
+    REQUIRE(synthesizer.synthesize(truth, 3).has_value());
+    for (uint64_t const permuted : {x1 & ~x0 & x2, x2 & ~x1 & x0, x0 & x1 & ~x2})
+    {
+        auto const circuit = synthesizer.synthesize(permuted, 3);
+        REQUIRE(circuit.has_value());
+        CHECK(circuit->computeTruthTable() == (permuted & 0xFF));
+        CHECK(circuit->gates.size() == 3);
+    }
+    CHECK(synthesizer.getCache().getMisses() == 1);
+    CHECK(synthesizer.getCache().getHits() == 4);
+    CHECK(synthesizer.getCache().size() == 1);
+
+    // Failure under small limit doesn't prevent success under larger one, sharing the cache.
+    auto const cache = std::make_shared<SynthesisCache>();
+    CHECK(!ExactSynthesizer(Basis::AIG, 3, -1, 1, cache).synthesize(x0 | x1, 2).has_value());
+    CHECK(ExactSynthesizer(Basis::AIG, 4, -1, 1, cache).synthesize(x0 | x1, 2).has_value());
+    CHECK(!ExactSynthesizer(Basis::AIG, 3, -1, 1, cache).synthesize(x0 | x1, 2).has_value());
+    CHECK(cache->getHits() == 1);
+}
@@ -0,0 +1,149 @@
+#ifndef CIRBO_SEARCH_TESTS_TESTING_CIRCUITS_HPP
+#define CIRBO_SEARCH_TESTS_TESTING_CIRCUITS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/simulation.hpp"
+#include "core/structures/dag.hpp"
+#include "core/types.hpp"
+#include "io/parsers/bench_to_circuit.hpp"
+#include "utils/encoder.hpp"
+
+/**
+ * Helpers of tests, which build circuits from BENCH descriptions and compare them.
+ */
+namespace cirbo::testing
+{
+
+/**
+ * @param bench -- description of circuit in BENCH format.
+ * @param encoder -- is set to encoder of gate names of circuit.
+ * @return parsed circuit.
+ */
+inline std::unique_ptr<DAG> parseCircuit(std::string const& bench, utils::NameEncoder& encoder)
+{
+    std::istringstream stream(bench);
+    io::parsers::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+    encoder = parser.getEncoder();
+    return parser.instantiate();
+}
+
+/**
+ * Checks, that both circuits compute same outputs on all assignments of inputs.
+ * Inputs are matched by names, inputs of `lhs`, which `rhs` has not, must not
+ * affect outputs (minimization may remove them). Outputs are matched by positions.
+ */
+inline bool equivalentOnAllInputs(
+    DAG const& lhs,
+    utils::NameEncoder const& lhs_encoder,
+    DAG const& rhs,
+    utils::NameEncoder& rhs_encoder)
+{
+    size_t const inputs   = lhs.getInputGates().size();
+    size_t const patterns = size_t{1} << inputs;
+    size_t const words    = std::max<size_t>(patterns / 64, 1);
+    Simulation lhs_simulation(lhs, words);
+    Simulation rhs_simulation(rhs, words);
+    for (size_t pattern = 0; pattern < patterns; ++pattern)
+    {
+        for (size_t input = 0; input < inputs; ++input)
+        {
+            bool const value  = ((pattern >> input) & 1U) != 0;
+            GateId const gate = lhs.getInputGates().at(input);
+            std::string name  = lhs_encoder.decodeGate(gate);
+            lhs_simulation.setInputValue(gate, pattern, value);
+            if (rhs_encoder.keyExists(name))
+            {
+                rhs_simulation.setInputValue(rhs_encoder.encodeGate(std::move(name)), pattern, value);
+            }
+        }
+    }
+    lhs_simulation.run(lhs);
+    rhs_simulation.run(rhs);
+
+    for (size_t output = 0; output < lhs.getOutputGates().size(); ++output)
+    {
+        for (size_t pattern = 0; pattern < patterns; ++pattern)
+        {
+            if (lhs_simulation.getValue(lhs.getOutputGates().at(output), pattern) !=
+                rhs_simulation.getValue(rhs.getOutputGates().at(output), pattern))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/* Gate, random circuits are built of: name of its type in BENCH format and its arity. */
+struct RandomGate
+{
+    char const* type;
+    size_t arity;
+};
+
+/* Shape of random circuit, see `makeRandomCircuit`. */
+struct RandomCircuitOptions
+{
+    size_t inputs  = 6;
+    size_t gates   = 60;
+    size_t outputs = 3;
+    /* Operands of each gate are taken among this number of previous nodes. */
+    size_t window = 12;
+    /* Gates are drawn uniformly from this list, repeated entries are more frequent. */
+    std::vector<RandomGate> types = {
+        {"NOT", 1},
+        {"AND", 2},
+        {"OR",  2}
+    };
+    /* Whether the first gate is a random constant. */
+    bool constant = false;
+};
+
+/**
+ * @return description of random circuit in BENCH format: inputs are named `0..inputs - 1`,
+ *         gates are named by next numbers, the last `outputs` gates are outputs.
+ */
+inline std::string makeRandomCircuit(RandomCircuitOptions const& options, unsigned seed)
+{
+    std::mt19937 engine(seed);
+    std::ostringstream bench;
+    size_t const end = options.inputs + options.gates;
+    for (size_t i = 0; i < options.inputs; ++i)
+    {
+        bench << "INPUT(" << i << ")\n";
+    }
+    for (size_t i = 0; i < options.outputs; ++i)
+    {
+        bench << "OUTPUT(" << end - 1 - i << ")\n";
+    }
+    size_t begin = options.inputs;
+    if (options.constant)
+    {
+        bench << begin++ << " = CONST(" << engine() % 2 << ")\n";
+    }
+    for (size_t gate = begin; gate < end; ++gate)
+    {
+        std::uniform_int_distribution<size_t> operand(gate > options.window ? gate - options.window : 0, gate - 1);
+        RandomGate const& type = options.types.at(engine() % options.types.size());
+        bench << gate << " = " << type.type << "(";
+        for (size_t i = 0; i < type.arity; ++i)
+        {
+            bench << (i == 0 ? "" : ", ") << operand(engine);
+        }
+        bench << ")\n";
+    }
+    return bench.str();
+}
+
+}  // namespace cirbo::testing
+
+#endif  // CIRBO_SEARCH_TESTS_TESTING_CIRCUITS_HPP
@@ -0,0 +1,128 @@
+#include "utils/buffer_pool.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "core/structures/dag.hpp"
+#include "core/structures/gate_info.hpp"
+#include "core/types.hpp"
+#include "io/parsers/bench_to_circuit.hpp"
+#include "minimization/strategy.hpp"
+
+using namespace cirbo;
+using namespace cirbo::utils;
+
+TEST_CASE("BufferPool ReusesReleasedBuffers", "[buffer_pool]")
+{
+    BufferPool<int> pool;
+    REQUIRE(pool.size() == 0);
+
+    std::vector<int> buffer = pool.acquire(100);
+    REQUIRE(buffer.size() == 100);
+    int const* data = buffer.data();
+
+    pool.release(std::move(buffer));
+    REQUIRE(pool.size() == 1);
+
+    std::vector<int> reused = pool.acquire();
+    REQUIRE(reused.empty());
+    REQUIRE(reused.capacity() >= 100);
+    REQUIRE(reused.data() == data);
+    REQUIRE(pool.size() == 0);
+}
+
+TEST_CASE("BufferPool AcquireCopy", "[buffer_pool]")
+{
+    BufferPool<int> pool;
+    std::vector<int> const source{1, 2, 3};
+
+    std::vector<int> copy = pool.acquireCopy(source);
+    REQUIRE(copy == source);
+}
+
+TEST_CASE("BufferPool RespectsCapacity", "[buffer_pool]")
+{
+    BufferPool<int> pool;
+    pool.setCapacity(1);
+
+    pool.release(std::vector<int>(1));
+    pool.release(std::vector<int>(1));
+    // Buffers without capacity are never kept.
+    pool.release(std::vector<int>());
+    REQUIRE(pool.size() == 1);
+
+    pool.clear();
+    REQUIRE(pool.size() == 0);
+}
+
+TEST_CASE("BufferPool DAGRecyclesStorage", "[buffer_pool]")
+{
+    auto& pool = getBufferPool<GateId>();
+    pool.clear();
+
+    {
+        DAG const dag(
+            {
+                {GateType::INPUT, {}    },
+                {GateType::INPUT, {}    },
+                {GateType::AND,   {0, 1}}
+        },
+            {2});
+    }
+    // Operands and users of gates are returned to the pool on circuit destruction.
+    REQUIRE(pool.size() > 0);
+
+    size_t const released = pool.size();
+    DAG const dag(
+        {
+            {GateType::INPUT, {}    },
+            {GateType::INPUT, {}    },
+            {GateType::OR,    {0, 1}}
+    },
+        {2});
+    REQUIRE(pool.size() < released);
+    REQUIRE(dag.getGateOperands(2) == GateIdContainer({0, 1}));
+    REQUIRE(dag.getGateUsers(0) == GateIdContainer({2}));
+}
+
+TEST_CASE("BufferPool TransformerTakesOwnership", "[buffer_pool]")
+{
+    std::string const dag =
+        "INPUT(0)\n"
+        "INPUT(1)\n"
+        "OUTPUT(2)\n"
+        "2 = AND(0, 1)\n"
+        "3 = OR(0, 1)\n";
+
+    std::istringstream stream(dag);
+    io::parsers::BenchToCircuit<DAG> parser;
+    parser.parseStream(stream);
+
+    auto [circuit, encoder] = minimization::RedundantGatesCleaner<DAG>().apply(
+        parser.instantiate(), std::make_unique<NameEncoder>(parser.getEncoder()));
+
+    REQUIRE(circuit->getNumberOfGates() == 3);
+    REQUIRE(encoder->decodeGate(2) == "2");
+
+    auto [moved_circuit, moved_encoder] =
+        minimization::DuplicateGatesCleaner<DAG>().apply(std::move(*circuit), std::move(*encoder));
+
+    REQUIRE(moved_circuit->getNumberOfGates() == 3);
+    REQUIRE(moved_circuit->getGateType(moved_circuit->getOutputGates().at(0)) == GateType::AND);
+    REQUIRE(moved_encoder->size() == 3);
+}
+
+TEST_CASE("BufferPool ClearsPoolsOfThread", "[buffer_pool]")
+{
+    getBufferPool<int>().release(std::vector<int>(4));
+    getBufferPool<double>().release(std::vector<double>(4));
+    REQUIRE(getBufferPool<int>().size() > 0);
+    REQUIRE(getBufferPool<double>().size() > 0);
+
+    clearBufferPools();
+    REQUIRE(getBufferPool<int>().size() == 0);
+    REQUIRE(getBufferPool<double>().size() == 0);
+}
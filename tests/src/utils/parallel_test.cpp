@@ -0,0 +1,57 @@
+#include "utils/parallel.hpp"
+
+#include <catch2/catch_test_macros.hpp>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using namespace cirbo::utils;
+
+TEST_CASE("ParallelFor VisitsEachIndexOnce", "[parallel]")
+{
+    for (size_t const threads : {size_t{1}, size_t{4}, size_t{100}})
+    {
+        std::vector<std::atomic<size_t> > visits(50);
+        parallelFor(visits.size(), threads, [&visits](size_t i) { ++visits[i]; });
+        for (auto const& count : visits)
+        {
+            REQUIRE(count == 1);
+        }
+    }
+    parallelFor(0, 4, [](size_t /*i*/) { FAIL("no indices expected"); });
+}
+
+TEST_CASE("ParallelFor PerThreadState", "[parallel]")
+{
+    std::atomic<size_t> states = 0;
+    std::vector<size_t> owners(100);
+    parallelFor(
+        owners.size(),
+        4,
+        [&states]() { return states++; },
+        [&owners](size_t i, size_t const& state) { owners[i] = state; });
+
+    REQUIRE(states >= 1);
+    REQUIRE(states <= 4);
+    for (size_t const owner : owners)
+    {
+        REQUIRE(owner < states);
+    }
+}
+
+TEST_CASE("ParallelFor RethrowsError", "[parallel]")
+{
+    std::atomic<size_t> visited = 0;
+    auto const body = [&visited](size_t i)
+    {
+        ++visited;
+        if (i == 3)
+        {
+            throw std::runtime_error("failed");
+        }
+    };
+    REQUIRE_THROWS_AS(parallelFor(1000, 4, body), std::runtime_error);
+    // Threads stop after their current index.
+    REQUIRE(visited < 1000);
+}
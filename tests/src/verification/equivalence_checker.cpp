@@ -0,0 +1,155 @@
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "core/structures/dag.hpp"
+#include "minimization/pipeline_parser.hpp"
+#include "testing/circuits.hpp"
+#include "verification/equivalence_checker.hpp"
+
+using namespace cirbo;
+using namespace cirbo::verification;
+using namespace cirbo::testing;
+
+namespace
+{
+
+std::string const dag =
+    "INPUT(a)\n"
+    "INPUT(b)\n"
+    "INPUT(c)\n"
+    "OUTPUT(f)\n"
+    "OUTPUT(g)\n"
+    "na = NOT(a)\n"
+    "nna = NOT(na)\n"
+    "x = AND(nna, b)\n"
+    "y = AND(a, b)\n"
+    "f = OR(x, y, c)\n"
+    "g = XOR(a, b, c)\n";
+
+}  // namespace
+
+TEST_CASE("EquivalenceChecker MinimizedCircuitIsEquivalent", "[equivalence_checker]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+
+    auto [minimized, minimized_encoder] = minimization::parsePipeline("aggressive")->apply(*circuit, encoder);
+    REQUIRE(minimized->getNumberOfGates() < circuit->getNumberOfGates());
+
+    EquivalenceReport const report = EquivalenceChecker(1, 2).check(*circuit, encoder, *minimized, *minimized_encoder);
+    REQUIRE(report.isEquivalent());
+    REQUIRE(report.outputs.size() == 2);
+    REQUIRE(report.outputs.at(0).name == "f");
+    REQUIRE_FALSE(report.outputs.at(0).by_simulation);
+}
+
+TEST_CASE("EquivalenceChecker MatchesInputsAndOutputsByName", "[equivalence_checker]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+    utils::NameEncoder other_encoder;
+    auto other = parseCircuit(
+        "INPUT(c)\n"
+        "INPUT(b)\n"
+        "INPUT(a)\n"
+        "OUTPUT(g)\n"
+        "OUTPUT(f)\n"
+        "g = XOR(c, b, a)\n"
+        "y = AND(a, b)\n"
+        "f = OR(y, c)\n",
+        other_encoder);
+
+    EquivalenceReport const report = EquivalenceChecker().check(*circuit, encoder, *other, other_encoder);
+    REQUIRE(report.isEquivalent());
+    REQUIRE(report.outputs.at(1).name == "g");
+    REQUIRE_FALSE(report.outputs_matched_by_positions);
+}
+
+TEST_CASE("EquivalenceChecker ReportsMatchingByPositions", "[equivalence_checker]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+    utils::NameEncoder other_encoder;
+    auto other = parseCircuit(
+        "INPUT(a)\n"
+        "INPUT(b)\n"
+        "INPUT(c)\n"
+        "OUTPUT(p)\n"
+        "OUTPUT(q)\n"
+        "y = AND(a, b)\n"
+        "p = OR(y, c)\n"
+        "q = XOR(a, b, c)\n",
+        other_encoder);
+
+    EquivalenceReport const report = EquivalenceChecker().check(*circuit, encoder, *other, other_encoder);
+    REQUIRE(report.isEquivalent());
+    REQUIRE(report.outputs_matched_by_positions);
+
+    std::ostringstream out;
+    report.write(out);
+    REQUIRE(out.str().find("matched by positions") != std::string::npos);
+}
+
+TEST_CASE("EquivalenceChecker FindsDifference", "[equivalence_checker]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+    utils::NameEncoder other_encoder;
+    // `g` differs on many assignments, so simulation finds one; `f` is equivalent.
+    auto other = parseCircuit(
+        "INPUT(a)\n"
+        "INPUT(b)\n"
+        "INPUT(c)\n"
+        "OUTPUT(f)\n"
+        "OUTPUT(g)\n"
+        "y = AND(a, b)\n"
+        "f = OR(y, c)\n"
+        "g = OR(a, b, c)\n",
+        other_encoder);
+
+    EquivalenceReport const report = EquivalenceChecker().check(*circuit, encoder, *other, other_encoder);
+    REQUIRE_FALSE(report.isEquivalent());
+    REQUIRE(report.outputs.at(0).status == OutputStatus::EQUIVALENT);
+    REQUIRE(report.outputs.at(1).status == OutputStatus::DIFFERENT);
+    REQUIRE(report.outputs.at(1).by_simulation);
+    REQUIRE(report.outputs.at(1).counterexample.size() == 3);
+}
+
+TEST_CASE("EquivalenceChecker SatFindsRareDifference", "[equivalence_checker]")
+{
+    utils::NameEncoder encoder;
+    utils::NameEncoder other_encoder;
+    std::string inputs;
+    for (int i = 0; i < 24; ++i)
+    {
+        inputs += "INPUT(i" + std::to_string(i) + ")\n";
+    }
+    std::string operands = "i0";
+    for (int i = 1; i < 24; ++i)
+    {
+        operands += ", i" + std::to_string(i);
+    }
+    // Outputs differ on one of 2^24 assignments, so simulation almost surely misses it.
+    auto circuit = parseCircuit(inputs + "OUTPUT(o)\no = AND(" + operands + ")\n", encoder);
+    auto other   = parseCircuit(inputs + "OUTPUT(o)\nz = CONST(0)\no = AND(z, i0)\n", other_encoder);
+
+    EquivalenceReport const report = EquivalenceChecker(1).check(*circuit, encoder, *other, other_encoder);
+    REQUIRE(report.outputs.at(0).status == OutputStatus::DIFFERENT);
+    REQUIRE_FALSE(report.outputs.at(0).by_simulation);
+    for (auto const& [name, value] : report.outputs.at(0).counterexample)
+    {
+        REQUIRE(value);
+    }
+}
+
+TEST_CASE("EquivalenceChecker DifferentNumberOfOutputs", "[equivalence_checker]")
+{
+    utils::NameEncoder encoder;
+    auto circuit = parseCircuit(dag, encoder);
+    utils::NameEncoder other_encoder;
+    auto other = parseCircuit("INPUT(a)\nOUTPUT(a)\n", other_encoder);
+
+    REQUIRE_THROWS_AS(EquivalenceChecker().check(*circuit, encoder, *other, other_encoder), std::invalid_argument);
+}